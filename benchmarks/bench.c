@@ -0,0 +1,355 @@
+/**
+ * bench.c - Micro-Benchmark Harness implementation
+ *
+ * See bench.h for the measurement model and command-line flags.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE     /* sysconf(_SC_LEVEL1_DCACHE_SIZE) */
+#endif
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#define BENCH_NULL_DEVICE "NUL"
+#else
+#include <unistd.h>
+#define BENCH_NULL_DEVICE "/dev/null"
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_POSIX_IO 1
+#include <fcntl.h>
+#endif
+
+#define BENCH_MAX_SAMPLES 1000
+#define BENCH_MIN_SAMPLES 5
+
+#if !defined(__GNUC__) && !defined(__clang__)
+const void *volatile bench_sink;
+#endif
+
+// Opened once by bench_parse_args when --counters is given
+static PerfCounters counters;
+static bool counters_open = false;
+
+void bench_config_default(BenchConfig *config) {
+    config->warmup = 3;
+    config->repetitions = 31;
+    config->min_sample_ns = 200e3;      // 200us: ~10000x the clock resolution
+    config->max_case_seconds = 3.0;
+    config->min_bytes = 4 * 1024;
+    config->max_bytes = 64 * 1024 * 1024;
+    config->filter = NULL;
+    config->counters = false;
+}
+
+/**
+ * Parse "64M", "256K", "4096" into bytes (0 on error)
+ */
+static size_t parse_size(const char *text) {
+    char *end;
+    unsigned long long value = strtoull(text, &end, 10);
+    switch (*end) {
+        case 'k': case 'K': value <<= 10; end++; break;
+        case 'm': case 'M': value <<= 20; end++; break;
+        case 'g': case 'G': value <<= 30; end++; break;
+        default: break;
+    }
+    return (*end == '\0') ? (size_t)value : 0;
+}
+
+static void print_usage(const char *program) {
+    printf("Usage: %s [--reps N] [--warmup N] [--max-size SIZE] [--filter TEXT] [--counters]\n", program);
+    printf("  --reps N        Timed samples per case (default 31)\n");
+    printf("  --warmup N      Untimed runs before sampling (default 3)\n");
+    printf("  --max-size SIZE Largest working set, e.g. 4M or 256K (default 64M)\n");
+    printf("  --filter TEXT   Only run cases whose name contains TEXT\n");
+    printf("  --counters      Report IPC and cache/branch/TLB misses per element\n");
+}
+
+bool bench_parse_args(BenchConfig *config, int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--reps") == 0 && value != NULL) {
+            config->repetitions = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--warmup") == 0 && value != NULL) {
+            config->warmup = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--max-size") == 0 && value != NULL) {
+            config->max_bytes = parse_size(value);
+            i++;
+        } else if (strcmp(arg, "--filter") == 0 && value != NULL) {
+            config->filter = value;
+            i++;
+        } else if (strcmp(arg, "--counters") == 0) {
+            config->counters = true;
+        } else {
+            print_usage(argv[0]);
+            return false;
+        }
+    }
+
+    if (config->repetitions < 1 || config->repetitions > BENCH_MAX_SAMPLES ||
+        config->warmup < 0 || config->max_bytes < config->min_bytes) {
+        print_usage(argv[0]);
+        return false;
+    }
+
+    if (config->counters && !counters_open) {
+        counters_open = perf_counters_open(&counters);
+        if (!counters_open) {
+            perf_counters_print_unavailable(&counters);
+            config->counters = false;
+        }
+    }
+    return true;
+}
+
+uint64_t bench_now_ns(void) {
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);    // Not monotonic, but high resolution
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Time 'runs' back-to-back runs (setup, if any, is outside the timer).
+ * With 'pc', hardware counters run exactly while the timer does.
+ */
+static double time_sample(const BenchCase *c, long runs, PerfCounters *pc) {
+    if (c->setup != NULL) {
+        c->setup(c->ctx);
+    }
+    if (pc != NULL) {
+        perf_counters_enable(pc);
+    }
+    uint64_t start = bench_now_ns();
+    for (long r = 0; r < runs; r++) {
+        c->run(c->ctx);
+    }
+    bench_clobber_memory();
+    uint64_t elapsed = bench_now_ns() - start;
+    if (pc != NULL) {
+        perf_counters_disable(pc);
+    }
+    return (double)elapsed;
+}
+
+bool bench_run(const BenchConfig *config, const BenchCase *c, BenchResult *result) {
+    if (config->filter != NULL && strstr(c->name, config->filter) == NULL) {
+        return false;
+    }
+
+    // Warmup: page in data, train predictors, settle the clock frequency
+    for (int w = 0; w < config->warmup; w++) {
+        time_sample(c, 1, NULL);
+    }
+
+    // Batch fast operations so each sample spans min_sample_ns
+    long runs = 1;
+    if (c->setup == NULL) {
+        double elapsed = time_sample(c, runs, NULL);
+        while (elapsed < config->min_sample_ns && runs < (1L << 30)) {
+            runs *= 2;
+            elapsed = time_sample(c, runs, NULL);
+        }
+    }
+
+    PerfCounters *pc = (config->counters && counters_open) ? &counters : NULL;
+    if (pc != NULL) {
+        perf_counters_reset(pc);
+    }
+
+    static double samples[BENCH_MAX_SAMPLES];
+    int count = 0;
+    uint64_t case_start = bench_now_ns();
+    while (count < config->repetitions) {
+        samples[count++] = time_sample(c, runs, pc) / (double)runs;
+        double spent = (double)(bench_now_ns() - case_start) * 1e-9;
+        if (count >= BENCH_MIN_SAMPLES && spent > config->max_case_seconds) {
+            break;
+        }
+    }
+
+    qsort(samples, (size_t)count, sizeof(double), compare_doubles);
+    result->samples = count;
+    result->runs_per_sample = runs;
+    result->min_ns = samples[0];
+    result->median_ns = (count % 2) ? samples[count / 2]
+                                    : 0.5 * (samples[count / 2 - 1] + samples[count / 2]);
+    // Nearest-rank p99
+    int rank = (int)((99.0 * count + 99) / 100);
+    result->p99_ns = samples[(rank < 1 ? 1 : rank) - 1];
+
+    result->has_counters = pc != NULL;
+    if (pc != NULL) {
+        perf_counters_read(pc, &result->counters);
+    }
+    return true;
+}
+
+size_t bench_cache_size(int level) {
+    long bytes = -1;
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+    switch (level) {
+        case 1: bytes = sysconf(_SC_LEVEL1_DCACHE_SIZE); break;
+        case 2: bytes = sysconf(_SC_LEVEL2_CACHE_SIZE); break;
+        case 3: bytes = sysconf(_SC_LEVEL3_CACHE_SIZE); break;
+        default: break;
+    }
+#endif
+    if (bytes > 0) {
+        return (size_t)bytes;
+    }
+    // Typical desktop/server core when the OS cannot tell us
+    switch (level) {
+        case 1: return 32 * 1024;
+        case 2: return 1024 * 1024;
+        case 3: return 32 * 1024 * 1024;
+        default: return 0;
+    }
+}
+
+static void format_bytes(char *out, size_t out_size, size_t bytes) {
+    if (bytes >= (1u << 30)) {
+        snprintf(out, out_size, "%zuGB", bytes >> 30);
+    } else if (bytes >= (1u << 20)) {
+        snprintf(out, out_size, "%zuMB", bytes >> 20);
+    } else if (bytes >= (1u << 10)) {
+        snprintf(out, out_size, "%zuKB", bytes >> 10);
+    } else {
+        snprintf(out, out_size, "%zuB", bytes);
+    }
+}
+
+int bench_sizes(const BenchConfig *config, BenchSize *sizes, int max_sizes) {
+    size_t l1 = bench_cache_size(1);
+    size_t l2 = bench_cache_size(2);
+    size_t l3 = bench_cache_size(3);
+    int count = 0;
+
+    for (size_t bytes = config->min_bytes; bytes <= config->max_bytes && count < max_sizes; bytes *= 4) {
+        const char *level = bytes <= l1 ? "L1" : bytes <= l2 ? "L2" : bytes <= l3 ? "L3" : "DRAM";
+        char text[16];
+        format_bytes(text, sizeof(text), bytes);
+        sizes[count].bytes = bytes;
+        snprintf(sizes[count].label, sizeof(sizes[count].label), "%s %s", text, level);
+        count++;
+    }
+    return count;
+}
+
+void bench_print_header(const char *suite) {
+    char l1[16], l2[16], l3[16];
+    format_bytes(l1, sizeof(l1), bench_cache_size(1));
+    format_bytes(l2, sizeof(l2), bench_cache_size(2));
+    format_bytes(l3, sizeof(l3), bench_cache_size(3));
+
+    printf("========================================\n");
+    printf("BENCHMARK: %s\n", suite);
+    printf("========================================\n");
+    printf("Caches: L1d %s, L2 %s, L3 %s\n\n", l1, l2, l3);
+    printf("%-28s %-12s %10s %10s %10s %9s\n",
+           "Case", "Working set", "median", "p99", "ns/elem", "GB/s");
+    printf("%-28s %-12s %10s %10s %10s %9s\n",
+           "----------------------------", "------------", "----------", "----------",
+           "----------", "---------");
+}
+
+static void format_time(char *out, size_t out_size, double ns) {
+    if (ns >= 1e9) {
+        snprintf(out, out_size, "%.2f s", ns * 1e-9);
+    } else if (ns >= 1e6) {
+        snprintf(out, out_size, "%.2f ms", ns * 1e-6);
+    } else if (ns >= 1e3) {
+        snprintf(out, out_size, "%.2f us", ns * 1e-3);
+    } else {
+        snprintf(out, out_size, "%.1f ns", ns);
+    }
+}
+
+void bench_print_result(const BenchCase *c, const BenchResult *r, const char *size_label) {
+    char median[16], p99[16], gbps[16];
+    format_time(median, sizeof(median), r->median_ns);
+    format_time(p99, sizeof(p99), r->p99_ns);
+    if (c->bytes > 0) {
+        snprintf(gbps, sizeof(gbps), "%.2f", (double)c->bytes / r->median_ns);
+    } else {
+        snprintf(gbps, sizeof(gbps), "-");
+    }
+    double per_element = c->elements > 0 ? r->median_ns / (double)c->elements : 0.0;
+
+    printf("%-28s %-12s %10s %10s %10.3f %9s\n",
+           c->name, size_label != NULL ? size_label : "-", median, p99, per_element, gbps);
+    if (r->has_counters) {
+        double total_elements = (double)r->samples * (double)r->runs_per_sample * (double)c->elements;
+        perf_sample_print(&r->counters, total_elements, "");
+    }
+    fflush(stdout);
+}
+
+uint32_t bench_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+#ifdef HAVE_POSIX_IO
+static int saved_stdout = -1;
+#endif
+
+void bench_quiet_begin(void) {
+#ifdef HAVE_POSIX_IO
+    fflush(stdout);
+    int null_fd = open(BENCH_NULL_DEVICE, O_WRONLY);
+    if (null_fd >= 0) {
+        saved_stdout = dup(STDOUT_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    }
+#endif
+}
+
+void bench_quiet_end(void) {
+#ifdef HAVE_POSIX_IO
+    fflush(stdout);
+    if (saved_stdout >= 0) {
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+        saved_stdout = -1;
+    }
+#endif
+}
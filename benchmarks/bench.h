@@ -0,0 +1,176 @@
+/**
+ * ============================================================================
+ * bench.h - Micro-Benchmark Harness
+ * ============================================================================
+ *
+ * PURPOSE:
+ * Repeatable timings for the examples in this repository. Replaces
+ * ad-hoc clock() loops (stack_vs_heap.c, sorting.c, ...) with:
+ * - A monotonic, nanosecond clock (CLOCK_MONOTONIC / QPC)
+ * - Warmup runs, then many timed samples; median and p99 reported
+ * - Automatic batching: fast operations repeat until a sample is long
+ *   enough for the clock to measure accurately
+ * - Per-run setup outside the timed region (e.g. re-shuffle before sort)
+ * - ns/element and GB/s, so different sizes compare directly
+ * - A size sweep from L1-resident to DRAM-resident working sets
+ * - bench_do_not_optimize(): keeps the compiler from deleting work
+ *
+ * USAGE:
+ *   static void run_sum(void *ctx) { ...; bench_do_not_optimize(&sum); }
+ *
+ *   BenchCase c = { "sum", n, n * sizeof(int), NULL, run_sum, &data };
+ *   BenchResult r;
+ *   if (bench_run(&config, &c, &r)) {
+ *       bench_print_result(&c, &r, size_label);
+ *   }
+ *
+ * COMMAND LINE (every bench_* executable):
+ *   --reps N        Timed samples per case (default 31)
+ *   --warmup N      Untimed runs first (default 3)
+ *   --max-size S    Largest working set, e.g. 4M, 256K (default 64M)
+ *   --filter TEXT   Only cases whose name contains TEXT
+ *   --counters      Also report hardware counters (perf_counters.h):
+ *                   IPC plus cycles/instructions/misses per element
+ *
+ * TIPS FOR STABLE NUMBERS:
+ * - Build with -DCMAKE_BUILD_TYPE=Release
+ * - Pin the process (taskset -c 2) and fix the CPU frequency governor
+ * - Compare medians; a large p99/median gap means interference
+ *
+ * ============================================================================
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "perf_counters.h"
+
+#define BENCH_MAX_SIZES 16
+
+/**
+ * Harness settings (bench_config_default + bench_parse_args)
+ */
+typedef struct {
+    int warmup;                 // Untimed runs before sampling
+    int repetitions;            // Timed samples per case
+    double min_sample_ns;       // Batch runs until one sample is this long
+    double max_case_seconds;    // Stop sampling early (min 5 samples) after this
+    size_t min_bytes;           // Smallest working set in the sweep
+    size_t max_bytes;           // Largest working set in the sweep
+    const char *filter;         // Substring filter on case names (NULL = all)
+    bool counters;              // Count hardware events during timed runs
+} BenchConfig;
+
+/**
+ * One benchmark case
+ *
+ * setup runs before EVERY timed run and is not timed. Cases with a
+ * setup are never batched (each sample is one run); cases without one
+ * may run back to back many times per sample.
+ */
+typedef struct {
+    const char *name;
+    size_t elements;            // Work items per run (ns/element)
+    size_t bytes;               // Bytes moved per run (GB/s); 0 = not meaningful
+    void (*setup)(void *ctx);   // May be NULL
+    void (*run)(void *ctx);
+    void *ctx;
+} BenchCase;
+
+/**
+ * Per-run statistics (nanoseconds for one call of run)
+ */
+typedef struct {
+    double median_ns;
+    double p99_ns;
+    double min_ns;
+    int samples;
+    long runs_per_sample;
+    bool has_counters;          // counters valid (config->counters and supported)
+    PerfSample counters;        // Totals over all timed runs (setup excluded)
+} BenchResult;
+
+/**
+ * Working-set size for a sweep point, labelled with the cache level
+ * it fits in on this machine (e.g. "32KB  L1")
+ */
+typedef struct {
+    size_t bytes;
+    char label[24];
+} BenchSize;
+
+void bench_config_default(BenchConfig *config);
+
+/**
+ * Parse the common flags. Returns false (after printing usage) on
+ * --help or a bad argument.
+ */
+bool bench_parse_args(BenchConfig *config, int argc, char **argv);
+
+/**
+ * Monotonic time in nanoseconds
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * Run one case. Returns false if the case is filtered out.
+ */
+bool bench_run(const BenchConfig *config, const BenchCase *bench_case, BenchResult *result);
+
+/**
+ * Sizes from config->min_bytes to config->max_bytes (x4 steps)
+ * Returns: number of entries written to sizes
+ */
+int bench_sizes(const BenchConfig *config, BenchSize *sizes, int max_sizes);
+
+/**
+ * Detected data cache sizes in bytes (nominal values if unknown)
+ */
+size_t bench_cache_size(int level);
+
+/**
+ * Report helpers: one header per suite, one line per result
+ */
+void bench_print_header(const char *suite);
+void bench_print_result(const BenchCase *bench_case, const BenchResult *result, const char *size_label);
+
+/**
+ * Repeatable pseudo-random numbers (xorshift64*) for input data
+ */
+uint32_t bench_random(uint64_t *state);
+
+/**
+ * Redirect stdout to the null device while examples that print are
+ * timed (no-op where unsupported). Calls must be paired.
+ */
+void bench_quiet_begin(void);
+void bench_quiet_end(void);
+
+/**
+ * Optimization barriers (Google Benchmark's DoNotOptimize/ClobberMemory)
+ * - bench_do_not_optimize(p): the value at p is treated as read, so the
+ *   computation that produced it cannot be removed
+ * - bench_clobber_memory(): all memory is treated as read and written,
+ *   so stores before it cannot be removed or sunk past it
+ */
+#if defined(__GNUC__) || defined(__clang__)
+static inline void bench_do_not_optimize(const void *p) {
+    __asm__ volatile("" : : "r"(p) : "memory");
+}
+static inline void bench_clobber_memory(void) {
+    __asm__ volatile("" : : : "memory");
+}
+#else
+extern const void *volatile bench_sink;
+static inline void bench_do_not_optimize(const void *p) {
+    bench_sink = p;
+}
+static inline void bench_clobber_memory(void) {
+    bench_sink = (const void*)&bench_sink;
+}
+#endif
+
+#endif /* BENCH_H */
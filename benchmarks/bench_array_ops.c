@@ -0,0 +1,113 @@
+/**
+ * bench_array_ops.c - Kernels behind data-structures/beginner/array_operations.c
+ *
+ * Reductions and in-place permutations over the whole array; GB/s
+ * counts bytes read (min/max) or read + written (reverse, rotate).
+ */
+
+#define main array_operations_example_main
+#include "../data-structures/beginner/array_operations.c"
+#undef main
+
+#include "bench.h"
+
+typedef struct {
+    int *data;
+    int size;
+    int threads;
+} ArrayContext;
+
+// The original one-int-at-a-time loop, for comparison
+static void scalar_min_max_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    MinMaxResult r = { a->data[0], a->data[0], 0, 0 };
+    for (int i = 1; i < a->size; i++) {
+        if (a->data[i] < r.min) { r.min = a->data[i]; r.min_index = (size_t)i; }
+        if (a->data[i] > r.max) { r.max = a->data[i]; r.max_index = (size_t)i; }
+    }
+    bench_do_not_optimize(&r);
+}
+
+static void min_max_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    MinMaxResult r;
+    array_min_max(a->data, (size_t)a->size, &r);
+    bench_do_not_optimize(&r);
+}
+
+static void min_max_parallel_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    MinMaxResult r;
+    array_min_max_parallel(a->data, (size_t)a->size, a->threads, &r);
+    bench_do_not_optimize(&r);
+}
+
+static void reverse_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    array_reverse(a->data, (size_t)a->size);
+    bench_do_not_optimize(a->data);
+}
+
+static void reverse_parallel_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    array_reverse_parallel(a->data, (size_t)a->size, a->threads);
+    bench_do_not_optimize(a->data);
+}
+
+static void rotate_short_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    array_rotate_left(a->data, (size_t)a->size, 7);
+    bench_do_not_optimize(a->data);
+}
+
+static void rotate_third_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    array_rotate_left(a->data, (size_t)a->size, (size_t)a->size / 3);
+    bench_do_not_optimize(a->data);
+}
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    bench_config_default(&config);
+    if (!bench_parse_args(&config, argc, argv)) {
+        return 1;
+    }
+
+    BenchSize sizes[BENCH_MAX_SIZES];
+    int num_sizes = bench_sizes(&config, sizes, BENCH_MAX_SIZES);
+    bench_print_header("array operations");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = (int)(sizes[s].bytes / sizeof(int));
+        int *data = malloc((size_t)n * sizeof(int));
+        if (data == NULL) {
+            break;
+        }
+        uint64_t seed = 0xa22a4u + (uint64_t)n;
+        for (int i = 0; i < n; i++) {
+            data[i] = (int)bench_random(&seed);
+        }
+
+        ArrayContext ctx = { data, n, 0 };
+        size_t bytes = (size_t)n * sizeof(int);
+        BenchCase cases[] = {
+            { "min/max scalar loop",      (size_t)n, bytes,     NULL, scalar_min_max_run, &ctx },
+            { "array_min_max",            (size_t)n, bytes,     NULL, min_max_run, &ctx },
+            { "array_min_max_parallel",   (size_t)n, bytes,     NULL, min_max_parallel_run, &ctx },
+            { "array_reverse",            (size_t)n, 2 * bytes, NULL, reverse_run, &ctx },
+            { "array_reverse_parallel",   (size_t)n, 2 * bytes, NULL, reverse_parallel_run, &ctx },
+            { "array_rotate_left (by 7)", (size_t)n, 2 * bytes, NULL, rotate_short_run, &ctx },
+            { "array_rotate_left (n/3)",  (size_t)n, 2 * bytes, NULL, rotate_third_run, &ctx },
+        };
+
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+            BenchResult result;
+            if (bench_run(&config, &cases[c], &result)) {
+                bench_print_result(&cases[c], &result, sizes[s].label);
+            }
+        }
+        printf("\n");
+        free(data);
+    }
+    return 0;
+}
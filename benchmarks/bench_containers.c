@@ -0,0 +1,226 @@
+/**
+ * bench_containers.c - DynamicArray (ex01) and linked lists (ex02)
+ *
+ * Both examples define main() and a few same-named helpers, so each
+ * is compiled into its own translation unit: this file is built twice,
+ * once with BENCH_DYNAMIC_ARRAY and once with BENCH_LINKED_LIST.
+ */
+
+#if defined(BENCH_DYNAMIC_ARRAY)
+#define main dynamic_array_example_main
+#include "../exercises/intermediate/ex01_dynamic_array.c"
+#undef main
+#elif defined(BENCH_LINKED_LIST)
+#define main linked_list_example_main
+#include "../exercises/intermediate/ex02_linked_list.c"
+#undef main
+#else
+#error "Define BENCH_DYNAMIC_ARRAY or BENCH_LINKED_LIST"
+#endif
+
+#include "bench.h"
+
+#if defined(BENCH_DYNAMIC_ARRAY)
+
+typedef struct {
+    int count;
+    GrowthPolicy policy;
+    const int *values;
+    DynamicArray *filled;
+} ArrayContext;
+
+static void append_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    DynamicArray *arr = create_array(4);
+    if (arr == NULL) {
+        return;
+    }
+    set_growth_policy(arr, a->policy);
+    for (int i = 0; i < a->count; i++) {
+        append(arr, i);
+    }
+    bench_do_not_optimize(arr->data);
+    destroy_array(arr);
+}
+
+static void append_many_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    DynamicArray *arr = create_array(4);
+    if (arr == NULL) {
+        return;
+    }
+    append_many(arr, a->values, (size_t)a->count);
+    bench_do_not_optimize(arr->data);
+    destroy_array(arr);
+}
+
+static void get_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    long long sum = 0;
+    for (size_t i = 0; i < a->filled->size; i++) {
+        int value;
+        get(a->filled, i, &value);
+        sum += value;
+    }
+    bench_do_not_optimize(&sum);
+}
+
+static void small_vector_run(void *ctx) {
+    ArrayContext *a = (ArrayContext*)ctx;
+    IntVec v;
+    IntVec_init(&v);
+    for (int i = 0; i < a->count; i++) {
+        IntVec_push(&v, i);
+    }
+    bench_do_not_optimize(v.data);
+    IntVec_free(&v);
+}
+
+static void run_suite(const BenchConfig *config, const BenchSize *size) {
+    int n = (int)(size->bytes / sizeof(int));
+    int *values = malloc((size_t)n * sizeof(int));
+    DynamicArray *filled = create_array((size_t)n);
+    if (values == NULL || filled == NULL) {
+        free(values);
+        destroy_array(filled);
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        values[i] = i;
+    }
+    append_many(filled, values, (size_t)n);
+
+    ArrayContext ctx = { n, GROWTH_DOUBLE, values, filled };
+    size_t bytes = (size_t)n * sizeof(int);
+    struct {
+        BenchCase bench;
+        GrowthPolicy policy;
+    } cases[] = {
+        { { "append (x2 growth)",   (size_t)n, bytes, NULL, append_run, &ctx }, GROWTH_DOUBLE },
+        { { "append (x1.5 growth)", (size_t)n, bytes, NULL, append_run, &ctx }, GROWTH_ONE_AND_HALF },
+        { { "append (page rounded)", (size_t)n, bytes, NULL, append_run, &ctx }, GROWTH_PAGE_ROUNDED },
+        { { "append_many",          (size_t)n, bytes, NULL, append_many_run, &ctx }, GROWTH_DOUBLE },
+        { { "get (sequential)",     (size_t)n, bytes, NULL, get_run, &ctx }, GROWTH_DOUBLE },
+        { { "IntVec_push (SBO)",    (size_t)n, bytes, NULL, small_vector_run, &ctx }, GROWTH_DOUBLE },
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        ctx.policy = cases[c].policy;
+        BenchResult result;
+        if (bench_run(config, &cases[c].bench, &result)) {
+            bench_print_result(&cases[c].bench, &result, size->label);
+        }
+    }
+    free(values);
+    destroy_array(filled);
+}
+
+#define SUITE_NAME "DynamicArray (ex01_dynamic_array.c)"
+
+#else /* BENCH_LINKED_LIST */
+
+typedef struct {
+    size_t count;
+    NodePool *pool;
+    Node *malloc_head;
+    Node *pool_head;
+    UnrolledList *unrolled;
+} ListContext;
+
+static void push_back_run(void *ctx) {
+    ListContext *l = (ListContext*)ctx;
+    LinkedList list;
+    list_init(&list, l->pool);
+    for (size_t i = 0; i < l->count; i++) {
+        list_push_back(&list, (int)i);
+    }
+    bench_do_not_optimize(list.head);
+    list_free(&list);
+}
+
+static void search_malloc_run(void *ctx) {
+    ListContext *l = (ListContext*)ctx;
+    Node *found = search(l->malloc_head, -1);     // Absent: walks every node
+    bench_do_not_optimize(&found);
+}
+
+static void search_pool_run(void *ctx) {
+    ListContext *l = (ListContext*)ctx;
+    Node *found = search(l->pool_head, -1);
+    bench_do_not_optimize(&found);
+}
+
+static void ulist_search_run(void *ctx) {
+    ListContext *l = (ListContext*)ctx;
+    bool found = ulist_search(l->unrolled, -1, NULL, NULL);
+    bench_do_not_optimize(&found);
+}
+
+static void run_suite(const BenchConfig *config, const BenchSize *size) {
+    size_t n = size->bytes / sizeof(Node);
+    NodePool pool;
+    node_pool_init(&pool);
+
+    // Prebuilt lists for the traversal cases
+    LinkedList malloc_list, pool_list;
+    UnrolledList unrolled;
+    list_init(&malloc_list, NULL);
+    list_init(&pool_list, &pool);
+    ulist_init(&unrolled);
+    for (size_t i = 0; i < n; i++) {
+        list_push_back(&malloc_list, (int)i);
+        list_push_back(&pool_list, (int)i);
+        ulist_push_back(&unrolled, (int)i);
+    }
+
+    NodePool build_pool;
+    node_pool_init(&build_pool);
+    ListContext ctx = { n, NULL, malloc_list.head, pool_list.head, &unrolled };
+    size_t node_bytes = n * sizeof(Node);
+    struct {
+        BenchCase bench;
+        NodePool *pool;
+    } cases[] = {
+        { { "list_push_back (malloc)", n, node_bytes, NULL, push_back_run, &ctx }, NULL },
+        { { "list_push_back (NodePool)", n, node_bytes, NULL, push_back_run, &ctx }, &build_pool },
+        { { "search (malloc nodes)",   n, node_bytes, NULL, search_malloc_run, &ctx }, NULL },
+        { { "search (NodePool nodes)", n, node_bytes, NULL, search_pool_run, &ctx }, NULL },
+        { { "ulist_search (unrolled)", n, n * sizeof(int), NULL, ulist_search_run, &ctx }, NULL },
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        ctx.pool = cases[c].pool;
+        BenchResult result;
+        if (bench_run(config, &cases[c].bench, &result)) {
+            bench_print_result(&cases[c].bench, &result, size->label);
+        }
+    }
+
+    list_free(&malloc_list);
+    list_free(&pool_list);
+    ulist_free(&unrolled);
+    node_pool_destroy(&pool);
+    node_pool_destroy(&build_pool);
+}
+
+#define SUITE_NAME "linked lists (ex02_linked_list.c)"
+
+#endif
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    bench_config_default(&config);
+    if (!bench_parse_args(&config, argc, argv)) {
+        return 1;
+    }
+
+    BenchSize sizes[BENCH_MAX_SIZES];
+    int num_sizes = bench_sizes(&config, sizes, BENCH_MAX_SIZES);
+    bench_print_header(SUITE_NAME);
+
+    for (int s = 0; s < num_sizes; s++) {
+        run_suite(&config, &sizes[s]);
+        printf("\n");
+    }
+    return 0;
+}
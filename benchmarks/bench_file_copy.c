@@ -0,0 +1,113 @@
+/**
+ * bench_file_copy.c - Copy engines from exercises/intermediate/ex03_file_copy.c
+ *
+ * The source file is written once per size and stays in the page
+ * cache, so this measures the copy path (syscalls, user-space copies,
+ * threads), not the disk. GB/s counts bytes copied; ns/elem is per byte.
+ *
+ * copy_file() and friends print progress, so stdout is silenced while
+ * they run; results are printed after it is restored.
+ */
+
+#define main file_copy_example_main
+#include "../exercises/intermediate/ex03_file_copy.c"
+#undef main
+
+#include "bench.h"
+
+#define BENCH_SOURCE_FILE "bench_copy_source.tmp"
+#define BENCH_DEST_FILE "bench_copy_dest.tmp"
+#define COPY_MIN_BYTES (64 * 1024)
+
+typedef struct {
+    CopyMethod method;
+    PipelineOptions pipeline;
+} CopyContext;
+
+static void copy_stdio_run(void *ctx) {
+    (void)ctx;
+    copy_file(BENCH_SOURCE_FILE, BENCH_DEST_FILE);
+}
+
+static void copy_kernel_run(void *ctx) {
+    CopyContext *c = (CopyContext*)ctx;
+    copy_file_kernel(BENCH_SOURCE_FILE, BENCH_DEST_FILE, c->method, NULL);
+}
+
+static void copy_pipelined_run(void *ctx) {
+    CopyContext *c = (CopyContext*)ctx;
+    copy_file_pipelined(BENCH_SOURCE_FILE, BENCH_DEST_FILE, &c->pipeline, NULL);
+}
+
+static bool write_source(size_t bytes) {
+    FILE *file = fopen(BENCH_SOURCE_FILE, "wb");
+    if (file == NULL) {
+        perror("Error creating benchmark file");
+        return false;
+    }
+    unsigned char block[4096];
+    uint64_t seed = 0xf11ec0u + bytes;
+    for (size_t written = 0; written < bytes; written += sizeof(block)) {
+        for (size_t i = 0; i < sizeof(block); i += 4) {
+            uint32_t r = bench_random(&seed);
+            memcpy(block + i, &r, 4);
+        }
+        size_t chunk = bytes - written < sizeof(block) ? bytes - written : sizeof(block);
+        if (fwrite(block, 1, chunk, file) != chunk) {
+            fclose(file);
+            return false;
+        }
+    }
+    return fclose(file) == 0;
+}
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    bench_config_default(&config);
+    config.min_bytes = COPY_MIN_BYTES;
+    if (!bench_parse_args(&config, argc, argv)) {
+        return 1;
+    }
+
+    BenchSize sizes[BENCH_MAX_SIZES];
+    int num_sizes = bench_sizes(&config, sizes, BENCH_MAX_SIZES);
+    bench_print_header("copy_file engines (source in page cache)");
+
+    for (int s = 0; s < num_sizes; s++) {
+        size_t bytes = sizes[s].bytes;
+        if (!write_source(bytes)) {
+            break;
+        }
+
+        CopyContext ctx = { COPY_METHOD_AUTO, { 1, PIPELINE_DEFAULT_DEPTH, false } };
+        struct {
+            BenchCase bench;
+            CopyMethod method;
+            int jobs;
+        } cases[] = {
+            { { "copy_file (stdio)",          bytes, bytes, NULL, copy_stdio_run, &ctx }, COPY_METHOD_STDIO, 1 },
+            { { "copy_file_kernel (auto)",    bytes, bytes, NULL, copy_kernel_run, &ctx }, COPY_METHOD_AUTO, 1 },
+            { { "copy_file_kernel (sendfile)", bytes, bytes, NULL, copy_kernel_run, &ctx }, COPY_METHOD_SENDFILE, 1 },
+            { { "copy_file_kernel (mmap)",    bytes, bytes, NULL, copy_kernel_run, &ctx }, COPY_METHOD_MMAP, 1 },
+            { { "copy_file_pipelined (1 job)", bytes, bytes, NULL, copy_pipelined_run, &ctx }, COPY_METHOD_AUTO, 1 },
+            { { "copy_file_pipelined (4 jobs)", bytes, bytes, NULL, copy_pipelined_run, &ctx }, COPY_METHOD_AUTO, 4 },
+        };
+
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+            ctx.method = cases[c].method;
+            ctx.pipeline.jobs = cases[c].jobs;
+            BenchResult result;
+            bench_quiet_begin();
+            bool ran = bench_run(&config, &cases[c].bench, &result);
+            bench_quiet_end();
+            if (ran) {
+                bench_print_result(&cases[c].bench, &result, sizes[s].label);
+            }
+        }
+        printf("\n");
+    }
+
+    remove(BENCH_SOURCE_FILE);
+    remove(BENCH_DEST_FILE);
+    return 0;
+}
@@ -0,0 +1,203 @@
+/**
+ * bench_searching.c - Search kernels from data-structures/beginner/searching.c
+ *
+ * Lookup cases run a fixed batch of random queries (half hits, half
+ * misses) against a sorted table of the given size: ns/elem is per
+ * lookup. Scan cases read the whole table once: ns/elem is per
+ * element scanned and GB/s is scan bandwidth. Build cases insert the
+ * whole table into a fresh hash map: ns/elem is per key inserted.
+ */
+
+#define main searching_example_main
+#include "../data-structures/beginner/searching.c"
+#undef main
+
+#include "bench.h"
+#include "../data-structures/beginner/hash_map.h"
+
+#define QUERY_COUNT 4096
+
+typedef struct {
+    const int *table;
+    int size;
+    const int *queries;
+    int *results;
+    EytzingerIndex eytzinger;
+    StaticIndex stree;
+    IntHashMap map;                 // table[i] -> i, so results match binary_search
+    int (*search_fn)(int arr[], int size, int target);
+    int (*const_search_fn)(const int arr[], int size, int target);
+} SearchContext;
+
+static void lookup_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    int sum = 0;
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        sum += s->search_fn != NULL ? s->search_fn((int*)s->table, s->size, s->queries[i])
+                                    : s->const_search_fn(s->table, s->size, s->queries[i]);
+    }
+    bench_do_not_optimize(&sum);
+}
+
+static void eytzinger_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    int sum = 0;
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        sum += eytzinger_search(&s->eytzinger, s->queries[i]);
+    }
+    bench_do_not_optimize(&sum);
+}
+
+static void stree_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    int sum = 0;
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        sum += static_index_search(&s->stree, s->queries[i]);
+    }
+    bench_do_not_optimize(&sum);
+}
+
+static void hash_get_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    int sum = 0;
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        int index = -1;
+        int_hash_map_get(&s->map, s->queries[i], &index);
+        sum += index;
+    }
+    bench_do_not_optimize(&sum);
+}
+
+static void hash_get_bulk_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    int_hash_map_get_bulk(&s->map, s->queries, QUERY_COUNT, s->results);
+    bench_do_not_optimize(s->results);
+}
+
+// Build from scratch: one put per key (incremental resizes on the way)
+static void hash_put_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    IntHashMap map;
+    int_hash_map_init(&map, 0);
+    for (int i = 0; i < s->size; i++) {
+        int_hash_map_put(&map, s->table[i], i, NULL);
+    }
+    size_t size = int_hash_map_size(&map);
+    bench_do_not_optimize(&size);
+    int_hash_map_free(&map);
+}
+
+// Build from scratch: one reserve, prefetched batches
+static void hash_put_bulk_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    IntHashMap map;
+    int_hash_map_init(&map, 0);
+    int_hash_map_put_bulk(&map, s->table, NULL, (size_t)s->size);
+    size_t size = int_hash_map_size(&map);
+    bench_do_not_optimize(&size);
+    int_hash_map_free(&map);
+}
+
+static void batch_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    binary_search_batch(s->table, s->size, s->queries, QUERY_COUNT, s->results);
+    bench_do_not_optimize(s->results);
+}
+
+// Scan for a key that is not present: touches every element
+static void scan_run(void *ctx) {
+    SearchContext *s = (SearchContext*)ctx;
+    int index = s->search_fn != NULL ? s->search_fn((int*)s->table, s->size, -1)
+                                     : s->const_search_fn(s->table, s->size, -1);
+    bench_do_not_optimize(&index);
+}
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    bench_config_default(&config);
+    if (!bench_parse_args(&config, argc, argv)) {
+        return 1;
+    }
+
+    BenchSize sizes[BENCH_MAX_SIZES];
+    int num_sizes = bench_sizes(&config, sizes, BENCH_MAX_SIZES);
+    bench_print_header("searching (sorted table, 4096 random queries per run)");
+
+    int *queries = malloc(QUERY_COUNT * sizeof(int));
+    int *results = malloc(QUERY_COUNT * sizeof(int));
+    if (queries == NULL || results == NULL) {
+        return 1;
+    }
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = (int)(sizes[s].bytes / sizeof(int));
+        int *table = malloc((size_t)n * sizeof(int));
+        if (table == NULL) {
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            table[i] = 2 * i;       // Even keys: odd queries miss
+        }
+        uint64_t seed = 0x5ea4c400u + (uint64_t)n;
+        for (int i = 0; i < QUERY_COUNT; i++) {
+            queries[i] = (int)(bench_random(&seed) % (2u * (unsigned)n));
+        }
+
+        SearchContext ctx;
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.table = table;
+        ctx.size = n;
+        ctx.queries = queries;
+        ctx.results = results;
+        bool have_eytzinger = eytzinger_init(&ctx.eytzinger, table, n);
+        bool have_stree = static_index_init(&ctx.stree, table, n);
+        bool have_map = int_hash_map_init(&ctx.map, 0) &&
+                        int_hash_map_put_bulk(&ctx.map, table, NULL, (size_t)n);
+
+        size_t scan_bytes = (size_t)n * sizeof(int);
+        struct {
+            BenchCase bench;
+            int (*search_fn)(int[], int, int);
+            int (*const_search_fn)(const int[], int, int);
+            bool available;
+        } cases[] = {
+            { { "binary_search",          QUERY_COUNT, 0, NULL, lookup_run, &ctx }, binary_search, NULL, true },
+            { { "binary_search_branchless", QUERY_COUNT, 0, NULL, lookup_run, &ctx }, NULL, binary_search_branchless, true },
+            { { "eytzinger_search",       QUERY_COUNT, 0, NULL, eytzinger_run, &ctx }, NULL, NULL, have_eytzinger },
+            { { "static_index_search",    QUERY_COUNT, 0, NULL, stree_run, &ctx }, NULL, NULL, have_stree },
+            { { "binary_search_batch",    QUERY_COUNT, 0, NULL, batch_run, &ctx }, NULL, NULL, true },
+            { { "int_hash_map_get",       QUERY_COUNT, 0, NULL, hash_get_run, &ctx }, NULL, NULL, have_map },
+            { { "int_hash_map_get_bulk",  QUERY_COUNT, 0, NULL, hash_get_bulk_run, &ctx }, NULL, NULL, have_map },
+            { { "hash_map_put (build)",   (size_t)n, 0, NULL, hash_put_run, &ctx }, NULL, NULL, true },
+            { { "hash_map_put_bulk (build)", (size_t)n, 0, NULL, hash_put_bulk_run, &ctx }, NULL, NULL, true },
+            { { "linear_search (scan)",   (size_t)n, scan_bytes, NULL, scan_run, &ctx }, linear_search, NULL, true },
+            { { "linear_search_simd (scan)", (size_t)n, scan_bytes, NULL, scan_run, &ctx }, NULL, linear_search_simd, true },
+        };
+
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+            if (!cases[c].available) {
+                continue;
+            }
+            ctx.search_fn = cases[c].search_fn;
+            ctx.const_search_fn = cases[c].const_search_fn;
+            BenchResult result;
+            if (bench_run(&config, &cases[c].bench, &result)) {
+                bench_print_result(&cases[c].bench, &result, sizes[s].label);
+            }
+        }
+        printf("\n");
+
+        if (have_eytzinger) {
+            eytzinger_free(&ctx.eytzinger);
+        }
+        if (have_stree) {
+            static_index_free(&ctx.stree);
+        }
+        int_hash_map_free(&ctx.map);
+        free(table);
+    }
+
+    free(queries);
+    free(results);
+    return 0;
+}
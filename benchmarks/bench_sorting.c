@@ -0,0 +1,112 @@
+/**
+ * bench_sorting.c - Sorting engines from data-structures/beginner/sorting.c
+ *
+ * Every run sorts a fresh copy of the same random input (the copy is
+ * made in setup, outside the timer). qsort() is the baseline.
+ */
+
+#define main sorting_example_main
+#include "../data-structures/beginner/sorting.c"
+#undef main
+
+#include "bench.h"
+
+#define INSERTION_SORT_MAX_BYTES (64 * 1024)    // O(n^2): keep it small
+
+typedef struct {
+    const int *input;
+    int *work;
+    int size;
+    void (*sort_fn)(int arr[], int size);
+    int threads;
+} SortContext;
+
+static void sort_setup(void *ctx) {
+    SortContext *s = (SortContext*)ctx;
+    memcpy(s->work, s->input, (size_t)s->size * sizeof(int));
+}
+
+static void sort_run(void *ctx) {
+    SortContext *s = (SortContext*)ctx;
+    s->sort_fn(s->work, s->size);
+    bench_do_not_optimize(s->work);
+}
+
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static void qsort_run(void *ctx) {
+    SortContext *s = (SortContext*)ctx;
+    qsort(s->work, (size_t)s->size, sizeof(int), compare_ints);
+    bench_do_not_optimize(s->work);
+}
+
+static void insertion_run(void *ctx) {
+    SortContext *s = (SortContext*)ctx;
+    insertion_sort_range(s->work, 0, s->size - 1);
+    bench_do_not_optimize(s->work);
+}
+
+static void parallel_run(void *ctx) {
+    SortContext *s = (SortContext*)ctx;
+    parallel_sort(s->work, s->size, s->threads);
+    bench_do_not_optimize(s->work);
+}
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    bench_config_default(&config);
+    if (!bench_parse_args(&config, argc, argv)) {
+        return 1;
+    }
+
+    BenchSize sizes[BENCH_MAX_SIZES];
+    int num_sizes = bench_sizes(&config, sizes, BENCH_MAX_SIZES);
+    bench_print_header("sorting (random 32-bit ints)");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = (int)(sizes[s].bytes / sizeof(int));
+        int *input = malloc((size_t)n * sizeof(int));
+        int *work = malloc((size_t)n * sizeof(int));
+        if (input == NULL || work == NULL) {
+            free(input);
+            free(work);
+            break;
+        }
+        uint64_t seed = 0x5eed0000u + (uint64_t)n;
+        for (int i = 0; i < n; i++) {
+            input[i] = (int)bench_random(&seed);
+        }
+
+        SortContext ctx = { input, work, n, NULL, 0 };
+        size_t bytes = (size_t)n * sizeof(int);
+        BenchCase cases[] = {
+            { "qsort (baseline)", (size_t)n, bytes, sort_setup, qsort_run, &ctx },
+            { "sort",             (size_t)n, bytes, sort_setup, sort_run, &ctx },
+            { "introsort",        (size_t)n, bytes, sort_setup, sort_run, &ctx },
+            { "radix_sort",       (size_t)n, bytes, sort_setup, sort_run, &ctx },
+            { "heap_sort",        (size_t)n, bytes, sort_setup, sort_run, &ctx },
+            { "parallel_sort",    (size_t)n, bytes, sort_setup, parallel_run, &ctx },
+            { "insertion_sort",   (size_t)n, bytes, sort_setup, insertion_run, &ctx },
+        };
+        void (*engines[])(int[], int) = { NULL, sort, introsort, radix_sort, heap_sort, NULL, NULL };
+
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+            if (cases[c].run == insertion_run && bytes > INSERTION_SORT_MAX_BYTES) {
+                continue;
+            }
+            ctx.sort_fn = engines[c];
+            BenchResult result;
+            if (bench_run(&config, &cases[c], &result)) {
+                bench_print_result(&cases[c], &result, sizes[s].label);
+            }
+        }
+        printf("\n");
+        free(input);
+        free(work);
+    }
+    return 0;
+}
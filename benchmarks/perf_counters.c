@@ -0,0 +1,221 @@
+/**
+ * perf_counters.c - Hardware Performance Counters (Linux perf_event_open)
+ *
+ * See perf_counters.h. On Linux each counter is a file descriptor from
+ * perf_event_open(2), controlled with ioctl() and read with read().
+ */
+
+#include "perf_counters.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#define HAVE_PERF_EVENT 1
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+static const char *const counter_names[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "L1d-miss", "LLC-miss", "branch-miss", "dTLB-miss"
+};
+
+const char* perf_counter_name(PerfCounterId id) {
+    return (id >= 0 && id < PERF_COUNTER_COUNT) ? counter_names[id] : "?";
+}
+
+#ifdef HAVE_PERF_EVENT
+
+#define HW_CACHE_CONFIG(cache, op, result) \
+    ((uint64_t)(cache) | ((uint64_t)(op) << 8) | ((uint64_t)(result) << 16))
+
+typedef struct {
+    uint32_t type;
+    uint64_t config;
+} PerfEventSpec;
+
+static const PerfEventSpec event_specs[PERF_COUNTER_COUNT] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, HW_CACHE_CONFIG(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                          PERF_COUNT_HW_CACHE_RESULT_MISS) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },     // Last-level cache
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_HW_CACHE, HW_CACHE_CONFIG(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                          PERF_COUNT_HW_CACHE_RESULT_MISS) },
+};
+
+/**
+ * Read layout for PERF_FORMAT_TOTAL_TIME_ENABLED | _RUNNING
+ */
+typedef struct {
+    uint64_t value;
+    uint64_t time_enabled;
+    uint64_t time_running;
+} PerfReadFormat;
+
+static int open_event(const PerfEventSpec *spec) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec->type;
+    attr.config = spec->config;
+    attr.disabled = 1;
+    attr.inherit = 1;           // Include threads created while counting
+    attr.exclude_kernel = 1;    // User mode only: allowed at paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // pid 0 = this process, cpu -1 = any CPU
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+bool perf_counters_open(PerfCounters *pc) {
+    pc->open_error = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        pc->fds[i] = open_event(&event_specs[i]);
+        if (pc->fds[i] < 0 && pc->open_error == 0) {
+            pc->open_error = errno;
+        }
+    }
+    return perf_counters_available(pc);
+}
+
+void perf_counters_close(PerfCounters *pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->fds[i] >= 0) {
+            close(pc->fds[i]);
+        }
+        pc->fds[i] = -1;
+    }
+}
+
+static void control_all(PerfCounters *pc, unsigned long request) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->fds[i] >= 0) {
+            ioctl(pc->fds[i], request, 0);
+        }
+    }
+}
+
+void perf_counters_reset(PerfCounters *pc) {
+    control_all(pc, PERF_EVENT_IOC_RESET);
+}
+
+void perf_counters_enable(PerfCounters *pc) {
+    control_all(pc, PERF_EVENT_IOC_ENABLE);
+}
+
+void perf_counters_disable(PerfCounters *pc) {
+    control_all(pc, PERF_EVENT_IOC_DISABLE);
+}
+
+void perf_counters_read(const PerfCounters *pc, PerfSample *sample) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        PerfReadFormat data;
+        sample->valid[i] = false;
+        sample->value[i] = 0.0;
+        if (pc->fds[i] < 0 || read(pc->fds[i], &data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            continue;
+        }
+        if (data.time_running == 0) {
+            continue;   // Never scheduled on the PMU (too many counters)
+        }
+        // More events than hardware counters: the kernel time-slices
+        // them, so extrapolate from the fraction of time it ran
+        double scale = (double)data.time_enabled / (double)data.time_running;
+        sample->value[i] = (double)data.value * scale;
+        sample->valid[i] = true;
+    }
+}
+
+#else /* !HAVE_PERF_EVENT */
+
+bool perf_counters_open(PerfCounters *pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        pc->fds[i] = -1;
+    }
+    pc->open_error = 0;
+    return false;
+}
+
+void perf_counters_close(PerfCounters *pc) {
+    (void)pc;
+}
+
+void perf_counters_reset(PerfCounters *pc) {
+    (void)pc;
+}
+
+void perf_counters_enable(PerfCounters *pc) {
+    (void)pc;
+}
+
+void perf_counters_disable(PerfCounters *pc) {
+    (void)pc;
+}
+
+void perf_counters_read(const PerfCounters *pc, PerfSample *sample) {
+    (void)pc;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        sample->value[i] = 0.0;
+        sample->valid[i] = false;
+    }
+}
+
+#endif
+
+bool perf_counters_available(const PerfCounters *pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->fds[i] >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void perf_counters_start(PerfCounters *pc) {
+    perf_counters_reset(pc);
+    perf_counters_enable(pc);
+}
+
+void perf_counters_stop(PerfCounters *pc, PerfSample *sample) {
+    perf_counters_disable(pc);
+    perf_counters_read(pc, sample);
+}
+
+void perf_sample_print(const PerfSample *sample, double elements, const char *label) {
+    printf("    [perf] %-10s", label != NULL ? label : "");
+    if (sample->valid[PERF_CYCLES] && sample->valid[PERF_INSTRUCTIONS] && sample->value[PERF_CYCLES] > 0) {
+        printf(" IPC %.2f |", sample->value[PERF_INSTRUCTIONS] / sample->value[PERF_CYCLES]);
+    } else {
+        printf(" IPC unsupported |");
+    }
+    printf(" per element:");
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (sample->valid[i] && elements > 0) {
+            printf(" %s %.3f", counter_names[i], sample->value[i] / elements);
+        } else {
+            printf(" %s unsupported", counter_names[i]);
+        }
+        printf(i + 1 < PERF_COUNTER_COUNT ? "," : "\n");
+    }
+}
+
+void perf_counters_print_unavailable(const PerfCounters *pc) {
+#ifdef HAVE_PERF_EVENT
+    printf("    [perf] hardware counters unsupported: %s\n",
+           pc->open_error != 0 ? strerror(pc->open_error) : "no counters");
+    if (pc->open_error == EACCES || pc->open_error == EPERM) {
+        printf("    [perf] try: sudo sysctl kernel.perf_event_paranoid=2\n");
+    } else if (pc->open_error == ENOENT || pc->open_error == ENODEV || pc->open_error == EOPNOTSUPP) {
+        printf("    [perf] no hardware PMU exposed (common inside VMs and containers)\n");
+    }
+#else
+    (void)pc;
+    printf("    [perf] hardware counters unsupported on this platform\n");
+#endif
+}
@@ -0,0 +1,94 @@
+/**
+ * ============================================================================
+ * perf_counters.h - Hardware Performance Counters (Linux perf_event_open)
+ * ============================================================================
+ *
+ * PURPOSE:
+ * Wall-clock time says HOW slow a kernel is; counters say WHY:
+ * - IPC (instructions / cycles):  < 1 usually means stalled on memory
+ * - L1d / LLC misses per element:  working set vs. cache size
+ * - Branch misses per element:     unpredictable control flow
+ * - dTLB misses per element:       page-granular random access
+ *
+ * Counters measure this process (and threads it creates) in user mode
+ * only, so they work at kernel.perf_event_paranoid <= 2. Every counter
+ * is opened separately: a counter the CPU or VM lacks is reported as
+ * "unsupported" without disabling the rest. Off Linux every counter is
+ * unsupported.
+ *
+ * USAGE:
+ *   PerfCounters pc;
+ *   perf_counters_open(&pc);
+ *   perf_counters_start(&pc);
+ *   work();
+ *   PerfSample sample;
+ *   perf_counters_stop(&pc, &sample);
+ *   perf_sample_print(&sample, elements, "work");
+ *   perf_counters_close(&pc);
+ *
+ * ============================================================================
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_COUNTER_COUNT
+} PerfCounterId;
+
+typedef struct {
+    int fds[PERF_COUNTER_COUNT];        // -1 = unsupported
+    int open_error;                     // errno of the first failure (0 = none)
+} PerfCounters;
+
+typedef struct {
+    double value[PERF_COUNTER_COUNT];   // Scaled for multiplexing
+    bool valid[PERF_COUNTER_COUNT];
+} PerfSample;
+
+/**
+ * Open every counter that this machine allows.
+ * Returns: true if at least one counter is available
+ */
+bool perf_counters_open(PerfCounters *pc);
+void perf_counters_close(PerfCounters *pc);
+bool perf_counters_available(const PerfCounters *pc);
+
+/**
+ * Fine-grained control: reset to zero, then enable/disable around
+ * the regions to count (accumulates across enable/disable pairs)
+ */
+void perf_counters_reset(PerfCounters *pc);
+void perf_counters_enable(PerfCounters *pc);
+void perf_counters_disable(PerfCounters *pc);
+void perf_counters_read(const PerfCounters *pc, PerfSample *sample);
+
+/**
+ * Convenience: reset + enable / disable + read
+ */
+void perf_counters_start(PerfCounters *pc);
+void perf_counters_stop(PerfCounters *pc, PerfSample *sample);
+
+const char* perf_counter_name(PerfCounterId id);
+
+/**
+ * Print IPC and per-element counts on one line (indent included),
+ * "unsupported" for counters that are not valid
+ */
+void perf_sample_print(const PerfSample *sample, double elements, const char *label);
+
+/**
+ * Explain why counters are missing (e.g. perf_event_paranoid)
+ */
+void perf_counters_print_unavailable(const PerfCounters *pc);
+
+#endif /* PERF_COUNTERS_H */
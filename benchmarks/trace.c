@@ -0,0 +1,400 @@
+/**
+ * trace.c - Hot-Path Tracing Runtime (ring registry and dump formats)
+ *
+ * See trace.h. Only compiled into a target when ENABLE_TRACING is on
+ * (CMake adds it through TRACE_SOURCES).
+ *
+ * Concurrency:
+ * - Each ring has one writer (its thread). Rings are pushed onto a global
+ *   list with compare-and-swap and never freed, so events of threads that
+ *   have exited are still dumped.
+ * - A pthread key destructor marks an exiting thread's ring free; the
+ *   next thread claims it with compare-and-swap on in_use.
+ * - A dump copies a ring's last TRACE_RING_EVENTS events and then
+ *   re-reads the head: any slot the writer may have reused during the copy
+ *   is dropped, so the output never contains a torn event from a live
+ *   thread.
+ */
+
+#include "trace.h"
+
+#if ENABLE_TRACING
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_PTHREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define TRACE_BINARY_MAGIC "TRC1"
+#define TRACE_BINARY_VERSION 1u
+#define TRACE_CALIBRATE_NS 10000000ull  // Stretch short runs to 10ms of clock
+
+_Thread_local TraceRing *trace_thread_ring = NULL;
+atomic_bool trace_enabled = true;
+
+static _Atomic(TraceRing*) ring_list = NULL;
+static atomic_uint next_thread_id = 1;
+static atomic_flag exit_hook_registered = ATOMIC_FLAG_INIT;
+
+#ifdef HAVE_PTHREADS
+static pthread_key_t ring_owner_key;    // Value: the thread's ring (destructor retires it)
+static pthread_once_t ring_owner_once = PTHREAD_ONCE_INIT;
+
+static void retire_ring(void *ring) {
+    atomic_store_explicit(&((TraceRing*)ring)->in_use, false, memory_order_release);
+}
+
+static void create_ring_owner_key(void) {
+    pthread_key_create(&ring_owner_key, retire_ring);
+}
+#endif
+
+/**
+ * Clock pair taken when the first ring was created: the start of both
+ * the timeline and the tick calibration
+ */
+static _Atomic uint64_t origin_ticks = 0;
+static _Atomic uint64_t origin_ns = 0;
+
+uint64_t trace_clock_ns(void) {
+    struct timespec now;
+#if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#else
+    timespec_get(&now, TIME_UTC);
+#endif
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+static void write_trace_at_exit(void) {
+    const char *path = getenv("TRACE_OUTPUT");
+    if (path == NULL || path[0] == '\0') {
+        path = "trace.json";
+    }
+    size_t length = strlen(path);
+    bool binary = length >= 4 && strcmp(path + length - 4, ".bin") == 0;
+    bool written = binary ? trace_write_binary(path) : trace_write_chrome_json(path);
+    if (!written) {
+        fprintf(stderr, "trace: cannot write %s\n", path);
+    }
+}
+
+/**
+ * A ring whose thread has exited; its events stay until overwritten
+ */
+static TraceRing* claim_retired_ring(void) {
+    for (TraceRing *ring = atomic_load(&ring_list); ring != NULL; ring = ring->next) {
+        bool expected = false;
+        if (!atomic_load_explicit(&ring->in_use, memory_order_relaxed)) {
+            if (atomic_compare_exchange_strong(&ring->in_use, &expected, true)) {
+                return ring;
+            }
+        }
+    }
+    return NULL;
+}
+
+TraceRing* trace_ring_create(void) {
+    TraceRing *ring = claim_retired_ring();
+    if (ring == NULL) {
+        ring = malloc(sizeof(TraceRing));
+        if (ring == NULL) {
+            return NULL;
+        }
+        atomic_init(&ring->head, 0);
+        atomic_init(&ring->in_use, true);
+        ring->thread_id = atomic_fetch_add(&next_thread_id, 1);
+
+        if (!atomic_flag_test_and_set(&exit_hook_registered)) {
+            atomic_store(&origin_ns, trace_clock_ns());
+            atomic_store(&origin_ticks, trace_now());
+            atexit(write_trace_at_exit);
+        }
+
+        TraceRing *head = atomic_load(&ring_list);
+        do {
+            ring->next = head;
+        } while (!atomic_compare_exchange_weak(&ring_list, &head, ring));
+    }
+
+#ifdef HAVE_PTHREADS
+    pthread_once(&ring_owner_once, create_ring_owner_key);
+    pthread_setspecific(ring_owner_key, ring);
+#endif
+    trace_thread_ring = ring;
+    return ring;
+}
+
+// ========================================
+// SNAPSHOT
+// ========================================
+
+typedef struct {
+    TraceEvent event;
+    uint32_t thread_id;
+} TracedEvent;
+
+typedef struct {
+    TracedEvent *events;
+    size_t count;
+    uint64_t origin;                    // Tick value of timestamp 0
+    double ticks_per_us;
+} TraceSnapshot;
+
+/**
+ * Ticks per microsecond, measured against the monotonic clock since the
+ * first ring was created
+ */
+static double calibrate_ticks_per_us(void) {
+#if defined(TRACE_CLOCK_TSC) || defined(TRACE_CLOCK_CNTVCT)
+    uint64_t start_ns = atomic_load(&origin_ns);
+    uint64_t start_ticks = atomic_load(&origin_ticks);
+    uint64_t now_ns = trace_clock_ns();
+    while (now_ns - start_ns < TRACE_CALIBRATE_NS) {
+        now_ns = trace_clock_ns();
+    }
+    uint64_t now_ticks = trace_now();
+    return (double)(now_ticks - start_ticks) * 1000.0 / (double)(now_ns - start_ns);
+#else
+    return 1000.0;                      // Ticks are already nanoseconds
+#endif
+}
+
+static bool take_snapshot(TraceSnapshot *snapshot) {
+    size_t capacity = 0;
+    for (TraceRing *ring = atomic_load(&ring_list); ring != NULL; ring = ring->next) {
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        capacity += head < TRACE_RING_EVENTS ? (size_t)head : TRACE_RING_EVENTS;
+    }
+
+    snapshot->events = malloc((capacity > 0 ? capacity : 1) * sizeof(TracedEvent));
+    snapshot->count = 0;
+    snapshot->origin = atomic_load(&origin_ticks);
+    snapshot->ticks_per_us = calibrate_ticks_per_us();
+    if (snapshot->events == NULL) {
+        return false;
+    }
+
+    for (TraceRing *ring = atomic_load(&ring_list); ring != NULL; ring = ring->next) {
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t first = head > TRACE_RING_EVENTS ? head - TRACE_RING_EVENTS : 0;
+        TracedEvent *out = snapshot->events + snapshot->count;
+        size_t copied = 0;
+        // The ring may have grown since capacity was counted: copy at
+        // most the events counted for it then
+        for (uint64_t i = first; i < head && snapshot->count + copied < capacity; i++) {
+            out[copied].event = ring->events[i & (TRACE_RING_EVENTS - 1)];
+            out[copied].thread_id = ring->thread_id;
+            copied++;
+        }
+
+        // Drop slots the writer reused while they were being copied. The
+        // fence keeps the copies above from moving past the re-read; the
+        // writer may be mid-way through event head_after, whose slot is
+        // that of event head_after - TRACE_RING_EVENTS, so that one goes too.
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t head_after = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        uint64_t valid_from = head_after + 1 > TRACE_RING_EVENTS ? head_after + 1 - TRACE_RING_EVENTS : 0;
+        size_t skip = valid_from > first ? (size_t)(valid_from - first) : 0;
+        if (skip >= copied) {
+            continue;
+        }
+        if (skip > 0) {
+            memmove(out, out + skip, (copied - skip) * sizeof(TracedEvent));
+        }
+        snapshot->count += copied - skip;
+    }
+    return true;
+}
+
+static double ticks_to_us(const TraceSnapshot *snapshot, uint64_t ticks) {
+    return (double)ticks / snapshot->ticks_per_us;
+}
+
+static double timestamp_us(const TraceSnapshot *snapshot, uint64_t ticks) {
+    // Events recorded before the origin (another thread raced the first
+    // ring's creation) are pinned to 0
+    return ticks > snapshot->origin ? ticks_to_us(snapshot, ticks - snapshot->origin) : 0.0;
+}
+
+// ========================================
+// CHROME TRACE JSON
+// ========================================
+
+static void write_json_string(FILE *file, const char *text) {
+    fputc('"', file);
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+        }
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+bool trace_write_chrome_json(const char *path) {
+    TraceSnapshot snapshot;
+    if (!take_snapshot(&snapshot)) {
+        return false;
+    }
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        free(snapshot.events);
+        return false;
+    }
+
+#ifdef HAVE_PTHREADS
+    long pid = (long)getpid();
+#else
+    long pid = 1;
+#endif
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < snapshot.count; i++) {
+        const TraceEvent *event = &snapshot.events[i].event;
+        fprintf(file, "%s{\"name\":", i > 0 ? ",\n" : "");
+        write_json_string(file, event->name);
+        fprintf(file, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%ld,\"tid\":%u",
+                (char)event->phase, timestamp_us(&snapshot, event->start),
+                pid, snapshot.events[i].thread_id);
+        if (event->phase == TRACE_PHASE_COMPLETE) {
+            fprintf(file, ",\"dur\":%.3f", ticks_to_us(&snapshot, event->value));
+        } else if (event->phase == TRACE_PHASE_COUNTER) {
+            fprintf(file, ",\"args\":{\"value\":%llu}", (unsigned long long)event->value);
+        } else {
+            fprintf(file, ",\"s\":\"t\"");
+        }
+        fputc('}', file);
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    free(snapshot.events);
+    return fclose(file) == 0;
+}
+
+// ========================================
+// COMPACT BINARY
+// ========================================
+
+/**
+ * Name pointer -> index, open addressing (names are literals, so pointer
+ * identity is enough; a name used from two files may appear twice)
+ */
+typedef struct {
+    const char **names;
+    uint32_t *indices;
+    size_t capacity;                    // Power of two
+    uint32_t count;
+    const char **ordered;               // Index -> name
+} NameTable;
+
+static size_t name_slot(const NameTable *table, const char *name) {
+    size_t slot = ((uintptr_t)name >> 3) * 0x9E3779B97F4A7C15ull & (table->capacity - 1);
+    while (table->names[slot] != NULL && table->names[slot] != name) {
+        slot = (slot + 1) & (table->capacity - 1);
+    }
+    return slot;
+}
+
+static bool name_table_init(NameTable *table, size_t events) {
+    table->capacity = 64;
+    while (table->capacity < events * 2) {
+        table->capacity *= 2;
+    }
+    table->names = calloc(table->capacity, sizeof(*table->names));
+    table->indices = malloc(table->capacity * sizeof(*table->indices));
+    table->ordered = malloc(table->capacity * sizeof(*table->ordered));
+    table->count = 0;
+    return table->names != NULL && table->indices != NULL && table->ordered != NULL;
+}
+
+static void name_table_free(NameTable *table) {
+    free(table->names);
+    free(table->indices);
+    free(table->ordered);
+}
+
+static uint32_t name_index(NameTable *table, const char *name) {
+    size_t slot = name_slot(table, name);
+    if (table->names[slot] == NULL) {
+        table->names[slot] = name;
+        table->indices[slot] = table->count;
+        table->ordered[table->count++] = name;
+    }
+    return table->indices[slot];
+}
+
+typedef struct {
+    uint64_t start;
+    uint64_t value;
+    uint32_t name;
+    uint16_t thread;
+    uint8_t phase;
+    uint8_t reserved;
+} TraceRecord;                          // 24 bytes on disk
+
+bool trace_write_binary(const char *path) {
+    TraceSnapshot snapshot;
+    if (!take_snapshot(&snapshot)) {
+        return false;
+    }
+    NameTable names;
+    FILE *file = NULL;
+    bool ok = name_table_init(&names, snapshot.count) && (file = fopen(path, "wb")) != NULL;
+
+    if (ok) {
+        for (size_t i = 0; i < snapshot.count; i++) {
+            name_index(&names, snapshot.events[i].event.name);
+        }
+        uint32_t version = TRACE_BINARY_VERSION;
+        uint32_t name_count = names.count;
+        uint32_t reserved = 0;
+        uint64_t event_count = snapshot.count;
+        ok = fwrite(TRACE_BINARY_MAGIC, 1, 4, file) == 4
+          && fwrite(&version, sizeof(version), 1, file) == 1
+          && fwrite(&snapshot.ticks_per_us, sizeof(double), 1, file) == 1
+          && fwrite(&name_count, sizeof(name_count), 1, file) == 1
+          && fwrite(&reserved, sizeof(reserved), 1, file) == 1
+          && fwrite(&event_count, sizeof(event_count), 1, file) == 1;
+
+        for (uint32_t i = 0; ok && i < names.count; i++) {
+            size_t length = strlen(names.ordered[i]);
+            uint16_t stored = (uint16_t)(length > UINT16_MAX ? UINT16_MAX : length);
+            ok = fwrite(&stored, sizeof(stored), 1, file) == 1
+              && fwrite(names.ordered[i], 1, stored, file) == stored;
+        }
+
+        for (size_t i = 0; ok && i < snapshot.count; i++) {
+            const TracedEvent *traced = &snapshot.events[i];
+            TraceRecord record = {
+                .start = traced->event.start > snapshot.origin ? traced->event.start - snapshot.origin : 0,
+                .value = traced->event.value,
+                .name = name_index(&names, traced->event.name),
+                .thread = (uint16_t)traced->thread_id,
+                .phase = (uint8_t)traced->event.phase,
+                .reserved = 0,
+            };
+            ok = fwrite(&record.start, sizeof(record.start), 1, file) == 1
+              && fwrite(&record.value, sizeof(record.value), 1, file) == 1
+              && fwrite(&record.name, sizeof(record.name), 1, file) == 1
+              && fwrite(&record.thread, sizeof(record.thread), 1, file) == 1
+              && fwrite(&record.phase, 1, 1, file) == 1
+              && fwrite(&record.reserved, 1, 1, file) == 1;
+        }
+    }
+
+    if (file != NULL && fclose(file) != 0) {
+        ok = false;
+    }
+    name_table_free(&names);
+    free(snapshot.events);
+    return ok;
+}
+
+#endif // ENABLE_TRACING
@@ -0,0 +1,234 @@
+/**
+ * ============================================================================
+ * trace.h - Compile-Time-Switchable Hot-Path Tracing
+ * ============================================================================
+ *
+ * PURPOSE:
+ * The production version of preprocessor.c's "#if ENABLE_PROFILING":
+ * mark a region with one macro, get a timeline you can open in
+ * chrome://tracing or https://ui.perfetto.dev, and pay NOTHING when the
+ * build has tracing off.
+ *
+ *   void copy_file(...) {
+ *       TRACE_SCOPE("copy_file");        // Duration of the enclosing block
+ *       ...
+ *       TRACE_COUNTER("bytes_copied", total);
+ *   }
+ *
+ * SWITCHES:
+ * - Compile time: ENABLE_TRACING=1 (cmake -DENABLE_TRACING=ON). Otherwise
+ *   every TRACE_* macro expands to ((void)0): no code, no data, no call.
+ * - Run time: trace_set_enabled(false) stops recording (one relaxed load
+ *   per event remains).
+ *
+ * RECORDING (ENABLE_TRACING=1):
+ * - Timestamps: rdtsc (x86) / cntvct_el0 (AArch64), ~20 cycles, no
+ *   syscall; CLOCK_MONOTONIC elsewhere. Converted to microseconds at dump
+ *   time against the monotonic clock.
+ * - Each thread writes to its own ring of TRACE_RING_EVENTS events
+ *   (allocated on first use): no locks, no atomics beyond one release
+ *   store of the ring head. A full ring overwrites its oldest events
+ *   (flight recorder: the dump holds the most recent window).
+ * - A thread that exits leaves its ring (and events) to the next new
+ *   thread, which records under the same tid: memory is bounded by the
+ *   peak number of live traced threads, not by threads ever started.
+ * - Names must be string literals (only the pointer is stored).
+ *
+ * COST MODEL (x86-64, per TRACE_SCOPE):
+ * Component              | Cost
+ * -----------------------|---------------------------------------------
+ * Two timestamps         | ~40 cycles
+ * Event write            | ~5 cycles (32 bytes into an L1-hot ring)
+ * Total                  | ~15-25 ns
+ * To stay under 1% overhead, trace calls that take >= 2-3 us (a sort, a
+ * file copy, a resize), not per-element helpers.
+ *
+ * OUTPUT:
+ * - At exit, to $TRACE_OUTPUT (default "trace.json"); a name ending in
+ *   ".bin" selects the binary format
+ * - trace_write_chrome_json() / trace_write_binary() on demand
+ *
+ * BINARY FORMAT (host byte order):
+ *   "TRC1" | u32 version | f64 ticks_per_us | u32 names | u32 reserved
+ *   | u64 events | names x { u16 length, bytes }
+ *   | events x { u64 start_ticks, u64 value, u32 name, u16 thread,
+ *                u8 phase ('X' / 'i' / 'C'), u8 0 }
+ * start_ticks is relative to the first traced event; value is the
+ * duration in ticks ('X') or the counter value ('C').
+ *
+ * ============================================================================
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef ENABLE_TRACING
+#define ENABLE_TRACING 0
+#endif
+
+#if ENABLE_TRACING
+
+#include <stdatomic.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define TRACE_CLOCK_TSC 1
+#elif defined(__aarch64__)
+#define TRACE_CLOCK_CNTVCT 1
+#endif
+
+#ifndef TRACE_RING_EVENTS
+#define TRACE_RING_EVENTS (1u << 16)    // Per thread: 64K events = 2MB
+#endif
+
+#define TRACE_PHASE_COMPLETE 'X'
+#define TRACE_PHASE_INSTANT 'i'
+#define TRACE_PHASE_COUNTER 'C'
+
+typedef struct {
+    uint64_t start;                     // trace_now() ticks
+    uint64_t value;                     // Duration in ticks, or counter value
+    const char *name;                   // String literal
+    uint32_t phase;                     // TRACE_PHASE_*
+    uint32_t reserved;
+} TraceEvent;
+
+typedef struct TraceRing {
+    _Alignas(64) atomic_uint_fast64_t head;   // Events ever written (owner stores)
+    struct TraceRing *next;             // Registry of every thread's ring
+    atomic_bool in_use;                 // false: owner exited, ring reusable
+    uint32_t thread_id;                 // 1, 2, ... in order of first event
+    TraceEvent events[TRACE_RING_EVENTS];
+} TraceRing;
+
+typedef struct {
+    const char *name;                   // NULL: recording was off at the start
+    uint64_t start;
+} TraceScope;
+
+extern _Thread_local TraceRing *trace_thread_ring;
+extern atomic_bool trace_enabled;
+
+/**
+ * Slow path: claim a ring retired by an exited thread, or allocate and
+ * register a new one
+ * Returns: NULL when out of memory (events are dropped)
+ */
+TraceRing* trace_ring_create(void);
+
+/**
+ * Monotonic clock in nanoseconds (the fallback timestamp source)
+ */
+uint64_t trace_clock_ns(void);
+
+static inline uint64_t trace_now(void) {
+#if defined(TRACE_CLOCK_TSC)
+    return __rdtsc();
+#elif defined(TRACE_CLOCK_CNTVCT)
+    uint64_t ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return trace_clock_ns();
+#endif
+}
+
+static inline bool trace_is_enabled(void) {
+    return atomic_load_explicit(&trace_enabled, memory_order_relaxed);
+}
+
+static inline void trace_set_enabled(bool enabled) {
+    atomic_store_explicit(&trace_enabled, enabled, memory_order_relaxed);
+}
+
+/**
+ * Append one event to this thread's ring. The release store publishes
+ * the event to a concurrent dump.
+ */
+static inline void trace_record(const char *name, uint32_t phase, uint64_t start, uint64_t value) {
+    TraceRing *ring = trace_thread_ring;
+    if (ring == NULL && (ring = trace_ring_create()) == NULL) {
+        return;
+    }
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    TraceEvent *event = &ring->events[head & (TRACE_RING_EVENTS - 1)];
+    event->start = start;
+    event->value = value;
+    event->name = name;
+    event->phase = phase;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+static inline TraceScope trace_scope_begin(const char *name) {
+    TraceScope scope = { NULL, 0 };
+    if (trace_is_enabled()) {
+        scope.name = name;
+        scope.start = trace_now();      // No timestamp while recording is off
+    }
+    return scope;
+}
+
+static inline void trace_scope_end(TraceScope *scope) {
+    if (scope->name != NULL) {
+        trace_record(scope->name, TRACE_PHASE_COMPLETE, scope->start, trace_now() - scope->start);
+    }
+}
+
+/**
+ * Write everything recorded so far
+ * Returns: false if the file cannot be written
+ */
+bool trace_write_chrome_json(const char *path);
+bool trace_write_binary(const char *path);
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+/**
+ * TRACE_SCOPE: time from here to the end of the enclosing block.
+ * Needs GCC/Clang (cleanup attribute); elsewhere use TRACE_BEGIN/END.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define TRACE_SCOPE(name)                                               \
+    TraceScope TRACE_CONCAT(trace_scope_, __LINE__)                     \
+        __attribute__((cleanup(trace_scope_end))) = trace_scope_begin(name)
+#else
+#define TRACE_SCOPE(name) TRACE_INSTANT(name)
+#endif
+
+#define TRACE_BEGIN(var, name) TraceScope var = trace_scope_begin(name)
+#define TRACE_END(var) trace_scope_end(&(var))
+
+#define TRACE_INSTANT(name)                                             \
+    do {                                                                \
+        if (trace_is_enabled()) {                                       \
+            trace_record((name), TRACE_PHASE_INSTANT, trace_now(), 0);  \
+        }                                                               \
+    } while (0)
+
+#define TRACE_COUNTER(name, count)                                      \
+    do {                                                                \
+        if (trace_is_enabled()) {                                       \
+            trace_record((name), TRACE_PHASE_COUNTER, trace_now(),      \
+                         (uint64_t)(count));                            \
+        }                                                               \
+    } while (0)
+
+#else // !ENABLE_TRACING: every macro compiles to nothing
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_BEGIN(var, name) ((void)0)
+#define TRACE_END(var) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#define TRACE_COUNTER(name, count) ((void)0)
+
+#endif // ENABLE_TRACING
+
+#endif // TRACE_H
@@ -0,0 +1,565 @@
+/**
+ * array_kernels.c - Vectorized and Multithreaded Array Kernels
+ *
+ * See array_kernels.h for the API. Every kernel has a scalar version
+ * that defines its behavior; the SIMD versions must match it exactly
+ * (including which index wins on ties: always the first occurrence).
+ */
+
+#include "array_kernels.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_PTHREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define ROTATE_BUFFER_ELEMENTS 1024     // 4KB on the stack: fits in L1
+#define SWAP_CHUNK_ELEMENTS 256         // Block size for swap_ranges
+#define MINMAX_BLOCK_ELEMENTS (1u << 30) // SIMD index lanes are 32-bit
+
+// ========================================
+// MIN / MAX
+// ========================================
+
+/**
+ * Merge a partial result into an accumulator (first occurrence wins)
+ */
+static void min_max_combine(MinMaxResult *acc, const MinMaxResult *part) {
+    if (part->min < acc->min || (part->min == acc->min && part->min_index < acc->min_index)) {
+        acc->min = part->min;
+        acc->min_index = part->min_index;
+    }
+    if (part->max > acc->max || (part->max == acc->max && part->max_index < acc->max_index)) {
+        acc->max = part->max;
+        acc->max_index = part->max_index;
+    }
+}
+
+/**
+ * Scalar min/max over arr[begin, end), begin < end
+ */
+static void min_max_scalar(const int *arr, size_t begin, size_t end, MinMaxResult *result) {
+    MinMaxResult r = { arr[begin], arr[begin], begin, begin };
+    for (size_t i = begin + 1; i < end; i++) {
+        if (arr[i] < r.min) {
+            r.min = arr[i];
+            r.min_index = i;
+        }
+        if (arr[i] > r.max) {
+            r.max = arr[i];
+            r.max_index = i;
+        }
+    }
+    *result = r;
+}
+
+/**
+ * Fold per-lane SIMD accumulators into one result
+ */
+static void min_max_reduce_lanes(const int *mins, const int *maxs,
+                                 const uint32_t *min_idx, const uint32_t *max_idx,
+                                 int lanes, size_t offset, MinMaxResult *result) {
+    MinMaxResult r = { mins[0], maxs[0], offset + min_idx[0], offset + max_idx[0] };
+    for (int lane = 1; lane < lanes; lane++) {
+        MinMaxResult part = { mins[lane], maxs[lane], offset + min_idx[lane], offset + max_idx[lane] };
+        min_max_combine(&r, &part);
+    }
+    *result = r;
+}
+
+#ifdef HAVE_X86_SIMD
+static bool cpu_has_avx2(void) {
+    static int has_avx2 = -1;
+    if (has_avx2 < 0) {
+        has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return has_avx2 != 0;
+}
+
+/**
+ * AVX2: 8 lanes, each tracking its running min/max and where it was seen.
+ * Strict compares keep the earliest index per lane.
+ * len is a non-zero multiple of 8 and below 2^31.
+ */
+__attribute__((target("avx2")))
+static void min_max_block_avx2(const int *p, size_t len, size_t offset, MinMaxResult *result) {
+    __m256i vmin = _mm256_loadu_si256((const __m256i*)p);
+    __m256i vmax = vmin;
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i vmin_idx = idx;
+    __m256i vmax_idx = idx;
+    const __m256i step = _mm256_set1_epi32(8);
+
+    for (size_t i = 8; i < len; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+        idx = _mm256_add_epi32(idx, step);
+        __m256i lt = _mm256_cmpgt_epi32(vmin, x);
+        __m256i gt = _mm256_cmpgt_epi32(x, vmax);
+        vmin = _mm256_min_epi32(vmin, x);
+        vmax = _mm256_max_epi32(vmax, x);
+        vmin_idx = _mm256_blendv_epi8(vmin_idx, idx, lt);
+        vmax_idx = _mm256_blendv_epi8(vmax_idx, idx, gt);
+    }
+
+    int mins[8], maxs[8];
+    uint32_t min_idx[8], max_idx[8];
+    _mm256_storeu_si256((__m256i*)mins, vmin);
+    _mm256_storeu_si256((__m256i*)maxs, vmax);
+    _mm256_storeu_si256((__m256i*)min_idx, vmin_idx);
+    _mm256_storeu_si256((__m256i*)max_idx, vmax_idx);
+    min_max_reduce_lanes(mins, maxs, min_idx, max_idx, 8, offset, result);
+}
+
+/**
+ * mask ? a : b (SSE2 has no blend instruction)
+ */
+static inline __m128i select_sse2(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * SSE2: 4 lanes; min/max emulated with compare + select.
+ * len is a non-zero multiple of 4 and below 2^31.
+ */
+static void min_max_block_sse2(const int *p, size_t len, size_t offset, MinMaxResult *result) {
+    __m128i vmin = _mm_loadu_si128((const __m128i*)p);
+    __m128i vmax = vmin;
+    __m128i idx = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i vmin_idx = idx;
+    __m128i vmax_idx = idx;
+    const __m128i step = _mm_set1_epi32(4);
+
+    for (size_t i = 4; i < len; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+        idx = _mm_add_epi32(idx, step);
+        __m128i lt = _mm_cmpgt_epi32(vmin, x);
+        __m128i gt = _mm_cmpgt_epi32(x, vmax);
+        vmin = select_sse2(lt, x, vmin);
+        vmax = select_sse2(gt, x, vmax);
+        vmin_idx = select_sse2(lt, idx, vmin_idx);
+        vmax_idx = select_sse2(gt, idx, vmax_idx);
+    }
+
+    int mins[4], maxs[4];
+    uint32_t min_idx[4], max_idx[4];
+    _mm_storeu_si128((__m128i*)mins, vmin);
+    _mm_storeu_si128((__m128i*)maxs, vmax);
+    _mm_storeu_si128((__m128i*)min_idx, vmin_idx);
+    _mm_storeu_si128((__m128i*)max_idx, vmax_idx);
+    min_max_reduce_lanes(mins, maxs, min_idx, max_idx, 4, offset, result);
+}
+#endif
+
+#ifdef HAVE_NEON
+/**
+ * NEON: 4 lanes, vbslq selects the index where a lane improved.
+ * len is a non-zero multiple of 4 and below 2^31.
+ */
+static void min_max_block_neon(const int *p, size_t len, size_t offset, MinMaxResult *result) {
+    int32x4_t vmin = vld1q_s32(p);
+    int32x4_t vmax = vmin;
+    static const uint32_t lane_index[4] = {0, 1, 2, 3};
+    uint32x4_t idx = vld1q_u32(lane_index);
+    uint32x4_t vmin_idx = idx;
+    uint32x4_t vmax_idx = idx;
+    const uint32x4_t step = vdupq_n_u32(4);
+
+    for (size_t i = 4; i < len; i += 4) {
+        int32x4_t x = vld1q_s32(p + i);
+        idx = vaddq_u32(idx, step);
+        uint32x4_t lt = vcltq_s32(x, vmin);
+        uint32x4_t gt = vcgtq_s32(x, vmax);
+        vmin = vminq_s32(vmin, x);
+        vmax = vmaxq_s32(vmax, x);
+        vmin_idx = vbslq_u32(lt, idx, vmin_idx);
+        vmax_idx = vbslq_u32(gt, idx, vmax_idx);
+    }
+
+    int mins[4], maxs[4];
+    uint32_t min_idx[4], max_idx[4];
+    vst1q_s32(mins, vmin);
+    vst1q_s32(maxs, vmax);
+    vst1q_u32(min_idx, vmin_idx);
+    vst1q_u32(max_idx, vmax_idx);
+    min_max_reduce_lanes(mins, maxs, min_idx, max_idx, 4, offset, result);
+}
+#endif
+
+/**
+ * Fused min/max
+ * Time Complexity: O(n), one pass, 4-8 elements per instruction
+ * Space Complexity: O(1)
+ */
+bool array_min_max(const int *arr, size_t size, MinMaxResult *result) {
+    if (size == 0) {
+        return false;
+    }
+
+    void (*block)(const int*, size_t, size_t, MinMaxResult*) = NULL;
+    size_t lanes = 1;
+#if defined(HAVE_X86_SIMD)
+    block = cpu_has_avx2() ? min_max_block_avx2 : min_max_block_sse2;
+    lanes = cpu_has_avx2() ? 8 : 4;
+#elif defined(HAVE_NEON)
+    block = min_max_block_neon;
+    lanes = 4;
+#endif
+
+    size_t vector_end = (block != NULL) ? size - size % lanes : 0;
+    bool have = false;
+    MinMaxResult acc = {0, 0, 0, 0};
+
+    for (size_t start = 0; start < vector_end; start += MINMAX_BLOCK_ELEMENTS) {
+        size_t len = vector_end - start;
+        if (len > MINMAX_BLOCK_ELEMENTS) {
+            len = MINMAX_BLOCK_ELEMENTS;
+        }
+        MinMaxResult part;
+        block(arr + start, len, start, &part);
+        if (have) {
+            min_max_combine(&acc, &part);
+        } else {
+            acc = part;
+            have = true;
+        }
+    }
+
+    if (vector_end < size) {
+        MinMaxResult tail;
+        min_max_scalar(arr, vector_end, size, &tail);
+        if (have) {
+            min_max_combine(&acc, &tail);
+        } else {
+            acc = tail;
+        }
+    }
+
+    *result = acc;
+    return true;
+}
+
+// ========================================
+// REVERSE
+// ========================================
+
+/**
+ * Swap left[i] with right_end[-1 - i] for i in [0, count).
+ * The two ranges must not overlap.
+ */
+static void reverse_swap_scalar(int *left, int *right_end, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int temp = left[i];
+        left[i] = right_end[-1 - (ptrdiff_t)i];
+        right_end[-1 - (ptrdiff_t)i] = temp;
+    }
+}
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+static void reverse_swap_avx2(int *left, int *right_end, size_t count) {
+    const __m256i reverse_lanes = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    while (count >= 8) {
+        right_end -= 8;
+        __m256i a = _mm256_loadu_si256((const __m256i*)left);
+        __m256i b = _mm256_loadu_si256((const __m256i*)right_end);
+        _mm256_storeu_si256((__m256i*)left, _mm256_permutevar8x32_epi32(b, reverse_lanes));
+        _mm256_storeu_si256((__m256i*)right_end, _mm256_permutevar8x32_epi32(a, reverse_lanes));
+        left += 8;
+        count -= 8;
+    }
+    reverse_swap_scalar(left, right_end, count);
+}
+
+static void reverse_swap_sse2(int *left, int *right_end, size_t count) {
+    while (count >= 4) {
+        right_end -= 4;
+        __m128i a = _mm_loadu_si128((const __m128i*)left);
+        __m128i b = _mm_loadu_si128((const __m128i*)right_end);
+        _mm_storeu_si128((__m128i*)left, _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128((__m128i*)right_end, _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 1, 2, 3)));
+        left += 4;
+        count -= 4;
+    }
+    reverse_swap_scalar(left, right_end, count);
+}
+#endif
+
+#ifdef HAVE_NEON
+static inline int32x4_t reverse_lanes_neon(int32x4_t v) {
+    v = vrev64q_s32(v);             // [1 0 3 2]
+    return vextq_s32(v, v, 2);      // [3 2 1 0]
+}
+
+static void reverse_swap_neon(int *left, int *right_end, size_t count) {
+    while (count >= 4) {
+        right_end -= 4;
+        int32x4_t a = vld1q_s32(left);
+        int32x4_t b = vld1q_s32(right_end);
+        vst1q_s32(left, reverse_lanes_neon(b));
+        vst1q_s32(right_end, reverse_lanes_neon(a));
+        left += 4;
+        count -= 4;
+    }
+    reverse_swap_scalar(left, right_end, count);
+}
+#endif
+
+static void reverse_swap(int *left, int *right_end, size_t count) {
+#if defined(HAVE_X86_SIMD)
+    if (cpu_has_avx2()) {
+        reverse_swap_avx2(left, right_end, count);
+    } else {
+        reverse_swap_sse2(left, right_end, count);
+    }
+#elif defined(HAVE_NEON)
+    reverse_swap_neon(left, right_end, count);
+#else
+    reverse_swap_scalar(left, right_end, count);
+#endif
+}
+
+/**
+ * SIMD reverse
+ * Time Complexity: O(n)
+ * Space Complexity: O(1)
+ */
+void array_reverse(int *arr, size_t size) {
+    reverse_swap(arr, arr + size, size / 2);
+}
+
+// ========================================
+// ROTATE
+// ========================================
+
+/**
+ * Exchange two equal-length, non-overlapping ranges in L1-sized chunks
+ * (memcpy is the fastest copy the platform has)
+ */
+static void swap_ranges(int *a, int *b, size_t len) {
+    int chunk[SWAP_CHUNK_ELEMENTS];
+    while (len > 0) {
+        size_t n = len < SWAP_CHUNK_ELEMENTS ? len : SWAP_CHUNK_ELEMENTS;
+        memcpy(chunk, a, n * sizeof(int));
+        memcpy(a, b, n * sizeof(int));
+        memcpy(b, chunk, n * sizeof(int));
+        a += n;
+        b += n;
+        len -= n;
+    }
+}
+
+/**
+ * Gries-Mills block-swap rotation of [A | B], |A| = left_len.
+ * Each round swaps the shorter block straight into its final place,
+ * so every element moves about once (vs. twice for three reversals),
+ * and every move is a sequential chunked copy.
+ */
+static void rotate_block_swap(int *base, size_t left_len, size_t right_len) {
+    while (left_len > 0 && right_len > 0 && left_len != right_len) {
+        if (left_len < right_len) {
+            // [A | B1 B2], |B2| = |A|  ->  [B2 B1 | A]: A is done
+            swap_ranges(base, base + right_len, left_len);
+            right_len -= left_len;
+        } else {
+            // [A1 A2 | B], |A1| = |B|  ->  [B | A2 A1]: B is done
+            swap_ranges(base, base + left_len, right_len);
+            base += right_len;
+            left_len -= right_len;
+        }
+    }
+    if (left_len > 0 && left_len == right_len) {
+        swap_ranges(base, base + left_len, left_len);
+    }
+}
+
+/**
+ * Cache-blocked left rotation
+ * Time Complexity: O(n)
+ * Space Complexity: O(1) - at most a 4KB stack buffer
+ *
+ * Short shifts park the small side in an L1-resident buffer and move
+ * the rest with one memmove; long shifts use block swaps.
+ */
+void array_rotate_left(int *arr, size_t size, size_t positions) {
+    if (size == 0) {
+        return;
+    }
+    positions %= size;
+    if (positions == 0) {
+        return;
+    }
+
+    size_t right_len = size - positions;
+    int buffer[ROTATE_BUFFER_ELEMENTS];
+
+    if (positions <= ROTATE_BUFFER_ELEMENTS && positions <= right_len) {
+        memcpy(buffer, arr, positions * sizeof(int));
+        memmove(arr, arr + positions, right_len * sizeof(int));
+        memcpy(arr + right_len, buffer, positions * sizeof(int));
+    } else if (right_len <= ROTATE_BUFFER_ELEMENTS) {
+        memcpy(buffer, arr + positions, right_len * sizeof(int));
+        memmove(arr + right_len, arr, positions * sizeof(int));
+        memcpy(arr, buffer, right_len * sizeof(int));
+    } else {
+        rotate_block_swap(arr, positions, right_len);
+    }
+}
+
+void array_rotate_right(int *arr, size_t size, size_t positions) {
+    if (size == 0) {
+        return;
+    }
+    positions %= size;
+    array_rotate_left(arr, size, (size - positions) % size);
+}
+
+// ========================================
+// PARALLEL VARIANTS
+// ========================================
+
+#ifdef HAVE_PTHREADS
+typedef struct {
+    const int *arr;
+    int *mutable_arr;
+    size_t size;
+    size_t begin;
+    size_t end;
+    MinMaxResult result;
+} ArrayTask;
+
+static int resolve_threads(int threads, size_t size) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > ARRAY_MAX_THREADS) {
+        threads = ARRAY_MAX_THREADS;
+    }
+    // Keep each thread's share at least a quarter of the cutoff
+    size_t max_useful = size / (ARRAY_PARALLEL_CUTOFF / 4);
+    if (max_useful < 1) {
+        max_useful = 1;
+    }
+    if ((size_t)threads > max_useful) {
+        threads = (int)max_useful;
+    }
+    return threads;
+}
+
+/**
+ * Run worker(task[t]) for t in [0, threads): the caller runs task 0.
+ * A task whose thread cannot be created runs on the caller instead.
+ */
+static void run_array_tasks(void *(*worker)(void*), ArrayTask *tasks, int threads) {
+    pthread_t handles[ARRAY_MAX_THREADS];
+    bool started[ARRAY_MAX_THREADS] = {false};
+
+    for (int t = 1; t < threads; t++) {
+        started[t] = pthread_create(&handles[t], NULL, worker, &tasks[t]) == 0;
+    }
+    worker(&tasks[0]);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(handles[t], NULL);
+        } else {
+            worker(&tasks[t]);
+        }
+    }
+}
+
+static void *min_max_worker(void *arg) {
+    ArrayTask *task = (ArrayTask*)arg;
+    array_min_max(task->arr + task->begin, task->end - task->begin, &task->result);
+    task->result.min_index += task->begin;
+    task->result.max_index += task->begin;
+    return NULL;
+}
+
+static void *reverse_worker(void *arg) {
+    ArrayTask *task = (ArrayTask*)arg;
+    // Pairs [begin, end) of the left half with their mirrors on the right
+    reverse_swap(task->mutable_arr + task->begin, task->mutable_arr + task->size - task->begin,
+                 task->end - task->begin);
+    return NULL;
+}
+
+/**
+ * Split [0, total) into 'threads' nearly equal ranges
+ */
+static void split_range(ArrayTask *tasks, int threads, size_t total) {
+    for (int t = 0; t < threads; t++) {
+        tasks[t].begin = total * (size_t)t / (size_t)threads;
+        tasks[t].end = total * (size_t)(t + 1) / (size_t)threads;
+    }
+}
+#endif
+
+/**
+ * Parallel min/max: each thread reduces a slice, results are combined
+ * in slice order so the first occurrence still wins.
+ */
+bool array_min_max_parallel(const int *arr, size_t size, int threads, MinMaxResult *result) {
+#ifdef HAVE_PTHREADS
+    if (size >= ARRAY_PARALLEL_CUTOFF) {
+        threads = resolve_threads(threads, size);
+        if (threads > 1) {
+            ArrayTask tasks[ARRAY_MAX_THREADS];
+            for (int t = 0; t < threads; t++) {
+                tasks[t].arr = arr;
+                tasks[t].mutable_arr = NULL;
+                tasks[t].size = size;
+            }
+            split_range(tasks, threads, size);
+            run_array_tasks(min_max_worker, tasks, threads);
+
+            MinMaxResult acc = tasks[0].result;
+            for (int t = 1; t < threads; t++) {
+                min_max_combine(&acc, &tasks[t].result);
+            }
+            *result = acc;
+            return true;
+        }
+    }
+#else
+    (void)threads;
+#endif
+    return array_min_max(arr, size, result);
+}
+
+/**
+ * Parallel reverse: the left half is split into slices; each thread
+ * swaps its slice with the mirrored slice of the right half.
+ */
+void array_reverse_parallel(int *arr, size_t size, int threads) {
+#ifdef HAVE_PTHREADS
+    if (size >= ARRAY_PARALLEL_CUTOFF) {
+        threads = resolve_threads(threads, size);
+        if (threads > 1) {
+            ArrayTask tasks[ARRAY_MAX_THREADS];
+            for (int t = 0; t < threads; t++) {
+                tasks[t].arr = arr;
+                tasks[t].mutable_arr = arr;
+                tasks[t].size = size;
+            }
+            split_range(tasks, threads, size / 2);
+            run_array_tasks(reverse_worker, tasks, threads);
+            return;
+        }
+    }
+#else
+    (void)threads;
+#endif
+    array_reverse(arr, size);
+}
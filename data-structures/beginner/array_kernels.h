@@ -0,0 +1,67 @@
+/**
+ * array_kernels.h - Vectorized and Multithreaded Array Kernels
+ *
+ * Production versions of the one-int-at-a-time loops in
+ * array_operations.c, for arrays of millions of elements:
+ * - array_min_max:     one fused pass for min, max and their indices
+ * - array_reverse:     SIMD lane-reversing swap from both ends
+ * - array_rotate_*:    buffer + memmove for short shifts, block-swap
+ *                      (each element moved about once) otherwise
+ * - *_parallel:        the same kernels split across threads
+ *
+ * SIMD paths (picked at runtime where it matters):
+ * - x86-64: AVX2 when the CPU has it, SSE2 otherwise
+ * - ARM:    NEON
+ * - Others: scalar loops
+ *
+ * Indices and sizes are size_t so arrays larger than 2^31 elements work.
+ */
+
+#ifndef ARRAY_KERNELS_H
+#define ARRAY_KERNELS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Arrays below this size are not worth waking threads for
+#define ARRAY_PARALLEL_CUTOFF (1 << 18)
+#define ARRAY_MAX_THREADS 64
+
+/**
+ * Result of a fused min/max pass.
+ * Indices are the FIRST occurrence of each value.
+ */
+typedef struct {
+    int min;
+    int max;
+    size_t min_index;
+    size_t max_index;
+} MinMaxResult;
+
+/**
+ * Find min and max (with indices) in a single pass
+ * Returns: false if size is 0 (result untouched)
+ */
+bool array_min_max(const int *arr, size_t size, MinMaxResult *result);
+
+/**
+ * Reverse the array in place
+ */
+void array_reverse(int *arr, size_t size);
+
+/**
+ * Rotate in place: left moves arr[positions] to arr[0]
+ * positions may exceed size (taken modulo size)
+ */
+void array_rotate_left(int *arr, size_t size, size_t positions);
+void array_rotate_right(int *arr, size_t size, size_t positions);
+
+/**
+ * Multithreaded variants. threads <= 0 uses every online CPU.
+ * Fall back to the single-threaded kernels for small arrays or
+ * when threads are unavailable.
+ */
+bool array_min_max_parallel(const int *arr, size_t size, int threads, MinMaxResult *result);
+void array_reverse_parallel(int *arr, size_t size, int threads);
+
+#endif // ARRAY_KERNELS_H
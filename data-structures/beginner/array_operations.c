@@ -13,16 +13,61 @@
  * - Search: O(n)
  * - Reverse: O(n)
  * - Rotate: O(n)
+ * 
+ * Reverse, rotate and min/max run on the SIMD kernels in
+ * array_kernels.c; section 10 measures them on a large array.
+ * 
+ * GapBuffer (section 11) keeps an unused gap at the edit cursor, so
+ * bursts of inserts/deletes near one spot cost O(1) each instead of
+ * shifting the whole tail.
+ * 
+ * print_array() formats through the buffered writer in
+ * fundamentals/intermediate/output_writer.c; section 12 compares it with
+ * a printf per element on a 10M-element dump.
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
+#include <time.h>
+#include "array_kernels.h"
+#include "output_writer.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
 #define MAX_SIZE 100
+#define KERNEL_BENCH_SIZE (16 * 1024 * 1024)   // 64MB of ints: far beyond cache
+#define GAP_MIN_CAPACITY 64
+#define EDIT_BENCH_SIZE 2000000
+#define EDIT_BENCH_EDITS 20000
+#define DUMP_BENCH_SIZE 10000000          // Elements formatted by the dump comparison
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+/**
+ * Gap buffer: one int array with a hole at the cursor
+ * 
+ *   data: [ front ... | gap (unused) | ... back ]
+ *          0     gap_start      gap_end     capacity
+ * 
+ * Inserting at the cursor writes into the gap; deleting widens it.
+ * Moving the cursor memmoves only the elements between old and new
+ * position, so localized edits are cheap while the contents stay in
+ * (at most) two contiguous runs for scanning.
+ */
+typedef struct {
+    int *data;
+    int capacity;
+    int gap_start;
+    int gap_end;
+} GapBuffer;
 
 // Function declarations
 void print_array(int arr[], int size);
@@ -36,6 +81,16 @@ int find_max(int arr[], int size);
 int find_min(int arr[], int size);
 void merge_arrays(int arr1[], int size1, int arr2[], int size2, int result[]);
 
+// Gap buffer: same shape as insert_element/delete_element, returns new size
+bool gap_init(GapBuffer *gb, const int initial[], int size);
+int gap_size(const GapBuffer *gb);
+int gap_insert_element(GapBuffer *gb, int element, int position);
+int gap_delete_element(GapBuffer *gb, int position);
+int gap_get(const GapBuffer *gb, int position);
+const int* gap_contiguous(GapBuffer *gb);
+void gap_print(const GapBuffer *gb);
+void gap_free(GapBuffer *gb);
+
 int main(void) {
 #ifdef _WIN32
     // Enable UTF-8 output on Windows console
@@ -147,6 +202,177 @@ int main(void) {
     print_array(merged, size1 + size2);
     printf("\n");
     
+    // 10. Vectorized kernels on a large array
+    printf("10. SIMD AND MULTITHREADED KERNELS\n");
+    size_t big_size = KERNEL_BENCH_SIZE;
+    int *big = malloc(big_size * sizeof(int));
+    if (big != NULL) {
+        srand(42);
+        for (size_t i = 0; i < big_size; i++) {
+            big[i] = rand() - RAND_MAX / 2;
+        }
+        printf("   %zu ints (%zu MB)\n", big_size, big_size * sizeof(int) >> 20);
+        
+        clock_t start = clock();
+        int scalar_min = big[0], scalar_max = big[0];
+        size_t scalar_min_idx = 0, scalar_max_idx = 0;
+        for (size_t i = 1; i < big_size; i++) {
+            if (big[i] < scalar_min) { scalar_min = big[i]; scalar_min_idx = i; }
+            if (big[i] > scalar_max) { scalar_max = big[i]; scalar_max_idx = i; }
+        }
+        double t_scalar = (double)(clock() - start) / CLOCKS_PER_SEC;
+        
+        MinMaxResult mm;
+        start = clock();
+        array_min_max(big, big_size, &mm);
+        double t_simd = (double)(clock() - start) / CLOCKS_PER_SEC;
+        
+        MinMaxResult mm_par;
+        start = clock();
+        array_min_max_parallel(big, big_size, 0, &mm_par);
+        double t_par = (double)(clock() - start) / CLOCKS_PER_SEC;
+        
+        bool same = mm.min == scalar_min && mm.min_index == scalar_min_idx &&
+                    mm.max == scalar_max && mm.max_index == scalar_max_idx &&
+                    mm_par.min_index == mm.min_index && mm_par.max_index == mm.max_index;
+        printf("   min %d at %zu, max %d at %zu %s\n", mm.min, mm.min_index, mm.max, mm.max_index,
+               same ? "✓ Matches scalar loop" : "✗ Mismatch");
+        double gb = (double)big_size * sizeof(int) / 1e9;
+        printf("   Scalar min/max:   %6.2f GB/s\n", gb / (t_scalar + 1e-9));
+        printf("   array_min_max:    %6.2f GB/s\n", gb / (t_simd + 1e-9));
+        printf("   ..._parallel:     %6.2f GB/s (CPU time: sums all threads)\n", gb / (t_par + 1e-9));
+        
+        int first = big[0], last = big[big_size - 1];
+        start = clock();
+        array_reverse(big, big_size);
+        double t_reverse = (double)(clock() - start) / CLOCKS_PER_SEC;
+        array_reverse_parallel(big, big_size, 0);   // Reverse back
+        printf("   array_reverse:    %6.2f GB/s %s\n", gb / (t_reverse + 1e-9),
+               big[0] == first && big[big_size - 1] == last ? "✓ Round trip ok" : "✗ Mismatch");
+        
+        size_t shift = big_size / 3 + 7;
+        int expected = big[shift];
+        start = clock();
+        array_rotate_left(big, big_size, shift);
+        double t_rotate = (double)(clock() - start) / CLOCKS_PER_SEC;
+        bool rotated = big[0] == expected;
+        array_rotate_right(big, big_size, shift);
+        printf("   array_rotate_left:%6.2f GB/s (by %zu) %s\n", gb / (t_rotate + 1e-9), shift,
+               rotated && big[0] == first ? "✓ Round trip ok" : "✗ Mismatch");
+        free(big);
+    }
+    printf("\n");
+    
+    // 11. Gap buffer for localized edits
+    printf("11. GAP BUFFER (FAST EDITS NEAR A CURSOR)\n");
+    GapBuffer gb;
+    int initial[] = {10, 20, 30, 40, 50};
+    if (gap_init(&gb, initial, 5)) {
+        printf("   Start:              ");
+        gap_print(&gb);
+        gap_insert_element(&gb, 25, 2);
+        gap_insert_element(&gb, 26, 3);     // Next to the cursor: no shifting
+        gap_insert_element(&gb, 27, 4);
+        printf("   Insert 25,26,27 @2: ");
+        gap_print(&gb);
+        gap_delete_element(&gb, 0);
+        printf("   Delete position 0:  ");
+        gap_print(&gb);
+        gap_insert_element(&gb, 99, 99);    // Invalid position: unchanged
+        gap_free(&gb);
+    }
+    
+    int *flat = malloc((EDIT_BENCH_SIZE + EDIT_BENCH_EDITS) * sizeof(int));
+    int *seed = malloc(EDIT_BENCH_SIZE * sizeof(int));
+    if (flat != NULL && seed != NULL) {
+        for (int i = 0; i < EDIT_BENCH_SIZE; i++) {
+            seed[i] = i;
+        }
+        memcpy(flat, seed, EDIT_BENCH_SIZE * sizeof(int));
+        
+        // Bursts of 100 edits around a cursor that jumps every burst
+        srand(11);
+        int flat_size = EDIT_BENCH_SIZE;
+        clock_t start = clock();
+        for (int e = 0, cursor = 0; e < EDIT_BENCH_EDITS; e++) {
+            if (e % 100 == 0) {
+                cursor = rand() % flat_size;
+            }
+            int at = cursor + e % 7;
+            if (at > flat_size) at = flat_size;
+            memmove(flat + at + 1, flat + at, (size_t)(flat_size - at) * sizeof(int));
+            flat[at] = -e;
+            flat_size++;
+        }
+        double t_flat = (double)(clock() - start) / CLOCKS_PER_SEC;
+        
+        GapBuffer big_gb;
+        if (gap_init(&big_gb, seed, EDIT_BENCH_SIZE)) {
+            srand(11);
+            start = clock();
+            for (int e = 0, cursor = 0; e < EDIT_BENCH_EDITS; e++) {
+                if (e % 100 == 0) {
+                    cursor = rand() % gap_size(&big_gb);
+                }
+                int at = cursor + e % 7;
+                if (at > gap_size(&big_gb)) at = gap_size(&big_gb);
+                gap_insert_element(&big_gb, -e, at);
+            }
+            double t_gap = (double)(clock() - start) / CLOCKS_PER_SEC;
+            
+            const int *contents = gap_contiguous(&big_gb);
+            bool same = gap_size(&big_gb) == flat_size &&
+                        memcmp(contents, flat, (size_t)flat_size * sizeof(int)) == 0;
+            printf("   %d inserts (bursts of 100) into %d elements:\n", EDIT_BENCH_EDITS, EDIT_BENCH_SIZE);
+            printf("   Shift tail (insert_element): %8.1f us/edit\n", t_flat * 1e6 / EDIT_BENCH_EDITS);
+            printf("   gap_insert_element:          %8.1f us/edit %s\n", t_gap * 1e6 / EDIT_BENCH_EDITS,
+                   same ? "✓ Same contents" : "✗ Mismatch");
+            gap_free(&big_gb);
+        }
+    }
+    free(flat);
+    free(seed);
+    printf("\n");
+    
+    // 12. Dumping a large array: printf per element vs buffered writer
+    // (timings are only meaningful with -O2: at -O0 every digit is a div)
+    printf("12. DUMPING A LARGE ARRAY (TO %s)\n", NULL_DEVICE);
+    int *dump = malloc(DUMP_BENCH_SIZE * sizeof(int));
+    FILE *sink = fopen(NULL_DEVICE, "w");
+    if (dump != NULL && sink != NULL) {
+        srand(7);
+        for (int i = 0; i < DUMP_BENCH_SIZE; i++) {
+            dump[i] = rand() - RAND_MAX / 2;
+        }
+        
+        clock_t start = clock();
+        long long printf_bytes = 0;
+        for (int i = 0; i < DUMP_BENCH_SIZE; i++) {
+            printf_bytes += fprintf(sink, i + 1 < DUMP_BENCH_SIZE ? "%d, " : "%d", dump[i]);
+        }
+        fflush(sink);
+        double t_printf = (double)(clock() - start) / CLOCKS_PER_SEC;
+        
+        OutputWriter writer;
+        if (output_writer_attach(&writer, sink, 0)) {
+            start = clock();
+            write_int_array(&writer, dump, DUMP_BENCH_SIZE, ", ");
+            output_writer_flush(&writer);
+            double t_writer = (double)(clock() - start) / CLOCKS_PER_SEC;
+            
+            printf("   %d ints, %lld bytes of text\n", DUMP_BENCH_SIZE, printf_bytes);
+            printf("   fprintf per element: %8.1f ms\n", t_printf * 1e3);
+            printf("   write_int_array:     %8.1f ms (%zu writes) %s\n", t_writer * 1e3, writer.flushes,
+                   (long long)writer.bytes_written == printf_bytes ? "✓ Same bytes" : "✗ Mismatch");
+            output_writer_close(&writer);
+        }
+    }
+    if (sink != NULL) {
+        fclose(sink);
+    }
+    free(dump);
+    printf("\n");
+    
     printf("========================================\n");
     printf("     OPERATIONS COMPLETED SUCCESSFULLY  \n");
     printf("========================================\n");
@@ -156,16 +382,16 @@ int main(void) {
 
 /**
  * Print array elements
+ * (one buffered write via output_writer.h, not a printf per element)
  */
 void print_array(int arr[], int size) {
-    printf("[");
-    for (int i = 0; i < size; i++) {
-        printf("%d", arr[i]);
-        if (i < size - 1) {
-            printf(", ");
-        }
-    }
-    printf("] (size: %d)\n", size);
+    OutputWriter *out = output_stdout();
+    output_write_char(out, '[');
+    write_int_array(out, arr, size > 0 ? (size_t)size : 0, ", ");
+    output_write_str(out, "] (size: ");
+    output_write_int(out, size);
+    output_write_str(out, ")\n");
+    output_writer_flush(out);
 }
 
 /**
@@ -229,110 +455,41 @@ int linear_search(int arr[], int size, int target) {
     return -1; // Not found
 }
 
-/** * Helper function to reverse a subarray from start to end indices
- * Time Complexity: O(n)
- * Space Complexity: O(1)
- */
-static void reverse_subarray(int arr[], int start, int end) {
-    while (start < end) {
-        int temp = arr[start];
-        arr[start] = arr[end];
-        arr[end] = temp;
-        start++;
-        end--;
-    }
-}
-
-/** * Reverse array in-place
+/**
+ * Reverse array in-place
  * Time Complexity: O(n)
  * Space Complexity: O(1)
+ * 
+ * Swaps from both ends, 8 elements per instruction (array_reverse)
  */
 void reverse_array(int arr[], int size) {
-    int left = 0;
-    int right = size - 1;
-    
-    while (left < right) {
-        // Swap elements
-        int temp = arr[left];
-        arr[left] = arr[right];
-        arr[right] = temp;
-        
-        left++;
-        right--;
+    if (size > 1) {
+        array_reverse(arr, (size_t)size);
     }
 }
 
 /**
  * Rotate array left by specified positions
  * Time Complexity: O(n)
- * Space Complexity: O(k) where k is positions
+ * Space Complexity: O(1) - small shifts use a 4KB stack buffer
+ * 
+ * Short shifts: buffer + one memmove. Long shifts: block swaps that
+ * move each element about once, instead of the reversal trick's three
+ * passes over the whole array.
  */
 void rotate_left(int arr[], int size, int positions) {
-    if (size == 0) return;
-    
-    // Handle positions greater than size
-    positions = positions % size;
-    if (positions == 0) return;
-    
-    // Store first 'positions' elements (use static buffer for MSVC compatibility)
-    #define MAX_ROTATE_BUFFER 256
-    int temp[MAX_ROTATE_BUFFER];
-    if (positions > MAX_ROTATE_BUFFER) {
-        // For larger rotations, use reversal algorithm instead
-        reverse_subarray(arr, 0, positions - 1);
-        reverse_subarray(arr, positions, size - 1);
-        reverse_subarray(arr, 0, size - 1);
-        return;
-    }
-    for (int i = 0; i < positions; i++) {
-        temp[i] = arr[i];
-    }
-    
-    // Shift remaining elements left
-    for (int i = 0; i < size - positions; i++) {
-        arr[i] = arr[i + positions];
-    }
-    
-    // Copy temp elements to end
-    for (int i = 0; i < positions; i++) {
-        arr[size - positions + i] = temp[i];
-    }
+    if (size <= 0 || positions < 0) return;
+    array_rotate_left(arr, (size_t)size, (size_t)positions);
 }
 
 /**
  * Rotate array right by specified positions
  * Time Complexity: O(n)
- * Space Complexity: O(k) where k is positions
+ * Space Complexity: O(1)
  */
 void rotate_right(int arr[], int size, int positions) {
-    if (size == 0) return;
-    
-    // Handle positions greater than size
-    positions = positions % size;
-    if (positions == 0) return;
-    
-    // Store last 'positions' elements (use static buffer for MSVC compatibility)
-    int temp[MAX_ROTATE_BUFFER];
-    if (positions > MAX_ROTATE_BUFFER) {
-        // For larger rotations, use reversal algorithm instead
-        reverse_subarray(arr, 0, size - 1);
-        reverse_subarray(arr, 0, positions - 1);
-        reverse_subarray(arr, positions, size - 1);
-        return;
-    }
-    for (int i = 0; i < positions; i++) {
-        temp[i] = arr[size - positions + i];
-    }
-    
-    // Shift elements right
-    for (int i = size - 1; i >= positions; i--) {
-        arr[i] = arr[i - positions];
-    }
-    
-    // Copy temp elements to beginning
-    for (int i = 0; i < positions; i++) {
-        arr[i] = temp[i];
-    }
+    if (size <= 0 || positions < 0) return;
+    array_rotate_right(arr, (size_t)size, (size_t)positions);
 }
 
 /**
@@ -341,18 +498,12 @@ void rotate_right(int arr[], int size, int positions) {
  * Space Complexity: O(1)
  */
 int find_max(int arr[], int size) {
-    if (size == 0) {
+    MinMaxResult result;
+    if (size <= 0 || !array_min_max(arr, (size_t)size, &result)) {
         printf("Error: Empty array\n");
         return -1;
     }
-    
-    int max = arr[0];
-    for (int i = 1; i < size; i++) {
-        if (arr[i] > max) {
-            max = arr[i];
-        }
-    }
-    return max;
+    return result.max;
 }
 
 /**
@@ -361,18 +512,12 @@ int find_max(int arr[], int size) {
  * Space Complexity: O(1)
  */
 int find_min(int arr[], int size) {
-    if (size == 0) {
+    MinMaxResult result;
+    if (size <= 0 || !array_min_max(arr, (size_t)size, &result)) {
         printf("Error: Empty array\n");
         return -1;
     }
-    
-    int min = arr[0];
-    for (int i = 1; i < size; i++) {
-        if (arr[i] < min) {
-            min = arr[i];
-        }
-    }
-    return min;
+    return result.min;
 }
 
 /**
@@ -391,3 +536,145 @@ void merge_arrays(int arr1[], int size1, int arr2[], int size2, int result[]) {
         result[size1 + i] = arr2[i];
     }
 }
+
+/**
+ * Initialize a gap buffer holding a copy of initial[0..size)
+ * The gap starts at the end, sized like the contents (min 64).
+ */
+bool gap_init(GapBuffer *gb, const int initial[], int size) {
+    int capacity = size * 2 > GAP_MIN_CAPACITY ? size * 2 : GAP_MIN_CAPACITY;
+    gb->data = malloc((size_t)capacity * sizeof(int));
+    if (gb->data == NULL) {
+        gb->capacity = gb->gap_start = gb->gap_end = 0;
+        return false;
+    }
+    if (size > 0) {
+        memcpy(gb->data, initial, (size_t)size * sizeof(int));
+    }
+    gb->capacity = capacity;
+    gb->gap_start = size;
+    gb->gap_end = capacity;
+    return true;
+}
+
+int gap_size(const GapBuffer *gb) {
+    return gb->capacity - (gb->gap_end - gb->gap_start);
+}
+
+/**
+ * Move the gap so it starts at logical index 'position'
+ * Time Complexity: O(distance moved)
+ */
+static void gap_move(GapBuffer *gb, int position) {
+    if (position < gb->gap_start) {
+        int count = gb->gap_start - position;
+        memmove(gb->data + gb->gap_end - count, gb->data + position, (size_t)count * sizeof(int));
+        gb->gap_start -= count;
+        gb->gap_end -= count;
+    } else if (position > gb->gap_start) {
+        int count = position - gb->gap_start;
+        memmove(gb->data + gb->gap_start, gb->data + gb->gap_end, (size_t)count * sizeof(int));
+        gb->gap_start += count;
+        gb->gap_end += count;
+    }
+}
+
+/**
+ * Double the capacity, keeping the back run at the end
+ */
+static bool gap_grow(GapBuffer *gb) {
+    int new_capacity = gb->capacity * 2;
+    int *new_data = realloc(gb->data, (size_t)new_capacity * sizeof(int));
+    if (new_data == NULL) {
+        return false;
+    }
+    int back = gb->capacity - gb->gap_end;
+    memmove(new_data + new_capacity - back, new_data + gb->gap_end, (size_t)back * sizeof(int));
+    gb->data = new_data;
+    gb->gap_end = new_capacity - back;
+    gb->capacity = new_capacity;
+    return true;
+}
+
+/**
+ * Insert element at specified position
+ * Time Complexity: O(1) amortized at the cursor, O(distance) to move it
+ * Space Complexity: O(1) amortized
+ */
+int gap_insert_element(GapBuffer *gb, int element, int position) {
+    int size = gap_size(gb);
+    if (position < 0 || position > size) {
+        printf("   Error: Invalid position %d (valid range: 0-%d)\n", position, size);
+        return size;
+    }
+    if (gb->gap_start == gb->gap_end && !gap_grow(gb)) {
+        printf("   Error: Out of memory\n");
+        return size;
+    }
+    
+    gap_move(gb, position);
+    gb->data[gb->gap_start++] = element;
+    return size + 1;
+}
+
+/**
+ * Delete element at specified position
+ * Time Complexity: O(1) at the cursor, O(distance) to move it
+ * Space Complexity: O(1)
+ */
+int gap_delete_element(GapBuffer *gb, int position) {
+    int size = gap_size(gb);
+    if (position < 0 || position >= size) {
+        printf("   Error: Invalid position %d (valid range: 0-%d)\n", position, size - 1);
+        return size;
+    }
+    
+    gap_move(gb, position);
+    gb->gap_end++;      // Element right after the gap joins the gap
+    return size - 1;
+}
+
+/**
+ * Read element at logical index (no bounds report, -1 if out of range)
+ */
+int gap_get(const GapBuffer *gb, int position) {
+    if (position < 0 || position >= gap_size(gb)) {
+        return -1;
+    }
+    return position < gb->gap_start ? gb->data[position]
+                                    : gb->data[position + (gb->gap_end - gb->gap_start)];
+}
+
+/**
+ * Move the gap to the end and return the contents as one array
+ * (valid until the next edit). Use before long scans.
+ */
+const int* gap_contiguous(GapBuffer *gb) {
+    gap_move(gb, gap_size(gb));
+    return gb->data;
+}
+
+void gap_print(const GapBuffer *gb) {
+    /* The two runs either side of the gap, written straight from the buffer */
+    OutputWriter *out = output_stdout();
+    size_t before = (size_t)gb->gap_start;
+    size_t after = (size_t)(gb->capacity - gb->gap_end);
+    output_write_char(out, '[');
+    write_int_array(out, gb->data, before, ", ");
+    if (before > 0 && after > 0) {
+        output_write_str(out, ", ");
+    }
+    write_int_array(out, gb->data + gb->gap_end, after, ", ");
+    output_write_str(out, "] (size: ");
+    output_write_int(out, gap_size(gb));
+    output_write_str(out, ", gap at ");
+    output_write_int(out, gb->gap_start);
+    output_write_str(out, ")\n");
+    output_writer_flush(out);
+}
+
+void gap_free(GapBuffer *gb) {
+    free(gb->data);
+    gb->data = NULL;
+    gb->capacity = gb->gap_start = gb->gap_end = 0;
+}
@@ -0,0 +1,701 @@
+/**
+ * hash_map.c - Open-Addressing Hash Maps (SwissTable-Style Probing)
+ *
+ * See hash_map.h for the layout. Both maps run on one table engine that
+ * is parameterized by a TableOps (slot size, hash, key compare). The
+ * engine functions are forced inline and IntHashMap passes a constant
+ * TableOps, so the compiler specializes them: the int map's probe loop
+ * compares ints directly instead of calling through function pointers.
+ *
+ * Control bytes:
+ *   0x00-0x7F  FULL: slot holds a key whose hash has this low 7-bit tag
+ *   0x80       EMPTY: never used (ends a probe)
+ *   0xFE       DELETED: removed key (a probe continues past it)
+ * Both free states have the top bit set, so "find a free slot" is one
+ * movemask of the group.
+ */
+
+#include "hash_map.h"
+#include "trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ENGINE static inline __attribute__((always_inline))
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define ENGINE static inline
+#define PREFETCH(addr) ((void)(addr))
+#endif
+
+#define CTRL_EMPTY ((uint8_t)0x80)
+#define CTRL_DELETED ((uint8_t)0xFE)
+#define NOT_FOUND SIZE_MAX
+#define VALUE_ALIGN 8
+
+// ========================================
+// GROUP MATCHING
+// ========================================
+
+/**
+ * Bitmask over the 16 slots of a group. SSE2 and the scalar loop give
+ * one bit per slot; NEON gives one bit per 4 (GROUP_SLOT_SHIFT).
+ */
+typedef uint64_t GroupMask;
+
+#if defined(HAVE_X86_SIMD)
+#define GROUP_SLOT_SHIFT 0
+
+static inline GroupMask group_match(const uint8_t *group, uint8_t byte) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (GroupMask)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)byte)));
+}
+
+static inline GroupMask group_match_free(const uint8_t *group) {
+    return (GroupMask)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+}
+#elif defined(HAVE_NEON)
+#define GROUP_SLOT_SHIFT 2
+
+/**
+ * NEON has no movemask: narrow each 16-bit pair to 8 bits (4 bits per
+ * byte) and keep one bit of each nibble
+ */
+static inline GroupMask neon_mask(uint8x16_t lanes) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & UINT64_C(0x8888888888888888);
+}
+
+static inline GroupMask group_match(const uint8_t *group, uint8_t byte) {
+    return neon_mask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(byte)));
+}
+
+static inline GroupMask group_match_free(const uint8_t *group) {
+    // vcltq against zero, not vcltzq_s8: that one is AArch64-only
+    return neon_mask(vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(group)), vdupq_n_s8(0)));
+}
+#else
+#define GROUP_SLOT_SHIFT 0
+
+static inline GroupMask group_match(const uint8_t *group, uint8_t byte) {
+    GroupMask mask = 0;
+    for (int i = 0; i < HASH_GROUP_WIDTH; i++) {
+        mask |= (GroupMask)(group[i] == byte) << i;
+    }
+    return mask;
+}
+
+static inline GroupMask group_match_free(const uint8_t *group) {
+    GroupMask mask = 0;
+    for (int i = 0; i < HASH_GROUP_WIDTH; i++) {
+        mask |= (GroupMask)(group[i] >> 7) << i;
+    }
+    return mask;
+}
+#endif
+
+static inline size_t mask_first_slot(GroupMask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(mask) >> GROUP_SLOT_SHIFT;
+#else
+    size_t bit = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit >> GROUP_SLOT_SHIFT;
+#endif
+}
+
+// ========================================
+// HASHING
+// ========================================
+
+/**
+ * splitmix64 finalizer: every input bit affects every output bit, so
+ * sequential ints spread over all groups and all tags
+ */
+static inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= UINT64_C(0xBF58476D1CE4E5B9);
+    x ^= x >> 27;
+    x *= UINT64_C(0x94D049BB133111EB);
+    x ^= x >> 31;
+    return x;
+}
+
+static inline uint64_t hash_int(int key) {
+    return mix64((uint64_t)(uint32_t)key + UINT64_C(0x9E3779B97F4A7C15));
+}
+
+uint64_t hash_bytes(const void *key, size_t key_size) {
+    const unsigned char *p = key;
+    uint64_t h = UINT64_C(0x9E3779B97F4A7C15) ^ ((uint64_t)key_size * UINT64_C(0xC2B2AE3D27D4EB4F));
+    size_t i = 0;
+    for (; i + 8 <= key_size; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, 8);
+        h = (h ^ mix64(word)) * UINT64_C(0x9FB21C651E98DF25);
+    }
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < key_size; i++, shift += 8) {
+        tail |= (uint64_t)p[i] << shift;
+    }
+    return mix64(h ^ tail);
+}
+
+bool keys_equal_bytes(const void *a, const void *b, size_t key_size) {
+    return memcmp(a, b, key_size) == 0;
+}
+
+static inline size_t hash_group(uint64_t hash) {
+    return (size_t)(hash >> 7);
+}
+
+static inline uint8_t hash_tag(uint64_t hash) {
+    return (uint8_t)(hash & 0x7F);
+}
+
+// ========================================
+// TABLE ENGINE
+// ========================================
+
+typedef struct {
+    size_t slot_size;
+    uint64_t (*hash)(const void *key, const void *context);
+    bool (*equal)(const void *slot_key, const void *key, const void *context);
+    const void *context;
+} TableOps;
+
+/**
+ * Max keys before growing: 7/8 of the capacity
+ */
+static size_t max_load(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+/**
+ * Smallest capacity (power of two, >= one group) holding 'count' keys
+ * Returns: 0 on overflow
+ */
+static size_t capacity_for(size_t count) {
+    size_t capacity = HASH_GROUP_WIDTH;
+    while (max_load(capacity) < count) {
+        if (capacity > SIZE_MAX / 2) {
+            return 0;
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static bool table_alloc(HashTable *t, size_t capacity, size_t slot_size) {
+    memset(t, 0, sizeof(*t));
+    if (capacity == 0 || capacity > SIZE_MAX / slot_size) {
+        return false;
+    }
+    t->ctrl = malloc(capacity);
+    t->slots = malloc(capacity * slot_size);
+    if (t->ctrl == NULL || t->slots == NULL) {
+        free(t->ctrl);
+        free(t->slots);
+        memset(t, 0, sizeof(*t));
+        return false;
+    }
+    memset(t->ctrl, CTRL_EMPTY, capacity);
+    t->capacity = capacity;
+    t->growth_left = max_load(capacity);
+    return true;
+}
+
+static void table_release(HashTable *t) {
+    free(t->ctrl);
+    free(t->slots);
+    memset(t, 0, sizeof(*t));
+}
+
+ENGINE unsigned char* table_slot(const HashTable *t, const TableOps *ops, size_t index) {
+    return t->slots + index * ops->slot_size;
+}
+
+/**
+ * Triangular probing over groups (+1, +2, +3, ...): with a power-of-two
+ * group count it visits every group exactly once
+ */
+typedef struct {
+    size_t group;
+    size_t step;
+    size_t mask;
+} Probe;
+
+ENGINE Probe probe_start(const HashTable *t, uint64_t hash) {
+    size_t mask = t->capacity / HASH_GROUP_WIDTH - 1;
+    Probe p = { hash_group(hash) & mask, 0, mask };
+    return p;
+}
+
+ENGINE void probe_next(Probe *p) {
+    p->step++;
+    p->group = (p->group + p->step) & p->mask;
+}
+
+ENGINE size_t table_find(const HashTable *t, const TableOps *ops, uint64_t hash, const void *key) {
+    if (t->capacity == 0) {
+        return NOT_FOUND;
+    }
+    uint8_t tag = hash_tag(hash);
+    Probe p = probe_start(t, hash);
+    for (;;) {
+        const uint8_t *ctrl = t->ctrl + p.group * HASH_GROUP_WIDTH;
+        for (GroupMask m = group_match(ctrl, tag); m != 0; m &= m - 1) {
+            size_t index = p.group * HASH_GROUP_WIDTH + mask_first_slot(m);
+            if (ops->equal(table_slot(t, ops, index), key, ops->context)) {
+                return index;
+            }
+        }
+        if (group_match(ctrl, CTRL_EMPTY) != 0) {
+            return NOT_FOUND;       // The key would have been placed here
+        }
+        probe_next(&p);
+    }
+}
+
+/**
+ * First EMPTY or DELETED slot on the key's probe path (the table always
+ * has at least 1/8 EMPTY slots, so this terminates)
+ */
+ENGINE size_t table_find_free(const HashTable *t, uint64_t hash) {
+    Probe p = probe_start(t, hash);
+    for (;;) {
+        GroupMask m = group_match_free(t->ctrl + p.group * HASH_GROUP_WIDTH);
+        if (m != 0) {
+            return p.group * HASH_GROUP_WIDTH + mask_first_slot(m);
+        }
+        probe_next(&p);
+    }
+}
+
+ENGINE void table_occupy(HashTable *t, size_t index, uint64_t hash) {
+    if (t->ctrl[index] == CTRL_EMPTY) {
+        t->growth_left--;
+    } else {
+        t->tombstones--;
+    }
+    t->ctrl[index] = hash_tag(hash);
+    t->size++;
+}
+
+/**
+ * Free a slot. If its group still has an EMPTY byte, no probe ever went
+ * past this group, so the slot can become EMPTY again instead of DELETED.
+ */
+static void table_erase(HashTable *t, size_t index) {
+    const uint8_t *group = t->ctrl + (index & ~(size_t)(HASH_GROUP_WIDTH - 1));
+    if (group_match(group, CTRL_EMPTY) != 0) {
+        t->ctrl[index] = CTRL_EMPTY;
+        t->growth_left++;
+    } else {
+        t->ctrl[index] = CTRL_DELETED;
+        t->tombstones++;
+    }
+    t->size--;
+}
+
+/**
+ * Copy every FULL slot of 'from' into 'to' (which has room)
+ */
+ENGINE void table_move_all(HashTable *to, HashTable *from, const TableOps *ops, size_t begin) {
+    for (size_t i = begin; i < from->capacity; i++) {
+        if (from->ctrl[i] & 0x80) {
+            continue;
+        }
+        const unsigned char *src = table_slot(from, ops, i);
+        uint64_t hash = ops->hash(src, ops->context);
+        size_t j = table_find_free(to, hash);
+        table_occupy(to, j, hash);
+        memcpy(table_slot(to, ops, j), src, ops->slot_size);
+    }
+}
+
+/**
+ * Move up to 'budget' slots of the old table into the current one; the
+ * old table is freed when it is empty. Moved slots are marked DELETED so
+ * a lookup that falls through to the old table cannot find a stale copy.
+ */
+ENGINE void store_migrate(HashStore *s, const TableOps *ops, size_t budget) {
+    HashTable *old = &s->old;
+    size_t end = old->capacity - s->migrate_next > budget ? s->migrate_next + budget : old->capacity;
+    for (size_t i = s->migrate_next; i < end; i++) {
+        if (old->ctrl[i] & 0x80) {
+            continue;
+        }
+        const unsigned char *src = table_slot(old, ops, i);
+        uint64_t hash = ops->hash(src, ops->context);
+        size_t j = table_find_free(&s->current, hash);
+        table_occupy(&s->current, j, hash);
+        memcpy(table_slot(&s->current, ops, j), src, ops->slot_size);
+        old->ctrl[i] = CTRL_DELETED;
+        old->size--;
+    }
+    s->migrate_next = end;
+    if (end == old->capacity) {
+        table_release(old);
+        s->migrate_next = 0;
+    }
+}
+
+/**
+ * Current table hit its load limit: start draining it into a new one,
+ * twice the size, or the same size when it is mostly tombstones
+ */
+static bool store_start_resize(HashStore *s, const TableOps *ops) {
+    TRACE_SCOPE("hash_map start_resize");
+    if (s->old.capacity != 0) {
+        store_migrate(s, ops, SIZE_MAX);
+    }
+    size_t capacity = s->current.capacity;
+    if (capacity == 0) {
+        capacity = HASH_GROUP_WIDTH;
+    } else if (s->current.size > capacity / 16 * 7) {
+        if (capacity > SIZE_MAX / 2) {
+            return false;
+        }
+        capacity *= 2;
+    }
+
+    HashTable next;
+    if (!table_alloc(&next, capacity, ops->slot_size)) {
+        return false;
+    }
+    if (s->current.size == 0) {
+        table_release(&s->current);
+    } else {
+        s->old = s->current;
+        s->migrate_next = 0;
+    }
+    s->current = next;
+    TRACE_COUNTER("hash_map capacity", capacity);
+    return true;
+}
+
+/**
+ * Rebuild at once into a table of at least 'capacity' slots
+ */
+static bool store_rehash(HashStore *s, const TableOps *ops, size_t capacity) {
+    TRACE_SCOPE("hash_map rehash");
+    HashTable next;
+    if (!table_alloc(&next, capacity, ops->slot_size)) {
+        return false;
+    }
+    if (s->old.capacity != 0) {
+        table_move_all(&next, &s->old, ops, s->migrate_next);
+        table_release(&s->old);
+        s->migrate_next = 0;
+    }
+    table_move_all(&next, &s->current, ops, 0);
+    table_release(&s->current);
+    s->current = next;
+    return true;
+}
+
+static bool store_reserve(HashStore *s, const TableOps *ops, size_t count) {
+    size_t size = s->current.size + s->old.size;
+    if (s->old.capacity == 0 && count <= size + s->current.growth_left) {
+        return true;
+    }
+    size_t capacity = capacity_for(count > size ? count : size);
+    if (capacity == 0) {
+        return false;
+    }
+    if (capacity < s->current.capacity) {
+        capacity = s->current.capacity;
+    }
+    return store_rehash(s, ops, capacity);
+}
+
+static void store_free(HashStore *s) {
+    table_release(&s->current);
+    table_release(&s->old);
+    s->migrate_next = 0;
+}
+
+/**
+ * Slot for 'key': the existing one, or a newly claimed one (*inserted).
+ * The caller writes the key / value into it.
+ * Returns: NULL on allocation failure
+ */
+ENGINE unsigned char* store_put(HashStore *s, const TableOps *ops, uint64_t hash,
+                                const void *key, bool *inserted) {
+    if (s->old.capacity != 0) {
+        store_migrate(s, ops, HASH_MIGRATE_SLOTS);
+    }
+    size_t index = table_find(&s->current, ops, hash, key);
+    if (index != NOT_FOUND) {
+        *inserted = false;
+        return table_slot(&s->current, ops, index);
+    }
+    if (s->old.capacity != 0) {
+        index = table_find(&s->old, ops, hash, key);
+        if (index != NOT_FOUND) {
+            *inserted = false;
+            return table_slot(&s->old, ops, index);
+        }
+    }
+
+    index = s->current.capacity != 0 ? table_find_free(&s->current, hash) : NOT_FOUND;
+    if (index == NOT_FOUND || (s->current.ctrl[index] == CTRL_EMPTY && s->current.growth_left == 0)) {
+        if (!store_start_resize(s, ops)) {
+            return NULL;
+        }
+        index = table_find_free(&s->current, hash);
+    }
+    table_occupy(&s->current, index, hash);
+    *inserted = true;
+    return table_slot(&s->current, ops, index);
+}
+
+ENGINE const unsigned char* store_get(const HashStore *s, const TableOps *ops, uint64_t hash,
+                                      const void *key) {
+    size_t index = table_find(&s->current, ops, hash, key);
+    if (index != NOT_FOUND) {
+        return table_slot(&s->current, ops, index);
+    }
+    if (s->old.capacity != 0) {
+        index = table_find(&s->old, ops, hash, key);
+        if (index != NOT_FOUND) {
+            return table_slot(&s->old, ops, index);
+        }
+    }
+    return NULL;
+}
+
+ENGINE bool store_remove(HashStore *s, const TableOps *ops, uint64_t hash, const void *key) {
+    if (s->old.capacity != 0) {
+        store_migrate(s, ops, HASH_MIGRATE_SLOTS);
+    }
+    size_t index = table_find(&s->current, ops, hash, key);
+    if (index != NOT_FOUND) {
+        table_erase(&s->current, index);
+        return true;
+    }
+    if (s->old.capacity != 0) {
+        index = table_find(&s->old, ops, hash, key);
+        if (index != NOT_FOUND) {
+            table_erase(&s->old, index);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Start loading the group (and first slots) a hash maps to
+ */
+ENGINE void store_prefetch(const HashStore *s, const TableOps *ops, uint64_t hash) {
+    const HashTable *t = &s->current;
+    if (t->capacity != 0) {
+        size_t group = hash_group(hash) & (t->capacity / HASH_GROUP_WIDTH - 1);
+        PREFETCH(t->ctrl + group * HASH_GROUP_WIDTH);
+        PREFETCH(table_slot(t, ops, group * HASH_GROUP_WIDTH));
+    }
+}
+
+// ========================================
+// INT KEYS
+// ========================================
+
+static uint64_t int_ops_hash(const void *key, const void *context) {
+    (void)context;
+    return hash_int(*(const int*)key);
+}
+
+static bool int_ops_equal(const void *slot_key, const void *key, const void *context) {
+    (void)context;
+    return *(const int*)slot_key == *(const int*)key;
+}
+
+static const TableOps INT_OPS = { sizeof(IntHashEntry), int_ops_hash, int_ops_equal, NULL };
+
+bool int_hash_map_init(IntHashMap *map, size_t expected) {
+    memset(map, 0, sizeof(*map));
+    return expected == 0 || int_hash_map_reserve(map, expected);
+}
+
+void int_hash_map_free(IntHashMap *map) {
+    store_free(&map->store);
+}
+
+bool int_hash_map_reserve(IntHashMap *map, size_t count) {
+    return store_reserve(&map->store, &INT_OPS, count);
+}
+
+static inline bool int_put_hashed(IntHashMap *map, uint64_t hash, int key, int value, bool *inserted) {
+    bool is_new;
+    IntHashEntry *entry = (IntHashEntry*)store_put(&map->store, &INT_OPS, hash, &key, &is_new);
+    if (entry == NULL) {
+        return false;
+    }
+    entry->key = key;
+    entry->value = value;
+    if (inserted != NULL) {
+        *inserted = is_new;
+    }
+    return true;
+}
+
+bool int_hash_map_put(IntHashMap *map, int key, int value, bool *inserted) {
+    return int_put_hashed(map, hash_int(key), key, value, inserted);
+}
+
+static inline bool int_get_hashed(const IntHashMap *map, uint64_t hash, int key, int *value) {
+    const IntHashEntry *entry = (const IntHashEntry*)store_get(&map->store, &INT_OPS, hash, &key);
+    if (entry == NULL) {
+        return false;
+    }
+    if (value != NULL) {
+        *value = entry->value;
+    }
+    return true;
+}
+
+bool int_hash_map_get(const IntHashMap *map, int key, int *value) {
+    return int_get_hashed(map, hash_int(key), key, value);
+}
+
+bool int_hash_map_remove(IntHashMap *map, int key) {
+    return store_remove(&map->store, &INT_OPS, hash_int(key), &key);
+}
+
+bool int_hash_map_put_bulk(IntHashMap *map, const int *keys, const int *values, size_t n) {
+    TRACE_SCOPE("int_hash_map_put_bulk");
+    size_t size = int_hash_map_size(map);
+    if (n > SIZE_MAX - size || !int_hash_map_reserve(map, size + n)) {
+        return false;
+    }
+    uint64_t hashes[HASH_BULK_BATCH];
+    for (size_t start = 0; start < n; start += HASH_BULK_BATCH) {
+        size_t count = n - start < HASH_BULK_BATCH ? n - start : HASH_BULK_BATCH;
+        for (size_t i = 0; i < count; i++) {
+            hashes[i] = hash_int(keys[start + i]);
+            store_prefetch(&map->store, &INT_OPS, hashes[i]);
+        }
+        for (size_t i = 0; i < count; i++) {
+            int value = values != NULL ? values[start + i] : (int)(start + i);
+            if (!int_put_hashed(map, hashes[i], keys[start + i], value, NULL)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t int_hash_map_get_bulk(const IntHashMap *map, const int *keys, size_t n, int *values) {
+    TRACE_SCOPE("int_hash_map_get_bulk");
+    size_t found = 0;
+    uint64_t hashes[HASH_BULK_BATCH];
+    for (size_t start = 0; start < n; start += HASH_BULK_BATCH) {
+        size_t count = n - start < HASH_BULK_BATCH ? n - start : HASH_BULK_BATCH;
+        for (size_t i = 0; i < count; i++) {
+            hashes[i] = hash_int(keys[start + i]);
+            store_prefetch(&map->store, &INT_OPS, hashes[i]);
+        }
+        for (size_t i = 0; i < count; i++) {
+            int value = -1;
+            if (int_get_hashed(map, hashes[i], keys[start + i], &value)) {
+                found++;
+            }
+            if (values != NULL) {
+                values[start + i] = value;
+            }
+        }
+    }
+    return found;
+}
+
+// ========================================
+// GENERIC KEYS
+// ========================================
+
+static uint64_t generic_ops_hash(const void *key, const void *context) {
+    const HashMap *map = context;
+    return map->hash(key, map->key_size);
+}
+
+static bool generic_ops_equal(const void *slot_key, const void *key, const void *context) {
+    const HashMap *map = context;
+    return map->equal(slot_key, key, map->key_size);
+}
+
+static inline TableOps generic_ops(const HashMap *map) {
+    TableOps ops = { map->slot_size, generic_ops_hash, generic_ops_equal, map };
+    return ops;
+}
+
+static size_t round_up(size_t n, size_t multiple) {
+    return (n + multiple - 1) / multiple * multiple;
+}
+
+bool hash_map_init(HashMap *map, size_t key_size, size_t value_size,
+                   HashFunction hash, KeyEqualFunction equal, size_t expected) {
+    memset(map, 0, sizeof(*map));
+    if (key_size == 0 || key_size > SIZE_MAX / 4 || value_size > SIZE_MAX / 4) {
+        return false;
+    }
+    map->key_size = key_size;
+    map->value_size = value_size;
+    map->value_offset = round_up(key_size, VALUE_ALIGN);
+    map->slot_size = round_up(map->value_offset + value_size, VALUE_ALIGN);
+    map->hash = hash != NULL ? hash : hash_bytes;
+    map->equal = equal != NULL ? equal : keys_equal_bytes;
+    return expected == 0 || hash_map_reserve(map, expected);
+}
+
+void hash_map_free(HashMap *map) {
+    store_free(&map->store);
+}
+
+bool hash_map_reserve(HashMap *map, size_t count) {
+    TableOps ops = generic_ops(map);
+    return store_reserve(&map->store, &ops, count);
+}
+
+bool hash_map_put(HashMap *map, const void *key, const void *value, bool *inserted) {
+    TableOps ops = generic_ops(map);
+    bool is_new;
+    unsigned char *slot = store_put(&map->store, &ops, map->hash(key, map->key_size), key, &is_new);
+    if (slot == NULL) {
+        return false;
+    }
+    if (is_new) {
+        memcpy(slot, key, map->key_size);
+    }
+    if (value != NULL) {
+        memcpy(slot + map->value_offset, value, map->value_size);
+    } else {
+        memset(slot + map->value_offset, 0, map->value_size);
+    }
+    if (inserted != NULL) {
+        *inserted = is_new;
+    }
+    return true;
+}
+
+void* hash_map_get(const HashMap *map, const void *key) {
+    TableOps ops = generic_ops(map);
+    const unsigned char *slot = store_get(&map->store, &ops, map->hash(key, map->key_size), key);
+    return slot != NULL ? (void*)(slot + map->value_offset) : NULL;
+}
+
+bool hash_map_remove(HashMap *map, const void *key) {
+    TableOps ops = generic_ops(map);
+    return store_remove(&map->store, &ops, map->hash(key, map->key_size), key);
+}
@@ -0,0 +1,192 @@
+/**
+ * hash_map.h - Open-Addressing Hash Maps (SwissTable-Style Probing)
+ *
+ * searching.c finds a key in O(n) (linear) or O(log n) (sorted array).
+ * A hash map answers "is this key present, and what is its value?" in
+ * O(1) expected time, with no sorting:
+ * - IntHashMap: int keys -> int values (the fast, specialized table)
+ * - HashMap:    fixed-size keys and values of any type, with a caller
+ *               hash / equality (or bytewise ones)
+ *
+ * Layout (both maps):
+ *   ctrl:  [tag][tag][EMPTY][tag][DELETED] ...   1 byte per slot
+ *   slots: [k,v][k,v][     ][k,v][       ] ...   key + value per slot
+ *
+ * A key's hash picks a GROUP of 16 slots (h1) and a 7-bit tag (h2). One
+ * SSE2 / NEON compare tests all 16 control bytes of a group against the
+ * tag at once, so a lookup usually reads one 16-byte ctrl group and one
+ * slot: about 1-2 cache misses, whatever the table size. Groups are
+ * probed in triangular order until one contains an EMPTY byte.
+ *
+ * Growth:
+ * - Maximum load 7/8. At that point a table twice the size is allocated
+ *   and the old one is drained INCREMENTALLY: every put / remove moves
+ *   HASH_MIGRATE_SLOTS old slots, so no single insert pays for a full
+ *   rehash. Lookups check both tables until the old one is empty.
+ * - Tables full of DELETED markers are rebuilt at the same size.
+ * - *_reserve / *_put_bulk size the table once up front instead.
+ *
+ * Memory Implications:
+ * - (1 + slot size) bytes per slot, at least 8/7 slots per key
+ *   (IntHashMap: 9 bytes per slot, ~10-20 bytes per key)
+ * - During an incremental resize both tables are live (~3x briefly)
+ *
+ * NOT THREAD-SAFE: concurrent readers are fine only while nobody writes.
+ */
+
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HASH_GROUP_WIDTH 16             // Slots per probed group (one SSE2 compare)
+#define HASH_MIGRATE_SLOTS 32           // Old slots moved per put / remove while resizing
+#define HASH_BULK_BATCH 16              // Keys hashed and prefetched ahead in bulk calls
+
+/**
+ * One table: control bytes plus slots
+ */
+typedef struct {
+    uint8_t *ctrl;                      // capacity control bytes
+    unsigned char *slots;               // capacity * slot_size bytes
+    size_t capacity;                    // 0 or a power of two >= HASH_GROUP_WIDTH
+    size_t size;                        // Live keys
+    size_t tombstones;                  // DELETED control bytes
+    size_t growth_left;                 // EMPTY slots usable before the 7/8 limit
+} HashTable;
+
+/**
+ * The current table and, while resizing, the old table being drained
+ */
+typedef struct {
+    HashTable current;                  // Receives every new key
+    HashTable old;                      // Capacity 0 when not resizing
+    size_t migrate_next;                // Next slot of 'old' to move
+} HashStore;
+
+typedef struct {
+    int key;
+    int value;
+} IntHashEntry;
+
+typedef struct {
+    HashStore store;                    // Slots are IntHashEntry
+} IntHashMap;
+
+typedef uint64_t (*HashFunction)(const void *key, size_t key_size);
+typedef bool (*KeyEqualFunction)(const void *a, const void *b, size_t key_size);
+
+typedef struct {
+    HashStore store;                    // Slots are key, padding, value
+    size_t key_size;
+    size_t value_size;
+    size_t value_offset;                // Value position in a slot (8-byte aligned)
+    size_t slot_size;
+    HashFunction hash;
+    KeyEqualFunction equal;
+} HashMap;
+
+// ========================================
+// INT KEYS
+// ========================================
+
+/**
+ * Empty map sized for 'expected' keys without resizing (0 = allocate
+ * on first insert)
+ * Returns: false on allocation failure
+ */
+bool int_hash_map_init(IntHashMap *map, size_t expected);
+void int_hash_map_free(IntHashMap *map);
+
+/**
+ * Make room for 'count' keys in total (finishes any incremental resize)
+ * Returns: false on allocation failure (map unchanged)
+ */
+bool int_hash_map_reserve(IntHashMap *map, size_t count);
+
+/**
+ * Insert key -> value, or overwrite the value if the key exists.
+ * *inserted (may be NULL) tells which happened: a dedup stage keeps the
+ * keys for which it is true.
+ * Returns: false on allocation failure (map unchanged)
+ *
+ * Time Complexity: O(1) expected, O(HASH_MIGRATE_SLOTS) while resizing
+ */
+bool int_hash_map_put(IntHashMap *map, int key, int value, bool *inserted);
+
+/**
+ * Look up a key; *value (may be NULL) receives its value
+ * Returns: true if present
+ */
+bool int_hash_map_get(const IntHashMap *map, int key, int *value);
+
+static inline bool int_hash_map_contains(const IntHashMap *map, int key) {
+    return int_hash_map_get(map, key, NULL);
+}
+
+/**
+ * Returns: true if the key was present (and is now removed)
+ */
+bool int_hash_map_remove(IntHashMap *map, int key);
+
+static inline size_t int_hash_map_size(const IntHashMap *map) {
+    return map->store.current.size + map->store.old.size;
+}
+
+/**
+ * Insert n keys (values[i], or i when values is NULL): reserves once,
+ * then hashes HASH_BULK_BATCH keys ahead and prefetches their groups so
+ * the cache misses overlap
+ * Returns: false on allocation failure (keys before it are inserted)
+ */
+bool int_hash_map_put_bulk(IntHashMap *map, const int *keys, const int *values, size_t n);
+
+/**
+ * Look up n keys with the same prefetching. values[i] gets the value of
+ * keys[i] or -1 when absent (values may be NULL).
+ * Returns: number of keys found
+ */
+size_t int_hash_map_get_bulk(const IntHashMap *map, const int *keys, size_t n, int *values);
+
+// ========================================
+// GENERIC KEYS
+// ========================================
+
+/**
+ * Bytewise defaults (used when hash / equal are NULL)
+ */
+uint64_t hash_bytes(const void *key, size_t key_size);
+bool keys_equal_bytes(const void *a, const void *b, size_t key_size);
+
+/**
+ * Map from key_size-byte keys to value_size-byte values. Keys and values
+ * are copied in; padding bytes in a struct key must be zeroed when the
+ * bytewise defaults are used.
+ * Returns: false on allocation failure or key_size == 0
+ */
+bool hash_map_init(HashMap *map, size_t key_size, size_t value_size,
+                   HashFunction hash, KeyEqualFunction equal, size_t expected);
+void hash_map_free(HashMap *map);
+bool hash_map_reserve(HashMap *map, size_t count);
+
+/**
+ * Insert or overwrite (value may be NULL for a zeroed value)
+ * Returns: false on allocation failure
+ */
+bool hash_map_put(HashMap *map, const void *key, const void *value, bool *inserted);
+
+/**
+ * Returns: pointer to the stored value (8-byte aligned, valid until the
+ *          next put / remove), or NULL if the key is absent
+ */
+void* hash_map_get(const HashMap *map, const void *key);
+
+bool hash_map_remove(HashMap *map, const void *key);
+
+static inline size_t hash_map_size(const HashMap *map) {
+    return map->store.current.size + map->store.old.size;
+}
+
+#endif // HASH_MAP_H
@@ -7,16 +7,59 @@
  * 
  * Demonstrates the importance of data organization for
  * algorithm efficiency.
+ * 
+ * High-throughput kernels:
+ * 3. Branchless Binary Search - Conditional move instead of a branch,
+ *    plus software prefetch of both possible next midpoints
+ * 4. Eytzinger Search - Array stored in BFS (heap) order so the next
+ *    16 levels' candidates sit in a few cache lines
+ * 5. SIMD Linear Search - AVX2/SSE2/NEON compare 8-16 ints per step
+ * 6. Batched Binary Search - Many keys searched in lockstep so their
+ *    cache misses overlap instead of queueing one after another
+ * 7. Static S-Tree Index - Build-once B+tree with 64-byte nodes:
+ *    lower_bound / upper_bound / range in 3-4 cache misses
+ * 8. Hash Map (hash_map.c) - Open addressing with 16-slot SIMD groups:
+ *    O(1) membership for unsorted keys, incremental resize, bulk insert
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include "hash_map.h"
+#include "trace.h"
+#include "output_writer.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr) ((void)(addr))
+#endif
+
 #define ARRAY_SIZE 15
+#define BENCH_TABLE_SIZE (1 << 22)    // 4M ints = 16MB: larger than most L2/L3 slices
+#define BENCH_LOOKUPS 2000000
+#define BENCH_LINEAR_SIZE 100000
+#define SEARCH_BATCH_GROUP 16         // Keys in flight: roughly the CPU's miss buffers (10-20)
+#define STREE_B 16                    // Keys per node: 16 ints = one 64-byte cache line
+#define STREE_FANOUT (STREE_B + 1)    // Children per internal node
+#define STREE_MAX_HEIGHT 8            // 17^8 > 2^31 keys
+#define CACHE_LINE_SIZE 64
 
 // Function declarations
 void print_array(const char* label, int arr[], int size);
@@ -24,6 +67,45 @@ int linear_search(int arr[], int size, int target);
 int binary_search(int arr[], int size, int target);
 int binary_search_recursive(int arr[], int left, int right, int target);
 void print_search_result(const char* algorithm, int result, int target);
+int binary_search_branchless(const int arr[], int size, int target);
+int linear_search_simd(const int arr[], int size, int target);
+void binary_search_batch(const int *arr, int size, const int *keys, int nkeys, int *out);
+
+/**
+ * Sorted array re-laid out in Eytzinger (BFS) order
+ * keys[1..size] hold the tree, rank[k] maps back to the sorted index
+ */
+typedef struct {
+    int *keys;
+    int *rank;
+    int size;
+} EytzingerIndex;
+
+bool eytzinger_init(EytzingerIndex *index, const int sorted[], int size);
+int eytzinger_search(const EytzingerIndex *index, int target);
+void eytzinger_free(EytzingerIndex *index);
+
+/**
+ * Static B+tree (S-tree) over a sorted array
+ * Every node is one cache line of STREE_B keys. The leaf layer holds
+ * the sorted array itself (padded with INT_MAX), so a leaf position is
+ * directly an index into the original array. Internal nodes hold the
+ * minimum key of children 1..16. Layers are stored root first.
+ */
+typedef struct {
+    int *nodes;                             // All layers, cache-line aligned
+    void *storage;                          // Unaligned block behind 'nodes'
+    int layer_offset[STREE_MAX_HEIGHT];     // First node of each layer (0 = root)
+    int height;                             // Layers, including the leaves
+    int size;
+} StaticIndex;
+
+bool static_index_init(StaticIndex *index, const int sorted[], int size);
+int static_index_lower_bound(const StaticIndex *index, int key);
+int static_index_upper_bound(const StaticIndex *index, int key);
+int static_index_range(const StaticIndex *index, int low, int high, int *first);
+int static_index_search(const StaticIndex *index, int key);
+void static_index_free(StaticIndex *index);
 
 int main(void) {
 #ifdef _WIN32
@@ -126,27 +208,279 @@ int main(void) {
     printf("  • Time:  O(log n)  - Same as iterative\n");
     printf("  • Space: O(log n)  - Recursive call stack\n\n");
     
+    // ==========================================
+    // 4. HIGH-THROUGHPUT SEARCH KERNELS
+    // ==========================================
+    printf("========================================\n");
+    printf("4. HIGH-THROUGHPUT SEARCH KERNELS\n");
+    printf("========================================\n");
+    printf("Algorithm: Same answers, organized for the CPU:\n");
+    printf("           no mispredicted branches, fewer cache misses\n\n");
+    
+    EytzingerIndex small_index;
+    bool have_small_index = eytzinger_init(&small_index, sorted, ARRAY_SIZE);
+    printf("Search results:\n");
+    for (int i = 0; i < num_targets; i++) {
+        print_search_result("Branchless", binary_search_branchless(sorted, ARRAY_SIZE, targets[i]), targets[i]);
+        if (have_small_index) {
+            print_search_result("Eytzinger ", eytzinger_search(&small_index, targets[i]), targets[i]);
+        }
+        print_search_result("SIMD linear", linear_search_simd(unsorted, ARRAY_SIZE, targets[i]), targets[i]);
+    }
+    if (have_small_index) {
+        eytzinger_free(&small_index);
+    }
+    
+    // Throughput on a table that does not fit in cache
+    int *table = malloc(BENCH_TABLE_SIZE * sizeof(int));
+    int *queries = malloc(BENCH_LOOKUPS * sizeof(int));
+    if (table != NULL && queries != NULL) {
+        for (int i = 0; i < BENCH_TABLE_SIZE; i++) {
+            table[i] = 2 * i;   // Even keys: odd queries miss
+        }
+        srand(7);
+        for (int i = 0; i < BENCH_LOOKUPS; i++) {
+            queries[i] = (int)(((unsigned)rand() << 15 ^ (unsigned)rand()) % (2u * BENCH_TABLE_SIZE));
+        }
+        
+        printf("\n%d lookups in a %d-element (%d MB) sorted table:\n",
+               BENCH_LOOKUPS, BENCH_TABLE_SIZE, (int)(BENCH_TABLE_SIZE * sizeof(int) >> 20));
+        
+        long long checksum = 0;
+        clock_t start = clock();
+        for (int i = 0; i < BENCH_LOOKUPS; i++) {
+            checksum += binary_search(table, BENCH_TABLE_SIZE, queries[i]);
+        }
+        double t_binary = (double)(clock() - start) / CLOCKS_PER_SEC;
+        
+        long long checksum_bl = 0;
+        start = clock();
+        for (int i = 0; i < BENCH_LOOKUPS; i++) {
+            checksum_bl += binary_search_branchless(table, BENCH_TABLE_SIZE, queries[i]);
+        }
+        double t_branchless = (double)(clock() - start) / CLOCKS_PER_SEC;
+        
+        printf("  binary_search:            %6.1f ns/lookup\n", t_binary * 1e9 / BENCH_LOOKUPS);
+        printf("  binary_search_branchless: %6.1f ns/lookup %s\n", t_branchless * 1e9 / BENCH_LOOKUPS,
+               checksum_bl == checksum ? "✓ Same results" : "✗ Mismatch");
+        
+        EytzingerIndex index;
+        if (eytzinger_init(&index, table, BENCH_TABLE_SIZE)) {
+            long long checksum_ey = 0;
+            start = clock();
+            for (int i = 0; i < BENCH_LOOKUPS; i++) {
+                checksum_ey += eytzinger_search(&index, queries[i]);
+            }
+            double t_eytzinger = (double)(clock() - start) / CLOCKS_PER_SEC;
+            printf("  eytzinger_search:         %6.1f ns/lookup %s\n", t_eytzinger * 1e9 / BENCH_LOOKUPS,
+                   checksum_ey == checksum ? "✓ Same results" : "✗ Mismatch");
+            eytzinger_free(&index);
+        }
+        
+        int *results = malloc(BENCH_LOOKUPS * sizeof(int));
+        if (results != NULL) {
+            start = clock();
+            binary_search_batch(table, BENCH_TABLE_SIZE, queries, BENCH_LOOKUPS, results);
+            double t_batch = (double)(clock() - start) / CLOCKS_PER_SEC;
+            long long checksum_batch = 0;
+            for (int i = 0; i < BENCH_LOOKUPS; i++) {
+                checksum_batch += results[i];
+            }
+            printf("  binary_search_batch:      %6.1f ns/lookup %s\n", t_batch * 1e9 / BENCH_LOOKUPS,
+                   checksum_batch == checksum ? "✓ Same results" : "✗ Mismatch");
+            free(results);
+        }
+        
+        StaticIndex stree;
+        if (static_index_init(&stree, table, BENCH_TABLE_SIZE)) {
+            long long checksum_st = 0;
+            start = clock();
+            for (int i = 0; i < BENCH_LOOKUPS; i++) {
+                checksum_st += static_index_search(&stree, queries[i]);
+            }
+            double t_stree = (double)(clock() - start) / CLOCKS_PER_SEC;
+            printf("  static_index_search:      %6.1f ns/lookup %s (%d levels)\n",
+                   t_stree * 1e9 / BENCH_LOOKUPS,
+                   checksum_st == checksum ? "✓ Same results" : "✗ Mismatch", stree.height);
+            static_index_free(&stree);
+        }
+        
+        // Hash map: value = index, so a miss leaves -1 like binary_search
+        IntHashMap map;
+        int *found = malloc(BENCH_LOOKUPS * sizeof(int));
+        if (found != NULL && int_hash_map_init(&map, 0)) {
+            start = clock();
+            bool built = int_hash_map_put_bulk(&map, table, NULL, BENCH_TABLE_SIZE);
+            double t_build = (double)(clock() - start) / CLOCKS_PER_SEC;
+            if (built) {
+                long long checksum_hm = 0;
+                start = clock();
+                for (int i = 0; i < BENCH_LOOKUPS; i++) {
+                    int index = -1;
+                    int_hash_map_get(&map, queries[i], &index);
+                    checksum_hm += index;
+                }
+                double t_hash = (double)(clock() - start) / CLOCKS_PER_SEC;
+                
+                start = clock();
+                int_hash_map_get_bulk(&map, queries, BENCH_LOOKUPS, found);
+                double t_hash_bulk = (double)(clock() - start) / CLOCKS_PER_SEC;
+                long long checksum_hb = 0;
+                for (int i = 0; i < BENCH_LOOKUPS; i++) {
+                    checksum_hb += found[i];
+                }
+                printf("  int_hash_map_get:         %6.1f ns/lookup %s\n", t_hash * 1e9 / BENCH_LOOKUPS,
+                       checksum_hm == checksum ? "✓ Same results" : "✗ Mismatch");
+                printf("  int_hash_map_get_bulk:    %6.1f ns/lookup %s (built in %.0f ms)\n",
+                       t_hash_bulk * 1e9 / BENCH_LOOKUPS,
+                       checksum_hb == checksum ? "✓ Same results" : "✗ Mismatch", t_build * 1e3);
+            }
+            int_hash_map_free(&map);
+        }
+        free(found);
+        
+        // Linear scans: unsorted data, fewer lookups
+        int scans = 2000;
+        long long checksum_lin = 0, checksum_simd = 0;
+        start = clock();
+        for (int i = 0; i < scans; i++) {
+            checksum_lin += linear_search(table, BENCH_LINEAR_SIZE, queries[i] % (2 * BENCH_LINEAR_SIZE));
+        }
+        double t_linear = (double)(clock() - start) / CLOCKS_PER_SEC;
+        start = clock();
+        for (int i = 0; i < scans; i++) {
+            checksum_simd += linear_search_simd(table, BENCH_LINEAR_SIZE, queries[i] % (2 * BENCH_LINEAR_SIZE));
+        }
+        double t_simd = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("\n%d linear scans over %d elements:\n", scans, BENCH_LINEAR_SIZE);
+        printf("  linear_search:            %6.2f elements/ns\n",
+               (double)scans * BENCH_LINEAR_SIZE / 2 / (t_linear * 1e9 + 1));
+        printf("  linear_search_simd:       %6.2f elements/ns %s\n",
+               (double)scans * BENCH_LINEAR_SIZE / 2 / (t_simd * 1e9 + 1),
+               checksum_simd == checksum_lin ? "✓ Same results" : "✗ Mismatch");
+    }
+    free(table);
+    free(queries);
+    printf("\n");
+    
+    // ==========================================
+    // 5. STATIC S-TREE INDEX
+    // ==========================================
+    printf("========================================\n");
+    printf("5. STATIC S-TREE INDEX\n");
+    printf("========================================\n");
+    printf("Algorithm: Build a B+tree once, query it many times\n");
+    printf("           One 64-byte node per level, SIMD node search\n\n");
+    
+    int with_duplicates[] = {11, 12, 22, 22, 22, 32, 34, 45, 45, 56, 64, 67, 78, 88, 90};
+    print_array("Sorted (duplicates)", with_duplicates, ARRAY_SIZE);
+    StaticIndex index;
+    if (static_index_init(&index, with_duplicates, ARRAY_SIZE)) {
+        int probes[] = {22, 45, 10, 91, 50};
+        for (int i = 0; i < 5; i++) {
+            printf("  key %2d: lower_bound = %2d, upper_bound = %2d\n", probes[i],
+                   static_index_lower_bound(&index, probes[i]),
+                   static_index_upper_bound(&index, probes[i]));
+        }
+        int first;
+        int count = static_index_range(&index, 20, 50, &first);
+        printf("  range [20, 50]: %d keys starting at index %d\n", count, first);
+        static_index_free(&index);
+    }
+    printf("\n");
+    
+    // ==========================================
+    // 6. HASH MAP
+    // ==========================================
+    printf("========================================\n");
+    printf("6. HASH MAP (Open Addressing)\n");
+    printf("========================================\n");
+    printf("Algorithm: hash(key) picks a group of 16 slots; one SIMD\n");
+    printf("           compare checks all 16 tags. No sorting needed\n\n");
+    
+    IntHashMap positions;
+    if (int_hash_map_init(&positions, ARRAY_SIZE) &&
+        int_hash_map_put_bulk(&positions, unsorted, NULL, ARRAY_SIZE)) {
+        print_array("Array (unsorted)", unsorted, ARRAY_SIZE);
+        printf("Search results:\n");
+        for (int i = 0; i < num_targets; i++) {
+            int position = -1;
+            int_hash_map_get(&positions, targets[i], &position);
+            print_search_result("Hash map", position, targets[i]);
+        }
+    }
+    int_hash_map_free(&positions);
+    
+    // Dedup: keep a key the first time put() reports it as new
+    int stream[] = {7, 3, 7, 9, 3, 3, 12, 9, 7, 1};
+    int stream_size = (int)(sizeof(stream) / sizeof(stream[0]));
+    IntHashMap seen;
+    int_hash_map_init(&seen, 0);
+    printf("\nDedup of {7, 3, 7, 9, 3, 3, 12, 9, 7, 1}: ");
+    for (int i = 0; i < stream_size; i++) {
+        bool inserted = false;
+        if (int_hash_map_put(&seen, stream[i], i, &inserted) && inserted) {
+            printf("%d ", stream[i]);
+        }
+    }
+    printf("(%zu unique)\n", int_hash_map_size(&seen));
+    
+    // Growth: the old table drains a few slots per insert
+    printf("Incremental resize while inserting 0..199:\n");
+    for (int key = 0; key < 200; key++) {
+        int_hash_map_put(&seen, 1000 + key, key, NULL);
+        if (seen.store.old.capacity != 0 && seen.store.migrate_next == HASH_MIGRATE_SLOTS) {
+            printf("  at %3zu keys: new table %3zu slots, draining old %3zu slots\n",
+                   int_hash_map_size(&seen), seen.store.current.capacity, seen.store.old.capacity);
+        }
+    }
+    int_hash_map_free(&seen);
+    
+    // Generic keys: fixed 16-byte strings -> counts
+    const char *words[] = {"apple", "pear", "apple", "fig", "pear", "apple"};
+    HashMap counts;
+    if (hash_map_init(&counts, 16, sizeof(int), NULL, NULL, 0)) {
+        for (int i = 0; i < 6; i++) {
+            char key[16] = {0};             // Zero padding: keys hash bytewise
+            strncpy(key, words[i], sizeof(key) - 1);
+            int *count = hash_map_get(&counts, key);
+            int next = count != NULL ? *count + 1 : 1;
+            hash_map_put(&counts, key, &next, NULL);
+        }
+        char apple[16] = "apple";
+        int *apples = hash_map_get(&counts, apple);
+        printf("Word counts: %zu distinct words, \"apple\" x %d\n",
+               hash_map_size(&counts), apples != NULL ? *apples : 0);
+        hash_map_free(&counts);
+    }
+    
+    printf("\nComplexity:\n");
+    printf("  • Average: O(1)  - One group probe, usually one slot compared\n");
+    printf("  • Worst:   O(n)  - Only with a broken hash function\n");
+    printf("  • Space:   O(n)  - ~9 bytes per slot, load factor <= 7/8\n\n");
+    
     // ==========================================
     // COMPARISON
     // ==========================================
     printf("========================================\n");
-    printf("LINEAR vs BINARY SEARCH COMPARISON\n");
+    printf("LINEAR vs BINARY SEARCH vs HASH MAP\n");
     printf("========================================\n\n");
     
-    printf("┌─────────────┬──────────────┬──────────────┐\n");
-    printf("│ Aspect      │ Linear       │ Binary       │\n");
-    printf("├─────────────┼──────────────┼──────────────┤\n");
-    printf("│ Time (Avg)  │ O(n)         │ O(log n)     │\n");
-    printf("│ Space       │ O(1)         │ O(1)*        │\n");
-    printf("│ Sorted?     │ No           │ Yes (MUST)   │\n");
-    printf("│ Data Type   │ Any          │ Array        │\n");
-    printf("│ Best For    │ Small/Unsort │ Large/Sorted │\n");
-    printf("└─────────────┴──────────────┴──────────────┘\n");
+    printf("┌─────────────┬──────────────┬──────────────┬──────────────┐\n");
+    printf("│ Aspect      │ Linear       │ Binary       │ Hash map     │\n");
+    printf("├─────────────┼──────────────┼──────────────┼──────────────┤\n");
+    printf("│ Time (Avg)  │ O(n)         │ O(log n)     │ O(1)         │\n");
+    printf("│ Space       │ O(1)         │ O(1)*        │ O(n) extra   │\n");
+    printf("│ Sorted?     │ No           │ Yes (MUST)   │ No           │\n");
+    printf("│ Data Type   │ Any          │ Array        │ Hashable key │\n");
+    printf("│ Best For    │ Small/Unsort │ Large/Sorted │ Membership   │\n");
+    printf("└─────────────┴──────────────┴──────────────┴──────────────┘\n");
     printf("* O(log n) for recursive version\n\n");
     
     printf("Example: Searching in 1,000,000 elements\n");
     printf("  • Linear Search: ~500,000 comparisons (average)\n");
-    printf("  • Binary Search: ~20 comparisons (log₂ 1,000,000)\n\n");
+    printf("  • Binary Search: ~20 comparisons (log₂ 1,000,000)\n");
+    printf("  • Hash Map:      ~1 group probe (16 tags in one compare)\n\n");
     
     printf("========================================\n");
     printf("     ALL SEARCHES COMPLETED            \n");
@@ -157,19 +491,18 @@ int main(void) {
 
 /**
  * Print array with optional label
+ * (one buffered write via output_writer.h, not a printf per element)
  */
 void print_array(const char* label, int arr[], int size) {
+    OutputWriter *out = output_stdout();
     if (label[0] != '\0') {
-        printf("%s: ", label);
-    }
-    printf("[");
-    for (int i = 0; i < size; i++) {
-        printf("%d", arr[i]);
-        if (i < size - 1) {
-            printf(", ");
-        }
+        output_write_str(out, label);
+        output_write_str(out, ": ");
     }
-    printf("]\n");
+    output_write_char(out, '[');
+    write_int_array(out, arr, size > 0 ? (size_t)size : 0, ", ");
+    output_write_str(out, "]\n");
+    output_writer_flush(out);
 }
 
 /**
@@ -271,3 +604,473 @@ void print_search_result(const char* algorithm, int result, int target) {
         printf("✗ Not found\n");
     }
 }
+
+/**
+ * Branchless Binary Search
+ * Time Complexity: O(log n), exactly ceil(log2 n) iterations
+ * Space Complexity: O(1)
+ * 
+ * The classic loop branches on every comparison, and for random keys
+ * that branch is mispredicted half the time (~15 cycles each). Here the
+ * comparison selects the next base with a conditional move, so the loop
+ * has no data-dependent branch. Both candidate midpoints of the next
+ * step are prefetched, overlapping the next cache miss with this one.
+ * 
+ * Returns: Index of target if found, -1 otherwise
+ */
+int binary_search_branchless(const int arr[], int size, int target) {
+    if (size <= 0) {
+        return -1;
+    }
+    
+    const int *base = arr;
+    int n = size;
+    
+    while (n > 1) {
+        int half = n / 2;
+        PREFETCH(&base[half / 2]);
+        PREFETCH(&base[half + half / 2]);
+        base = (base[half] < target) ? base + half : base;   // cmov, not a branch
+        n -= half;
+    }
+    
+    int index = (int)(base - arr) + (*base < target);
+    return (index < size && arr[index] == target) ? index : -1;
+}
+
+/**
+ * Count trailing 1 bits (used to climb back up the Eytzinger tree)
+ */
+static inline int trailing_ones(unsigned int k) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(~k);
+#else
+    int count = 0;
+    while (k & 1u) {
+        k >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * In-order walk of the implicit tree assigns sorted elements to BFS slots
+ */
+static int eytzinger_fill(EytzingerIndex *index, const int sorted[], int next, int k) {
+    if (k <= index->size) {
+        next = eytzinger_fill(index, sorted, next, 2 * k);
+        index->keys[k] = sorted[next];
+        index->rank[k] = next;
+        next++;
+        next = eytzinger_fill(index, sorted, next, 2 * k + 1);
+    }
+    return next;
+}
+
+/**
+ * Build an Eytzinger index from a sorted array
+ * Time Complexity: O(n)
+ * Space Complexity: O(n) - keys plus a rank array for original indices
+ */
+bool eytzinger_init(EytzingerIndex *index, const int sorted[], int size) {
+    TRACE_SCOPE("eytzinger_init");
+    index->size = size;
+    index->keys = (int*)malloc(((size_t)size + 1) * sizeof(int));
+    index->rank = (int*)malloc(((size_t)size + 1) * sizeof(int));
+    if (index->keys == NULL || index->rank == NULL) {
+        eytzinger_free(index);
+        return false;
+    }
+    
+    eytzinger_fill(index, sorted, 0, 1);
+    return true;
+}
+
+/**
+ * Eytzinger Search
+ * Time Complexity: O(log n)
+ * Space Complexity: O(1)
+ * 
+ * Node k's children are 2k and 2k+1, so the 16 descendants four levels
+ * down are contiguous: keys[16k .. 16k+15] = one 64-byte cache line.
+ * Prefetching it each step keeps 4 levels of misses in flight, and the
+ * descent itself is branchless.
+ * 
+ * Returns: Index of target in the original sorted array, -1 otherwise
+ */
+int eytzinger_search(const EytzingerIndex *index, int target) {
+    unsigned int k = 1;
+    unsigned int n = (unsigned int)index->size;
+    
+    while (k <= n) {
+        PREFETCH(index->keys + 16 * (size_t)k);
+        k = 2 * k + (unsigned int)(index->keys[k] < target);
+    }
+    
+    // Undo the final run of right turns: lands on the lower bound
+    k >>= trailing_ones(k) + 1;
+    if (k == 0 || index->keys[k] != target) {
+        return -1;
+    }
+    return index->rank[k];
+}
+
+void eytzinger_free(EytzingerIndex *index) {
+    free(index->keys);
+    free(index->rank);
+    index->keys = NULL;
+    index->rank = NULL;
+    index->size = 0;
+}
+
+/**
+ * Scalar tail / fallback for the SIMD scans
+ */
+static int linear_search_from(const int arr[], int start, int size, int target) {
+    for (int i = start; i < size; i++) {
+        if (arr[i] == target) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#ifdef HAVE_X86_SIMD
+/**
+ * AVX2: two 8-int compares per iteration (16 ints per step)
+ */
+__attribute__((target("avx2")))
+static int linear_search_avx2(const int arr[], int size, int target) {
+    __m256i needle = _mm256_set1_epi32(target);
+    int i = 0;
+    
+    for (; i + 16 <= size; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(arr + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(arr + i + 8));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi32(a, needle), _mm256_cmpeq_epi32(b, needle));
+        if (!_mm256_testz_si256(hits, hits)) {
+            unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, needle)));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+            mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(b, needle)));
+            return i + 8 + __builtin_ctz(mask);
+        }
+    }
+    return linear_search_from(arr, i, size, target);
+}
+
+/**
+ * SSE2 (baseline on x86-64): 4 ints per compare, 16 per step
+ */
+static int linear_search_sse2(const int arr[], int size, int target) {
+    __m128i needle = _mm_set1_epi32(target);
+    int i = 0;
+    
+    for (; i + 16 <= size; i += 16) {
+        __m128i c0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i)), needle);
+        __m128i c1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i + 4)), needle);
+        __m128i c2 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i + 8)), needle);
+        __m128i c3 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i + 12)), needle);
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c0)) |
+                        (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c1)) << 4 |
+                        (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c2)) << 8 |
+                        (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c3)) << 12;
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return linear_search_from(arr, i, size, target);
+}
+#endif
+
+#ifdef HAVE_NEON
+/**
+ * Largest lane: vmaxvq_u32 is AArch64-only, 32-bit ARM takes two
+ * pairwise steps
+ */
+static inline uint32_t neon_max_u32(uint32x4_t v) {
+#if defined(__aarch64__)
+    return vmaxvq_u32(v);
+#else
+    uint32x2_t max = vpmax_u32(vget_low_u32(v), vget_high_u32(v));
+    return vget_lane_u32(vpmax_u32(max, max), 0);
+#endif
+}
+
+/**
+ * Sum of the lanes (vaddvq_s32 on AArch64, pairwise adds elsewhere)
+ */
+static inline int32_t neon_sum_s32(int32x4_t v) {
+#if defined(__aarch64__)
+    return vaddvq_s32(v);
+#else
+    int32x2_t sum = vadd_s32(vget_low_s32(v), vget_high_s32(v));
+    return vget_lane_s32(vpadd_s32(sum, sum), 0);
+#endif
+}
+
+/**
+ * NEON: four 4-int compares per iteration (16 ints per step)
+ */
+static int linear_search_neon(const int arr[], int size, int target) {
+    int32x4_t needle = vdupq_n_s32(target);
+    int i = 0;
+    
+    for (; i + 16 <= size; i += 16) {
+        uint32x4_t c0 = vceqq_s32(vld1q_s32(arr + i), needle);
+        uint32x4_t c1 = vceqq_s32(vld1q_s32(arr + i + 4), needle);
+        uint32x4_t c2 = vceqq_s32(vld1q_s32(arr + i + 8), needle);
+        uint32x4_t c3 = vceqq_s32(vld1q_s32(arr + i + 12), needle);
+        uint32x4_t any = vorrq_u32(vorrq_u32(c0, c1), vorrq_u32(c2, c3));
+        if (neon_max_u32(any) != 0) {
+            return linear_search_from(arr, i, i + 16, target);
+        }
+    }
+    return linear_search_from(arr, i, size, target);
+}
+#endif
+
+/**
+ * SIMD Linear Search
+ * Time Complexity: O(n), but 8-16 comparisons per instruction
+ * Space Complexity: O(1)
+ * 
+ * Picks AVX2 at runtime when the CPU has it, SSE2 otherwise on x86-64,
+ * NEON on ARM, and the plain loop everywhere else.
+ * 
+ * Returns: Index of first occurrence of target, -1 otherwise
+ */
+int linear_search_simd(const int arr[], int size, int target) {
+#if defined(HAVE_X86_SIMD)
+    static int has_avx2 = -1;
+    if (has_avx2 < 0) {
+        has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return has_avx2 ? linear_search_avx2(arr, size, target)
+                    : linear_search_sse2(arr, size, target);
+#elif defined(HAVE_NEON)
+    return linear_search_neon(arr, size, target);
+#else
+    return linear_search_from(arr, 0, size, target);
+#endif
+}
+
+/**
+ * Batched Binary Search
+ * Time Complexity: O(k log n) for k keys
+ * Space Complexity: O(1) beyond the output array
+ * 
+ * One lookup on a table bigger than cache is ~20 dependent misses;
+ * searching keys one at a time pays each miss in full. Every search
+ * over the same array takes the same number of halving steps, so a
+ * group of SEARCH_BATCH_GROUP keys can advance in lockstep: each step
+ * updates every key and prefetches that key's next probe. By the time
+ * the loop comes back around to a key, its cache line is (ideally)
+ * already on its way, so misses from different keys overlap.
+ * 
+ * out[i] receives the index of keys[i] in arr, or -1 if absent
+ * (same contract as binary_search for arrays of distinct values).
+ */
+void binary_search_batch(const int *arr, int size, const int *keys, int nkeys, int *out) {
+    TRACE_SCOPE("binary_search_batch");
+    if (size <= 0) {
+        for (int i = 0; i < nkeys; i++) {
+            out[i] = -1;
+        }
+        return;
+    }
+    
+    for (int first = 0; first < nkeys; first += SEARCH_BATCH_GROUP) {
+        int group = nkeys - first < SEARCH_BATCH_GROUP ? nkeys - first : SEARCH_BATCH_GROUP;
+        const int *group_keys = keys + first;
+        const int *base[SEARCH_BATCH_GROUP];
+        
+        for (int j = 0; j < group; j++) {
+            base[j] = arr;
+        }
+        PREFETCH(&arr[size / 2]);
+        
+        int n = size;
+        while (n > 1) {
+            int half = n / 2;
+            int next_half = (n - half) / 2;
+            for (int j = 0; j < group; j++) {
+                base[j] = (base[j][half] < group_keys[j]) ? base[j] + half : base[j];
+                PREFETCH(&base[j][next_half]);
+            }
+            n -= half;
+        }
+        
+        for (int j = 0; j < group; j++) {
+            int index = (int)(base[j] - arr) + (*base[j] < group_keys[j]);
+            out[first + j] = (index < size && arr[index] == group_keys[j]) ? index : -1;
+        }
+    }
+}
+
+/**
+ * Count keys in one node that are < key (the child/slot to descend to)
+ * Node is 16 ints in one aligned cache line.
+ */
+static inline int stree_node_rank(const int *node, int key) {
+#if defined(HAVE_X86_SIMD) && defined(__AVX2__)
+    __m256i needle = _mm256_set1_epi32(key);
+    __m256i lo = _mm256_cmpgt_epi32(needle, _mm256_load_si256((const __m256i*)node));
+    __m256i hi = _mm256_cmpgt_epi32(needle, _mm256_load_si256((const __m256i*)(node + 8)));
+    unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lo)) |
+                    (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8;
+    return __builtin_popcount(mask);
+#elif defined(HAVE_X86_SIMD)
+    __m128i needle = _mm_set1_epi32(key);
+    __m128i c0 = _mm_cmpgt_epi32(needle, _mm_load_si128((const __m128i*)node));
+    __m128i c1 = _mm_cmpgt_epi32(needle, _mm_load_si128((const __m128i*)(node + 4)));
+    __m128i c2 = _mm_cmpgt_epi32(needle, _mm_load_si128((const __m128i*)(node + 8)));
+    __m128i c3 = _mm_cmpgt_epi32(needle, _mm_load_si128((const __m128i*)(node + 12)));
+    // Each lane is 0 or -1: sum the lanes and negate
+    __m128i sum = _mm_add_epi32(_mm_add_epi32(c0, c1), _mm_add_epi32(c2, c3));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return -_mm_cvtsi128_si32(sum);
+#elif defined(HAVE_NEON)
+    int32x4_t needle = vdupq_n_s32(key);
+    uint32x4_t c0 = vcltq_s32(vld1q_s32(node), needle);
+    uint32x4_t c1 = vcltq_s32(vld1q_s32(node + 4), needle);
+    uint32x4_t c2 = vcltq_s32(vld1q_s32(node + 8), needle);
+    uint32x4_t c3 = vcltq_s32(vld1q_s32(node + 12), needle);
+    int32x4_t sum = vaddq_s32(vaddq_s32(vreinterpretq_s32_u32(c0), vreinterpretq_s32_u32(c1)),
+                              vaddq_s32(vreinterpretq_s32_u32(c2), vreinterpretq_s32_u32(c3)));
+    return -neon_sum_s32(sum);
+#else
+    int rank = 0;
+    for (int i = 0; i < STREE_B; i++) {
+        rank += node[i] < key;
+    }
+    return rank;
+#endif
+}
+
+/**
+ * Build an S-tree index from a sorted array
+ * Time Complexity: O(n)
+ * Space Complexity: O(n) - leaves copy the array, internal layers add ~1/16
+ * 
+ * Returns: false on allocation failure (index left empty)
+ */
+bool static_index_init(StaticIndex *index, const int sorted[], int size) {
+    TRACE_SCOPE("static_index_init");
+    memset(index, 0, sizeof(*index));
+    index->size = size;
+    
+    // Layer sizes bottom-up: leaves, then ceil(previous / 17) until one node
+    int layer_nodes[STREE_MAX_HEIGHT];
+    int height = 0;
+    int nodes = size > 0 ? (size + STREE_B - 1) / STREE_B : 1;
+    layer_nodes[height++] = nodes;
+    while (nodes > 1) {
+        nodes = (nodes + STREE_FANOUT - 1) / STREE_FANOUT;
+        layer_nodes[height++] = nodes;
+    }
+    index->height = height;
+    
+    // Root first: layer_offset[0] is the root, layer_offset[height-1] the leaves
+    size_t total = 0;
+    for (int level = 0; level < height; level++) {
+        index->layer_offset[level] = (int)total;
+        total += (size_t)layer_nodes[height - 1 - level];
+    }
+    
+    size_t bytes = total * STREE_B * sizeof(int);
+    index->storage = malloc(bytes + CACHE_LINE_SIZE);
+    if (index->storage == NULL) {
+        return false;
+    }
+    uintptr_t aligned = ((uintptr_t)index->storage + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1);
+    index->nodes = (int*)aligned;
+    
+    // Leaves: the sorted array, padded with INT_MAX (never < any key)
+    int leaf_count = layer_nodes[0];
+    int *leaves = index->nodes + (size_t)index->layer_offset[height - 1] * STREE_B;
+    memcpy(leaves, sorted, (size_t)size * sizeof(int));
+    for (size_t i = (size_t)size; i < (size_t)leaf_count * STREE_B; i++) {
+        leaves[i] = INT_MAX;
+    }
+    
+    // Internal layers: separator j = smallest key under child j+1, which
+    // is the first key of that child's leftmost leaf
+    long long leaves_per_child = 1;
+    for (int up = 1; up < height; up++) {
+        int *layer = index->nodes + (size_t)index->layer_offset[height - 1 - up] * STREE_B;
+        for (int node = 0; node < layer_nodes[up]; node++) {
+            for (int j = 0; j < STREE_B; j++) {
+                long long child = (long long)node * STREE_FANOUT + j + 1;
+                long long leaf = child * leaves_per_child;
+                layer[node * STREE_B + j] = (child < layer_nodes[up - 1]) ? leaves[leaf * STREE_B] : INT_MAX;
+            }
+        }
+        leaves_per_child *= STREE_FANOUT;
+    }
+    return true;
+}
+
+/**
+ * S-tree lower_bound
+ * Time Complexity: O(log_17 n) node visits, one cache line each
+ * Space Complexity: O(1)
+ * 
+ * Returns: First index i with sorted[i] >= key, or size if none
+ */
+int static_index_lower_bound(const StaticIndex *index, int key) {
+    int node = 0;
+    for (int level = 0; level < index->height - 1; level++) {
+        const int *keys = index->nodes + (size_t)(index->layer_offset[level] + node) * STREE_B;
+        node = node * STREE_FANOUT + stree_node_rank(keys, key);
+    }
+    const int *leaf = index->nodes + (size_t)(index->layer_offset[index->height - 1] + node) * STREE_B;
+    int position = node * STREE_B + stree_node_rank(leaf, key);
+    return position < index->size ? position : index->size;
+}
+
+/**
+ * S-tree upper_bound
+ * Returns: First index i with sorted[i] > key, or size if none
+ */
+int static_index_upper_bound(const StaticIndex *index, int key) {
+    if (key == INT_MAX) {
+        return index->size;
+    }
+    return static_index_lower_bound(index, key + 1);
+}
+
+/**
+ * S-tree range query over [low, high]
+ * Returns: Number of keys in range; *first receives the index of the
+ *          first one (valid when the count is non-zero)
+ */
+int static_index_range(const StaticIndex *index, int low, int high, int *first) {
+    int begin = static_index_lower_bound(index, low);
+    int end = low <= high ? static_index_upper_bound(index, high) : begin;
+    if (first != NULL) {
+        *first = begin;
+    }
+    return end > begin ? end - begin : 0;
+}
+
+/**
+ * S-tree exact-match search
+ * Returns: Index of key (first occurrence), -1 otherwise
+ */
+int static_index_search(const StaticIndex *index, int key) {
+    int position = static_index_lower_bound(index, key);
+    if (position == index->size) {
+        return -1;
+    }
+    const int *leaves = index->nodes + (size_t)index->layer_offset[index->height - 1] * STREE_B;
+    return leaves[position] == key ? position : -1;
+}
+
+void static_index_free(StaticIndex *index) {
+    free(index->storage);
+    memset(index, 0, sizeof(*index));
+}
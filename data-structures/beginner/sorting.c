@@ -8,17 +8,48 @@
  * 
  * All three have O(n²) time complexity but differ in their approach
  * and practical performance characteristics.
+ * 
+ * Production engine (for large inputs):
+ * 4. Introsort - Quicksort with median-of-3/ninther pivots, heapsort
+ *    fallback when recursion gets too deep (guaranteed O(n log n)),
+ *    and insertion sort for small partitions
+ * 5. LSD Radix Sort - Four 8-bit counting passes over 32-bit ints, O(n)
+ * 
+ * sort() picks between them by size.
+ * 
+ * 6. Parallel Merge Sort - Chunks sorted with sort() on worker threads,
+ *    then merged pairwise; every merge is split into independent
+ *    segments (merge path / co-ranking) so all threads stay busy even
+ *    on the final merge.
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "trace.h"
+#include "output_writer.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_PTHREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 #define ARRAY_SIZE 10
+#define INSERTION_SORT_THRESHOLD 24   // Partitions this small: insertion sort wins
+#define NINTHER_THRESHOLD 128         // Partitions this large: median of 9 pivots
+#define RADIX_SORT_THRESHOLD 4096     // Above this, radix beats comparison sorts
+#define BENCHMARK_SIZE 1000000
+#define PARALLEL_SORT_CUTOFF 65536    // Below this, thread startup costs more than it saves
+#define PARALLEL_MAX_THREADS 256
 
 // Function declarations
 void print_array(const char* label, int arr[], int size);
@@ -27,6 +58,13 @@ void bubble_sort(int arr[], int size);
 void selection_sort(int arr[], int size);
 void insertion_sort(int arr[], int size);
 bool is_sorted(int arr[], int size);
+void insertion_sort_range(int arr[], int lo, int hi);
+void heap_sort(int arr[], int size);
+void introsort(int arr[], int size);
+void radix_sort(int arr[], int size);
+void sort(int arr[], int size);
+void merge_sorted(const int a[], int na, const int b[], int nb, int out[]);
+void parallel_sort(int arr[], int size, int threads);
 
 int main(void) {
 #ifdef _WIN32
@@ -122,6 +160,76 @@ int main(void) {
     printf("  • Space:   O(1)   - In-place sorting\n");
     printf("  • Stable:  Yes    - Equal elements maintain order\n\n");
     
+    // ==========================================
+    // 4. PRODUCTION SORT ENGINE
+    // ==========================================
+    printf("========================================\n");
+    printf("4. PRODUCTION SORT ENGINE\n");
+    printf("========================================\n");
+    printf("Algorithm: sort() = introsort for small inputs,\n");
+    printf("           LSD radix sort for large int arrays\n\n");
+    
+    copy_array(arr, original, ARRAY_SIZE);
+    sort(arr, ARRAY_SIZE);
+    printf("sort():  ");
+    print_array("", arr, ARRAY_SIZE);
+    printf("Status: %s\n\n", is_sorted(arr, ARRAY_SIZE) ? "✓ Sorted" : "✗ Not sorted");
+    
+    int *big = malloc(BENCHMARK_SIZE * sizeof(int));
+    int *work = malloc(BENCHMARK_SIZE * sizeof(int));
+    if (big != NULL && work != NULL) {
+        srand(42);
+        for (int i = 0; i < BENCHMARK_SIZE; i++) {
+            // Full 32-bit range including negatives
+            big[i] = (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+        }
+        
+        const char *names[] = { "introsort", "radix_sort", "sort" };
+        void (*sorters[])(int[], int) = { introsort, radix_sort, sort };
+        printf("Sorting %d random ints:\n", BENCHMARK_SIZE);
+        for (int s = 0; s < 3; s++) {
+            copy_array(work, big, BENCHMARK_SIZE);
+            clock_t start = clock();
+            sorters[s](work, BENCHMARK_SIZE);
+            double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+            printf("  %-11s %8.3f s  %s\n", names[s], elapsed,
+                   is_sorted(work, BENCHMARK_SIZE) ? "✓ Sorted" : "✗ Not sorted");
+        }
+        
+        // Adversarial inputs for quicksort: already sorted and all-equal
+        for (int i = 0; i < BENCHMARK_SIZE; i++) {
+            work[i] = i % 3;
+        }
+        introsort(work, BENCHMARK_SIZE);
+        printf("  introsort on few unique keys: %s\n",
+               is_sorted(work, BENCHMARK_SIZE) ? "✓ Sorted" : "✗ Not sorted");
+        introsort(work, BENCHMARK_SIZE);
+        printf("  introsort on sorted input:    %s\n",
+               is_sorted(work, BENCHMARK_SIZE) ? "✓ Sorted" : "✗ Not sorted");
+    }
+    
+    // Parallel merge sort: thread count sweep
+    if (big != NULL && work != NULL) {
+        printf("\nParallel sort of %d ints:\n", BENCHMARK_SIZE);
+        const int thread_counts[] = { 1, 2, 4, 8 };
+        for (int t = 0; t < 4; t++) {
+            copy_array(work, big, BENCHMARK_SIZE);
+            clock_t start = clock();
+            parallel_sort(work, BENCHMARK_SIZE, thread_counts[t]);
+            double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+            printf("  %d thread(s) %8.3f s CPU  %s\n", thread_counts[t], elapsed,
+                   is_sorted(work, BENCHMARK_SIZE) ? "✓ Sorted" : "✗ Not sorted");
+        }
+        printf("  (clock() sums CPU time over all threads; wall time drops with cores)\n");
+    }
+    free(big);
+    free(work);
+    
+    printf("\nComplexity:\n");
+    printf("  • Introsort: O(n log n) worst case, in-place, not stable\n");
+    printf("  • Radix:     O(n) - 4 passes, O(n) extra space, stable\n");
+    printf("  • Parallel:  O(n log n / p + n log p / p) with p threads\n\n");
+    
     // ==========================================
     // COMPARISON
     // ==========================================
@@ -144,6 +252,10 @@ int main(void) {
     printf("  • Online sorting (data arrives over time)\n");
     printf("  • Part of more complex algorithms (Timsort)\n\n");
     
+    printf("sort() (introsort / radix):\n");
+    printf("  • Anything beyond a few hundred elements\n");
+    printf("  • Tens of millions of keys per batch\n\n");
+    
     printf("========================================\n");
     printf("     ALL ALGORITHMS COMPLETED           \n");
     printf("========================================\n");
@@ -153,19 +265,18 @@ int main(void) {
 
 /**
  * Print array with optional label
+ * (one buffered write via output_writer.h, not a printf per element)
  */
 void print_array(const char* label, int arr[], int size) {
-    if (strlen(label) > 0) {
-        printf("%s: ", label);
-    }
-    printf("[");
-    for (int i = 0; i < size; i++) {
-        printf("%d", arr[i]);
-        if (i < size - 1) {
-            printf(", ");
-        }
+    OutputWriter *out = output_stdout();
+    if (label[0] != '\0') {
+        output_write_str(out, label);
+        output_write_str(out, ": ");
     }
-    printf("]\n");
+    output_write_char(out, '[');
+    write_int_array(out, arr, size > 0 ? (size_t)size : 0, ", ");
+    output_write_str(out, "]\n");
+    output_writer_flush(out);
 }
 
 /**
@@ -186,6 +297,7 @@ void copy_array(int dest[], int src[], int size) {
  * elements and swapping them if they're in the wrong order.
  */
 void bubble_sort(int arr[], int size) {
+    TRACE_SCOPE("bubble_sort");
     printf("\nSorting process:\n");
     
     for (int i = 0; i < size - 1; i++) {
@@ -224,6 +336,7 @@ void bubble_sort(int arr[], int size) {
  * and putting it at the beginning.
  */
 void selection_sort(int arr[], int size) {
+    TRACE_SCOPE("selection_sort");
     printf("\nSorting process:\n");
     
     for (int i = 0; i < size - 1; i++) {
@@ -259,6 +372,7 @@ void selection_sort(int arr[], int size) {
  * each element into its proper position.
  */
 void insertion_sort(int arr[], int size) {
+    TRACE_SCOPE("insertion_sort");
     printf("\nSorting process:\n");
     
     for (int i = 1; i < size; i++) {
@@ -292,3 +406,477 @@ bool is_sorted(int arr[], int size) {
     }
     return true;
 }
+
+/**
+ * Insertion sort on arr[lo..hi] (inclusive), without tracing output
+ * Used by introsort to finish small partitions: for n < ~24 its tight,
+ * branch-predictable loop beats any O(n log n) algorithm.
+ */
+void insertion_sort_range(int arr[], int lo, int hi) {
+    for (int i = lo + 1; i <= hi; i++) {
+        int key = arr[i];
+        int j = i - 1;
+        
+        while (j >= lo && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        
+        arr[j + 1] = key;
+    }
+}
+
+static inline void swap_int(int *a, int *b) {
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+/**
+ * Restore the max-heap property below index 'root'
+ */
+static void sift_down(int arr[], int root, int size) {
+    int value = arr[root];
+    
+    for (;;) {
+        int child = 2 * root + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && arr[child + 1] > arr[child]) {
+            child++;
+        }
+        if (arr[child] <= value) {
+            break;
+        }
+        arr[root] = arr[child];
+        root = child;
+    }
+    arr[root] = value;
+}
+
+/**
+ * Heap Sort
+ * Time Complexity: O(n log n) in all cases
+ * Space Complexity: O(1)
+ * 
+ * Introsort's safety net when quicksort keeps choosing bad pivots.
+ */
+void heap_sort(int arr[], int size) {
+    for (int i = size / 2 - 1; i >= 0; i--) {
+        sift_down(arr, i, size);
+    }
+    for (int end = size - 1; end > 0; end--) {
+        swap_int(&arr[0], &arr[end]);
+        sift_down(arr, 0, end);
+    }
+}
+
+/**
+ * Order arr[a] <= arr[b] <= arr[c]
+ */
+static inline void sort3(int arr[], int a, int b, int c) {
+    if (arr[b] < arr[a]) swap_int(&arr[a], &arr[b]);
+    if (arr[c] < arr[b]) swap_int(&arr[b], &arr[c]);
+    if (arr[b] < arr[a]) swap_int(&arr[a], &arr[b]);
+}
+
+/**
+ * Introsort core on arr[lo..hi]
+ * - Pivot: median of 3, or Tukey's ninther for big partitions
+ * - Partition: Hoare-style with the pivot value, equal keys split
+ *   evenly so runs of duplicates cannot cause O(n²)
+ * - Recurse into the smaller half, loop on the larger: O(log n) stack
+ */
+static void introsort_loop(int arr[], int lo, int hi, int depth_limit) {
+    while (hi - lo + 1 > INSERTION_SORT_THRESHOLD) {
+        if (depth_limit-- == 0) {
+            // Too many unbalanced partitions: switch to guaranteed O(n log n)
+            heap_sort(arr + lo, hi - lo + 1);
+            return;
+        }
+        
+        int n = hi - lo + 1;
+        int mid = lo + n / 2;
+        if (n > NINTHER_THRESHOLD) {
+            int step = n / 8;
+            sort3(arr, lo, lo + step, lo + 2 * step);
+            sort3(arr, mid - step, mid, mid + step);
+            sort3(arr, hi - 2 * step, hi - step, hi);
+            sort3(arr, lo + step, mid, hi - step);
+        } else {
+            sort3(arr, lo, mid, hi);
+        }
+        int pivot = arr[mid];
+        
+        int i = lo - 1;
+        int j = hi + 1;
+        for (;;) {
+            do { i++; } while (arr[i] < pivot);
+            do { j--; } while (arr[j] > pivot);
+            if (i >= j) {
+                break;
+            }
+            swap_int(&arr[i], &arr[j]);
+        }
+        
+        // arr[lo..j] <= pivot <= arr[j+1..hi]
+        if (j - lo < hi - j) {
+            introsort_loop(arr, lo, j, depth_limit);
+            lo = j + 1;
+        } else {
+            introsort_loop(arr, j + 1, hi, depth_limit);
+            hi = j;
+        }
+    }
+    insertion_sort_range(arr, lo, hi);
+}
+
+/**
+ * Introsort
+ * Time Complexity: O(n log n) worst case
+ * Space Complexity: O(log n) stack
+ */
+void introsort(int arr[], int size) {
+    if (size < 2) {
+        return;
+    }
+    TRACE_SCOPE("introsort");
+    
+    int depth_limit = 0;
+    for (int n = size; n > 1; n >>= 1) {
+        depth_limit += 2;   // 2 * floor(log2(n))
+    }
+    introsort_loop(arr, 0, size - 1, depth_limit);
+}
+
+/**
+ * LSD Radix Sort for 32-bit ints
+ * Time Complexity: O(n) - four counting passes of 8 bits each
+ * Space Complexity: O(n) scratch buffer
+ * 
+ * Keys are mapped to unsigned by flipping the sign bit, so negatives
+ * sort before positives. A pass is skipped when every key has the
+ * same byte in that position (common for small-range data).
+ */
+void radix_sort(int arr[], int size) {
+    if (size < 2) {
+        return;
+    }
+    TRACE_SCOPE("radix_sort");
+    
+    uint32_t *keys = (uint32_t*)malloc((size_t)size * sizeof(uint32_t));
+    uint32_t *scratch = (uint32_t*)malloc((size_t)size * sizeof(uint32_t));
+    if (keys == NULL || scratch == NULL) {
+        free(keys);
+        free(scratch);
+        introsort(arr, size);   // Out of memory: in-place fallback
+        return;
+    }
+    
+    // One pass builds all four histograms
+    size_t counts[4][256];
+    memset(counts, 0, sizeof(counts));
+    for (int i = 0; i < size; i++) {
+        uint32_t key = (uint32_t)arr[i] ^ 0x80000000u;
+        keys[i] = key;
+        counts[0][key & 0xFF]++;
+        counts[1][(key >> 8) & 0xFF]++;
+        counts[2][(key >> 16) & 0xFF]++;
+        counts[3][key >> 24]++;
+    }
+    
+    uint32_t *src = keys;
+    uint32_t *dst = scratch;
+    for (int pass = 0; pass < 4; pass++) {
+        int shift = pass * 8;
+        
+        if (counts[pass][(src[0] >> shift) & 0xFF] == (size_t)size) {
+            continue;   // All keys share this byte - order unchanged
+        }
+        
+        // Exclusive prefix sum -> starting offset of each bucket
+        size_t offsets[256];
+        size_t total = 0;
+        for (int b = 0; b < 256; b++) {
+            offsets[b] = total;
+            total += counts[pass][b];
+        }
+        
+        for (int i = 0; i < size; i++) {
+            uint32_t key = src[i];
+            dst[offsets[(key >> shift) & 0xFF]++] = key;
+        }
+        
+        uint32_t *temp = src;
+        src = dst;
+        dst = temp;
+    }
+    
+    for (int i = 0; i < size; i++) {
+        arr[i] = (int)(src[i] ^ 0x80000000u);
+    }
+    
+    free(keys);
+    free(scratch);
+}
+
+/**
+ * General-purpose int sort
+ * Small arrays: introsort (in place, no allocation)
+ * Large arrays: radix sort (linear time)
+ */
+void sort(int arr[], int size) {
+    if (size >= RADIX_SORT_THRESHOLD) {
+        radix_sort(arr, size);
+    } else {
+        introsort(arr, size);
+    }
+}
+
+/**
+ * Merge two sorted arrays into 'out' (size na + nb)
+ * Time Complexity: O(na + nb)
+ * Stable: on ties, elements of 'a' come first
+ */
+void merge_sorted(const int a[], int na, const int b[], int nb, int out[]) {
+    int i = 0;
+    int j = 0;
+    int k = 0;
+    
+    while (i < na && j < nb) {
+        out[k++] = (b[j] < a[i]) ? b[j++] : a[i++];
+    }
+    while (i < na) {
+        out[k++] = a[i++];
+    }
+    while (j < nb) {
+        out[k++] = b[j++];
+    }
+}
+
+#ifdef HAVE_PTHREADS
+/**
+ * Co-rank (merge path): how many of the first k merged outputs come from 'a'
+ * Lets one merge be cut into independent slices with a binary search.
+ * Time Complexity: O(log min(na, nb))
+ */
+static int co_rank(long long k, const int a[], int na, const int b[], int nb) {
+    int lo = (k > nb) ? (int)(k - nb) : 0;
+    int hi = (k < na) ? (int)k : na;
+    
+    for (;;) {
+        int i = lo + (hi - lo) / 2;
+        int j = (int)(k - i);
+        if (i < na && j > 0 && a[i] <= b[j - 1]) {
+            lo = i + 1;      // a[i] belongs in the prefix: take more from a
+        } else if (i > 0 && j < nb && a[i - 1] > b[j]) {
+            hi = i - 1;      // a[i-1] belongs after b[j]: take fewer from a
+        } else {
+            return i;
+        }
+    }
+}
+
+typedef struct {
+    int *arr;
+    int size;
+} SortTask;
+
+typedef struct {
+    const int *a;
+    int na;
+    const int *b;
+    int nb;
+    int *out;
+} MergeTask;
+
+/**
+ * Minimal task pool: a fixed set of threads pulls task indices from a
+ * shared counter, so uneven tasks still balance across threads
+ */
+typedef struct {
+    void (*run)(void *task);
+    char *tasks;
+    size_t task_size;
+    int count;
+    int next;
+    pthread_mutex_t lock;
+} TaskPool;
+
+static void* task_pool_worker(void *arg) {
+    TaskPool *pool = (TaskPool*)arg;
+    
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        int index = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        
+        if (index >= pool->count) {
+            break;
+        }
+        pool->run(pool->tasks + (size_t)index * pool->task_size);
+    }
+    return NULL;
+}
+
+/**
+ * Run 'count' tasks on up to 'threads' threads (the caller is one of them)
+ */
+static void run_tasks(void (*run)(void*), void *tasks, size_t task_size,
+                      int count, int threads) {
+    TaskPool pool = { run, (char*)tasks, task_size, count, 0, PTHREAD_MUTEX_INITIALIZER };
+    pthread_t workers[PARALLEL_MAX_THREADS];
+    int started = 0;
+    
+    if (threads > count) {
+        threads = count;
+    }
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&workers[started], NULL, task_pool_worker, &pool) == 0) {
+            started++;
+        }
+    }
+    task_pool_worker(&pool);
+    for (int t = 0; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+    pthread_mutex_destroy(&pool.lock);
+}
+
+static void run_sort_task(void *task) {
+    SortTask *t = (SortTask*)task;
+    sort(t->arr, t->size);
+}
+
+static void run_merge_task(void *task) {
+    MergeTask *t = (MergeTask*)task;
+    TRACE_SCOPE("parallel_sort merge slice");
+    merge_sorted(t->a, t->na, t->b, t->nb, t->out);
+}
+
+/**
+ * Parallel Merge Sort
+ * Time Complexity: O(n log n / p) sorting + O(n log p / p) merging
+ * Space Complexity: O(n) merge buffer
+ * 
+ * 1. Split into p chunks and sort() each on its own thread
+ * 2. Merge runs pairwise, log2(p) rounds, ping-ponging between the
+ *    array and a buffer. Each pair's output is cut into slices with
+ *    co_rank() so a round always has ~p independent merge tasks.
+ * 
+ * threads <= 0 uses every online CPU.
+ */
+void parallel_sort(int arr[], int size, int threads) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > PARALLEL_MAX_THREADS) {
+        threads = PARALLEL_MAX_THREADS;
+    }
+    if (threads < 2 || size < PARALLEL_SORT_CUTOFF) {
+        sort(arr, size);
+        return;
+    }
+    TRACE_SCOPE("parallel_sort");
+    
+    int *buffer = (int*)malloc((size_t)size * sizeof(int));
+    int *bounds = (int*)malloc(((size_t)threads + 1) * sizeof(int));
+    SortTask *sort_tasks = (SortTask*)malloc((size_t)threads * sizeof(SortTask));
+    MergeTask *merge_tasks = (MergeTask*)malloc((size_t)threads * 2 * sizeof(MergeTask));
+    if (buffer == NULL || bounds == NULL || sort_tasks == NULL || merge_tasks == NULL) {
+        free(buffer);
+        free(bounds);
+        free(sort_tasks);
+        free(merge_tasks);
+        sort(arr, size);   // Out of memory: sequential in place
+        return;
+    }
+    
+    // Phase 1: sort independent chunks
+    int runs = threads;
+    for (int c = 0; c <= runs; c++) {
+        bounds[c] = (int)((long long)size * c / runs);
+    }
+    for (int c = 0; c < runs; c++) {
+        sort_tasks[c].arr = arr + bounds[c];
+        sort_tasks[c].size = bounds[c + 1] - bounds[c];
+    }
+    run_tasks(run_sort_task, sort_tasks, sizeof(SortTask), runs, threads);
+    
+    // Phase 2: merge rounds
+    int *src = arr;
+    int *dst = buffer;
+    while (runs > 1) {
+        TRACE_SCOPE("parallel_sort merge round");
+        int pairs = runs / 2;
+        int slices = threads / pairs;
+        if (slices < 1) {
+            slices = 1;
+        }
+        
+        int task_count = 0;
+        for (int r = 0; r + 1 < runs; r += 2) {
+            const int *a = src + bounds[r];
+            const int *b = src + bounds[r + 1];
+            int na = bounds[r + 1] - bounds[r];
+            int nb = bounds[r + 2] - bounds[r + 1];
+            int *out = dst + bounds[r];
+            long long total = (long long)na + nb;
+            
+            for (int p = 0; p < slices; p++) {
+                long long k0 = total * p / slices;
+                long long k1 = total * (p + 1) / slices;
+                int i0 = co_rank(k0, a, na, b, nb);
+                int i1 = co_rank(k1, a, na, b, nb);
+                MergeTask *t = &merge_tasks[task_count++];
+                t->a = a + i0;
+                t->na = i1 - i0;
+                t->b = b + (k0 - i0);
+                t->nb = (int)((k1 - i1) - (k0 - i0));
+                t->out = out + k0;
+            }
+        }
+        if (runs % 2 == 1) {
+            // Odd run out: carry it over to the other buffer unchanged
+            MergeTask *t = &merge_tasks[task_count++];
+            t->a = src + bounds[runs - 1];
+            t->na = bounds[runs] - bounds[runs - 1];
+            t->b = NULL;
+            t->nb = 0;
+            t->out = dst + bounds[runs - 1];
+        }
+        run_tasks(run_merge_task, merge_tasks, sizeof(MergeTask), task_count, threads);
+        
+        // Drop every other boundary: run r+1 merged into run r
+        int new_runs = 0;
+        for (int r = 0; r < runs; r += 2) {
+            bounds[new_runs++] = bounds[r];
+        }
+        bounds[new_runs] = size;
+        runs = new_runs;
+        
+        int *temp = src;
+        src = dst;
+        dst = temp;
+    }
+    
+    if (src != arr) {
+        memcpy(arr, src, (size_t)size * sizeof(int));
+    }
+    
+    free(buffer);
+    free(bounds);
+    free(sort_tasks);
+    free(merge_tasks);
+}
+#else
+/**
+ * No pthreads on this platform: sequential sort
+ */
+void parallel_sort(int arr[], int size, int threads) {
+    (void)threads;
+    sort(arr, size);
+}
+#endif
@@ -37,6 +37,10 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include "bit_ops.h"    // count_set_bits, find_first_set, reverse_bits, swap_bytes_*, field_*
+#include "roaring_bitmap.h"
 
 /* ============================================================================
  * PART 1: Fundamental Bit Operations
@@ -154,44 +158,16 @@ void bit_write(uint32_t* reg, uint8_t bit_pos, bool value) {
  * ============================================================================
  */
 
-/**
- * Read multi-bit field from register
- * 
- * Example: Extract bits 8-11 (4 bits) from register
- * 
- * @param reg       Register value
- * @param start_bit Starting bit position (LSB of field)
- * @param num_bits  Number of bits in field
- * @return          Field value (right-justified)
- * 
- * CPU: ~4-5 cycles (shift, mask)
- */
-uint32_t field_read(uint32_t reg, uint8_t start_bit, uint8_t num_bits) {
-    // Create mask: (1 << num_bits) - 1
-    // For 4 bits: (1 << 4) - 1 = 16 - 1 = 15 = 0b1111
-    uint32_t mask = (1U << num_bits) - 1;
-    
-    // Shift field to LSB position and mask
-    return (reg >> start_bit) & mask;
-}
-
-/**
- * Write multi-bit field to register
- * 
- * Example: Write value 0b1010 to bits 8-11
- * Preserves all other bits in the register
- * 
- * CPU: ~6-7 cycles (shifts, mask, combine)
+/*
+ * field_read() and field_write() live in bit_ops.h (static inline, so
+ * the shift and mask are inlined at every call site):
+ *
+ *   field_read(reg, 8, 4)           -> (reg >> 8) & 0xF
+ *   field_write(&reg, 8, 4, 0xA)    -> clear bits 8-11, then OR in 0xA << 8
+ *
+ * bits_extract() / bits_deposit() generalize them to fields whose bits
+ * are NOT contiguous (BMI2 pext / pdep when the CPU has them).
  */
-void field_write(uint32_t* reg, uint8_t start_bit, uint8_t num_bits, uint32_t value) {
-    uint32_t mask = (1U << num_bits) - 1;
-    
-    // Clear the field
-    *reg &= ~(mask << start_bit);
-    
-    // Set the new value (mask value to prevent overflow)
-    *reg |= ((value & mask) << start_bit);
-}
 
 /**
  * Modify field with read-modify-write
@@ -372,66 +348,17 @@ void compare_bitfield_styles(void) {
  * ============================================================================
  */
 
-/**
- * Count number of set bits (population count)
- * 
- * Useful for: checking how many interrupts pending, data validation
- * 
- * CPU: O(number of set bits) - Brian Kernighan's algorithm
- * Modern CPUs have __builtin_popcount() that uses dedicated instruction
+/*
+ * count_set_bits(), find_first_set() and reverse_bits() live in
+ * bit_ops.h. They compile to popcnt / tzcnt (or bsf) / rbit where the
+ * CPU has them; the loops they replace are kept there as the fallback:
+ *
+ *   count_set_bits:  n &= n - 1 until zero (Kernighan, 1 step per set bit)
+ *   find_first_set:  isolate n & -n, then shift down to find its position
+ *   reverse_bits:    32 steps of "shift result left, copy LSB of n"
+ *
+ * popcount_array() counts a whole bitmap with AVX2 Harley-Seal.
  */
-uint32_t count_set_bits(uint32_t n) {
-    uint32_t count = 0;
-    while (n) {
-        n &= (n - 1);  // Clear least significant set bit
-        count++;
-    }
-    return count;
-    
-    // Example: n = 0b10110
-    // Iteration 1: n &= 0b10101 -> n = 0b10100, count = 1
-    // Iteration 2: n &= 0b10011 -> n = 0b10000, count = 2
-    // Iteration 3: n &= 0b01111 -> n = 0b00000, count = 3
-}
-
-/**
- * Find first set bit (count trailing zeros)
- * 
- * Useful for: interrupt priority resolution, bitboard games
- * 
- * Returns: position of first set bit (0-31), or 32 if no bits set
- */
-uint32_t find_first_set(uint32_t n) {
-    if (n == 0) return 32;
-    
-    // Isolate lowest set bit
-    uint32_t isolated = n & (~n + 1);
-    
-    // Count trailing zeros (log2 of isolated bit)
-    uint32_t pos = 0;
-    while (isolated > 1) {
-        isolated >>= 1;
-        pos++;
-    }
-    return pos;
-    
-    // Modern: __builtin_ctz(n) for "count trailing zeros"
-}
-
-/**
- * Reverse bits in a 32-bit word
- * 
- * Useful for: protocols with LSB-first bit order, CRC calculations
- */
-uint32_t reverse_bits(uint32_t n) {
-    uint32_t result = 0;
-    for (int i = 0; i < 32; i++) {
-        result <<= 1;              // Make room for next bit
-        result |= (n & 1);         // Copy LSB
-        n >>= 1;                   // Move to next bit
-    }
-    return result;
-}
 
 /**
  * Check if number is power of 2
@@ -467,27 +394,11 @@ uint32_t align_up(uint32_t value, uint32_t alignment) {
  * ============================================================================
  */
 
-/**
- * Swap bytes in 16-bit value
- * 
- * Converts between big-endian and little-endian
- * Example: 0x1234 <-> 0x3412
+/*
+ * swap_bytes_16() / swap_bytes_32() / swap_bytes_64() live in bit_ops.h:
+ * one bswap (x86) or rev (ARM) instruction instead of four shift/mask
+ * pairs. Example: 0x12345678 <-> 0x78563412
  */
-uint16_t swap_bytes_16(uint16_t value) {
-    return (value >> 8) | (value << 8);
-}
-
-/**
- * Swap bytes in 32-bit value
- * 
- * Example: 0x12345678 <-> 0x78563412
- */
-uint32_t swap_bytes_32(uint32_t value) {
-    return ((value >> 24) & 0xFF) |
-           ((value >> 8)  & 0xFF00) |
-           ((value << 8)  & 0xFF0000) |
-           ((value << 24) & 0xFF000000);
-}
 
 /* ============================================================================
  * MAIN: Demonstration
@@ -539,6 +450,13 @@ int main(void) {
     
     field_write(&config, 8, 4, 0xA);
     printf("After writing 0xA to bits 8-11: 0x%08X\n", config);
+
+    // Scattered field: the 2-bit MODER fields of pins 1 and 3
+    uint32_t moder = 0x000000C4;    // Pin 1 = 0b01 (output), pin 3 = 0b11 (analog)
+    uint32_t pins_1_3 = 0x0000000Cu | 0x000000C0u;
+    uint32_t packed = bits_extract(moder, pins_1_3);
+    printf("bits_extract(MODER, pins 1+3) = 0x%X (pin 3 mode, pin 1 mode)\n", packed);
+    printf("bits_deposit(0x%X, same mask)  = 0x%08X\n", packed, bits_deposit(packed, pins_1_3));
     
     printf("\n");
     
@@ -548,6 +466,8 @@ int main(void) {
     printf("Number: 0b%s\n", "10110110");
     printf("Set bits: %u\n", count_set_bits(test));
     printf("First set bit position: %u\n", find_first_set(test));
+    printf("Leading zeros: %u\n", count_leading_zeros(test));
+    printf("Reversed: 0x%08X\n", reverse_bits(test));
     
     printf("\nPower of 2 tests:\n");
     printf("8 is power of 2: %s\n", is_power_of_2(8) ? "Yes" : "No");
@@ -570,6 +490,106 @@ int main(void) {
     printf("Original: 0x%08X\n", val32);
     printf("Swapped:  0x%08X\n", swap_bytes_32(val32));
     
+    printf("\n");
+
+    // Part 5: Bulk popcount (bitmap cardinality)
+    printf("--- Part 5: Bulk Popcount ---\n");
+    printf("(Timings are only meaningful with -O2: at -O0 nothing is inlined)\n");
+    size_t words = 1 << 20;     // 8MB bitmap = 64M bits
+    uint64_t* bitmap = malloc(words * sizeof(uint64_t));
+    if (bitmap != NULL) {
+        uint64_t state = 0x9E3779B97F4A7C15u;
+        for (size_t i = 0; i < words; i++) {
+            state ^= state << 13;   // xorshift64: random-looking bits
+            state ^= state >> 7;
+            state ^= state << 17;
+            bitmap[i] = state;
+        }
+        clock_t start = clock();
+        uint64_t scalar = 0;
+        for (int rep = 0; rep < 10; rep++) {
+            scalar += popcount_array_scalar(bitmap, words);
+        }
+        double scalar_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / 10;
+
+        start = clock();
+        uint64_t fast = 0;
+        for (int rep = 0; rep < 10; rep++) {
+            fast += popcount_array(bitmap, words);
+        }
+        double fast_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / 10;
+
+        printf("Set bits in %zu words: %llu\n", words, (unsigned long long)(fast / 10));
+        printf("  Word-at-a-time loop:     %.2f ms\n", scalar_ms);
+        printf("  popcount_array (%s): %.2f ms %s\n",
+#ifdef BIT_OPS_X86_DISPATCH
+               bit_ops_popcount_level() == 2 ? "AVX2  " : bit_ops_popcount_level() == 1 ? "POPCNT" : "scalar",
+#else
+               "scalar",
+#endif
+               fast_ms, fast == scalar ? "✓" : "✗ MISMATCH");
+        free(bitmap);
+    }
+
+    // Part 6: Compressed bitmaps (sets of millions of ids)
+    printf("\n--- Part 6: Compressed Bitmaps ---\n");
+    RoaringBitmap sparse, eighths, thirds, range;
+    roaring_init(&sparse);
+    roaring_init(&eighths);
+    roaring_init(&thirds);
+    roaring_init(&range);
+
+    bool ok = true;
+    uint64_t state = 0x2545F4914F6CDD1Du;
+    for (int i = 0; i < 1000000 && ok; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        ok = roaring_add(&sparse, (uint32_t)(state >> 32));    // Anywhere in 0..2^32
+    }
+    for (uint32_t id = 0; id < 8000000 && ok; id += 8) ok = roaring_add(&eighths, id);
+    for (uint32_t id = 0; id < 8000000 && ok; id += 3) ok = roaring_add(&thirds, id);
+    ok = ok && roaring_add_range(&range, 100000000, 101000000);
+    ok = ok && roaring_optimize(&sparse) && roaring_optimize(&eighths) && roaring_optimize(&range);
+
+    if (ok) {
+        printf("%-26s %10s %12s\n", "Set", "Ids", "Bytes");
+        printf("%-26s %10llu %12zu  (arrays)\n", "1M random ids",
+               (unsigned long long)roaring_cardinality(&sparse), roaring_memory_bytes(&sparse));
+        printf("%-26s %10llu %12zu  (bitsets)\n", "Every 8th id below 8M",
+               (unsigned long long)roaring_cardinality(&eighths), roaring_memory_bytes(&eighths));
+        printf("%-26s %10llu %12zu  (runs)\n", "Ids 100M..101M",
+               (unsigned long long)roaring_cardinality(&range), roaring_memory_bytes(&range));
+        printf("(1M ids as a bitset over 2^32: 512 MB, as sorted uint32_t: 4 MB)\n");
+
+        RoaringBitmap both;
+        if (roaring_and(&eighths, &thirds, &both)) {
+            printf("Every 8th AND every 3rd: %llu ids (and_cardinality: %llu), first:",
+                   (unsigned long long)roaring_cardinality(&both),
+                   (unsigned long long)roaring_and_cardinality(&eighths, &thirds));
+            RoaringIterator it;
+            uint32_t id;
+            roaring_iterator_init(&it, &both);
+            for (int i = 0; i < 5 && roaring_iterator_next(&it, &id); i++) printf(" %u", id);
+            printf("\n");
+            roaring_free(&both);
+        }
+        if (roaring_andnot(&eighths, &thirds, &both)) {
+            printf("Every 8th AND NOT every 3rd: %llu ids\n", (unsigned long long)roaring_cardinality(&both));
+            roaring_free(&both);
+        }
+        if (roaring_or(&range, &sparse, &both)) {
+            printf("Range OR random ids: %llu ids\n", (unsigned long long)roaring_cardinality(&both));
+            roaring_free(&both);
+        }
+    } else {
+        printf("Out of memory\n");
+    }
+    roaring_free(&sparse);
+    roaring_free(&eighths);
+    roaring_free(&thirds);
+    roaring_free(&range);
+
     printf("\n=================================================\n");
     printf("Key Takeaways:\n");
     printf("1. Master: set, clear, toggle, test\n");
@@ -577,6 +597,8 @@ int main(void) {
     printf("3. Use BSRR-style registers for atomic operations\n");
     printf("4. Prefer explicit bits over bit fields in structs\n");
     printf("5. Know your endianness for network protocols\n");
+    printf("6. Use intrinsics (bit_ops.h) for popcount/ctz/clz/bswap\n");
+    printf("7. Large id sets: pick array/bitset/run per chunk (roaring_bitmap.h)\n");
     printf("=================================================\n");
     
     return 0;
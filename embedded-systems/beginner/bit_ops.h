@@ -0,0 +1,485 @@
+/**
+ * ============================================================================
+ * bit_ops.h - Header-Only Intrinsic Bit Operations
+ * ============================================================================
+ *
+ * PURPOSE:
+ * The counting, scanning, reversing and byte-swapping helpers from
+ * bit_manipulation.c, mapped to the single instructions modern CPUs
+ * have for them:
+ *
+ *   Function             x86-64            ARM                Fallback
+ *   -------------------  ----------------  -----------------  ----------------
+ *   count_set_bits       popcnt            vcnt (A64) / SWAR  Kernighan loop
+ *   find_first_set       tzcnt / bsf       rbit + clz         shift loop
+ *   count_leading_zeros  lzcnt / bsr       clz                shift loop
+ *   reverse_bits         bswap + SWAR      rbit               32-step loop
+ *   swap_bytes_16/32/64  bswap / rol       rev                shifts + masks
+ *   bits_extract/deposit pext / pdep       (loop)             loop over mask
+ *
+ * Compiler builtins (GCC/Clang) and MSVC intrinsics are used when
+ * available; the portable loops are kept as the fallback and as the
+ * reference the fast paths must match.
+ *
+ * RUNTIME DISPATCH:
+ * bits_extract / bits_deposit (BMI2) and popcount_array (AVX2 / POPCNT)
+ * check the CPU once and pick the best version, so one binary runs on
+ * any x86-64. Single-word functions are resolved at compile time: a
+ * per-call dispatch would cost more than the instruction itself
+ * (build with -march=native to get popcnt/tzcnt/lzcnt inline).
+ *
+ * MEMORY IMPLICATIONS:
+ * - Everything is static inline: no library, nothing to link
+ * - popcount_array reads its input once, no extra memory
+ *
+ * CPU OVERHEAD (per 32-bit word):
+ * - Loops: 1 iteration per bit (up to 32)
+ * - Intrinsics: 1 instruction, 1-3 cycles
+ * - popcount_array (AVX2 Harley-Seal): ~0.1 cycles per 64-bit word
+ *
+ * ============================================================================
+ */
+
+#ifndef BIT_OPS_H
+#define BIT_OPS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BIT_OPS_BUILTINS 1
+#elif defined(_MSC_VER)
+#define BIT_OPS_MSVC 1
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) && defined(BIT_OPS_BUILTINS)
+#define BIT_OPS_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+/* ============================================================================
+ * Counting and scanning
+ * ============================================================================
+ */
+
+/**
+ * Count number of set bits (population count)
+ *
+ * Fallback: Brian Kernighan's algorithm, O(number of set bits)
+ *   n &= n - 1 clears the lowest set bit: 0b10110 -> 0b10100 -> 0b10000 -> 0
+ */
+static inline uint32_t count_set_bits(uint32_t n) {
+#if defined(BIT_OPS_BUILTINS)
+    return (uint32_t)__builtin_popcount(n);
+#elif defined(BIT_OPS_MSVC) && (defined(_M_X64) || defined(_M_IX86))
+    return __popcnt(n);
+#else
+    uint32_t count = 0;
+    while (n) {
+        n &= (n - 1);  // Clear least significant set bit
+        count++;
+    }
+    return count;
+#endif
+}
+
+static inline uint32_t count_set_bits_64(uint64_t n) {
+#if defined(BIT_OPS_BUILTINS)
+    return (uint32_t)__builtin_popcountll(n);
+#else
+    return count_set_bits((uint32_t)n) + count_set_bits((uint32_t)(n >> 32));
+#endif
+}
+
+/**
+ * Find first set bit (count trailing zeros)
+ * Returns: position of first set bit (0-31), or 32 if no bits set
+ */
+static inline uint32_t find_first_set(uint32_t n) {
+    if (n == 0) return 32;
+#if defined(BIT_OPS_BUILTINS)
+    return (uint32_t)__builtin_ctz(n);
+#elif defined(BIT_OPS_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, n);
+    return (uint32_t)index;
+#else
+    // Isolate lowest set bit, then take its log2
+    uint32_t isolated = n & (~n + 1);
+    uint32_t pos = 0;
+    while (isolated > 1) {
+        isolated >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+static inline uint32_t find_first_set_64(uint64_t n) {
+    if (n == 0) return 64;
+#if defined(BIT_OPS_BUILTINS)
+    return (uint32_t)__builtin_ctzll(n);
+#else
+    uint32_t low = find_first_set((uint32_t)n);
+    return low < 32 ? low : 32 + find_first_set((uint32_t)(n >> 32));
+#endif
+}
+
+/**
+ * Count leading zeros
+ * Returns: 0-31, or 32 if no bits set (same as the lzcnt instruction)
+ */
+static inline uint32_t count_leading_zeros(uint32_t n) {
+    if (n == 0) return 32;
+#if defined(BIT_OPS_BUILTINS)
+    return (uint32_t)__builtin_clz(n);
+#elif defined(BIT_OPS_MSVC)
+    unsigned long index;
+    _BitScanReverse(&index, n);
+    return 31u - (uint32_t)index;
+#else
+    uint32_t count = 0;
+    while ((n & 0x80000000u) == 0) {
+        n <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/* ============================================================================
+ * Byte and bit order
+ * ============================================================================
+ */
+
+/**
+ * Swap bytes (big-endian <-> little-endian)
+ * Example: 0x12345678 <-> 0x78563412
+ */
+static inline uint16_t swap_bytes_16(uint16_t value) {
+#if defined(BIT_OPS_BUILTINS)
+    return __builtin_bswap16(value);
+#else
+    return (uint16_t)((value >> 8) | (value << 8));
+#endif
+}
+
+static inline uint32_t swap_bytes_32(uint32_t value) {
+#if defined(BIT_OPS_BUILTINS)
+    return __builtin_bswap32(value);
+#elif defined(BIT_OPS_MSVC)
+    return _byteswap_ulong(value);
+#else
+    return ((value >> 24) & 0xFF) |
+           ((value >> 8)  & 0xFF00) |
+           ((value << 8)  & 0xFF0000) |
+           ((value << 24) & 0xFF000000);
+#endif
+}
+
+static inline uint64_t swap_bytes_64(uint64_t value) {
+#if defined(BIT_OPS_BUILTINS)
+    return __builtin_bswap64(value);
+#elif defined(BIT_OPS_MSVC)
+    return _byteswap_uint64(value);
+#else
+    return ((uint64_t)swap_bytes_32((uint32_t)value) << 32) | swap_bytes_32((uint32_t)(value >> 32));
+#endif
+}
+
+/**
+ * Reverse bits in a 32-bit word (LSB-first protocols, CRC tables)
+ */
+static inline uint32_t reverse_bits(uint32_t n) {
+#if defined(BIT_OPS_BUILTINS) && defined(__aarch64__)
+    uint32_t result;
+    __asm__("rbit %w0, %w1" : "=r"(result) : "r"(n));
+    return result;
+#elif defined(BIT_OPS_BUILTINS) && defined(__ARM_FEATURE_CLZ) && \
+      defined(__ARM_ARCH_ISA_THUMB) && __ARM_ARCH_ISA_THUMB >= 2
+    // rbit came with Thumb-2 (ARMv6T2): Cortex-A/R, M3/M4/M7, ARMv8-M
+    // Mainline. M0/M0+/M23 (v6-M, v8-M Baseline) take the portable path.
+    uint32_t result;
+    __asm__("rbit %0, %1" : "=r"(result) : "r"(n));
+    return result;
+#elif defined(BIT_OPS_BUILTINS)
+    // No rbit on x86: reverse the bytes, then the bits inside each byte
+    n = __builtin_bswap32(n);
+    n = ((n >> 4) & 0x0F0F0F0Fu) | ((n & 0x0F0F0F0Fu) << 4);
+    n = ((n >> 2) & 0x33333333u) | ((n & 0x33333333u) << 2);
+    n = ((n >> 1) & 0x55555555u) | ((n & 0x55555555u) << 1);
+    return n;
+#else
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i++) {
+        result <<= 1;              // Make room for next bit
+        result |= (n & 1);         // Copy LSB
+        n >>= 1;                   // Move to next bit
+    }
+    return result;
+#endif
+}
+
+/* ============================================================================
+ * Bit fields
+ * ============================================================================
+ */
+
+/**
+ * Mask of the low num_bits bits (num_bits = 32 gives all ones;
+ * 1U << 32 would be undefined behavior)
+ */
+static inline uint32_t low_mask_32(uint8_t num_bits) {
+    return num_bits >= 32 ? 0xFFFFFFFFu : (1U << num_bits) - 1;
+}
+
+/**
+ * Read multi-bit field from register
+ *
+ * @param reg       Register value
+ * @param start_bit Starting bit position (LSB of field)
+ * @param num_bits  Number of bits in field (1-32)
+ * @return          Field value (right-justified)
+ *
+ * CPU: shift + and (a single bextr with BMI1)
+ */
+static inline uint32_t field_read(uint32_t reg, uint8_t start_bit, uint8_t num_bits) {
+    return (reg >> start_bit) & low_mask_32(num_bits);
+}
+
+/**
+ * Write multi-bit field to register, preserving all other bits
+ */
+static inline void field_write(uint32_t* reg, uint8_t start_bit, uint8_t num_bits, uint32_t value) {
+    uint32_t mask = low_mask_32(num_bits);
+    *reg = (*reg & ~(mask << start_bit)) | ((value & mask) << start_bit);
+}
+
+#ifdef BIT_OPS_X86_DISPATCH
+static inline bool bit_ops_cpu_has_bmi2(void) {
+    static int has_bmi2 = -1;
+    if (has_bmi2 < 0) {
+        has_bmi2 = __builtin_cpu_supports("bmi2") ? 1 : 0;
+    }
+    return has_bmi2 != 0;
+}
+
+__attribute__((target("bmi2")))
+static inline uint32_t bits_extract_bmi2(uint32_t value, uint32_t mask) {
+    return _pext_u32(value, mask);
+}
+
+__attribute__((target("bmi2")))
+static inline uint32_t bits_deposit_bmi2(uint32_t value, uint32_t mask) {
+    return _pdep_u32(value, mask);
+}
+#endif
+
+/**
+ * Gather the bits of 'value' selected by 'mask' into the low bits
+ * (pext). Unlike field_read the field may be scattered:
+ *   bits_extract(0b1011'0110, 0b1111'0000) = 0b1011
+ *   bits_extract(MODER, 0x0000000C | 0x000000C0) = mode of pins 1 and 3
+ *
+ * CPU: 1 instruction with BMI2 (Intel Haswell+, AMD Zen 3+; microcoded
+ * and slow on Zen 1/2), otherwise one loop iteration per mask bit.
+ */
+static inline uint32_t bits_extract(uint32_t value, uint32_t mask) {
+#ifdef BIT_OPS_X86_DISPATCH
+    if (bit_ops_cpu_has_bmi2()) {
+        return bits_extract_bmi2(value, mask);
+    }
+#endif
+    uint32_t result = 0;
+    for (uint32_t out_bit = 1; mask != 0; out_bit <<= 1) {
+        uint32_t lowest = mask & (~mask + 1);
+        if (value & lowest) {
+            result |= out_bit;
+        }
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+/**
+ * Scatter the low bits of 'value' into the positions set in 'mask'
+ * (pdep): the inverse of bits_extract
+ */
+static inline uint32_t bits_deposit(uint32_t value, uint32_t mask) {
+#ifdef BIT_OPS_X86_DISPATCH
+    if (bit_ops_cpu_has_bmi2()) {
+        return bits_deposit_bmi2(value, mask);
+    }
+#endif
+    uint32_t result = 0;
+    for (uint32_t in_bit = 1; mask != 0; in_bit <<= 1) {
+        uint32_t lowest = mask & (~mask + 1);
+        if (value & in_bit) {
+            result |= lowest;
+        }
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+/* ============================================================================
+ * Bulk population count
+ * ============================================================================
+ */
+
+/**
+ * Portable 64-bit popcount without a loop per bit (SWAR)
+ */
+static inline uint64_t popcount_swar_64(uint64_t x) {
+    x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+    x = (x & UINT64_C(0x3333333333333333)) + ((x >> 2) & UINT64_C(0x3333333333333333));
+    x = (x + (x >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    return (x * UINT64_C(0x0101010101010101)) >> 56;
+}
+
+static inline uint64_t popcount_array_scalar(const uint64_t* words, size_t count) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+#if defined(BIT_OPS_BUILTINS)
+        total += (uint64_t)__builtin_popcountll(words[i]);
+#else
+        total += popcount_swar_64(words[i]);
+#endif
+    }
+    return total;
+}
+
+#ifdef BIT_OPS_X86_DISPATCH
+/**
+ * POPCNT instruction, four independent accumulators (popcnt has 3-cycle
+ * latency but 1/cycle throughput)
+ */
+__attribute__((target("popcnt")))
+static inline uint64_t popcount_array_popcnt(const uint64_t* words, size_t count) {
+    uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    size_t blocked = count - count % 4;     // No i + 4 that could wrap
+    size_t i = 0;
+    for (; i < blocked; i += 4) {
+        c0 += (uint64_t)__builtin_popcountll(words[i]);
+        c1 += (uint64_t)__builtin_popcountll(words[i + 1]);
+        c2 += (uint64_t)__builtin_popcountll(words[i + 2]);
+        c3 += (uint64_t)__builtin_popcountll(words[i + 3]);
+    }
+    for (; i < count; ++i) {
+        c0 += (uint64_t)__builtin_popcountll(words[i]);
+    }
+    return c0 + c1 + c2 + c3;
+}
+
+/**
+ * Per-64-bit-lane popcount of a 256-bit vector (Mula): each nibble
+ * indexes a 16-entry table with vpshufb, vpsadbw sums the bytes
+ */
+__attribute__((target("avx2")))
+static inline __m256i popcount_256(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_and_si256(v, low_nibbles);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi32(v, 4), low_nibbles);
+    __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+/**
+ * Carry-save adder: 3 inputs -> sum bit (low) and carry bit (high),
+ * bit-parallel across all 256 positions
+ */
+__attribute__((target("avx2")))
+static inline void carry_save_add(__m256i* high, __m256i* low, __m256i a, __m256i b, __m256i c) {
+    __m256i u = _mm256_xor_si256(a, b);
+    *high = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    *low = _mm256_xor_si256(u, c);
+}
+
+/**
+ * Harley-Seal: a tree of carry-save adders turns 16 input vectors into
+ * 'ones', 'twos', 'fours', 'eights' and one 'sixteens' vector, so only
+ * one vector per 16 needs an actual popcount
+ */
+__attribute__((target("avx2")))
+static inline uint64_t popcount_array_avx2(const uint64_t* words, size_t count) {
+    const __m256i* data = (const __m256i*)words;
+    size_t vectors = count / 4;
+    __m256i total = _mm256_setzero_si256();
+    __m256i ones = _mm256_setzero_si256();
+    __m256i twos = _mm256_setzero_si256();
+    __m256i fours = _mm256_setzero_si256();
+    __m256i eights = _mm256_setzero_si256();
+    __m256i sixteens, twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+    size_t blocked = vectors - vectors % 16;
+    size_t i = 0;
+
+#define BIT_OPS_LOAD(k) _mm256_loadu_si256(data + i + (k))
+    for (; i < blocked; i += 16) {
+        carry_save_add(&twos_a, &ones, ones, BIT_OPS_LOAD(0), BIT_OPS_LOAD(1));
+        carry_save_add(&twos_b, &ones, ones, BIT_OPS_LOAD(2), BIT_OPS_LOAD(3));
+        carry_save_add(&fours_a, &twos, twos, twos_a, twos_b);
+        carry_save_add(&twos_a, &ones, ones, BIT_OPS_LOAD(4), BIT_OPS_LOAD(5));
+        carry_save_add(&twos_b, &ones, ones, BIT_OPS_LOAD(6), BIT_OPS_LOAD(7));
+        carry_save_add(&fours_b, &twos, twos, twos_a, twos_b);
+        carry_save_add(&eights_a, &fours, fours, fours_a, fours_b);
+        carry_save_add(&twos_a, &ones, ones, BIT_OPS_LOAD(8), BIT_OPS_LOAD(9));
+        carry_save_add(&twos_b, &ones, ones, BIT_OPS_LOAD(10), BIT_OPS_LOAD(11));
+        carry_save_add(&fours_a, &twos, twos, twos_a, twos_b);
+        carry_save_add(&twos_a, &ones, ones, BIT_OPS_LOAD(12), BIT_OPS_LOAD(13));
+        carry_save_add(&twos_b, &ones, ones, BIT_OPS_LOAD(14), BIT_OPS_LOAD(15));
+        carry_save_add(&fours_b, &twos, twos, twos_a, twos_b);
+        carry_save_add(&eights_b, &fours, fours, fours_a, fours_b);
+        carry_save_add(&sixteens, &eights, eights, eights_a, eights_b);
+        total = _mm256_add_epi64(total, popcount_256(sixteens));
+    }
+#undef BIT_OPS_LOAD
+
+    // Weight each partial count by its place value
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_256(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_256(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_256(twos), 1));
+    total = _mm256_add_epi64(total, popcount_256(ones));
+    for (; i < vectors; ++i) {
+        total = _mm256_add_epi64(total, popcount_256(_mm256_loadu_si256(data + i)));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, total);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           popcount_array_popcnt(words + vectors * 4, count - vectors * 4);
+}
+
+static inline int bit_ops_popcount_level(void) {
+    static int level = -1;         // 2 = AVX2, 1 = POPCNT, 0 = neither
+    if (level < 0) {
+        level = __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("popcnt") ? 1 : 0;
+    }
+    return level;
+}
+#endif
+
+/**
+ * Total set bits in an array of 64-bit words (bitmap cardinality)
+ *
+ * Dispatch: AVX2 Harley-Seal, else POPCNT, else builtin/SWAR loop.
+ * Small arrays skip the vector setup.
+ */
+static inline uint64_t popcount_array(const uint64_t* words, size_t count) {
+#ifdef BIT_OPS_X86_DISPATCH
+    int level = bit_ops_popcount_level();
+    if (level == 2 && count >= 64) {
+        return popcount_array_avx2(words, count);
+    }
+    if (level >= 1) {
+        return popcount_array_popcnt(words, count);
+    }
+#endif
+    return popcount_array_scalar(words, count);
+}
+
+#endif /* BIT_OPS_H */
@@ -0,0 +1,183 @@
+/**
+ * ============================================================================
+ * event_wait.h - Portable Wait / Notify (WFE, futex, WaitOnAddress)
+ * ============================================================================
+ *
+ * PURPOSE:
+ * Replace "while (!flag) { }" spin loops with a wait that SLEEPS until the
+ * code that sets the flag (an ISR, another thread) says something changed.
+ *
+ * CONCEPT:
+ * An EventSignal is a 32-bit sequence number. The notifier bumps it after
+ * changing the condition; a waiter remembers the number it saw, checks the
+ * condition, and sleeps only while the number is unchanged. A notify that
+ * lands between the check and the sleep changes the number, so the sleep
+ * returns at once: no lost wakeups.
+ *
+ *   Platform          Sleep                     Wake
+ *   ----------------  ------------------------  -------------------------
+ *   Cortex-M          WFE (event register)      SEV, or any interrupt
+ *   Linux             futex(FUTEX_WAIT)         futex(FUTEX_WAKE)
+ *   Windows 8+        WaitOnAddress             WakeByAddressAll
+ *   Other hosted      nanosleep, 50us -> 1ms    (polled)
+ *
+ * Every wait starts with a short bounded spin (EVENT_SPIN_LIMIT polls with
+ * a pause/yield hint): if the condition flips within a few microseconds
+ * the waiter never pays for a sleep / wake round trip.
+ *
+ * MEMORY IMPLICATIONS:
+ * - One EventSignal = 8 bytes (sequence + waiter count), no allocation
+ *
+ * CPU OVERHEAD:
+ * - Busy-wait:        100% of a core (hosted) / full run current (board)
+ * - event_wait:       0% while blocked; WFE stops the core clock
+ * - event_notify:     one atomic add; the wake syscall is skipped when
+ *                     nobody is sleeping
+ *
+ * Cortex-M note: event_notify() from an ISR uses a plain load + store (M0
+ * has no atomic read-modify-write). That is safe as long as the signal is
+ * only notified from one interrupt priority.
+ *
+ * ============================================================================
+ */
+
+#ifndef EVENT_WAIT_H
+#define EVENT_WAIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#if defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+#define EVENT_WAIT_CORTEX_M 1
+#elif defined(__linux__)
+#define EVENT_WAIT_FUTEX 1
+#include <limits.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#elif defined(_WIN32)
+#define EVENT_WAIT_WINDOWS 1
+#include <windows.h>                // Link with Synchronization.lib
+#elif defined(__unix__) || defined(__APPLE__)
+#define EVENT_WAIT_NANOSLEEP 1
+#include <time.h>
+#endif
+
+#define EVENT_SPIN_LIMIT 64         // Polls before going to sleep
+
+typedef struct {
+    atomic_uint_least32_t sequence;
+    atomic_uint_least32_t waiters;  // Threads inside the sleep call (hosted)
+} EventSignal;
+
+#define EVENT_SIGNAL_INIT { 0, 0 }
+
+static inline void event_signal_init(EventSignal* signal) {
+    atomic_init(&signal->sequence, 0);
+    atomic_init(&signal->waiters, 0);
+}
+
+/**
+ * CPU hint for spin loops (x86 pause, ARM yield): saves power and lets
+ * the other hyperthread run
+ */
+static inline void event_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __asm__ volatile("pause");
+#elif (defined(__aarch64__) || defined(__ARM_ARCH)) && (defined(__GNUC__) || defined(__clang__))
+    __asm__ volatile("yield");
+#elif defined(_MSC_VER)
+    YieldProcessor();
+#endif
+}
+
+/**
+ * Sequence number to pass to event_wait(). Read it BEFORE checking the
+ * condition.
+ */
+static inline uint32_t event_prepare(EventSignal* signal) {
+    return (uint32_t)atomic_load_explicit(&signal->sequence, memory_order_acquire);
+}
+
+/**
+ * Sleep until the sequence differs from 'seen'. May return early
+ * (spurious wakeup): always re-check the condition.
+ */
+static inline void event_wait(EventSignal* signal, uint32_t seen) {
+#if defined(EVENT_WAIT_CORTEX_M)
+    while (atomic_load_explicit(&signal->sequence, memory_order_acquire) == seen) {
+        __asm__ volatile("wfe" ::: "memory");     // Event register latches an earlier SEV
+    }
+#elif defined(EVENT_WAIT_FUTEX)
+    atomic_fetch_add(&signal->waiters, 1);
+    // The kernel re-checks *sequence == seen atomically before sleeping
+    syscall(SYS_futex, (uint32_t*)&signal->sequence, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+    atomic_fetch_sub(&signal->waiters, 1);
+#elif defined(EVENT_WAIT_WINDOWS)
+    atomic_fetch_add(&signal->waiters, 1);
+    WaitOnAddress((volatile VOID*)&signal->sequence, &seen, sizeof(seen), INFINITE);
+    atomic_fetch_sub(&signal->waiters, 1);
+#elif defined(EVENT_WAIT_NANOSLEEP)
+    long nanoseconds = 50000;
+    while (atomic_load_explicit(&signal->sequence, memory_order_acquire) == seen) {
+        struct timespec delay = { 0, nanoseconds };
+        nanosleep(&delay, NULL);
+        if (nanoseconds < 1000000) nanoseconds *= 2;
+    }
+#else
+    while (atomic_load_explicit(&signal->sequence, memory_order_acquire) == seen) {
+        event_cpu_relax();
+    }
+#endif
+}
+
+/**
+ * Wake every waiter. Call AFTER changing the condition.
+ */
+static inline void event_notify(EventSignal* signal) {
+#if defined(EVENT_WAIT_CORTEX_M)
+    uint32_t next = (uint32_t)atomic_load_explicit(&signal->sequence, memory_order_relaxed) + 1;
+    atomic_store_explicit(&signal->sequence, next, memory_order_release);
+    __asm__ volatile("dsb\n\tsev" ::: "memory");
+#else
+    atomic_fetch_add(&signal->sequence, 1);
+    if (atomic_load(&signal->waiters) == 0) return;    // Nobody asleep: skip the syscall
+#if defined(EVENT_WAIT_FUTEX)
+    syscall(SYS_futex, (uint32_t*)&signal->sequence, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#elif defined(EVENT_WAIT_WINDOWS)
+    WakeByAddressAll((PVOID)&signal->sequence);
+#endif
+#endif
+}
+
+/**
+ * One backoff step for a wait loop: spin for the first EVENT_SPIN_LIMIT
+ * steps, then sleep
+ */
+static inline void event_backoff(EventSignal* signal, uint32_t seen, uint32_t* spins) {
+    if (*spins < EVENT_SPIN_LIMIT) {
+        (*spins)++;
+        event_cpu_relax();
+    } else {
+        event_wait(signal, seen);
+    }
+}
+
+/**
+ * Block until 'condition' is true. Whoever makes it true must call
+ * event_notify(signal) afterwards.
+ *
+ *   EVENT_WAIT_UNTIL(&uart_event, data_ready);
+ */
+#define EVENT_WAIT_UNTIL(signal, condition)                     \
+    do {                                                        \
+        uint32_t event_spins_ = 0;                              \
+        for (;;) {                                              \
+            uint32_t event_seen_ = event_prepare(signal);       \
+            if (condition) break;                               \
+            event_backoff((signal), event_seen_, &event_spins_); \
+        }                                                       \
+    } while (0)
+
+#endif /* EVENT_WAIT_H */
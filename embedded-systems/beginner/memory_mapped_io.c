@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "event_wait.h"
 
 /* ============================================================================
  * PART 1: Understanding Memory-Mapped I/O
@@ -140,14 +141,129 @@ typedef struct {
  * ============================================================================
  */
 
+/**
+ * Spread a 16-bit pin mask to the 2-bit-per-pin layout of MODER, OSPEEDR
+ * and PUPDR: pin n -> bit 2n (0b1011 -> 0b01000101)
+ */
+static inline uint32_t gpio_spread_2bit(uint16_t pins) {
+    uint32_t x = pins;
+    x = (x | (x << 8)) & 0x00FF00FFU;
+    x = (x | (x << 4)) & 0x0F0F0F0FU;
+    x = (x | (x << 2)) & 0x33333333U;
+    x = (x | (x << 1)) & 0x55555555U;
+    return x;
+}
+
+/**
+ * RAM copy of a port's configuration registers
+ * 
+ * Configuring pins one by one costs a read-modify-write of 4 registers
+ * per pin (8 data pins: 32 bus reads + 32 writes). With a shadow the
+ * registers are read once, edited in RAM, and only the changed ones are
+ * written back once.
+ * 
+ * Valid only while nothing else (an ISR, another driver) writes these
+ * registers between gpio_shadow_load() and gpio_shadow_commit().
+ */
+typedef struct {
+    GPIO_TypeDef* gpio;
+    uint32_t moder;
+    uint32_t otyper;
+    uint32_t ospeedr;
+    uint32_t pupdr;
+    uint8_t dirty;                  // GPIO_SHADOW_* bits of registers to write
+} GpioShadow;
+
+#define GPIO_SHADOW_MODER   (1U << 0)
+#define GPIO_SHADOW_OTYPER  (1U << 1)
+#define GPIO_SHADOW_OSPEEDR (1U << 2)
+#define GPIO_SHADOW_PUPDR   (1U << 3)
+
+void gpio_shadow_load(GpioShadow* shadow, GPIO_TypeDef* gpio) {
+    shadow->gpio = gpio;
+    shadow->moder = gpio->MODER;
+    shadow->otyper = gpio->OTYPER;
+    shadow->ospeedr = gpio->OSPEEDR;
+    shadow->pupdr = gpio->PUPDR;
+    shadow->dirty = 0;
+}
+
+/**
+ * Replace the 2-bit fields of 'pins' in a shadow register
+ */
+static void gpio_shadow_field(GpioShadow* shadow, uint32_t* reg, uint8_t flag,
+                              uint16_t pins, uint32_t value_2bit) {
+    uint32_t lanes = gpio_spread_2bit(pins);
+    uint32_t updated = (*reg & ~(lanes * 3U)) | (lanes * value_2bit);
+    if (updated != *reg) {
+        *reg = updated;
+        shadow->dirty |= flag;
+    }
+}
+
+/**
+ * Shadow edits: push-pull, high-speed outputs / inputs with optional pull-up
+ */
+void gpio_shadow_outputs(GpioShadow* shadow, uint16_t pins) {
+    gpio_shadow_field(shadow, &shadow->moder, GPIO_SHADOW_MODER, pins, GPIO_MODE_OUTPUT);
+    gpio_shadow_field(shadow, &shadow->ospeedr, GPIO_SHADOW_OSPEEDR, pins, GPIO_SPEED_HIGH);
+    gpio_shadow_field(shadow, &shadow->pupdr, GPIO_SHADOW_PUPDR, pins, GPIO_PUPD_NONE);
+    if (shadow->otyper & pins) {
+        shadow->otyper &= ~(uint32_t)pins;  // Push-pull
+        shadow->dirty |= GPIO_SHADOW_OTYPER;
+    }
+}
+
+void gpio_shadow_inputs(GpioShadow* shadow, uint16_t pins, bool pullup) {
+    gpio_shadow_field(shadow, &shadow->moder, GPIO_SHADOW_MODER, pins, GPIO_MODE_INPUT);
+    gpio_shadow_field(shadow, &shadow->pupdr, GPIO_SHADOW_PUPDR, pins,
+                      pullup ? GPIO_PUPD_PULLUP : GPIO_PUPD_NONE);
+}
+
+/**
+ * Write back the registers that changed
+ * Returns: number of register writes
+ * 
+ * Order: speed, type and pulls first, MODER last, so a pin never drives
+ * its output with a stale configuration
+ */
+int gpio_shadow_commit(GpioShadow* shadow) {
+    int writes = 0;
+    GPIO_TypeDef* gpio = shadow->gpio;
+    if (shadow->dirty & GPIO_SHADOW_OSPEEDR) { gpio->OSPEEDR = shadow->ospeedr; writes++; }
+    if (shadow->dirty & GPIO_SHADOW_OTYPER)  { gpio->OTYPER = shadow->otyper;   writes++; }
+    if (shadow->dirty & GPIO_SHADOW_PUPDR)   { gpio->PUPDR = shadow->pupdr;     writes++; }
+    if (shadow->dirty & GPIO_SHADOW_MODER)   { gpio->MODER = shadow->moder;     writes++; }
+    shadow->dirty = 0;
+    return writes;
+}
+
+/**
+ * Configure all 'pins' of a port in one pass (4 reads, <= 4 writes):
+ * the batched forms of gpio_init_output() / gpio_init_input()
+ */
+int gpio_init_outputs(GPIO_TypeDef* gpio, uint16_t pins) {
+    GpioShadow shadow;
+    gpio_shadow_load(&shadow, gpio);
+    gpio_shadow_outputs(&shadow, pins);
+    return gpio_shadow_commit(&shadow);
+}
+
+int gpio_init_inputs(GPIO_TypeDef* gpio, uint16_t pins, bool pullup) {
+    GpioShadow shadow;
+    gpio_shadow_load(&shadow, gpio);
+    gpio_shadow_inputs(&shadow, pins, pullup);
+    return gpio_shadow_commit(&shadow);
+}
+
 /**
  * Configure a GPIO pin as output
  * 
  * @param gpio Pointer to GPIO port (GPIOA, GPIOB, etc.)
  * @param pin  Pin number (0-15)
  * 
- * Memory: Modifies 4 hardware registers
- * CPU: ~20-30 cycles total (4 read-modify-write operations)
+ * Memory: Reads 4 hardware registers, writes only those that change
+ * CPU: ~15-30 cycles total (4 reads, up to 4 writes)
  * 
  * WHY THIS MATTERS:
  * - Each register access goes to hardware, not cached
@@ -155,26 +271,13 @@ typedef struct {
  * - Atomic operations at bit level (other pins unaffected)
  */
 void gpio_init_output(GPIO_TypeDef* gpio, uint8_t pin) {
-    // 1. Configure pin mode (2 bits per pin)
-    uint32_t mode = gpio->MODER;
-    mode &= ~(0x3U << (pin * 2));            // Clear 2 bits
-    mode |= (GPIO_MODE_OUTPUT << (pin * 2)); // Set as output
-    gpio->MODER = mode;
-    
-    // 2. Configure output type (1 bit per pin)
-    gpio->OTYPER &= ~(1U << pin);            // Push-pull (0)
-    
-    // 3. Configure speed (2 bits per pin)
-    uint32_t speed = gpio->OSPEEDR;
-    speed &= ~(0x3U << (pin * 2));
-    speed |= (GPIO_SPEED_HIGH << (pin * 2));
-    gpio->OSPEEDR = speed;
-    
-    // 4. Configure pull-up/pull-down (2 bits per pin)
-    uint32_t pupd = gpio->PUPDR;
-    pupd &= ~(0x3U << (pin * 2));
-    pupd |= (GPIO_PUPD_NONE << (pin * 2));
-    gpio->PUPDR = pupd;
+    // 1. Mode = output (2 bits per pin)
+    // 2. Output type = push-pull (1 bit per pin)
+    // 3. Speed = high (2 bits per pin)
+    // 4. No pull-up/pull-down (2 bits per pin)
+    // Edited in a shadow copy: each register is read once and written
+    // back only if it changed, MODER last
+    gpio_init_outputs(gpio, (uint16_t)(1U << pin));
 }
 
 /**
@@ -183,18 +286,8 @@ void gpio_init_output(GPIO_TypeDef* gpio, uint8_t pin) {
  * Similar to output but sets mode differently
  */
 void gpio_init_input(GPIO_TypeDef* gpio, uint8_t pin, bool pullup) {
-    // Configure mode as input
-    uint32_t mode = gpio->MODER;
-    mode &= ~(0x3U << (pin * 2));            // Input = 00
-    gpio->MODER = mode;
-    
-    // Configure pull resistor
-    uint32_t pupd = gpio->PUPDR;
-    pupd &= ~(0x3U << (pin * 2));
-    if (pullup) {
-        pupd |= (GPIO_PUPD_PULLUP << (pin * 2));
-    }
-    gpio->PUPDR = pupd;
+    // Mode = input (00), pull-up optional; MODER/PUPDR read once each
+    gpio_init_inputs(gpio, (uint16_t)(1U << pin), pullup);
 }
 
 /**
@@ -265,6 +358,116 @@ bool gpio_read(GPIO_TypeDef* gpio, uint8_t pin) {
     // Always read IDR for input, even on output pins (read-back)
 }
 
+/* ============================================================================
+ * PART 3b: Port-Level Writes, Shadow Registers, Waveforms
+ * ============================================================================
+ * 
+ * The functions above move ONE pin per bus transaction. BSRR takes all 16
+ * pins at once: bits 0-15 set, bits 16-31 clear, in a single write. An
+ * 8-bit parallel bus written pin by pin needs 8 transactions per byte
+ * (and the pins change at 8 different times); one BSRR word needs 1.
+ */
+
+/**
+ * BSRR word that sets 'set_mask' pins and clears 'clear_mask' pins
+ * (if a pin is in both, set wins - STM32 hardware rule)
+ */
+static inline uint32_t gpio_bsrr_word(uint16_t set_mask, uint16_t clear_mask) {
+    return (uint32_t)set_mask | ((uint32_t)clear_mask << 16);
+}
+
+/**
+ * Set and clear any pins of a port in one atomic write
+ * 
+ * CPU: ~2-4 cycles regardless of how many pins change
+ */
+void gpio_port_write(GPIO_TypeDef* gpio, uint16_t set_mask, uint16_t clear_mask) {
+    gpio->BSRR = gpio_bsrr_word(set_mask, clear_mask);
+}
+
+/**
+ * BSRR word that puts 'value' on pins first_pin .. first_pin + width - 1
+ * (a parallel bus), leaving other pins alone
+ */
+static inline uint32_t gpio_bus_word(uint8_t first_pin, uint8_t width, uint16_t value) {
+    uint16_t mask = (uint16_t)((((uint32_t)1 << width) - 1) << first_pin);
+    uint16_t bits = (uint16_t)(value << first_pin);
+    return gpio_bsrr_word(bits & mask, (uint16_t)(~bits & mask));
+}
+
+void gpio_bus_write(GPIO_TypeDef* gpio, uint8_t first_pin, uint8_t width, uint16_t value) {
+    gpio->BSRR = gpio_bus_word(first_pin, width, value);
+}
+
+/**
+ * Toggle several pins: read ODR once, write BSRR once. Unlike
+ * "ODR ^= mask" no other pin can be lost if an ISR changes it meanwhile.
+ */
+void gpio_port_toggle(GPIO_TypeDef* gpio, uint16_t mask) {
+    uint16_t odr = (uint16_t)gpio->ODR;
+    gpio->BSRR = gpio_bsrr_word((uint16_t)(~odr & mask), (uint16_t)(odr & mask));
+}
+
+/**
+ * Waveform player: stream precomputed BSRR words to a port
+ * 
+ * All the bit work (masks, strobes) happens once when the table is
+ * built; playback is one load + one store per step. Steps are paced by
+ * the Cortex-M3+ DWT cycle counter (call dwt_cycle_counter_enable()
+ * first); 0 cycles = as fast as the bus allows.
+ * 
+ * Zero-CPU alternative on STM32: a timer update event triggering a DMA
+ * stream from the table to &GPIOx->BSRR.
+ */
+#define DEMCR           (*(volatile uint32_t*)0xE000EDFC)  // Debug exception control
+#define DWT_CTRL        (*(volatile uint32_t*)0xE0001000)
+#define DWT_CYCCNT      (*(volatile uint32_t*)0xE0001004)
+#define DEMCR_TRCENA    (1U << 24)
+#define DWT_CYCCNTENA   (1U << 0)
+
+void dwt_cycle_counter_enable(void) {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CYCCNTENA;
+}
+
+void gpio_waveform_play(GPIO_TypeDef* gpio, const uint32_t* words, size_t count,
+                        uint32_t cycles_per_step) {
+    if (cycles_per_step == 0) {
+        for (size_t i = 0; i < count; i++) {
+            gpio->BSRR = words[i];
+        }
+        return;
+    }
+    uint32_t next = DWT_CYCCNT;
+    for (size_t i = 0; i < count; i++) {
+        while ((int32_t)(DWT_CYCCNT - next) < 0) {
+            // Wait for this step's time slot (wraps correctly)
+        }
+        gpio->BSRR = words[i];
+        next += cycles_per_step;
+    }
+}
+
+/**
+ * Build the table for writing 'count' bytes to an 8-bit bus on pins
+ * first_pin .. first_pin + 7 with an active-low write strobe (device
+ * latches on the rising edge):
+ *   step 1: data on the bus, strobe LOW
+ *   step 2: strobe HIGH
+ * 'words' must hold 2 * count entries.
+ * Returns: number of words written
+ */
+size_t gpio_waveform_build_bus8(uint32_t* words, const uint8_t* bytes, size_t count,
+                                uint8_t first_pin, uint8_t strobe_pin) {
+    uint16_t strobe = (uint16_t)(1U << strobe_pin);
+    for (size_t i = 0; i < count; i++) {
+        words[2 * i] = gpio_bus_word(first_pin, 8, bytes[i]) | gpio_bsrr_word(0, strobe);
+        words[2 * i + 1] = gpio_bsrr_word(strobe, 0);
+    }
+    return 2 * count;
+}
+
 /* ============================================================================
  * PART 4: Real-World Example - LED Blink
  * ============================================================================
@@ -312,48 +515,163 @@ void blink_led_example(void) {
  * ============================================================================
  */
 
+/**
+ * Debouncing all 16 pins of a port at once (vertical counters)
+ * 
+ * A mechanical contact bounces for 1-10 ms. Instead of stopping the CPU
+ * for 10 ms per read, sample the port every 1 ms tick and accept a new
+ * level only after it was seen on 4 consecutive ticks.
+ * 
+ * Each pin needs a 2-bit counter. Stored "vertically" - bit n of count0
+ * and bit n of count1 form pin n's counter - the 16 counters update
+ * together with a handful of AND/XOR operations:
+ * 
+ *   changed = state ^ sample       pins that differ from the debounced level
+ *   counter: reset to 3 where not changed, else count down (3, 2, 1, 0)
+ *   pins whose counter reached 0 on this tick flip 'state'
+ * 
+ * Memory: 8 bytes per port
+ * CPU: ~10 instructions per tick for 16 pins; reading is one load
+ */
+typedef struct {
+    volatile uint16_t state;        // Debounced level, bit per pin
+    uint16_t count0, count1;        // Vertical 2-bit counters
+    volatile uint16_t press_toggle; // Bit flips on every debounced HIGH -> LOW
+} PortDebouncer;
+
+void debouncer_init(PortDebouncer* d, uint16_t initial_level) {
+    d->state = initial_level;
+    d->count0 = 0xFFFF;             // Counters start at 3
+    d->count1 = 0xFFFF;
+    d->press_toggle = 0;
+}
+
+/**
+ * Feed one sample (call from a periodic tick, e.g. SysTick at 1 kHz)
+ * Returns: pins whose debounced level changed on this tick
+ */
+uint16_t debouncer_tick(PortDebouncer* d, uint16_t sample) {
+    uint16_t changed = d->state ^ sample;
+    d->count0 = (uint16_t)~(d->count0 & changed);           // Count down where changed,
+    d->count1 = (uint16_t)(d->count0 ^ (d->count1 & changed)); // reset to 3 elsewhere
+    uint16_t flipped = changed & d->count0 & d->count1;     // Wrapped past 0: 4 ticks stable
+    uint16_t state = d->state ^ flipped;
+    d->state = state;
+    d->press_toggle ^= flipped & ~state;                    // Falling edges (active-low press)
+    return flipped;
+}
+
+/**
+ * Debounced level of every pin: non-blocking, O(1)
+ */
+static inline uint16_t debouncer_state(const PortDebouncer* d) {
+    return d->state;
+}
+
+/**
+ * Pins pressed (debounced HIGH -> LOW) since the last call
+ * 
+ * Lock-free between the tick ISR and the main loop: the ISR only writes
+ * press_toggle, the caller only writes *seen. Two presses of one pin
+ * between calls cancel out - at 4 ticks per edge that takes 16+ ms
+ * without a call.
+ */
+uint16_t debouncer_take_presses(const PortDebouncer* d, uint16_t* seen) {
+    uint16_t toggle = d->press_toggle;
+    uint16_t presses = toggle ^ *seen;
+    *seen = toggle;
+    return presses;
+}
+
+// One debouncer per port, fed by SysTick
+static PortDebouncer port_debouncers[3];   // GPIOA, GPIOB, GPIOC
+static GPIO_TypeDef* const debounced_ports[3] = { GPIOA, GPIOB, GPIOC };
+
+static volatile bool debounce_tick_running = false;
+static EventSignal button_event = EVENT_SIGNAL_INIT;
+
+#define DEBOUNCE_CORE_CLOCK_HZ 168000000U   // Same 168 MHz core as delay_ms()
+
+#define SYST_CSR        (*(volatile uint32_t*)0xE000E010)  // SysTick control/status
+#define SYST_RVR        (*(volatile uint32_t*)0xE000E014)  // Reload value
+#define SYST_CVR        (*(volatile uint32_t*)0xE000E018)  // Current value
+#define SYST_CSR_ENABLE     (1U << 0)
+#define SYST_CSR_TICKINT    (1U << 1)
+#define SYST_CSR_CLKSOURCE  (1U << 2)   // Core clock
+
+/**
+ * Start the 1 kHz tick and seed the debouncers with the current pin levels
+ *
+ * Must run after the button pins are configured as inputs (the seed is
+ * read from IDR). Until it has run, port_debouncers is all zeros - every
+ * pin "LOW", i.e. pressed - so the readers below never use it before.
+ */
+void debounce_tick_start(uint32_t core_clock_hz) {
+    for (int p = 0; p < 3; p++) {
+        debouncer_init(&port_debouncers[p], (uint16_t)debounced_ports[p]->IDR);
+    }
+    SYST_RVR = core_clock_hz / 1000 - 1;
+    SYST_CVR = 0;
+    SYST_CSR = SYST_CSR_CLKSOURCE | SYST_CSR_TICKINT | SYST_CSR_ENABLE;
+    debounce_tick_running = true;
+}
+
+void SysTick_Handler(void) {
+    for (int p = 0; p < 3; p++) {
+        uint16_t flipped = debouncer_tick(&port_debouncers[p], (uint16_t)debounced_ports[p]->IDR);
+        if (p == 2 && (flipped & (1U << 13))) {
+            event_notify(&button_event);    // PC13 (user button) changed
+        }
+    }
+}
+
 /**
  * Read button with debouncing
  * 
  * Hardware: Button on PC13 (common on STM32 Nucleo boards)
  * Connection: Button pulls pin LOW when pressed (needs pull-up)
  * 
- * CPU: ~10-15 cycles per read
- * Memory: 0 bytes (uses stack for locals)
+ * Returns the level SysTick_Handler has seen stable for 4 ms, or the raw
+ * level if debounce_tick_start() has not run yet.
+ * 
+ * CPU: ~5 cycles per read, never blocks
+ * Memory: 0 bytes (state lives in port_debouncers)
  */
 bool button_read_debounced(GPIO_TypeDef* gpio, uint8_t pin) {
-    // Read pin twice with small delay
-    bool state1 = gpio_read(gpio, pin);
-    delay_ms(10);  // 10ms debounce delay
-    bool state2 = gpio_read(gpio, pin);
-    
-    // Return true only if both reads agree
-    return state1 && state2;
+    if (!debounce_tick_running) {
+        return gpio_read(gpio, pin);    // No tick yet: debouncers not seeded
+    }
+    for (int p = 0; p < 3; p++) {
+        if (debounced_ports[p] == gpio) {
+            return (debouncer_state(&port_debouncers[p]) >> pin) & 1;
+        }
+    }
+    return gpio_read(gpio, pin);    // Port without a debouncer: raw level
 }
 
 /**
  * Wait for button press
  * 
- * Blocks until button is pressed (LOW on STM32 boards)
+ * Blocks until button is pressed (LOW on STM32 boards). The core sleeps
+ * (WFE) until SysTick_Handler reports a debounced level change instead
+ * of polling IDR at full speed. Starts the debounce tick if the
+ * application has not: the tick is what wakes it.
  */
 void wait_for_button(void) {
     printf("Waiting for button press (PC13)...\n");
     
     // Configure PC13 as input with pull-up
     gpio_init_input(GPIOC, 13, true);
-    
-    // Wait for LOW (button pressed)
-    while (gpio_read(GPIOC, 13)) {
-        // Spin-wait (inefficient - use interrupt in real code)
+    if (!debounce_tick_running) {
+        debounce_tick_start(DEBOUNCE_CORE_CLOCK_HZ);
     }
     
-    // Debounce
-    delay_ms(50);
+    // Wait for a debounced LOW (button pressed); SysTick_Handler
+    // notifies button_event when the debounced level changes
+    EVENT_WAIT_UNTIL(&button_event, !button_read_debounced(GPIOC, 13));
     
     // Wait for release (HIGH)
-    while (!gpio_read(GPIOC, 13)) {
-        // Wait
-    }
+    EVENT_WAIT_UNTIL(&button_event, button_read_debounced(GPIOC, 13));
     
     printf("Button pressed and released!\n");
 }
@@ -452,14 +770,65 @@ int main(void) {
     printf("GPIO_TypeDef size: %zu bytes\n", sizeof(GPIO_TypeDef));
     printf("Each register is 4 bytes (uint32_t)\n");
     
+    // Batched port access, on a port simulated in RAM (safe to run hosted;
+    // BSRR here is just memory, it does not update ODR)
+    printf("\n--- Batched Port Access (simulated port) ---\n");
+    GPIO_TypeDef sim_port = { 0 };
+    const uint16_t bus_pins = 0x00FF;           // Data bus D0-D7 on pins 0-7
+    const uint8_t strobe_pin = 8;               // WR strobe on pin 8
+    int writes = gpio_init_outputs(&sim_port, bus_pins | (1U << strobe_pin));
+    printf("9 pins configured with %d register writes (pin by pin: 36 read-modify-writes)\n", writes);
+    printf("MODER = 0x%08X, OSPEEDR = 0x%08X\n",
+           (unsigned)sim_port.MODER, (unsigned)sim_port.OSPEEDR);
+    
+    const uint8_t message[] = { 'H', 'e', 'l', 'l', 'o' };
+    uint32_t waveform[2 * sizeof(message)];
+    size_t steps = gpio_waveform_build_bus8(waveform, message, sizeof(message), 0, strobe_pin);
+    printf("Waveform for \"Hello\" on the 8-bit bus: %zu BSRR words\n", steps);
+    printf("  'H': 0x%08X (data + WR low), 0x%08X (WR high)\n",
+           (unsigned)waveform[0], (unsigned)waveform[1]);
+    printf("  Bus transactions per byte: 2 (pin by pin: 8 data + 2 strobe)\n");
+    gpio_waveform_play(&sim_port, waveform, steps, 0);
+    printf("  Last word played: 0x%08X\n", (unsigned)sim_port.BSRR);
+    
+    // Debouncing a bouncy signal, one sample per 1 ms tick
+    printf("\n--- 16-Pin Debouncer (simulated 1 kHz ticks) ---\n");
+    PortDebouncer debouncer;
+    uint16_t presses_seen = 0;
+    debouncer_init(&debouncer, 0xFFFF);         // All pins idle HIGH (pull-ups)
+    // Pin 13: bounces for 5 ms, held LOW 20 ms, bounces 4 ms, released.
+    // Pin 2: a 2 ms glitch that must be ignored.
+    const char* pin13 = "11110101000000000000000000001010111111";
+    const char* pin2  = "11111111110011111111111111111111111111";
+    int raw_edges = 0, debounced_edges = 0, presses = 0;
+    char raw_line[64], debounced_line[64];
+    size_t ticks = 0;
+    for (; pin13[ticks] != '\0'; ticks++) {
+        uint16_t sample = 0xFFFF;
+        if (pin13[ticks] == '0') sample &= (uint16_t)~(1U << 13);
+        if (pin2[ticks] == '0') sample &= (uint16_t)~(1U << 2);
+        if (ticks > 0 && pin13[ticks] != pin13[ticks - 1]) raw_edges++;
+        uint16_t flipped = debouncer_tick(&debouncer, sample);
+        if (flipped & (1U << 13)) debounced_edges++;
+        if (debouncer_take_presses(&debouncer, &presses_seen) & (1U << 13)) presses++;
+        raw_line[ticks] = pin13[ticks] == '1' ? '-' : '_';
+        debounced_line[ticks] = (debouncer_state(&debouncer) >> 13) & 1 ? '-' : '_';
+    }
+    raw_line[ticks] = debounced_line[ticks] = '\0';
+    printf("PC13 raw:       %s  (%d edges)\n", raw_line, raw_edges);
+    printf("PC13 debounced: %s  (%d edges, %d press)\n", debounced_line, debounced_edges, presses);
+    printf("Pin 2 glitch filtered: %s\n", (debouncer_state(&debouncer) >> 2) & 1 ? "yes" : "no");
+    
     printf("\n=================================================\n");
     printf("Key Takeaways:\n");
     printf("1. Peripherals live at fixed memory addresses\n");
     printf("2. Use volatile pointers to prevent caching\n");
     printf("3. Structure overlays provide clean syntax\n");
     printf("4. BSRR register enables atomic bit operations\n");
+    printf("   (and writes a whole port - or bus - in one transaction)\n");
     printf("5. Always enable peripheral clock before use\n");
     printf("6. Read datasheet for exact register layouts\n");
+    printf("7. Debounce from a timer tick; never delay_ms() in a poll\n");
     printf("=================================================\n");
     
     return 0;
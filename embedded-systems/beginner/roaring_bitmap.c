@@ -0,0 +1,930 @@
+/**
+ * roaring_bitmap.c - Compressed Bitmap Implementation
+ *
+ * See roaring_bitmap.h for the container layout. Internally every chunk
+ * operation falls into one of two shapes:
+ * - Array paths: sorted merges / binary searches over uint16_t values
+ * - Word paths: the chunk expanded to 1024 uint64_t words, combined word
+ *   by word, counted with popcount_array(), then stored as an array again
+ *   if it came out sparse
+ * A run container is applied range by range (set / clear / count a span
+ * of words) instead of being expanded, so no path keeps an 8KB scratch
+ * copy on the stack - roaring code often runs on small embedded stacks.
+ */
+
+#include "roaring_bitmap.h"
+#include "bit_ops.h"    // popcount_array, count_set_bits_64, find_first_set_64
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_SIZE 65536u
+
+typedef enum {
+    OP_AND,
+    OP_OR,
+    OP_ANDNOT
+} RoaringOp;
+
+/* ============================================================================
+ * Word helpers (one chunk = 1024 words)
+ * ============================================================================
+ */
+
+/**
+ * Set bits first..last (inclusive) of a chunk
+ */
+static void words_set_range(uint64_t *words, uint32_t first, uint32_t last) {
+    uint32_t first_word = first >> 6;
+    uint32_t last_word = last >> 6;
+    uint64_t first_mask = UINT64_MAX << (first & 63);
+    uint64_t last_mask = UINT64_MAX >> (63 - (last & 63));
+
+    if (first_word == last_word) {
+        words[first_word] |= first_mask & last_mask;
+        return;
+    }
+    words[first_word] |= first_mask;
+    for (uint32_t i = first_word + 1; i < last_word; i++) {
+        words[i] = UINT64_MAX;
+    }
+    words[last_word] |= last_mask;
+}
+
+/**
+ * Clear bits first..last (inclusive) of a chunk
+ */
+static void words_clear_range(uint64_t *words, uint32_t first, uint32_t last) {
+    uint32_t first_word = first >> 6;
+    uint32_t last_word = last >> 6;
+    uint64_t first_mask = UINT64_MAX << (first & 63);
+    uint64_t last_mask = UINT64_MAX >> (63 - (last & 63));
+
+    if (first_word == last_word) {
+        words[first_word] &= ~(first_mask & last_mask);
+        return;
+    }
+    words[first_word] &= ~first_mask;
+    for (uint32_t i = first_word + 1; i < last_word; i++) {
+        words[i] = 0;
+    }
+    words[last_word] &= ~last_mask;
+}
+
+/**
+ * Number of set bits among first..last (inclusive)
+ */
+static uint32_t words_count_range(const uint64_t *words, uint32_t first, uint32_t last) {
+    uint32_t first_word = first >> 6;
+    uint32_t last_word = last >> 6;
+    uint64_t first_mask = UINT64_MAX << (first & 63);
+    uint64_t last_mask = UINT64_MAX >> (63 - (last & 63));
+
+    if (first_word == last_word) {
+        return count_set_bits_64(words[first_word] & first_mask & last_mask);
+    }
+    uint32_t count = count_set_bits_64(words[first_word] & first_mask) +
+                     count_set_bits_64(words[last_word] & last_mask);
+    if (last_word > first_word + 1) {
+        count += (uint32_t)popcount_array(words + first_word + 1, last_word - first_word - 1);
+    }
+    return count;
+}
+
+/**
+ * Number of runs of consecutive set bits: a run starts at every set bit
+ * whose lower neighbour (carried across words) is clear
+ */
+static uint32_t words_count_runs(const uint64_t *words) {
+    uint32_t runs = 0;
+    uint64_t carry = 0;
+    for (uint32_t i = 0; i < ROARING_BITSET_WORDS; i++) {
+        uint64_t w = words[i];
+        runs += count_set_bits_64(w & ~((w << 1) | carry));
+        carry = w >> 63;
+    }
+    return runs;
+}
+
+static uint32_t words_to_array(const uint64_t *words, uint16_t *values) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < ROARING_BITSET_WORDS; i++) {
+        uint64_t w = words[i];
+        while (w) {
+            values[count++] = (uint16_t)(i * 64 + find_first_set_64(w));
+            w &= w - 1;
+        }
+    }
+    return count;
+}
+
+static uint32_t words_to_runs(const uint64_t *words, RoaringRun *runs) {
+    uint32_t count = 0;
+    uint32_t i = 0;
+    uint64_t w = words[0];
+
+    for (;;) {
+        while (w == 0) {
+            if (++i == ROARING_BITSET_WORDS) return count;
+            w = words[i];
+        }
+        uint32_t start = i * 64 + find_first_set_64(w);
+        w |= w - 1;                     // Fill below the start: ~w now finds the end
+        while (w == UINT64_MAX) {
+            if (++i == ROARING_BITSET_WORDS) {
+                runs[count++] = (RoaringRun){ (uint16_t)start, (uint16_t)(CHUNK_SIZE - 1 - start) };
+                return count;
+            }
+            w = words[i];
+        }
+        uint32_t end = i * 64 + find_first_set_64(~w);     // First clear bit
+        runs[count++] = (RoaringRun){ (uint16_t)start, (uint16_t)(end - 1 - start) };
+        w &= w + 1;                     // Clear the run's bits in this word
+    }
+}
+
+/**
+ * Run helpers for sorted values: a run starts wherever a value is not
+ * its predecessor + 1
+ */
+static uint32_t values_count_runs(const uint16_t *values, uint32_t count) {
+    uint32_t runs = count > 0;
+    for (uint32_t i = 1; i < count; i++) {
+        runs += values[i] != (uint16_t)(values[i - 1] + 1);
+    }
+    return runs;
+}
+
+static uint32_t values_to_runs(const uint16_t *values, uint32_t count, RoaringRun *runs) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (i > 0 && values[i] == (uint16_t)(values[i - 1] + 1)) {
+            runs[n - 1].length++;
+        } else {
+            runs[n++] = (RoaringRun){ values[i], 0 };
+        }
+    }
+    return n;
+}
+
+/**
+ * |a AND b| of two sorted run lists
+ */
+static uint32_t runs_and_cardinality(const RoaringRun *a, uint32_t na, const RoaringRun *b, uint32_t nb) {
+    uint32_t total = 0;
+    uint32_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        uint32_t a_end = (uint32_t)a[i].start + a[i].length;
+        uint32_t b_end = (uint32_t)b[j].start + b[j].length;
+        uint32_t lo = a[i].start > b[j].start ? a[i].start : b[j].start;
+        uint32_t hi = a_end < b_end ? a_end : b_end;
+        if (lo <= hi) total += hi - lo + 1;
+        if (a_end < b_end) i++;
+        else j++;
+    }
+    return total;
+}
+
+/* ============================================================================
+ * Containers
+ * ============================================================================
+ */
+
+static uint32_t array_lower_bound(const uint16_t *values, uint32_t count, uint16_t value) {
+    uint32_t lo = 0, hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (values[mid] < value) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static bool run_contains(const RoaringRun *runs, uint32_t count, uint16_t value) {
+    // Last run starting at or before 'value'
+    uint32_t lo = 0, hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (runs[mid].start <= value) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo > 0 && (uint32_t)(value - runs[lo - 1].start) <= runs[lo - 1].length;
+}
+
+static bool container_contains(const RoaringContainer *c, uint16_t value) {
+    switch (c->type) {
+    case ROARING_ARRAY: {
+        uint32_t index = array_lower_bound(c->data.values, c->count, value);
+        return index < c->count && c->data.values[index] == value;
+    }
+    case ROARING_BITSET:
+        return (c->data.words[value >> 6] >> (value & 63)) & 1;
+    case ROARING_RUN:
+        return run_contains(c->data.runs, c->count, value);
+    }
+    return false;
+}
+
+static void container_free(RoaringContainer *c) {
+    switch (c->type) {
+    case ROARING_ARRAY:  free(c->data.values); break;
+    case ROARING_BITSET: free(c->data.words);  break;
+    case ROARING_RUN:    free(c->data.runs);   break;
+    }
+    memset(c, 0, sizeof(*c));
+}
+
+/**
+ * Expand any container into 1024 words
+ */
+static void container_fill_words(const RoaringContainer *c, uint64_t *words) {
+    if (c->type == ROARING_BITSET) {
+        memcpy(words, c->data.words, ROARING_BITSET_WORDS * sizeof(uint64_t));
+        return;
+    }
+    memset(words, 0, ROARING_BITSET_WORDS * sizeof(uint64_t));
+    if (c->type == ROARING_ARRAY) {
+        for (uint32_t i = 0; i < c->count; i++) {
+            uint16_t v = c->data.values[i];
+            words[v >> 6] |= UINT64_C(1) << (v & 63);
+        }
+    } else {
+        for (uint32_t i = 0; i < c->count; i++) {
+            RoaringRun run = c->data.runs[i];
+            words_set_range(words, run.start, (uint32_t)run.start + run.length);
+        }
+    }
+}
+
+/**
+ * Turn a malloc'd word buffer holding 'cardinality' bits (> 0) into the
+ * container: an array when sparse (freeing 'words'), else a bitset that
+ * takes ownership. Never fails: if the array cannot be allocated the
+ * chunk simply stays a bitset.
+ */
+static void container_adopt_words(RoaringContainer *c, uint64_t *words, uint32_t cardinality) {
+    c->cardinality = cardinality;
+    if (cardinality <= ROARING_ARRAY_MAX) {
+        uint16_t *values = malloc(cardinality * sizeof(uint16_t));
+        if (values != NULL) {
+            c->type = ROARING_ARRAY;
+            c->count = words_to_array(words, values);
+            c->capacity = cardinality;
+            c->data.values = values;
+            free(words);
+            return;
+        }
+    }
+    c->type = ROARING_BITSET;
+    c->count = 0;
+    c->capacity = 0;
+    c->data.words = words;
+}
+
+/**
+ * Rebuild a container from its own words (run -> array / bitset,
+ * bitset -> array once it is sparse)
+ */
+static bool container_normalize(RoaringContainer *c) {
+    uint64_t *words = malloc(ROARING_BITSET_WORDS * sizeof(uint64_t));
+    if (words == NULL) return false;
+    container_fill_words(c, words);
+    uint32_t cardinality = c->cardinality;
+    container_free(c);
+    container_adopt_words(c, words, cardinality);
+    return true;
+}
+
+static bool array_to_bitset(RoaringContainer *c) {
+    uint64_t *words = malloc(ROARING_BITSET_WORDS * sizeof(uint64_t));
+    if (words == NULL) return false;
+    container_fill_words(c, words);
+    uint32_t cardinality = c->cardinality;
+    container_free(c);
+    c->type = ROARING_BITSET;
+    c->cardinality = cardinality;
+    c->data.words = words;
+    return true;
+}
+
+static bool container_clone(const RoaringContainer *src, RoaringContainer *dst) {
+    *dst = *src;
+    size_t bytes;
+    switch (src->type) {
+    case ROARING_ARRAY:  bytes = src->count * sizeof(uint16_t); break;
+    case ROARING_BITSET: bytes = ROARING_BITSET_WORDS * sizeof(uint64_t); break;
+    default:             bytes = src->count * sizeof(RoaringRun); break;
+    }
+    void *copy = malloc(bytes);
+    if (copy == NULL) return false;
+    memcpy(copy, src->data.values, bytes);     // All union members are plain arrays
+    dst->capacity = src->type == ROARING_BITSET ? 0 : src->count;
+    switch (src->type) {
+    case ROARING_ARRAY:  dst->data.values = copy; break;
+    case ROARING_BITSET: dst->data.words = copy;  break;
+    case ROARING_RUN:    dst->data.runs = copy;   break;
+    }
+    return true;
+}
+
+/**
+ * Sorted-merge AND / OR / ANDNOT of two arrays into 'out'
+ * (sized for the largest possible result)
+ */
+static uint32_t array_merge(const uint16_t *a, uint32_t na, const uint16_t *b, uint32_t nb,
+                            RoaringOp op, uint16_t *out) {
+    uint32_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            if (op != OP_AND) out[n++] = a[i];
+            i++;
+        } else if (a[i] > b[j]) {
+            if (op == OP_OR) out[n++] = b[j];
+            j++;
+        } else {
+            if (op != OP_ANDNOT) out[n++] = a[i];
+            i++;
+            j++;
+        }
+    }
+    if (op != OP_AND) {
+        while (i < na) out[n++] = a[i++];
+    }
+    if (op == OP_OR) {
+        while (j < nb) out[n++] = b[j++];
+    }
+    return n;
+}
+
+/**
+ * out = the values of 'array' that are (keep_present) or are not in 'other'
+ */
+static bool array_filter(const RoaringContainer *array, const RoaringContainer *other,
+                         bool keep_present, RoaringContainer *out) {
+    if (array->count == 0) return true;
+    uint16_t *values = malloc(array->count * sizeof(uint16_t));
+    if (values == NULL) return false;
+
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < array->count; i++) {
+        uint16_t v = array->data.values[i];
+        if (container_contains(other, v) == keep_present) {
+            values[n++] = v;
+        }
+    }
+    if (n == 0) {
+        free(values);
+        return true;
+    }
+    out->type = ROARING_ARRAY;
+    out->data.values = values;
+    out->count = out->cardinality = n;
+    out->capacity = array->count;
+    return true;
+}
+
+/**
+ * out = a <op> b for one chunk. An empty result leaves out->cardinality 0
+ * with nothing allocated.
+ */
+static bool container_op(const RoaringContainer *a, const RoaringContainer *b,
+                         RoaringOp op, RoaringContainer *out) {
+    memset(out, 0, sizeof(*out));
+    out->type = ROARING_ARRAY;
+
+    if (a->type == ROARING_ARRAY && b->type == ROARING_ARRAY) {
+        uint32_t max = op == OP_OR ? a->count + b->count : a->count;
+        if (max <= ROARING_ARRAY_MAX) {
+            if (max == 0) return true;
+            uint16_t *values = malloc(max * sizeof(uint16_t));
+            if (values == NULL) return false;
+            uint32_t n = array_merge(a->data.values, a->count, b->data.values, b->count, op, values);
+            if (n == 0) {
+                free(values);
+                return true;
+            }
+            out->data.values = values;
+            out->count = out->cardinality = n;
+            out->capacity = max;
+            return true;
+        }
+        // A union that may not fit an array: build it as words
+    } else if (op == OP_AND && a->type == ROARING_ARRAY) {
+        return array_filter(a, b, true, out);
+    } else if (op == OP_AND && b->type == ROARING_ARRAY) {
+        return array_filter(b, a, true, out);
+    } else if (op == OP_ANDNOT && a->type == ROARING_ARRAY) {
+        return array_filter(a, b, false, out);
+    }
+
+    uint64_t *words = malloc(ROARING_BITSET_WORDS * sizeof(uint64_t));
+    if (words == NULL) return false;
+    container_fill_words(a, words);
+
+    if (b->type == ROARING_ARRAY) {
+        // Only OR / ANDNOT get here: touch just b's bits
+        for (uint32_t i = 0; i < b->count; i++) {
+            uint16_t v = b->data.values[i];
+            uint64_t bit = UINT64_C(1) << (v & 63);
+            if (op == OP_OR) words[v >> 6] |= bit;
+            else words[v >> 6] &= ~bit;
+        }
+    } else if (b->type == ROARING_RUN) {
+        // Apply b's runs to the words directly: no second 8KB expansion
+        uint32_t next = 0;                      // First bit not yet covered (AND)
+        for (uint32_t i = 0; i < b->count; i++) {
+            uint32_t first = b->data.runs[i].start;
+            uint32_t last = first + b->data.runs[i].length;
+            if (op == OP_OR) {
+                words_set_range(words, first, last);
+            } else if (op == OP_ANDNOT) {
+                words_clear_range(words, first, last);
+            } else {
+                if (first > next) words_clear_range(words, next, first - 1);
+                next = last + 1;
+            }
+        }
+        if (op == OP_AND && next < CHUNK_SIZE) {
+            words_clear_range(words, next, CHUNK_SIZE - 1);
+        }
+    } else {
+        const uint64_t *other = b->data.words;
+        switch (op) {
+        case OP_AND:
+            for (uint32_t i = 0; i < ROARING_BITSET_WORDS; i++) words[i] &= other[i];
+            break;
+        case OP_OR:
+            for (uint32_t i = 0; i < ROARING_BITSET_WORDS; i++) words[i] |= other[i];
+            break;
+        case OP_ANDNOT:
+            for (uint32_t i = 0; i < ROARING_BITSET_WORDS; i++) words[i] &= ~other[i];
+            break;
+        }
+    }
+
+    uint32_t cardinality = (uint32_t)popcount_array(words, ROARING_BITSET_WORDS);
+    if (cardinality == 0) {
+        free(words);
+        return true;
+    }
+    container_adopt_words(out, words, cardinality);
+    return true;
+}
+
+/* ============================================================================
+ * Chunk index
+ * ============================================================================
+ */
+
+static size_t key_lower_bound(const RoaringBitmap *bitmap, uint16_t key) {
+    size_t lo = 0, hi = bitmap->size;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (bitmap->keys[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static const RoaringContainer* find_container(const RoaringBitmap *bitmap, uint16_t key) {
+    size_t pos = key_lower_bound(bitmap, key);
+    if (pos < bitmap->size && bitmap->keys[pos] == key) {
+        return &bitmap->containers[pos];
+    }
+    return NULL;
+}
+
+static bool reserve_chunks(RoaringBitmap *bitmap) {
+    if (bitmap->size < bitmap->capacity) return true;
+    size_t capacity = bitmap->capacity ? bitmap->capacity * 2 : 4;
+
+    uint16_t *keys = realloc(bitmap->keys, capacity * sizeof(uint16_t));
+    if (keys == NULL) return false;
+    bitmap->keys = keys;                // Larger than needed is harmless
+    RoaringContainer *containers = realloc(bitmap->containers, capacity * sizeof(RoaringContainer));
+    if (containers == NULL) return false;
+    bitmap->containers = containers;
+    bitmap->capacity = capacity;
+    return true;
+}
+
+/**
+ * Insert an empty array container for 'key' at index 'pos'
+ */
+static RoaringContainer* insert_chunk(RoaringBitmap *bitmap, size_t pos, uint16_t key) {
+    if (!reserve_chunks(bitmap)) return NULL;
+    memmove(&bitmap->keys[pos + 1], &bitmap->keys[pos], (bitmap->size - pos) * sizeof(uint16_t));
+    memmove(&bitmap->containers[pos + 1], &bitmap->containers[pos],
+            (bitmap->size - pos) * sizeof(RoaringContainer));
+    bitmap->keys[pos] = key;
+    RoaringContainer *c = &bitmap->containers[pos];
+    memset(c, 0, sizeof(*c));
+    c->type = ROARING_ARRAY;
+    bitmap->size++;
+    return c;
+}
+
+static void remove_chunk(RoaringBitmap *bitmap, size_t pos) {
+    container_free(&bitmap->containers[pos]);
+    memmove(&bitmap->keys[pos], &bitmap->keys[pos + 1], (bitmap->size - pos - 1) * sizeof(uint16_t));
+    memmove(&bitmap->containers[pos], &bitmap->containers[pos + 1],
+            (bitmap->size - pos - 1) * sizeof(RoaringContainer));
+    bitmap->size--;
+}
+
+/**
+ * Append a chunk with a key larger than every existing one;
+ * takes ownership of *c (freed on failure)
+ */
+static bool append_chunk(RoaringBitmap *bitmap, uint16_t key, RoaringContainer *c) {
+    if (!reserve_chunks(bitmap)) {
+        container_free(c);
+        return false;
+    }
+    bitmap->keys[bitmap->size] = key;
+    bitmap->containers[bitmap->size] = *c;
+    bitmap->size++;
+    return true;
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================
+ */
+
+void roaring_init(RoaringBitmap *bitmap) {
+    memset(bitmap, 0, sizeof(*bitmap));
+}
+
+void roaring_free(RoaringBitmap *bitmap) {
+    for (size_t i = 0; i < bitmap->size; i++) {
+        container_free(&bitmap->containers[i]);
+    }
+    free(bitmap->keys);
+    free(bitmap->containers);
+    roaring_init(bitmap);
+}
+
+bool roaring_add(RoaringBitmap *bitmap, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    uint16_t low = (uint16_t)value;
+    size_t pos = key_lower_bound(bitmap, key);
+    bool created = false;
+
+    if (pos == bitmap->size || bitmap->keys[pos] != key) {
+        if (insert_chunk(bitmap, pos, key) == NULL) return false;
+        created = true;
+    }
+    RoaringContainer *c = &bitmap->containers[pos];
+
+    if (c->type == ROARING_RUN) {
+        if (run_contains(c->data.runs, c->count, low)) return true;
+        if (!container_normalize(c)) return false;
+    }
+
+    if (c->type == ROARING_ARRAY) {
+        uint32_t index = array_lower_bound(c->data.values, c->count, low);
+        if (index < c->count && c->data.values[index] == low) return true;
+
+        if (c->count < ROARING_ARRAY_MAX) {
+            if (c->count == c->capacity) {
+                uint32_t capacity = c->capacity ? c->capacity * 2 : 4;
+                if (capacity > ROARING_ARRAY_MAX) capacity = ROARING_ARRAY_MAX;
+                uint16_t *values = realloc(c->data.values, capacity * sizeof(uint16_t));
+                if (values == NULL) {
+                    if (created) remove_chunk(bitmap, pos);
+                    return false;
+                }
+                c->data.values = values;
+                c->capacity = capacity;
+            }
+            memmove(&c->data.values[index + 1], &c->data.values[index],
+                    (c->count - index) * sizeof(uint16_t));
+            c->data.values[index] = low;
+            c->count++;
+            c->cardinality++;
+            return true;
+        }
+        // Array full: 4097 ids are cheaper as a bitset
+        if (!array_to_bitset(c)) return false;
+    }
+
+    uint64_t bit = UINT64_C(1) << (low & 63);
+    if ((c->data.words[low >> 6] & bit) == 0) {
+        c->data.words[low >> 6] |= bit;
+        c->cardinality++;
+    }
+    return true;
+}
+
+bool roaring_remove(RoaringBitmap *bitmap, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    uint16_t low = (uint16_t)value;
+    size_t pos = key_lower_bound(bitmap, key);
+    if (pos == bitmap->size || bitmap->keys[pos] != key) return true;
+    RoaringContainer *c = &bitmap->containers[pos];
+
+    if (c->type == ROARING_RUN) {
+        if (!run_contains(c->data.runs, c->count, low)) return true;
+        if (!container_normalize(c)) return false;
+    }
+
+    if (c->type == ROARING_ARRAY) {
+        uint32_t index = array_lower_bound(c->data.values, c->count, low);
+        if (index == c->count || c->data.values[index] != low) return true;
+        memmove(&c->data.values[index], &c->data.values[index + 1],
+                (c->count - index - 1) * sizeof(uint16_t));
+        c->count--;
+        c->cardinality--;
+    } else {
+        uint64_t bit = UINT64_C(1) << (low & 63);
+        if ((c->data.words[low >> 6] & bit) == 0) return true;
+        c->data.words[low >> 6] &= ~bit;
+        c->cardinality--;
+        if (c->cardinality == ROARING_ARRAY_MAX) {
+            container_normalize(c);     // On failure it just stays a bitset
+        }
+    }
+
+    if (c->cardinality == 0) {
+        remove_chunk(bitmap, pos);
+    }
+    return true;
+}
+
+bool roaring_contains(const RoaringBitmap *bitmap, uint32_t value) {
+    const RoaringContainer *c = find_container(bitmap, (uint16_t)(value >> 16));
+    return c != NULL && container_contains(c, (uint16_t)value);
+}
+
+bool roaring_add_range(RoaringBitmap *bitmap, uint64_t lo, uint64_t hi) {
+    if (hi > (UINT64_C(1) << 32)) hi = UINT64_C(1) << 32;
+
+    while (lo < hi) {
+        uint16_t key = (uint16_t)(lo >> 16);
+        uint64_t chunk_end = ((uint64_t)key + 1) << 16;
+        if (chunk_end > hi) chunk_end = hi;
+        uint32_t first = (uint32_t)(lo & 0xFFFF);
+        uint32_t last = (uint32_t)((chunk_end - 1) & 0xFFFF);
+
+        size_t pos = key_lower_bound(bitmap, key);
+        if (pos == bitmap->size || bitmap->keys[pos] != key) {
+            RoaringRun *runs = malloc(sizeof(RoaringRun));
+            if (runs == NULL) return false;
+            RoaringContainer *c = insert_chunk(bitmap, pos, key);
+            if (c == NULL) {
+                free(runs);
+                return false;
+            }
+            runs[0] = (RoaringRun){ (uint16_t)first, (uint16_t)(last - first) };
+            c->type = ROARING_RUN;
+            c->data.runs = runs;
+            c->count = c->capacity = 1;
+            c->cardinality = last - first + 1;
+        } else {
+            RoaringContainer *c = &bitmap->containers[pos];
+            if (c->type == ROARING_BITSET) {
+                words_set_range(c->data.words, first, last);
+                c->cardinality = (uint32_t)popcount_array(c->data.words, ROARING_BITSET_WORDS);
+            } else {
+                uint64_t *words = malloc(ROARING_BITSET_WORDS * sizeof(uint64_t));
+                if (words == NULL) return false;
+                container_fill_words(c, words);
+                words_set_range(words, first, last);
+                container_free(c);
+                container_adopt_words(c, words, (uint32_t)popcount_array(words, ROARING_BITSET_WORDS));
+            }
+        }
+        lo = chunk_end;
+    }
+    return true;
+}
+
+uint64_t roaring_cardinality(const RoaringBitmap *bitmap) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < bitmap->size; i++) {
+        total += bitmap->containers[i].cardinality;
+    }
+    return total;
+}
+
+/**
+ * Walk both key lists in order: AND keeps shared keys, OR every key,
+ * ANDNOT the keys of 'a'
+ */
+static bool bitmap_op(const RoaringBitmap *a, const RoaringBitmap *b, RoaringOp op, RoaringBitmap *out) {
+    roaring_init(out);
+    size_t i = 0, j = 0;
+
+    while (i < a->size || j < b->size) {
+        RoaringContainer result;
+        uint16_t key;
+        bool have_a = i < a->size;
+        bool have_b = j < b->size;
+        if (op == OP_AND && !(have_a && have_b)) break;
+
+        if (have_a && have_b && a->keys[i] == b->keys[j]) {
+            key = a->keys[i];
+            if (!container_op(&a->containers[i], &b->containers[j], op, &result)) goto fail;
+            i++;
+            j++;
+        } else if (have_a && (!have_b || a->keys[i] < b->keys[j])) {
+            key = a->keys[i];
+            if (op == OP_AND) {
+                i++;
+                continue;
+            }
+            if (!container_clone(&a->containers[i], &result)) goto fail;
+            i++;
+        } else {
+            key = b->keys[j];
+            if (op != OP_OR) {
+                if (op == OP_ANDNOT && !have_a) break;     // Nothing left of 'a'
+                j++;
+                continue;
+            }
+            if (!container_clone(&b->containers[j], &result)) goto fail;
+            j++;
+        }
+
+        if (result.cardinality > 0 && !append_chunk(out, key, &result)) goto fail;
+    }
+    return true;
+
+fail:
+    roaring_free(out);
+    return false;
+}
+
+bool roaring_and(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out) {
+    return bitmap_op(a, b, OP_AND, out);
+}
+
+bool roaring_or(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out) {
+    return bitmap_op(a, b, OP_OR, out);
+}
+
+bool roaring_andnot(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out) {
+    return bitmap_op(a, b, OP_ANDNOT, out);
+}
+
+uint64_t roaring_and_cardinality(const RoaringBitmap *a, const RoaringBitmap *b) {
+    uint64_t total = 0;
+    size_t i = 0, j = 0;
+
+    while (i < a->size && j < b->size) {
+        if (a->keys[i] < b->keys[j]) {
+            i++;
+        } else if (a->keys[i] > b->keys[j]) {
+            j++;
+        } else {
+            const RoaringContainer *ca = &a->containers[i++];
+            const RoaringContainer *cb = &b->containers[j++];
+            if (cb->type == ROARING_ARRAY && ca->type != ROARING_ARRAY) {
+                const RoaringContainer *swap = ca;
+                ca = cb;
+                cb = swap;
+            }
+            if (ca->type == ROARING_ARRAY) {
+                for (uint32_t k = 0; k < ca->count; k++) {
+                    total += container_contains(cb, ca->data.values[k]);
+                }
+            } else if (ca->type == ROARING_RUN && cb->type == ROARING_RUN) {
+                total += runs_and_cardinality(ca->data.runs, ca->count, cb->data.runs, cb->count);
+            } else if (ca->type == ROARING_RUN || cb->type == ROARING_RUN) {
+                // Count the bitset's bits inside each run
+                const RoaringContainer *runs = ca->type == ROARING_RUN ? ca : cb;
+                const uint64_t *words = ca->type == ROARING_RUN ? cb->data.words : ca->data.words;
+                for (uint32_t k = 0; k < runs->count; k++) {
+                    uint32_t first = runs->data.runs[k].start;
+                    total += words_count_range(words, first, first + runs->data.runs[k].length);
+                }
+            } else {
+                const uint64_t *wa = ca->data.words;
+                const uint64_t *wb = cb->data.words;
+                for (uint32_t k = 0; k < ROARING_BITSET_WORDS; k++) {
+                    total += count_set_bits_64(wa[k] & wb[k]);
+                }
+            }
+        }
+    }
+    return total;
+}
+
+bool roaring_optimize(RoaringBitmap *bitmap) {
+    for (size_t i = 0; i < bitmap->size; i++) {
+        // Runs are counted from the container's own storage, never an 8KB copy
+        RoaringContainer *c = &bitmap->containers[i];
+        uint32_t runs;
+        switch (c->type) {
+        case ROARING_ARRAY:  runs = values_count_runs(c->data.values, c->count); break;
+        case ROARING_BITSET: runs = words_count_runs(c->data.words); break;
+        default:             runs = c->count; break;
+        }
+        size_t run_bytes = runs * sizeof(RoaringRun);
+        size_t standard_bytes = c->cardinality <= ROARING_ARRAY_MAX
+                              ? c->cardinality * sizeof(uint16_t)
+                              : ROARING_BITSET_WORDS * sizeof(uint64_t);
+
+        if (run_bytes < standard_bytes) {
+            if (c->type == ROARING_RUN) continue;
+            RoaringRun *encoded = malloc(run_bytes);
+            if (encoded == NULL) return false;
+            if (c->type == ROARING_ARRAY) {
+                values_to_runs(c->data.values, c->count, encoded);
+            } else {
+                words_to_runs(c->data.words, encoded);
+            }
+            uint32_t cardinality = c->cardinality;
+            container_free(c);
+            c->type = ROARING_RUN;
+            c->data.runs = encoded;
+            c->count = c->capacity = runs;
+            c->cardinality = cardinality;
+        } else if (c->type == ROARING_RUN ||
+                   (c->type == ROARING_BITSET && c->cardinality <= ROARING_ARRAY_MAX)) {
+            if (!container_normalize(c)) return false;
+        } else if (c->type == ROARING_ARRAY && c->capacity > c->count) {
+            // Drop the slack left by doubling (a smaller realloc keeps the old block on failure)
+            uint16_t *values = realloc(c->data.values, c->count * sizeof(uint16_t));
+            if (values != NULL) {
+                c->data.values = values;
+                c->capacity = c->count;
+            }
+        }
+    }
+
+    if (bitmap->size > 0 && bitmap->capacity > bitmap->size) {
+        RoaringContainer *containers = realloc(bitmap->containers, bitmap->size * sizeof(RoaringContainer));
+        if (containers != NULL) {
+            bitmap->containers = containers;
+            bitmap->capacity = bitmap->size;
+            uint16_t *keys = realloc(bitmap->keys, bitmap->size * sizeof(uint16_t));
+            if (keys != NULL) bitmap->keys = keys;      // Else the old, larger block stays
+        }
+    }
+    return true;
+}
+
+size_t roaring_memory_bytes(const RoaringBitmap *bitmap) {
+    size_t bytes = bitmap->capacity * (sizeof(uint16_t) + sizeof(RoaringContainer));
+    for (size_t i = 0; i < bitmap->size; i++) {
+        const RoaringContainer *c = &bitmap->containers[i];
+        switch (c->type) {
+        case ROARING_ARRAY:  bytes += c->capacity * sizeof(uint16_t); break;
+        case ROARING_BITSET: bytes += ROARING_BITSET_WORDS * sizeof(uint64_t); break;
+        case ROARING_RUN:    bytes += c->capacity * sizeof(RoaringRun); break;
+        }
+    }
+    return bytes;
+}
+
+void roaring_iterator_init(RoaringIterator *it, const RoaringBitmap *bitmap) {
+    memset(it, 0, sizeof(*it));
+    it->bitmap = bitmap;
+}
+
+bool roaring_iterator_next(RoaringIterator *it, uint32_t *value) {
+    while (it->container < it->bitmap->size) {
+        const RoaringContainer *c = &it->bitmap->containers[it->container];
+        uint32_t base = (uint32_t)it->bitmap->keys[it->container] << 16;
+
+        switch (c->type) {
+        case ROARING_ARRAY:
+            if (it->position < c->count) {
+                *value = base | c->data.values[it->position++];
+                return true;
+            }
+            break;
+        case ROARING_BITSET:
+            while (it->word == 0 && it->position < ROARING_BITSET_WORDS) {
+                it->word = c->data.words[it->position++];
+            }
+            if (it->word != 0) {
+                // 'position' already points past the word being drained
+                *value = base | ((it->position - 1) * 64 + find_first_set_64(it->word));
+                it->word &= it->word - 1;
+                return true;
+            }
+            break;
+        case ROARING_RUN:
+            if (it->position < c->count) {
+                RoaringRun run = c->data.runs[it->position];
+                *value = base | (run.start + it->offset);
+                if (it->offset == run.length) {
+                    it->position++;
+                    it->offset = 0;
+                } else {
+                    it->offset++;
+                }
+                return true;
+            }
+            break;
+        }
+
+        it->container++;
+        it->position = 0;
+        it->offset = 0;
+        it->word = 0;
+    }
+    return false;
+}
@@ -0,0 +1,159 @@
+/**
+ * ============================================================================
+ * roaring_bitmap.h - Compressed Bitmap (Roaring-Style Containers)
+ * ============================================================================
+ *
+ * PURPOSE:
+ * bit_set() / bit_test() work on one 32-bit register. This is the same set
+ * of operations for millions of 32-bit ids, stored compressed.
+ *
+ * CONCEPT:
+ * The id space is cut into 65,536 chunks of 65,536 ids (high 16 bits =
+ * chunk key, low 16 bits = position in the chunk). Each non-empty chunk
+ * is stored in whichever container is smallest for its contents:
+ *
+ *   Container  Layout                        Bytes          Best for
+ *   ---------  ----------------------------  -------------  ---------------------
+ *   array      sorted uint16_t values        2 per id       <= 4096 ids (sparse)
+ *   bitset     1024 x uint64_t (65,536 bits) 8192 (fixed)   > 4096 ids (dense)
+ *   run        (start, length) pairs         4 per run      long consecutive ranges
+ *
+ * 4096 is the break-even: 4096 ids x 2 bytes = 8192 bytes = one bitset.
+ * Empty chunks cost nothing.
+ *
+ * MEMORY IMPLICATIONS (1 million ids):
+ *   Uncompressed bitset over 0..2^32:  512 MB
+ *   Sorted uint32_t array:             4 MB
+ *   This bitmap (after roaring_optimize):
+ *     every 8th id of 0..8M            1 MB (122 bitsets)
+ *     one range of 1M ids              ~500 bytes (16 runs)
+ *     uniformly random over 2^32       ~3.7 MB: ~15 ids in each of the
+ *                                      65,536 chunks, so the 26-byte chunk
+ *                                      header costs almost as much as the
+ *                                      ids. Compression needs clustering.
+ *
+ * CPU OVERHEAD:
+ * - add / remove / contains: binary search over chunk keys, then O(1)
+ *   (bitset) or O(log 4096) (array / run) inside the chunk
+ * - AND / OR / ANDNOT: chunk-by-chunk; bitset pairs are 1024 word ops and
+ *   one popcount_array(), array pairs are a sorted merge
+ * - cardinality: O(chunks), each container keeps its own count
+ *
+ * Point updates on a run container turn it back into an array or bitset;
+ * roaring_optimize() re-encodes runs after bulk loading.
+ *
+ * ============================================================================
+ */
+
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define ROARING_ARRAY_MAX 4096          // Array container limit (ids)
+#define ROARING_BITSET_WORDS 1024       // 65,536 bits
+
+typedef enum {
+    ROARING_ARRAY,
+    ROARING_BITSET,
+    ROARING_RUN
+} RoaringContainerType;
+
+/** Consecutive ids start .. start + length (inclusive) */
+typedef struct {
+    uint16_t start;
+    uint16_t length;
+} RoaringRun;
+
+typedef struct {
+    RoaringContainerType type;
+    uint32_t cardinality;           // Ids in this chunk (1..65536)
+    uint32_t count;                 // Array: values used, run: runs used
+    uint32_t capacity;              // Array / run: entries allocated
+    union {
+        uint16_t *values;           // ROARING_ARRAY, sorted
+        uint64_t *words;            // ROARING_BITSET
+        RoaringRun *runs;           // ROARING_RUN, sorted, non-adjacent
+    } data;
+} RoaringContainer;
+
+/**
+ * Chunks sorted by key: containers[i] holds ids (keys[i] << 16) | low.
+ * Zero-initialized (or roaring_init()) is an empty bitmap.
+ */
+typedef struct {
+    uint16_t *keys;
+    RoaringContainer *containers;
+    size_t size;
+    size_t capacity;
+} RoaringBitmap;
+
+/**
+ * In-order iterator; the bitmap must not change while iterating
+ */
+typedef struct {
+    const RoaringBitmap *bitmap;
+    size_t container;               // Current chunk
+    uint32_t position;              // Array index / next word / run index
+    uint32_t offset;                // Offset inside the current run
+    uint64_t word;                  // Bits of the current word not yet returned
+} RoaringIterator;
+
+void roaring_init(RoaringBitmap *bitmap);
+void roaring_free(RoaringBitmap *bitmap);
+
+/**
+ * Add / remove one id (no-op if already present / absent)
+ * Returns: false on allocation failure (bitmap unchanged)
+ */
+bool roaring_add(RoaringBitmap *bitmap, uint32_t value);
+bool roaring_remove(RoaringBitmap *bitmap, uint32_t value);
+bool roaring_contains(const RoaringBitmap *bitmap, uint32_t value);
+
+/**
+ * Add every id in [lo, hi) (hi up to 2^32). Chunks the range covers
+ * without existing ids become single-run containers.
+ * Returns: false on allocation failure (earlier chunks stay added)
+ */
+bool roaring_add_range(RoaringBitmap *bitmap, uint64_t lo, uint64_t hi);
+
+uint64_t roaring_cardinality(const RoaringBitmap *bitmap);
+
+/**
+ * out = a AND b / a OR b / a AND NOT b
+ * 'out' is (re)initialized and must not alias a or b. Result chunks are
+ * arrays or bitsets; call roaring_optimize() to find runs again.
+ * Returns: false on allocation failure ('out' left empty)
+ */
+bool roaring_and(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out);
+bool roaring_or(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out);
+bool roaring_andnot(const RoaringBitmap *a, const RoaringBitmap *b, RoaringBitmap *out);
+
+/**
+ * |a AND b| without building the result
+ */
+uint64_t roaring_and_cardinality(const RoaringBitmap *a, const RoaringBitmap *b);
+
+/**
+ * Re-encode every chunk in its smallest container (array, bitset or run)
+ * and release spare capacity; call once after bulk loading
+ * Returns: false on allocation failure (the bitmap stays valid)
+ */
+bool roaring_optimize(RoaringBitmap *bitmap);
+
+/**
+ * Bytes used by the containers and the key index
+ */
+size_t roaring_memory_bytes(const RoaringBitmap *bitmap);
+
+/**
+ * Iterate in increasing order:
+ *   roaring_iterator_init(&it, &bitmap);
+ *   while (roaring_iterator_next(&it, &id)) { ... }
+ */
+void roaring_iterator_init(RoaringIterator *it, const RoaringBitmap *bitmap);
+bool roaring_iterator_next(RoaringIterator *it, uint32_t *value);
+
+#endif /* ROARING_BITMAP_H */
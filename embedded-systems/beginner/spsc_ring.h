@@ -0,0 +1,198 @@
+/**
+ * ============================================================================
+ * spsc_ring.h - Lock-Free Single-Producer / Single-Consumer Byte Ring
+ * ============================================================================
+ *
+ * PURPOSE:
+ * Hand bytes from ONE producer (an ISR, a DMA callback, a thread) to ONE
+ * consumer (the main loop) without disabling interrupts and without
+ * losing data when the producer runs several times before the consumer.
+ *
+ * CONCEPT:
+ * - head: next slot to write, only the producer stores it
+ * - tail: next slot to read, only the consumer stores it
+ * - Both are free-running counters; slot = counter & (capacity - 1), so
+ *   the capacity must be a power of two and head - tail is the fill level
+ * - The producer writes the data, THEN publishes head with a release
+ *   store; the consumer loads head with acquire before reading the data
+ *   (and the same in reverse for tail). No locks, no read-modify-write.
+ *
+ * Why not volatile: volatile stops the compiler caching a value but it
+ * does not order the data writes before the index update (see
+ * volatile_reordering_example()). Acquire/release does both.
+ *
+ * MEMORY IMPLICATIONS:
+ * - Storage is supplied by the caller (a static array: no malloc in ISRs)
+ * - head and tail live on separate cache lines so producer and consumer
+ *   never fight over one line (false sharing). Each side also keeps a
+ *   cached copy of the other's index and only re-reads it when the ring
+ *   looks full / empty.
+ *
+ * CPU OVERHEAD:
+ * - push / pop: one relaxed load, usually no cross-core traffic, one
+ *   release store
+ * - *_bulk: the same two index operations for the whole batch plus at
+ *   most two memcpy calls (the batch may wrap around the end)
+ *
+ * Needs C11 <stdatomic.h>. Plain loads/stores of a 32-bit index are
+ * lock-free even on Cortex-M0 (no LDREX/STREX required).
+ *
+ * ============================================================================
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#define SPSC_CACHE_LINE 64
+
+typedef struct {
+    // Producer's line
+    _Alignas(SPSC_CACHE_LINE) atomic_size_t head;
+    size_t cached_tail;             // Producer's last view of tail
+
+    // Consumer's line
+    _Alignas(SPSC_CACHE_LINE) atomic_size_t tail;
+    size_t cached_head;             // Consumer's last view of head
+
+    // Read-only after init
+    _Alignas(SPSC_CACHE_LINE) uint8_t* buffer;
+    size_t mask;                    // capacity - 1
+} SpscRing;
+
+/**
+ * Use 'storage' (capacity bytes) as an empty ring
+ * Returns: false unless capacity is a power of two (>= 2)
+ */
+static inline bool spsc_ring_init(SpscRing* ring, uint8_t* storage, size_t capacity) {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) return false;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->cached_tail = 0;
+    ring->cached_head = 0;
+    ring->buffer = storage;
+    ring->mask = capacity - 1;
+    return true;
+}
+
+static inline size_t spsc_ring_capacity(const SpscRing* ring) {
+    return ring->mask + 1;
+}
+
+/**
+ * Bytes currently queued. Exact when called by either side while the
+ * other is idle; otherwise a snapshot.
+ */
+static inline size_t spsc_ring_size(SpscRing* ring) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    return head - tail;
+}
+
+/* ============================================================================
+ * Producer side
+ * ============================================================================
+ */
+
+/**
+ * Free slots as seen by the producer. Re-reads tail only when the cached
+ * value says there is not enough room.
+ */
+static inline size_t spsc_ring_room(SpscRing* ring, size_t head, size_t wanted) {
+    size_t capacity = ring->mask + 1;
+    size_t free_slots = capacity - (head - ring->cached_tail);
+    if (free_slots < wanted) {
+        ring->cached_tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        free_slots = capacity - (head - ring->cached_tail);
+    }
+    return free_slots;
+}
+
+/**
+ * Queue one byte (safe to call from an ISR)
+ * Returns: false if the ring is full (byte dropped)
+ */
+static inline bool spsc_ring_push(SpscRing* ring, uint8_t byte) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (spsc_ring_room(ring, head, 1) == 0) return false;
+    ring->buffer[head & ring->mask] = byte;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * Queue up to 'count' bytes with a single index update
+ * Returns: bytes queued (less than count if the ring filled up)
+ */
+static inline size_t spsc_ring_push_bulk(SpscRing* ring, const uint8_t* data, size_t count) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t free_slots = spsc_ring_room(ring, head, count);
+    if (count > free_slots) count = free_slots;
+    if (count == 0) return 0;
+
+    size_t start = head & ring->mask;
+    size_t first = spsc_ring_capacity(ring) - start;   // Slots before the wrap
+    if (first > count) first = count;
+    memcpy(&ring->buffer[start], data, first);
+    memcpy(ring->buffer, data + first, count - first);
+
+    atomic_store_explicit(&ring->head, head + count, memory_order_release);
+    return count;
+}
+
+/* ============================================================================
+ * Consumer side
+ * ============================================================================
+ */
+
+/**
+ * Bytes available to the consumer. Re-reads head only when the cached
+ * value says the ring holds fewer than 'wanted'.
+ */
+static inline size_t spsc_ring_available(SpscRing* ring, size_t tail, size_t wanted) {
+    size_t available = ring->cached_head - tail;
+    if (available < wanted) {
+        ring->cached_head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        available = ring->cached_head - tail;
+    }
+    return available;
+}
+
+/**
+ * Take one byte
+ * Returns: false if the ring is empty
+ */
+static inline bool spsc_ring_pop(SpscRing* ring, uint8_t* byte) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (spsc_ring_available(ring, tail, 1) == 0) return false;
+    *byte = ring->buffer[tail & ring->mask];
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * Take up to 'max' bytes with a single index update (drain a batch)
+ * Returns: bytes copied to 'out'
+ */
+static inline size_t spsc_ring_pop_bulk(SpscRing* ring, uint8_t* out, size_t max) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t count = spsc_ring_available(ring, tail, max);
+    if (count > max) count = max;
+    if (count == 0) return 0;
+
+    size_t start = tail & ring->mask;
+    size_t first = spsc_ring_capacity(ring) - start;
+    if (first > count) first = count;
+    memcpy(out, &ring->buffer[start], first);
+    memcpy(out + first, ring->buffer, count - first);
+
+    atomic_store_explicit(&ring->tail, tail + count, memory_order_release);
+    return count;
+}
+
+#endif /* SPSC_RING_H */
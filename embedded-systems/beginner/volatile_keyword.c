@@ -37,6 +37,16 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
+#include <stdatomic.h>
+#include "spsc_ring.h"
+#include "event_wait.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_PTHREADS 1
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 /* ============================================================================
  * PART 1: Hardware Register Simulation
@@ -48,9 +58,14 @@
 // Simulated hardware register (in real embedded: memory-mapped I/O address)
 static uint32_t simulated_hardware_register = 0x00;
 
+// Notified by whatever makes the register change (on a board: the
+// peripheral's ISR; here: the simulation helper)
+static EventSignal hardware_event = EVENT_SIGNAL_INIT;
+
 // Helper to simulate hardware changing the register
 void simulate_hardware_update(void) {
     simulated_hardware_register = 0xFF;  // Hardware sets ready flag
+    event_notify(&hardware_event);
 }
 
 /**
@@ -94,9 +109,10 @@ void wait_for_hardware_correct(void) {
     //   ldr r0, [status_register]  ; Load from memory
     //   cmp r0, #0                 ; Compare
     //   beq loop                   ; Branch if equal
-    while (*status_register == 0) {
-        // Genuine memory read each iteration
-    }
+    //
+    // Instead of spinning at 100% CPU, sleep between reads (WFE / futex)
+    // until simulate_hardware_update() or an ISR notifies hardware_event
+    EVENT_WAIT_UNTIL(&hardware_event, *status_register != 0);
     
     printf("Hardware ready!\n");
 }
@@ -170,12 +186,17 @@ bool gpio_read_pin(uint8_t pin) {
  */
 
 // Flag set by interrupt handler
+// (single-core ISR model: volatile is enough when the "ISR" interrupts the
+// same core, as in these demos. A flag shared between threads or cores
+// needs atomics - see wait_demo_flag below.)
 static volatile bool data_ready = false;
+static EventSignal uart_event = EVENT_SIGNAL_INIT;
 
 // Simulated interrupt handler
 void UART_IRQHandler(void) {
     // Hardware interrupt occurred - data received
     data_ready = true;  // Signal main loop
+    event_notify(&uart_event);  // Wake the main loop if it is asleep
     
     // Without volatile, compiler might optimize away the write
     // thinking "no one reads this variable"
@@ -185,22 +206,209 @@ void UART_IRQHandler(void) {
  * Wait for data in main loop
  * 
  * Pattern: Polling a flag set by interrupt
- * CPU overhead: Spin-wait burns CPU cycles
- * Better approach: Use sleep/WFI instruction in real embedded
+ * CPU overhead: a short spin, then the core sleeps (WFE on Cortex-M,
+ * futex on Linux) until UART_IRQHandler() notifies uart_event
  */
 void wait_for_uart_data(void) {
     printf("Waiting for UART interrupt...\n");
     
     // Must be volatile - ISR modifies it
-    while (!data_ready) {
-        // Busy-wait (inefficient but simple)
-        // In real embedded: __WFI() to sleep until interrupt
-    }
+    EVENT_WAIT_UNTIL(&uart_event, data_ready);
     
     printf("Data received!\n");
     data_ready = false;  // Clear flag
 }
 
+/* ============================================================================
+ * PART 3b: Interrupt-to-Main-Loop Byte Queue
+ * ============================================================================
+ * One flag holds one event: if the UART delivers 8 bytes before the main
+ * loop looks, 7 are gone. A lock-free SPSC ring (spsc_ring.h) queues them
+ * all; the ISR is the only producer and the main loop the only consumer.
+ */
+
+static volatile uint8_t simulated_uart_dr;      // UART data register
+static volatile uint8_t flag_rx_byte;           // Single-slot handoff (flag version)
+
+static uint8_t uart_rx_storage[256];            // Power of two
+static SpscRing uart_rx_ring;
+static uint32_t uart_rx_overruns;               // Bytes dropped because the ring was full
+
+/**
+ * Flag version: each interrupt overwrites the previous byte
+ */
+void UART_IRQHandler_flag(void) {
+    flag_rx_byte = simulated_uart_dr;
+    data_ready = true;
+}
+
+/**
+ * Ring version: each interrupt queues its byte
+ *
+ * CPU: ~10 instructions, no interrupt masking, no loop
+ */
+void UART_IRQHandler_ring(void) {
+    uint8_t byte = simulated_uart_dr;           // Reading DR clears RXNE on STM32
+    if (!spsc_ring_push(&uart_rx_ring, byte)) {
+        uart_rx_overruns++;
+    }
+}
+
+/**
+ * Main loop side: take everything that arrived since the last call
+ *
+ * Woken once per batch instead of once per byte: the core can sleep
+ * (EVENT_WAIT_UNTIL, event_wait.h) between batches rather than spin on a flag.
+ */
+size_t uart_drain(uint8_t* out, size_t max) {
+    return spsc_ring_pop_bulk(&uart_rx_ring, out, max);
+}
+
+void demonstrate_uart_queue(void) {
+    const char message[] = "AT+OK\r\n";     // 7 bytes arrive back to back
+    uint8_t received[sizeof(uart_rx_storage)];
+
+    // Flag version: every byte lands before the main loop runs
+    data_ready = false;
+    for (size_t i = 0; message[i] != '\0'; i++) {
+        simulated_uart_dr = (uint8_t)message[i];
+        UART_IRQHandler_flag();
+    }
+    printf("Flag: main loop sees 1 byte ('%c' = 0x%02X), %zu lost\n",
+           flag_rx_byte >= 0x20 ? flag_rx_byte : '?', flag_rx_byte, sizeof(message) - 2);
+    data_ready = false;
+
+    // Ring version: same burst
+    spsc_ring_init(&uart_rx_ring, uart_rx_storage, sizeof(uart_rx_storage));
+    for (size_t i = 0; message[i] != '\0'; i++) {
+        simulated_uart_dr = (uint8_t)message[i];
+        UART_IRQHandler_ring();
+    }
+    size_t count = uart_drain(received, sizeof(received));
+    printf("Ring: main loop drains %zu bytes in one batch: \"", count);
+    for (size_t i = 0; i < count; i++) {
+        if (received[i] == '\r') printf("\\r");
+        else if (received[i] == '\n') printf("\\n");
+        else printf("%c", received[i]);
+    }
+    printf("\", %u overruns\n", uart_rx_overruns);
+}
+
+#ifdef HAVE_PTHREADS
+// A second thread stands in for the UART interrupt at full speed
+#define STRESS_BYTES 20000000u
+
+static SpscRing stress_ring;
+static uint8_t stress_storage[4096];
+
+static void* stress_producer(void* arg) {
+    (void)arg;
+    uint8_t chunk[64];
+    uint32_t sent = 0;
+    while (sent < STRESS_BYTES) {
+        // Alternate single-byte (ISR-style) and burst (DMA-style) pushes
+        if (sent % 1024 < 512) {
+            if (spsc_ring_push(&stress_ring, (uint8_t)sent)) sent++;
+            else sched_yield();
+            continue;
+        }
+        size_t n = sizeof(chunk);
+        if (n > STRESS_BYTES - sent) n = STRESS_BYTES - sent;
+        for (size_t i = 0; i < n; i++) chunk[i] = (uint8_t)(sent + i);
+        size_t pushed = spsc_ring_push_bulk(&stress_ring, chunk, n);
+        sent += (uint32_t)pushed;
+        if (pushed < n) sched_yield();      // Ring full: let the consumer run
+    }
+    return NULL;
+}
+
+void demonstrate_ring_stress(void) {
+    pthread_t producer;
+    spsc_ring_init(&stress_ring, stress_storage, sizeof(stress_storage));
+    if (pthread_create(&producer, NULL, stress_producer, NULL) != 0) {
+        printf("Could not start producer thread\n");
+        return;
+    }
+
+    clock_t start = clock();
+    uint8_t batch[512];
+    uint32_t received = 0, errors = 0, batches = 0;
+    while (received < STRESS_BYTES) {
+        size_t n = spsc_ring_pop_bulk(&stress_ring, batch, sizeof(batch));
+        if (n == 0) {
+            sched_yield();                  // On a microcontroller: __WFI()
+            continue;
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (batch[i] != (uint8_t)(received + i)) errors++;
+        }
+        received += (uint32_t)n;
+        batches++;
+    }
+    pthread_join(producer, NULL);
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Threaded: %u bytes in %u batches, %u out of order/lost, %.1f MB/s\n",
+           received, batches, errors, seconds > 0 ? received / seconds / 1e6 : 0.0);
+}
+#endif
+
+#ifdef HAVE_PTHREADS
+/**
+ * CPU time a waiter burns while the "interrupt" takes 200 ms to arrive:
+ * spin loop vs EVENT_WAIT_UNTIL
+ *
+ * Here the "ISR" is a real second thread, so the flag is atomic_bool:
+ * volatile would be a data race. The release store / acquire load pair
+ * also orders any data written before the flag.
+ */
+static atomic_bool wait_demo_flag;
+static EventSignal wait_demo_event = EVENT_SIGNAL_INIT;
+static bool wait_demo_spin;
+
+static double thread_cpu_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void* wait_demo_waiter(void* arg) {
+    double* cpu_ms = arg;
+    double start = thread_cpu_ms();
+    if (wait_demo_spin) {
+        while (!atomic_load_explicit(&wait_demo_flag, memory_order_acquire)) {
+            // Busy-wait
+        }
+    } else {
+        EVENT_WAIT_UNTIL(&wait_demo_event,
+                         atomic_load_explicit(&wait_demo_flag, memory_order_acquire));
+    }
+    *cpu_ms = thread_cpu_ms() - start;
+    return NULL;
+}
+
+static double measure_waiter_cpu(bool spin) {
+    pthread_t waiter;
+    double cpu_ms = -1.0;
+    atomic_store_explicit(&wait_demo_flag, false, memory_order_relaxed);  // Before the thread exists
+    wait_demo_spin = spin;
+    if (pthread_create(&waiter, NULL, wait_demo_waiter, &cpu_ms) != 0) return -1.0;
+
+    struct timespec delay = { 0, 200 * 1000000L };
+    nanosleep(&delay, NULL);
+    atomic_store_explicit(&wait_demo_flag, true, memory_order_release);   // The "ISR" fires
+    event_notify(&wait_demo_event);
+    pthread_join(waiter, NULL);
+    return cpu_ms;
+}
+
+void demonstrate_event_wait(void) {
+    printf("Waiter CPU time over a 200 ms wait:\n");
+    printf("  Spin loop:        %6.1f ms\n", measure_waiter_cpu(true));
+    printf("  EVENT_WAIT_UNTIL: %6.1f ms\n", measure_waiter_cpu(false));
+}
+#endif
+
 /* ============================================================================
  * PART 4: Performance Comparison
  * ============================================================================
@@ -341,6 +549,16 @@ int main(void) {
     UART_IRQHandler();  // Simulate interrupt
     wait_for_uart_data();
     
+    printf("\n");
+
+    // Demonstration 3b: Queue instead of flag
+    printf("--- Demo 3b: ISR -> Main Loop Byte Queue ---\n");
+    demonstrate_uart_queue();
+#ifdef HAVE_PTHREADS
+    demonstrate_ring_stress();
+    demonstrate_event_wait();
+#endif
+
     printf("\n");
     
     // Demonstration 4: Performance comparison
@@ -362,6 +580,8 @@ int main(void) {
     printf("3. volatile ≠ atomic (use mutexes for multi-byte)\n");
     printf("4. volatile ≠ memory barrier (use __DMB on ARM)\n");
     printf("5. Accept the performance cost for correctness\n");
+    printf("6. ISR -> main loop data: SPSC ring with acquire/release, not a flag\n");
+    printf("7. Sleep while waiting (EVENT_WAIT_UNTIL), don't spin\n");
     printf("=================================================\n");
     
     return 0;
@@ -8,27 +8,31 @@
  * - Read a number from user
  * - Check if it's prime
  * - Display appropriate message
+ *
+ * The check is is_prime64() (deterministic Miller-Rabin, any 64-bit
+ * number in microseconds) and the extras use the segmented sieve
+ * from fundamentals/intermediate/prime_sieve.h.
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
+#include "prime_sieve.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
-bool is_prime(int n) {
-    if (n <= 1) return false;
-    if (n <= 3) return true;
-    if (n % 2 == 0 || n % 3 == 0) return false;
+#define FACTOR_SEARCH_LIMIT 10000000ULL
 
-    // Check divisors up to √n
-    for (int i = 5; i * i <= n; i += 6) {
-        if (n % i == 0 || n % (i + 2) == 0) {
-            return false;
+// Smallest factor > 1 of a composite, or 0 if it is above the search limit
+unsigned long long smallest_factor(unsigned long long n) {
+    for (unsigned long long i = 2; i <= n / i && i <= FACTOR_SEARCH_LIMIT; i++) {
+        if (n % i == 0) {
+            return i;
         }
     }
-    return true;
+    return 0;
 }
 
 int main(void) {
@@ -37,34 +41,54 @@ int main(void) {
     setvbuf(stdout, NULL, _IOFBF, 1000);
 #endif
 
-    int number;
+    long long number;
 
     printf("========================================\n");
     printf("      PRIME NUMBER CHECKER             \n");
     printf("========================================\n\n");
 
     printf("Enter a positive integer: ");
-    scanf("%d", &number);
+    if (scanf("%lld", &number) != 1) {
+        printf("\nThat is not a number.\n");
+        return 1;
+    }
 
     printf("\n");
 
     if (number < 0) {
         printf("Please enter a positive number.\n");
-    } else if (is_prime(number)) {
-        printf("%d is a PRIME number! ✓\n", number);
-        printf("It is only divisible by 1 and %d.\n", number);
+    } else if (is_prime64((uint64_t)number)) {
+        printf("%lld is a PRIME number! ✓\n", number);
+        printf("It is only divisible by 1 and %lld.\n", number);
     } else {
-        printf("%d is NOT a prime number. ✗\n", number);
-        
+        printf("%lld is NOT a prime number. ✗\n", number);
+
         // Show first factor found
-        if (number > 1) {
-            for (int i = 2; i <= number / 2; i++) {
-                if (number % i == 0) {
-                    printf("It is divisible by %d (and others).\n", i);
-                    break;
-                }
+        unsigned long long factor = number > 1 ? smallest_factor((unsigned long long)number) : 0;
+        if (factor != 0) {
+            printf("It is divisible by %llu (and others).\n", factor);
+        } else if (number > 1) {
+            printf("Its smallest factor is above %llu.\n", FACTOR_SEARCH_LIMIT);
+        }
+    }
+
+    // Bulk queries from the sieve (counting below 10^10 takes seconds)
+    uint64_t n = (uint64_t)number;
+    if (number >= 2 && n <= 10000000000ULL) {
+        printf("\nThere are %llu primes <= %lld.\n",
+               (unsigned long long)prime_count_parallel(n, 0), number);
+    }
+    if (number >= 0 && n <= PRIME_SIEVE_MAX - 1000) {
+        size_t count;
+        uint64_t *primes = primes_in_range(n + 1, n + 1000, &count);
+        if (count > 0) {
+            printf("Next primes:");
+            for (size_t i = 0; i < count && i < 5; i++) {
+                printf(" %llu", (unsigned long long)primes[i]);
             }
+            printf("\n");
         }
+        free(primes);
     }
 
     return 0;
@@ -6,9 +6,15 @@
  * 
  * Formula: n! = n × (n-1) × (n-2) × ... × 2 × 1
  * Example: 5! = 5 × 4 × 3 × 2 × 1 = 120
+ *
+ * Only 21 factorials (0! .. 20!) fit in 64 bits, so the answer is a
+ * lookup in the precomputed table from math_utils (factorial_checked),
+ * which also reports overflow instead of returning a wrapped value.
+ * The loop version is kept to show how the table values are built.
  */
 
 #include <stdio.h>
+#include "math_utils.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -26,11 +32,11 @@ long long factorial_iterative(int n) {
     return result;
 }
 
-// Recursive factorial
-long long factorial_recursive(int n) {
-    if (n < 0) return -1;
-    if (n == 0 || n == 1) return 1;
-    return n * factorial_recursive(n - 1);
+// Table lookup: O(1), -1 if n is negative or n! overflows
+long long factorial_lookup(int n) {
+    uint64_t value;
+    if (!factorial_checked(n, &value)) return -1;
+    return (long long)value;  // 20! < LLONG_MAX
 }
 
 int main(void) {
@@ -46,17 +52,17 @@ int main(void) {
     printf("      FACTORIAL CALCULATOR             \n");
     printf("========================================\n\n");
 
-    printf("Enter a number (0-20): ");
+    printf("Enter a number (0-%d): ", FACTORIAL_MAX_U64);
     scanf("%d", &number);
 
     printf("\n");
 
     if (number < 0) {
         printf("Factorial is not defined for negative numbers.\n");
-    } else if (number > 20) {
-        printf("Number too large (overflow risk). Please enter 0-20.\n");
+    } else if (number > FACTORIAL_MAX_U64) {
+        printf("Number too large (overflow risk). Please enter 0-%d.\n", FACTORIAL_MAX_U64);
     } else {
-        result = factorial_iterative(number);
+        result = factorial_lookup(number);
         printf("%d! = %lld\n\n", number, result);
 
         // Show calculation steps for small numbers
@@ -68,10 +74,10 @@ int main(void) {
             printf(" = %lld\n", result);
         }
 
-        // Verify with recursive version
-        long long recursive_result = factorial_recursive(number);
-        printf("\nVerification (recursive): %d! = %lld ✓\n", 
-               number, recursive_result);
+        // Verify with the loop version
+        long long iterative_result = factorial_iterative(number);
+        printf("\nVerification (iterative): %d! = %lld %s\n",
+               number, iterative_result, iterative_result == result ? "✓" : "✗");
     }
 
     return 0;
@@ -6,9 +6,16 @@
  * 
  * Sequence: 0, 1, 1, 2, 3, 5, 8, 13, 21, 34, ...
  * Each term is the sum of the two preceding terms.
+ *
+ * Terms up to F(93) fit in 64 bits (94 terms). A single term comes from
+ * the precomputed table in math_utils (fibonacci_checked), not from the
+ * exponential fib(n-1) + fib(n-2) recursion.
  */
 
 #include <stdio.h>
+#include "math_utils.h"
+
+#define MAX_TERMS (FIBONACCI_MAX_U64 + 1)
 
 #ifdef _WIN32
 #include <windows.h>
@@ -20,18 +27,18 @@ void print_fibonacci(int n) {
         return;
     }
 
-    long long prev = 0, curr = 1, next;
+    unsigned long long prev = 0, curr = 1, next;
 
     printf("Fibonacci sequence (%d terms):\n", n);
     
     for (int i = 0; i < n; i++) {
         if (i == 0) {
-            printf("%lld", prev);
+            printf("%llu", prev);
         } else if (i == 1) {
-            printf(", %lld", curr);
+            printf(", %llu", curr);
         } else {
             next = prev + curr;
-            printf(", %lld", next);
+            printf(", %llu", next);
             prev = curr;
             curr = next;
         }
@@ -44,11 +51,11 @@ void print_fibonacci(int n) {
     printf("\n");
 }
 
-// Recursive Fibonacci (for single term)
-long long fib_recursive(int n) {
-    if (n <= 0) return 0;
-    if (n == 1) return 1;
-    return fib_recursive(n - 1) + fib_recursive(n - 2);
+// Single term: O(1) table lookup (0 if n is out of range)
+unsigned long long fib_term(int n) {
+    uint64_t value;
+    if (!fibonacci_checked(n, &value)) return 0;
+    return (unsigned long long)value;
 }
 
 int main(void) {
@@ -70,9 +77,9 @@ int main(void) {
 
     if (terms <= 0) {
         printf("Please enter a positive number.\n");
-    } else if (terms > 50) {
-        printf("Limited to 50 terms to prevent overflow.\n");
-        terms = 50;
+    } else if (terms > MAX_TERMS) {
+        printf("Limited to %d terms to prevent overflow.\n", MAX_TERMS);
+        terms = MAX_TERMS;
         print_fibonacci(terms);
     } else {
         print_fibonacci(terms);
@@ -80,8 +87,8 @@ int main(void) {
         // Show a specific term calculation
         if (terms >= 10) {
             int specific = 10;
-            printf("\nSpecific term: fib(%d) = %lld\n", 
-                   specific, fib_recursive(specific));
+            printf("\nSpecific term: fib(%d) = %llu\n",
+                   specific, fib_term(specific));
         }
     }
 
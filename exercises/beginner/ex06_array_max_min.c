@@ -8,39 +8,25 @@
  * - Create an array of integers
  * - Find both max and min values
  * - Display their values and positions
+ * 
+ * Uses array_min_max() from data-structures/beginner/array_kernels.c:
+ * one fused SIMD pass finds both values and both indices.
  */
 
 #include <stdio.h>
+#include "array_kernels.h"
+#include "output_writer.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
-void find_max_min(int arr[], int size, int* max, int* min, int* max_idx, int* min_idx) {
-    *max = arr[0];
-    *min = arr[0];
-    *max_idx = 0;
-    *min_idx = 0;
-
-    for (int i = 1; i < size; i++) {
-        if (arr[i] > *max) {
-            *max = arr[i];
-            *max_idx = i;
-        }
-        if (arr[i] < *min) {
-            *min = arr[i];
-            *min_idx = i;
-        }
-    }
-}
-
 void print_array(int arr[], int size) {
-    printf("[");
-    for (int i = 0; i < size; i++) {
-        printf("%d", arr[i]);
-        if (i < size - 1) printf(", ");
-    }
-    printf("]\n");
+    OutputWriter *out = output_stdout();
+    output_write_char(out, '[');
+    write_int_array(out, arr, size > 0 ? (size_t)size : 0, ", ");
+    output_write_str(out, "]\n");
+    output_writer_flush(out);
 }
 
 int main(void) {
@@ -52,8 +38,6 @@ int main(void) {
     int numbers[] = {45, 12, 89, 23, 67, 5, 91, 34, 78, 56};
     int size = sizeof(numbers) / sizeof(numbers[0]);
 
-    int max, min, max_idx, min_idx;
-
     printf("========================================\n");
     printf("    ARRAY MAXIMUM AND MINIMUM          \n");
     printf("========================================\n\n");
@@ -62,12 +46,16 @@ int main(void) {
     print_array(numbers, size);
     printf("Size: %d elements\n\n", size);
 
-    find_max_min(numbers, size, &max, &min, &max_idx, &min_idx);
+    MinMaxResult result;
+    if (!array_min_max(numbers, (size_t)size, &result)) {
+        printf("Error: Empty array\n");
+        return 1;
+    }
 
     printf("Results:\n");
-    printf("  Maximum: %d at index %d\n", max, max_idx);
-    printf("  Minimum: %d at index %d\n", min, min_idx);
-    printf("  Range: %d (difference between max and min)\n", max - min);
+    printf("  Maximum: %d at index %zu\n", result.max, result.max_index);
+    printf("  Minimum: %d at index %zu\n", result.min, result.min_index);
+    printf("  Range: %d (difference between max and min)\n", result.max - result.min);
 
     return 0;
 }
@@ -11,18 +11,18 @@
  */
 
 #include <stdio.h>
+#include "output_writer.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
 void print_array(int arr[], int size) {
-    printf("[");
-    for (int i = 0; i < size; i++) {
-        printf("%d", arr[i]);
-        if (i < size - 1) printf(", ");
-    }
-    printf("]\n");
+    OutputWriter *out = output_stdout();
+    output_write_char(out, '[');
+    write_int_array(out, arr, size > 0 ? (size_t)size : 0, ", ");
+    output_write_str(out, "]\n");
+    output_writer_flush(out);
 }
 
 void reverse_array(int arr[], int size) {
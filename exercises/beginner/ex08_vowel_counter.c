@@ -9,22 +9,57 @@
  * - Count vowels (a, e, i, o, u) - case insensitive
  * - Count consonants (other letters)
  * - Display the counts
+ * 
+ * Uses count_classes() from fundamentals/intermediate/char_classes.c:
+ * the string's length is taken once and both classes are counted 16-32
+ * bytes at a time with a nibble lookup table instead of three calls per
+ * character.
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <ctype.h>
+#include <time.h>
+#include "char_classes.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
+#define CORPUS_BYTES (64u << 20)   // 64MB of generated text for the timing run
+
+enum { CLASS_VOWEL, CLASS_CONSONANT };
+
 int is_vowel(char c) {
     c = tolower(c);
     return (c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u');
 }
 
-void count_vowels_consonants(const char* str, int* vowels, int* consonants) {
+static int is_consonant(int c) {
+    return isalpha(c) && !is_vowel((char)c);
+}
+
+/**
+ * Vowel / consonant table, built on first use (C locale letters only)
+ */
+static const CharClassTable* letter_classes(void) {
+    static CharClassTable table;
+    static int ready = 0;
+    if (!ready) {
+        char_class_table_init(&table);
+        char_class_add(&table, "aeiouAEIOU");             // CLASS_VOWEL
+        char_class_add_ctype(&table, is_consonant);      // CLASS_CONSONANT
+        ready = 1;
+    }
+    return &table;
+}
+
+/**
+ * Original version: three calls and a '\0' test per character
+ */
+void count_vowels_consonants_ctype(const char* str, int* vowels, int* consonants) {
     *vowels = 0;
     *consonants = 0;
 
@@ -39,6 +74,58 @@ void count_vowels_consonants(const char* str, int* vowels, int* consonants) {
     }
 }
 
+void count_vowels_consonants(const char* str, int* vowels, int* consonants) {
+    uint64_t counts[CHAR_CLASS_MAX];
+    count_classes(str, strlen(str), letter_classes(), counts);
+    *vowels = (int)counts[CLASS_VOWEL];
+    *consonants = (int)counts[CLASS_CONSONANT];
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Same counts over a large buffer: per-character loop, vectorized kernel,
+ * and the kernel on every CPU (timings are only meaningful with -O2)
+ */
+static void corpus_benchmark(void) {
+    static const char sample[] = "The quick brown fox jumps over the lazy dog; 42 times!\n";
+    char* corpus = malloc(CORPUS_BYTES + 1);
+    if (corpus == NULL) {
+        printf("\n(no memory for the %u MB corpus)\n", CORPUS_BYTES >> 20);
+        return;
+    }
+    for (size_t i = 0; i < CORPUS_BYTES; i++) {
+        corpus[i] = sample[i % (sizeof(sample) - 1)];
+    }
+    corpus[CORPUS_BYTES] = '\0';
+
+    int v = 0, c = 0;
+    uint64_t counts[CHAR_CLASS_MAX], parallel[CHAR_CLASS_MAX];
+    double t0 = now_seconds();
+    count_vowels_consonants_ctype(corpus, &v, &c);
+    double t1 = now_seconds();
+    count_classes(corpus, CORPUS_BYTES, letter_classes(), counts);
+    double t2 = now_seconds();
+    count_classes_parallel(corpus, CORPUS_BYTES, letter_classes(), parallel, 0);
+    double t3 = now_seconds();
+
+    double mb = (double)CORPUS_BYTES / 1e6;
+    printf("\n%u MB corpus:\n", CORPUS_BYTES >> 20);
+    printf("  isalpha/tolower loop:    %10d vowels %10d consonants  %8.1f MB/s\n",
+           v, c, mb / (t1 - t0));
+    printf("  count_classes:           %10llu vowels %10llu consonants  %8.1f MB/s\n",
+           (unsigned long long)counts[CLASS_VOWEL], (unsigned long long)counts[CLASS_CONSONANT],
+           mb / (t2 - t1));
+    printf("  count_classes_parallel:  %10llu vowels %10llu consonants  %8.1f MB/s\n",
+           (unsigned long long)parallel[CLASS_VOWEL], (unsigned long long)parallel[CLASS_CONSONANT],
+           mb / (t3 - t2));
+    free(corpus);
+}
+
 int main(void) {
 #ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
@@ -66,5 +153,7 @@ int main(void) {
     printf("  Consonants: %d\n", consonants);
     printf("  Total letters: %d\n", vowels + consonants);
 
+    corpus_benchmark();
+
     return 0;
 }
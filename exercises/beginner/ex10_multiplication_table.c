@@ -11,6 +11,7 @@
  */
 
 #include <stdio.h>
+#include "output_writer.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -20,9 +21,18 @@ void print_multiplication_table(int number, int limit) {
     printf("Multiplication Table for %d:\n", number);
     printf("─────────────────────────────\n");
 
+    // Rows are formatted into one buffer (output_writer.h) and written
+    // together: same "%2d × %2d = %4d" layout, no printf per row
+    OutputWriter *out = output_stdout();
     for (int i = 1; i <= limit; i++) {
-        printf("%2d × %2d = %4d\n", number, i, number * i);
+        output_write_int_padded(out, number, 2);
+        output_write_str(out, " × ");
+        output_write_int_padded(out, i, 2);
+        output_write_str(out, " = ");
+        output_write_int_padded(out, (long long)number * i, 4);
+        output_write_char(out, '\n');
     }
+    output_writer_flush(out);
 }
 
 int main(void) {
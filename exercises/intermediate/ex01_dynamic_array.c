@@ -14,11 +14,16 @@
  *    - destroy() - Free all memory
  * 3. Use proper error handling
  * 4. Resize strategy: double capacity when full, halve when 1/4 full
+ * 5. Configurable growth policy (2x, 1.5x, page-rounded) and bulk
+ *    operations that resize and shift at most once per call
  * 
  * Memory Implications:
  * - realloc() may copy entire array: O(n) worst case
  * - Doubling strategy amortizes to O(1) per insertion
  * - Memory overhead: unused capacity space
+ * - 1.5x growth lets freed blocks be reused by later growth; 2x never can
+ * - Page-rounded growth keeps large arrays on whole pages (no tail waste)
+ * - Bulk insert/erase: one memmove of the tail instead of k shifts
  * 
  * Learning objectives:
  * - Dynamic memory management
@@ -29,7 +34,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
+#include "small_vector.h"
+#include "trace.h"
+#include "output_writer.h"
 
 /* Windows UTF-8 console setup */
 #ifdef _WIN32
@@ -41,6 +50,17 @@ void setup_utf8_console(void) {
 void setup_utf8_console(void) {}
 #endif
 
+#define PAGE_SIZE_BYTES 4096
+
+/**
+ * How capacity grows when the array is full
+ */
+typedef enum {
+    GROWTH_DOUBLE,        /* capacity * 2   - fewest reallocs */
+    GROWTH_ONE_AND_HALF,  /* capacity * 1.5 - less slack, allows block reuse */
+    GROWTH_PAGE_ROUNDED   /* capacity * 2 rounded up to whole 4KB pages */
+} GrowthPolicy;
+
 /**
  * Dynamic array structure
  */
@@ -48,6 +68,7 @@ typedef struct {
     int *data;      /* Pointer to array data */
     size_t size;    /* Number of elements currently in array */
     size_t capacity; /* Total allocated capacity */
+    GrowthPolicy growth; /* Applied when more capacity is needed */
 } DynamicArray;
 
 /**
@@ -69,10 +90,20 @@ DynamicArray* create_array(size_t initial_capacity) {
     
     arr->size = 0;
     arr->capacity = initial_capacity;
+    arr->growth = GROWTH_DOUBLE;
     
     return arr;
 }
 
+/**
+ * Select the growth policy used by later appends/inserts
+ */
+void set_growth_policy(DynamicArray *arr, GrowthPolicy policy) {
+    if (arr != NULL) {
+        arr->growth = policy;
+    }
+}
+
 /**
  * Resize the array (internal helper function)
  * Time complexity: O(n) - must copy all elements
@@ -81,6 +112,8 @@ static bool resize_array(DynamicArray *arr, size_t new_capacity) {
     if (arr == NULL || new_capacity < arr->size) {
         return false;
     }
+    TRACE_SCOPE("dynamic_array resize");
+    TRACE_COUNTER("dynamic_array capacity", new_capacity);
     
     int *new_data = (int*)realloc(arr->data, new_capacity * sizeof(int));
     if (new_data == NULL) {
@@ -93,6 +126,78 @@ static bool resize_array(DynamicArray *arr, size_t new_capacity) {
     return true;
 }
 
+/**
+ * Next capacity under the array's growth policy, at least 'min_capacity'
+ */
+static size_t grown_capacity(const DynamicArray *arr, size_t min_capacity) {
+    size_t capacity = arr->capacity;
+    
+    switch (arr->growth) {
+        case GROWTH_ONE_AND_HALF:
+            capacity = capacity + capacity / 2;
+            break;
+        case GROWTH_PAGE_ROUNDED:
+        case GROWTH_DOUBLE:
+        default:
+            capacity = capacity * 2;
+            break;
+    }
+    
+    /* A single large batch may need more than one growth step */
+    if (capacity < min_capacity) {
+        capacity = min_capacity;
+    }
+    if (capacity < 4) {
+        capacity = 4;
+    }
+    
+    if (arr->growth == GROWTH_PAGE_ROUNDED) {
+        size_t per_page = PAGE_SIZE_BYTES / sizeof(int);
+        capacity = (capacity + per_page - 1) / per_page * per_page;
+    }
+    
+    return capacity;
+}
+
+/**
+ * Make room for at least 'min_capacity' elements, growing by policy
+ * Time complexity: O(n) when it reallocates, O(1) otherwise
+ */
+static bool ensure_capacity(DynamicArray *arr, size_t min_capacity) {
+    if (min_capacity <= arr->capacity) {
+        return true;
+    }
+    return resize_array(arr, grown_capacity(arr, min_capacity));
+}
+
+/**
+ * Reserve exact capacity up front (no growth policy applied)
+ * Time complexity: O(n) if it reallocates
+ */
+bool reserve(DynamicArray *arr, size_t capacity) {
+    if (arr == NULL) {
+        return false;
+    }
+    if (capacity <= arr->capacity) {
+        return true;
+    }
+    return resize_array(arr, capacity);
+}
+
+/**
+ * Release unused capacity
+ * Time complexity: O(n) - realloc may move the block
+ */
+bool shrink_to_fit(DynamicArray *arr) {
+    if (arr == NULL) {
+        return false;
+    }
+    if (arr->size == arr->capacity || arr->size == 0) {
+        return true;  /* Keep one block around for an empty array */
+    }
+    return resize_array(arr, arr->size);
+}
+
 /**
  * Append element to end of array
  * Time complexity: O(1) amortized, O(n) worst case
@@ -103,17 +208,36 @@ bool append(DynamicArray *arr, int value) {
     }
     
     /* Resize if at capacity */
-    if (arr->size >= arr->capacity) {
-        size_t new_capacity = arr->capacity * 2;
-        if (!resize_array(arr, new_capacity)) {
-            return false;
-        }
+    if (!ensure_capacity(arr, arr->size + 1)) {
+        return false;
     }
     
     arr->data[arr->size++] = value;
     return true;
 }
 
+/**
+ * Append 'count' elements in one call
+ * Time complexity: O(count) - at most one realloc, one memcpy
+ */
+bool append_many(DynamicArray *arr, const int *values, size_t count) {
+    if (arr == NULL || (values == NULL && count > 0)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    TRACE_SCOPE("append_many");
+    
+    if (!ensure_capacity(arr, arr->size + count)) {
+        return false;
+    }
+    
+    memcpy(arr->data + arr->size, values, count * sizeof(int));
+    arr->size += count;
+    return true;
+}
+
 /**
  * Insert element at specific index
  * Time complexity: O(n) - must shift elements
@@ -124,17 +248,13 @@ bool insert(DynamicArray *arr, size_t index, int value) {
     }
     
     /* Resize if needed */
-    if (arr->size >= arr->capacity) {
-        size_t new_capacity = arr->capacity * 2;
-        if (!resize_array(arr, new_capacity)) {
-            return false;
-        }
+    if (!ensure_capacity(arr, arr->size + 1)) {
+        return false;
     }
     
     /* Shift elements right */
-    for (size_t i = arr->size; i > index; i--) {
-        arr->data[i] = arr->data[i - 1];
-    }
+    memmove(arr->data + index + 1, arr->data + index,
+            (arr->size - index) * sizeof(int));
     
     arr->data[index] = value;
     arr->size++;
@@ -142,6 +262,32 @@ bool insert(DynamicArray *arr, size_t index, int value) {
     return true;
 }
 
+/**
+ * Insert 'count' elements starting at 'index'
+ * Time complexity: O(n + count) - one memmove of the tail,
+ * instead of O(n * count) for 'count' single inserts
+ */
+bool insert_range(DynamicArray *arr, size_t index, const int *values, size_t count) {
+    if (arr == NULL || index > arr->size || (values == NULL && count > 0)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    
+    if (!ensure_capacity(arr, arr->size + count)) {
+        return false;
+    }
+    
+    /* Open a gap of 'count' slots, then fill it */
+    memmove(arr->data + index + count, arr->data + index,
+            (arr->size - index) * sizeof(int));
+    memcpy(arr->data + index, values, count * sizeof(int));
+    arr->size += count;
+    
+    return true;
+}
+
 /**
  * Delete element at specific index
  * Time complexity: O(n) - must shift elements
@@ -152,9 +298,8 @@ bool delete(DynamicArray *arr, size_t index) {
     }
     
     /* Shift elements left */
-    for (size_t i = index; i < arr->size - 1; i++) {
-        arr->data[i] = arr->data[i + 1];
-    }
+    memmove(arr->data + index, arr->data + index + 1,
+            (arr->size - index - 1) * sizeof(int));
     
     arr->size--;
     
@@ -166,6 +311,30 @@ bool delete(DynamicArray *arr, size_t index) {
     return true;
 }
 
+/**
+ * Remove 'count' elements starting at 'index'
+ * Time complexity: O(n) - one memmove of the tail
+ */
+bool erase_range(DynamicArray *arr, size_t index, size_t count) {
+    if (arr == NULL || index > arr->size || count > arr->size - index) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    
+    memmove(arr->data + index, arr->data + index + count,
+            (arr->size - index - count) * sizeof(int));
+    arr->size -= count;
+    
+    /* Same shrink rule as delete() */
+    if (arr->capacity > 4 && arr->size < arr->capacity / 4) {
+        resize_array(arr, arr->capacity / 2);
+    }
+    
+    return true;
+}
+
 /**
  * Get element at specific index
  * Time complexity: O(1)
@@ -181,6 +350,7 @@ bool get(const DynamicArray *arr, size_t index, int *value) {
 
 /**
  * Print array contents
+ * One buffered pass (output_writer.h) instead of a printf per element
  */
 void print_array(const DynamicArray *arr) {
     if (arr == NULL) {
@@ -188,14 +358,15 @@ void print_array(const DynamicArray *arr) {
         return;
     }
     
-    printf("Array[size=%zu, capacity=%zu]: [", arr->size, arr->capacity);
-    for (size_t i = 0; i < arr->size; i++) {
-        printf("%d", arr->data[i]);
-        if (i < arr->size - 1) {
-            printf(", ");
-        }
-    }
-    printf("]\n");
+    OutputWriter *out = output_stdout();
+    output_write_str(out, "Array[size=");
+    output_write_uint(out, arr->size);
+    output_write_str(out, ", capacity=");
+    output_write_uint(out, arr->capacity);
+    output_write_str(out, "]: [");
+    write_int_array(out, arr->data, arr->size, ", ");
+    output_write_str(out, "]\n");
+    output_writer_flush(out);
 }
 
 /**
@@ -209,6 +380,28 @@ void destroy_array(DynamicArray *arr) {
     }
 }
 
+/* ========================================================================
+ * Generic small vectors (see small_vector.h)
+ * ======================================================================== */
+
+/* Most per-request vectors hold < 16 elements: those never touch malloc */
+DEFINE_SMALL_VECTOR(IntVec, int, 16)
+
+/**
+ * Element type that owns heap memory - stored by value, moved bitwise
+ */
+typedef struct {
+    int id;
+    char *name;
+} Record;
+
+DEFINE_SMALL_VECTOR(RecordVec, Record, 4)
+
+static void record_destroy(Record *r) {
+    free(r->name);
+    r->name = NULL;
+}
+
 /**
  * Main function with test cases
  */
@@ -279,11 +472,112 @@ int main(void) {
     destroy_array(arr);
     printf("\n6. Array destroyed, memory freed\n");
     
+    /* Bulk operations */
+    printf("\n7. Bulk operations (one memmove per call)\n");
+    DynamicArray *bulk = create_array(4);
+    if (bulk == NULL) {
+        fprintf(stderr, "Failed to create array\n");
+        return 1;
+    }
+    const int batch[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    const int middle[] = { 100, 200, 300 };
+    
+    append_many(bulk, batch, 8);
+    printf("   append_many(1..8):         ");
+    print_array(bulk);
+    
+    insert_range(bulk, 2, middle, 3);
+    printf("   insert_range(2, 100..300): ");
+    print_array(bulk);
+    
+    erase_range(bulk, 0, 4);
+    printf("   erase_range(0, 4):         ");
+    print_array(bulk);
+    
+    shrink_to_fit(bulk);
+    printf("   shrink_to_fit():           ");
+    print_array(bulk);
+    destroy_array(bulk);
+    
+    /* Growth policies: count reallocations for 1M appends */
+    printf("\n8. Growth policies (1,000,000 appends from capacity 1)\n");
+    const GrowthPolicy policies[] = { GROWTH_DOUBLE, GROWTH_ONE_AND_HALF, GROWTH_PAGE_ROUNDED };
+    const char *policy_names[] = { "2x", "1.5x", "page-rounded" };
+    for (int p = 0; p < 3; p++) {
+        DynamicArray *g = create_array(1);
+        if (g == NULL) {
+            break;
+        }
+        set_growth_policy(g, policies[p]);
+        int resizes = 0;
+        size_t last_capacity = g->capacity;
+        for (int i = 0; i < 1000000; i++) {
+            append(g, i);
+            if (g->capacity != last_capacity) {
+                resizes++;
+                last_capacity = g->capacity;
+            }
+        }
+        printf("   %-13s %2d reallocs, final capacity %zu (%.1f%% slack)\n",
+               policy_names[p], resizes, g->capacity,
+               100.0 * (double)(g->capacity - g->size) / (double)g->capacity);
+        destroy_array(g);
+    }
+    
+    /* reserve() removes reallocs entirely when the size is known */
+    DynamicArray *r = create_array(1);
+    if (r != NULL && reserve(r, 1000000)) {
+        printf("   reserve(1000000) -> capacity %zu, 0 reallocs during appends\n", r->capacity);
+    }
+    destroy_array(r);
+    
+    /* Generic vectors with inline storage */
+    printf("\n9. Generic small vectors (inline capacity, no malloc when small)\n");
+    IntVec small;
+    IntVec_init(&small);
+    for (int i = 0; i < 16; i++) {
+        IntVec_push(&small, i * i);
+    }
+    printf("   IntVec with 16 ints:  inline=%s, sizeof(IntVec)=%zu\n",
+           IntVec_is_inline(&small) ? "yes" : "no", sizeof(IntVec));
+    IntVec_push(&small, 256);
+    printf("   After 17th push:      inline=%s, capacity=%zu, v[16]=%d\n",
+           IntVec_is_inline(&small) ? "yes" : "no", small.capacity, *IntVec_at(&small, 16));
+    
+    IntVec moved;
+    IntVec_init(&moved);
+    IntVec_move(&moved, &small);
+    printf("   After move:           dst size=%zu, src size=%zu (heap block stolen)\n",
+           moved.size, small.size);
+    IntVec_free(&moved);
+    IntVec_free(&small);
+    
+    RecordVec records;
+    RecordVec_init(&records);
+    const char *names[] = { "alpha", "beta", "gamma", "delta", "epsilon", "zeta" };
+    for (int i = 0; i < 6; i++) {
+        /* Construct in place - no temporary Record to copy */
+        Record *slot = RecordVec_emplace(&records);
+        if (slot == NULL) {
+            break;
+        }
+        slot->id = i;
+        slot->name = (char*)malloc(strlen(names[i]) + 1);
+        if (slot->name != NULL) {
+            strcpy(slot->name, names[i]);
+        }
+    }
+    printf("   RecordVec (inline 4) with %zu records: inline=%s, [5]={%d, \"%s\"}\n",
+           records.size, RecordVec_is_inline(&records) ? "yes" : "no",
+           RecordVec_at(&records, 5)->id, RecordVec_at(&records, 5)->name);
+    RecordVec_free_with(&records, record_destroy);
+    
     printf("\n╔════════════════════════════════════════════════════════════╗\n");
     printf("║ Performance Analysis:                                      ║\n");
     printf("║ - Append: O(1) amortized                                   ║\n");
     printf("║ - Insert: O(n) due to shifting                             ║\n");
     printf("║ - Delete: O(n) due to shifting                             ║\n");
+    printf("║ - insert_range/erase_range: O(n + k), one memmove          ║\n");
     printf("║ - Get: O(1) direct access                                  ║\n");
     printf("║ - Space: O(n) with some overhead                           ║\n");
     printf("╚════════════════════════════════════════════════════════════╝\n");
@@ -20,6 +20,11 @@
  * - Non-contiguous memory: poor cache locality
  * - O(1) insertion/deletion at known position
  * - O(n) traversal and search
+ * - Optional NodePool: nodes carved from contiguous slabs, recycled
+ *   through an intrusive free list, released all at once on reset
+ * - LinkedList handle caches tail and length: O(1) append and length
+ * - Unrolled list packs UNROLL_K ints per node: ~K times fewer pointer
+ *   chases (and cache misses) per traversal
  * 
  * Learning objectives:
  * - Pointer manipulation
@@ -30,7 +35,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
+#include "output_writer.h"
 
 /* Windows UTF-8 console setup */
 #ifdef _WIN32
@@ -50,12 +57,118 @@ typedef struct Node {
     struct Node *next;
 } Node;
 
+#define NODES_PER_SLAB 1024  /* 16KB slabs on 64-bit: 4 pages of nodes */
+
 /**
- * Create a new node
+ * Slab: one malloc holding many contiguous nodes
+ */
+typedef struct NodeSlab {
+    struct NodeSlab *next;
+    Node nodes[];            /* NODES_PER_SLAB nodes follow the header */
+} NodeSlab;
+
+/**
+ * Fixed-size node pool
+ * - Fresh nodes are bump-allocated from the current slab (sequential
+ *   addresses, so traversal walks memory in order)
+ * - Freed nodes go on an intrusive free list threaded through 'next'
+ * - node_pool_reset() releases every node in O(1) and keeps the slabs
+ */
+typedef struct {
+    NodeSlab *first;         /* Slab chain, in allocation order */
+    NodeSlab *current;       /* Slab being bump-allocated */
+    size_t used;             /* Nodes handed out from 'current' */
+    Node *free_list;         /* Recycled nodes */
+    size_t slab_count;
+} NodePool;
+
+/**
+ * Initialize an empty pool (no memory until the first node)
+ */
+void node_pool_init(NodePool *pool) {
+    pool->first = NULL;
+    pool->current = NULL;
+    pool->used = 0;
+    pool->free_list = NULL;
+    pool->slab_count = 0;
+}
+
+/**
+ * Take one node from the pool
+ * Time complexity: O(1) - malloc only once per NODES_PER_SLAB nodes
+ */
+static Node* node_pool_alloc(NodePool *pool) {
+    /* Recycled nodes first: they are likely still in cache */
+    if (pool->free_list != NULL) {
+        Node *node = pool->free_list;
+        pool->free_list = node->next;
+        return node;
+    }
+    
+    if (pool->current == NULL || pool->used == NODES_PER_SLAB) {
+        if (pool->current != NULL && pool->current->next != NULL) {
+            /* Reuse a slab kept by an earlier reset */
+            pool->current = pool->current->next;
+        } else {
+            NodeSlab *slab = (NodeSlab*)malloc(sizeof(NodeSlab) + NODES_PER_SLAB * sizeof(Node));
+            if (slab == NULL) {
+                return NULL;
+            }
+            slab->next = NULL;
+            if (pool->current != NULL) {
+                pool->current->next = slab;
+            } else {
+                pool->first = slab;
+            }
+            pool->current = slab;
+            pool->slab_count++;
+        }
+        pool->used = 0;
+    }
+    
+    return &pool->current->nodes[pool->used++];
+}
+
+/**
+ * Return one node to the pool
  * Time complexity: O(1)
  */
-Node* create_node(int data) {
-    Node *new_node = (Node*)malloc(sizeof(Node));
+static void node_pool_release(NodePool *pool, Node *node) {
+    node->next = pool->free_list;
+    pool->free_list = node;
+}
+
+/**
+ * Release every node allocated from the pool at once
+ * Time complexity: O(1) - no per-node work, slabs are kept for reuse
+ * Any list built from this pool becomes invalid.
+ */
+void node_pool_reset(NodePool *pool) {
+    pool->current = pool->first;
+    pool->used = 0;
+    pool->free_list = NULL;
+}
+
+/**
+ * Give the slabs back to the system
+ * Time complexity: O(slabs)
+ */
+void node_pool_destroy(NodePool *pool) {
+    NodeSlab *slab = pool->first;
+    while (slab != NULL) {
+        NodeSlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    node_pool_init(pool);
+}
+
+/**
+ * Create a new node from 'pool', or from malloc when pool is NULL
+ * Time complexity: O(1)
+ */
+Node* create_node_from(NodePool *pool, int data) {
+    Node *new_node = (pool != NULL) ? node_pool_alloc(pool) : (Node*)malloc(sizeof(Node));
     if (new_node == NULL) {
         fprintf(stderr, "Memory allocation failed\n");
         return NULL;
@@ -68,11 +181,30 @@ Node* create_node(int data) {
 }
 
 /**
- * Insert node at the front of the list
+ * Create a new node
  * Time complexity: O(1)
  */
-void insert_front(Node **head, int data) {
-    Node *new_node = create_node(data);
+Node* create_node(int data) {
+    return create_node_from(NULL, data);
+}
+
+/**
+ * Free a node back to where it came from
+ */
+static void destroy_node(NodePool *pool, Node *node) {
+    if (pool != NULL) {
+        node_pool_release(pool, node);
+    } else {
+        free(node);
+    }
+}
+
+/**
+ * Insert node at the front of the list, allocating from 'pool' (may be NULL)
+ * Time complexity: O(1)
+ */
+void insert_front_pool(NodePool *pool, Node **head, int data) {
+    Node *new_node = create_node_from(pool, data);
     if (new_node == NULL) {
         return;
     }
@@ -82,11 +214,19 @@ void insert_front(Node **head, int data) {
 }
 
 /**
- * Insert node at the end of the list
+ * Insert node at the front of the list
+ * Time complexity: O(1)
+ */
+void insert_front(Node **head, int data) {
+    insert_front_pool(NULL, head, data);
+}
+
+/**
+ * Insert node at the end of the list, allocating from 'pool' (may be NULL)
  * Time complexity: O(n) - must traverse to end
  */
-void insert_end(Node **head, int data) {
-    Node *new_node = create_node(data);
+void insert_end_pool(NodePool *pool, Node **head, int data) {
+    Node *new_node = create_node_from(pool, data);
     if (new_node == NULL) {
         return;
     }
@@ -106,6 +246,14 @@ void insert_end(Node **head, int data) {
     current->next = new_node;
 }
 
+/**
+ * Insert node at the end of the list
+ * Time complexity: O(n) - must traverse to end
+ */
+void insert_end(Node **head, int data) {
+    insert_end_pool(NULL, head, data);
+}
+
 /**
  * Insert node after a node with specific value
  * Time complexity: O(n)
@@ -135,10 +283,10 @@ bool insert_after(Node *head, int target, int data) {
 }
 
 /**
- * Delete first node with specific value
+ * Delete first node with specific value, returning it to 'pool' (may be NULL)
  * Time complexity: O(n)
  */
-bool delete_node(Node **head, int data) {
+bool delete_node_pool(NodePool *pool, Node **head, int data) {
     if (*head == NULL) {
         return false;
     }
@@ -147,7 +295,7 @@ bool delete_node(Node **head, int data) {
     if ((*head)->data == data) {
         Node *temp = *head;
         *head = (*head)->next;
-        free(temp);
+        destroy_node(pool, temp);
         return true;
     }
     
@@ -165,11 +313,19 @@ bool delete_node(Node **head, int data) {
     /* Delete node */
     Node *temp = current->next;
     current->next = current->next->next;
-    free(temp);
+    destroy_node(pool, temp);
     
     return true;
 }
 
+/**
+ * Delete first node with specific value
+ * Time complexity: O(n)
+ */
+bool delete_node(Node **head, int data) {
+    return delete_node_pool(NULL, head, data);
+}
+
 /**
  * Search for a node with specific value
  * Time complexity: O(n)
@@ -205,7 +361,7 @@ size_t get_length(Node *head) {
 
 /**
  * Print all nodes in the list
- * Time complexity: O(n)
+ * Time complexity: O(n) - buffered (output_writer.h), no printf per node
  */
 void print_list(Node *head) {
     if (head == NULL) {
@@ -213,16 +369,18 @@ void print_list(Node *head) {
         return;
     }
     
-    printf("List: ");
+    OutputWriter *out = output_stdout();
+    output_write_str(out, "List: ");
     Node *current = head;
     while (current != NULL) {
-        printf("%d", current->data);
+        output_write_int(out, current->data);
         if (current->next != NULL) {
-            printf(" -> ");
+            output_write_str(out, " -> ");
         }
         current = current->next;
     }
-    printf(" -> NULL\n");
+    output_write_str(out, " -> NULL\n");
+    output_writer_flush(out);
 }
 
 /**
@@ -243,6 +401,22 @@ void free_list(Node **head) {
     *head = NULL;
 }
 
+/**
+ * Return all nodes of a pooled list to its pool's free list
+ * Time complexity: O(n) - use node_pool_reset() to drop every list at once
+ */
+void free_list_pool(NodePool *pool, Node **head) {
+    Node *current = *head;
+    
+    while (current != NULL) {
+        Node *next = current->next;
+        node_pool_release(pool, current);
+        current = next;
+    }
+    
+    *head = NULL;
+}
+
 /**
  * Reverse the linked list
  * Time complexity: O(n)
@@ -263,6 +437,325 @@ void reverse_list(Node **head) {
     *head = prev;
 }
 
+/* ========================================================================
+ * List handle: cached head, tail and length
+ * ======================================================================== */
+
+/**
+ * Singly linked list handle
+ * Keeps the bare Node chain compatible with print_list()/search()/...
+ */
+typedef struct {
+    Node *head;
+    Node *tail;
+    size_t length;
+    NodePool *pool;          /* Optional node source (NULL = malloc) */
+} LinkedList;
+
+/**
+ * Initialize an empty list drawing nodes from 'pool' (may be NULL)
+ */
+void list_init(LinkedList *list, NodePool *pool) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    list->pool = pool;
+}
+
+/**
+ * Append at the tail
+ * Time complexity: O(1) - no traversal, tail is cached
+ */
+bool list_push_back(LinkedList *list, int data) {
+    Node *node = create_node_from(list->pool, data);
+    if (node == NULL) {
+        return false;
+    }
+    
+    if (list->tail == NULL) {
+        list->head = node;
+    } else {
+        list->tail->next = node;
+    }
+    list->tail = node;
+    list->length++;
+    
+    return true;
+}
+
+/**
+ * Prepend at the head
+ * Time complexity: O(1)
+ */
+bool list_push_front(LinkedList *list, int data) {
+    Node *node = create_node_from(list->pool, data);
+    if (node == NULL) {
+        return false;
+    }
+    
+    node->next = list->head;
+    list->head = node;
+    if (list->tail == NULL) {
+        list->tail = node;
+    }
+    list->length++;
+    
+    return true;
+}
+
+/**
+ * Remove the head element (queue dequeue)
+ * Time complexity: O(1)
+ */
+bool list_pop_front(LinkedList *list, int *data) {
+    if (list->head == NULL) {
+        return false;
+    }
+    
+    Node *node = list->head;
+    if (data != NULL) {
+        *data = node->data;
+    }
+    list->head = node->next;
+    if (list->head == NULL) {
+        list->tail = NULL;
+    }
+    list->length--;
+    destroy_node(list->pool, node);
+    
+    return true;
+}
+
+/**
+ * Delete first node with 'data', keeping tail and length correct
+ * Time complexity: O(n)
+ */
+bool list_remove(LinkedList *list, int data) {
+    Node *prev = NULL;
+    Node *current = list->head;
+    
+    while (current != NULL && current->data != data) {
+        prev = current;
+        current = current->next;
+    }
+    if (current == NULL) {
+        return false;
+    }
+    
+    if (prev == NULL) {
+        list->head = current->next;
+    } else {
+        prev->next = current->next;
+    }
+    if (list->tail == current) {
+        list->tail = prev;
+    }
+    list->length--;
+    destroy_node(list->pool, current);
+    
+    return true;
+}
+
+/**
+ * Number of elements
+ * Time complexity: O(1) - cached
+ */
+size_t list_length(const LinkedList *list) {
+    return list->length;
+}
+
+/**
+ * Reverse in place; the old head becomes the tail
+ * Time complexity: O(n)
+ */
+void list_reverse(LinkedList *list) {
+    list->tail = list->head;
+    reverse_list(&list->head);
+}
+
+/**
+ * Free all nodes
+ * Time complexity: O(n)
+ */
+void list_free(LinkedList *list) {
+    if (list->pool != NULL) {
+        free_list_pool(list->pool, &list->head);
+    } else {
+        free_list(&list->head);
+    }
+    list->tail = NULL;
+    list->length = 0;
+}
+
+/* ========================================================================
+ * Unrolled linked list: K ints per node
+ * ======================================================================== */
+
+#define UNROLL_K 13  /* next (8) + count (4) + 13 ints (52) = 64 bytes: one cache line */
+
+/**
+ * Unrolled node - values[0..count) are in use
+ */
+typedef struct UnrolledNode {
+    struct UnrolledNode *next;
+    int count;
+    int values[UNROLL_K];
+} UnrolledNode;
+
+/**
+ * Unrolled list handle
+ */
+typedef struct {
+    UnrolledNode *head;
+    UnrolledNode *tail;
+    size_t length;
+} UnrolledList;
+
+void ulist_init(UnrolledList *list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+}
+
+/**
+ * Append at the tail
+ * Time complexity: O(1) - malloc only once per UNROLL_K values
+ */
+bool ulist_push_back(UnrolledList *list, int value) {
+    if (list->tail == NULL || list->tail->count == UNROLL_K) {
+        UnrolledNode *node = (UnrolledNode*)malloc(sizeof(UnrolledNode));
+        if (node == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            return false;
+        }
+        node->next = NULL;
+        node->count = 0;
+        if (list->tail == NULL) {
+            list->head = node;
+        } else {
+            list->tail->next = node;
+        }
+        list->tail = node;
+    }
+    
+    list->tail->values[list->tail->count++] = value;
+    list->length++;
+    return true;
+}
+
+/**
+ * Find a value; reports the node and slot that hold it
+ * Time complexity: O(n), but only n/K pointer dereferences
+ */
+bool ulist_search(const UnrolledList *list, int value, UnrolledNode **node_out, int *slot_out) {
+    for (UnrolledNode *node = list->head; node != NULL; node = node->next) {
+        for (int i = 0; i < node->count; i++) {
+            if (node->values[i] == value) {
+                if (node_out != NULL) *node_out = node;
+                if (slot_out != NULL) *slot_out = i;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Delete first occurrence of a value
+ * Time complexity: O(n) search + O(K) shift inside one node
+ */
+bool ulist_remove(UnrolledList *list, int value) {
+    UnrolledNode *prev = NULL;
+    
+    for (UnrolledNode *node = list->head; node != NULL; prev = node, node = node->next) {
+        for (int i = 0; i < node->count; i++) {
+            if (node->values[i] != value) {
+                continue;
+            }
+            
+            /* Close the gap within this node only */
+            memmove(&node->values[i], &node->values[i + 1],
+                    (size_t)(node->count - i - 1) * sizeof(int));
+            node->count--;
+            list->length--;
+            
+            if (node->count == 0) {
+                if (prev == NULL) {
+                    list->head = node->next;
+                } else {
+                    prev->next = node->next;
+                }
+                if (list->tail == node) {
+                    list->tail = prev;
+                }
+                free(node);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Reverse: reverse the node chain and the values inside each node
+ * Time complexity: O(n)
+ */
+void ulist_reverse(UnrolledList *list) {
+    UnrolledNode *prev = NULL;
+    UnrolledNode *current = list->head;
+    
+    list->tail = list->head;
+    while (current != NULL) {
+        for (int i = 0, j = current->count - 1; i < j; i++, j--) {
+            int temp = current->values[i];
+            current->values[i] = current->values[j];
+            current->values[j] = temp;
+        }
+        UnrolledNode *next = current->next;
+        current->next = prev;
+        prev = current;
+        current = next;
+    }
+    list->head = prev;
+}
+
+/**
+ * Print all values, one bracket group per node
+ * (buffered like print_list(): one write_int_array() per node, one flush)
+ */
+void ulist_print(const UnrolledList *list) {
+    if (list->head == NULL) {
+        printf("List is empty\n");
+        return;
+    }
+    
+    OutputWriter *out = output_stdout();
+    output_write_str(out, "Unrolled: ");
+    for (UnrolledNode *node = list->head; node != NULL; node = node->next) {
+        output_write_char(out, '[');
+        write_int_array(out, node->values, (size_t)node->count, " ");
+        output_write_str(out, node->next != NULL ? "] -> " : "]");
+    }
+    output_write_str(out, " -> NULL (length ");
+    output_write_uint(out, list->length);
+    output_write_str(out, ")\n");
+    output_writer_flush(out);
+}
+
+/**
+ * Free all nodes
+ * Time complexity: O(n / K)
+ */
+void ulist_free(UnrolledList *list) {
+    UnrolledNode *node = list->head;
+    while (node != NULL) {
+        UnrolledNode *next = node->next;
+        free(node);
+        node = next;
+    }
+    ulist_init(list);
+}
+
 /**
  * Main function with test cases
  */
@@ -348,6 +841,75 @@ int main(void) {
     free_list(&head);
     print_list(head);
     
+    /* Pool-backed lists */
+    printf("\n9. Pool-backed lists (slab of %d contiguous nodes)\n", NODES_PER_SLAB);
+    NodePool pool;
+    node_pool_init(&pool);
+    
+    Node *pooled = NULL;
+    for (int i = 5; i >= 1; i--) {
+        insert_front_pool(&pool, &pooled, i * 10);
+    }
+    print_list(pooled);
+    printf("   Adjacent nodes %td bytes apart (sizeof(Node) = %zu)\n",
+           (char*)pooled - (char*)pooled->next, sizeof(Node));
+    
+    delete_node_pool(&pool, &pooled, 30);
+    insert_front_pool(&pool, &pooled, 5);   /* Reuses the freed node */
+    print_list(pooled);
+    
+    /* Churn many short-lived lists: one reset frees each batch */
+    for (int round = 0; round < 1000; round++) {
+        Node *temp = NULL;
+        for (int i = 0; i < 2000; i++) {
+            insert_front_pool(&pool, &temp, i);
+        }
+        node_pool_reset(&pool);
+    }
+    printf("   1000 rounds x 2000 nodes: %zu slab mallocs total\n", pool.slab_count);
+    
+    node_pool_destroy(&pool);
+    
+    /* List handle with cached tail and length */
+    printf("\n10. List handle: O(1) push_back and length\n");
+    LinkedList queue;
+    list_init(&queue, NULL);
+    for (int i = 1; i <= 5; i++) {
+        list_push_back(&queue, i * 100);
+    }
+    print_list(queue.head);
+    int front = 0;
+    if (!list_pop_front(&queue, &front)) {
+        printf("   pop_front failed: list is empty\n");
+    }
+    list_remove(&queue, 500);   /* Removing the tail updates the cached tail */
+    list_push_back(&queue, 600);
+    printf("   pop_front -> %d, remove 500, push_back 600\n   ", front);
+    print_list(queue.head);
+    list_reverse(&queue);
+    printf("   reversed (tail now %d, length %zu)\n   ", queue.tail->data, list_length(&queue));
+    print_list(queue.head);
+    list_free(&queue);
+    
+    /* Unrolled list */
+    printf("\n11. Unrolled list (%d ints per %zu-byte node)\n", UNROLL_K, sizeof(UnrolledNode));
+    UnrolledList unrolled;
+    ulist_init(&unrolled);
+    for (int i = 1; i <= 30; i++) {
+        ulist_push_back(&unrolled, i);
+    }
+    ulist_print(&unrolled);
+    ulist_remove(&unrolled, 15);
+    ulist_reverse(&unrolled);
+    printf("   remove 15, reverse:\n   ");
+    ulist_print(&unrolled);
+    UnrolledNode *where;
+    int slot;
+    if (ulist_search(&unrolled, 7, &where, &slot)) {
+        printf("   search(7): slot %d of node holding %d values\n", slot, where->count);
+    }
+    ulist_free(&unrolled);
+    
     printf("\n╔════════════════════════════════════════════════════════════╗\n");
     printf("║ Performance Analysis:                                      ║\n");
     printf("║ - Insert front: O(1)                                       ║\n");
@@ -359,6 +921,9 @@ int main(void) {
     printf("║ Memory Overhead:                                           ║\n");
     printf("║ - Per node: 8 bytes (pointer) + data size                 ║\n");
     printf("║ - Poor cache locality vs. arrays                           ║\n");
+    printf("║ - NodePool: slab-contiguous nodes, O(1) bulk reset        ║\n");
+    printf("║ - LinkedList handle: O(1) push_back and length            ║\n");
+    printf("║ - Unrolled list: 13 ints per cache-line node              ║\n");
     printf("╚════════════════════════════════════════════════════════════╝\n");
     
     return 0;
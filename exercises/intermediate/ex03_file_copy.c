@@ -14,6 +14,8 @@
  * - Buffer size affects performance: larger = fewer syscalls
  * - Typical: 4KB-64KB buffer (match OS page size)
  * - Trade-off: memory usage vs. I/O efficiency
+ * - Kernel-side copy (copy_file_range/sendfile) skips the userspace
+ *   buffer entirely: data never crosses the user/kernel boundary
  * 
  * Learning objectives:
  * - File I/O operations
@@ -22,10 +24,41 @@
  * - System programming patterns
  */
 
+/* copy_file_range() is a GNU extension - must be requested before any include */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+#include "trace.h"    /* TRACE_SCOPE: compiled out unless ENABLE_TRACING */
+#include "crc32.h"    /* crc32c_update(): SSE4.2 / ARMv8 CRC, slicing-16 fallback */
+
+/* POSIX file descriptors are needed for the kernel-side copy paths */
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_POSIX_IO 1
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+/* Pipelined engine: reader threads + optional io_uring (see CMakeLists.txt) */
+#ifdef HAVE_POSIX_IO
+#include <pthread.h>
+#endif
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
 
 /* Windows UTF-8 console setup */
 #ifdef _WIN32
@@ -38,6 +71,66 @@ void setup_utf8_console(void) {}
 #endif
 
 #define BUFFER_SIZE 8192  /* 8KB buffer - good balance */
+#define KERNEL_CHUNK_SIZE (8 * 1024 * 1024)  /* 8MB per syscall, keeps progress dots alive */
+#define PIPELINE_BLOCK_SIZE (1024 * 1024)    /* 1MB per ring slot */
+#define PIPELINE_ALIGNMENT 4096              /* Page/sector aligned - O_DIRECT friendly */
+#define PIPELINE_DEFAULT_DEPTH 8
+#define PIPELINE_MAX_DEPTH 256
+#define PIPELINE_MAX_JOBS 64
+#define VERIFY_BLOCK_SIZE (1024 * 1024)     /* 1MB blocks for memcmp/checksum */
+
+/**
+ * How to confirm a copy
+ */
+typedef enum {
+    VERIFY_NONE,
+    VERIFY_CHECKSUM,  /* CRC32C computed during the copy, destination read once */
+    VERIFY_FULL       /* Block-by-block memcmp of source and destination */
+} VerifyMode;
+
+/**
+ * Copy strategies, fastest first.
+ * COPY_METHOD_AUTO tries each kernel-side method in order and falls back
+ * to the next one when the kernel or filesystem does not support it.
+ */
+typedef enum {
+    COPY_METHOD_AUTO,
+    COPY_METHOD_COPY_FILE_RANGE,  /* In-kernel, may reflink or offload to the device */
+    COPY_METHOD_SENDFILE,         /* In-kernel page cache -> file, one copy */
+    COPY_METHOD_MMAP,             /* Map source, write() straight from the mapping */
+    COPY_METHOD_STDIO             /* Portable fread/fwrite loop via copy_file() */
+} CopyMethod;
+
+/**
+ * Human-readable name of a copy method
+ */
+const char* copy_method_name(CopyMethod method) {
+    switch (method) {
+        case COPY_METHOD_AUTO:            return "auto";
+        case COPY_METHOD_COPY_FILE_RANGE: return "copy_file_range";
+        case COPY_METHOD_SENDFILE:        return "sendfile";
+        case COPY_METHOD_MMAP:            return "mmap+write";
+        case COPY_METHOD_STDIO:           return "stdio";
+    }
+    return "unknown";
+}
+
+/**
+ * Print one progress dot per 10% copied
+ * (large kernel-side chunks can cross several 10% steps at once)
+ */
+static void show_progress(size_t total_copied, long file_size, int *last_decile) {
+    if (file_size > 0) {
+        int decile = (int)((total_copied * 10) / (size_t)file_size);
+        if (decile > *last_decile) {
+            while (*last_decile < decile) {
+                printf(".");
+                (*last_decile)++;
+            }
+            fflush(stdout);
+        }
+    }
+}
 
 /**
  * Get file size
@@ -55,10 +148,14 @@ long get_file_size(FILE *file) {
 }
 
 /**
- * Copy file with progress reporting
+ * Copy file with progress reporting.
+ * If 'checksum' is not NULL, the CRC32C of every byte is computed while
+ * it is still in the cache-hot copy buffer, so verification later only
+ * has to read the destination.
  * Returns: 0 on success, -1 on error
  */
-int copy_file(const char *source_path, const char *dest_path) {
+int copy_file_checked(const char *source_path, const char *dest_path, uint32_t *checksum) {
+    TRACE_SCOPE("copy_file");
     FILE *source = NULL;
     FILE *dest = NULL;
     unsigned char *buffer = NULL;
@@ -95,9 +192,12 @@ int copy_file(const char *source_path, const char *dest_path) {
     }
     
     /* Copy file in chunks */
+    if (checksum != NULL) {
+        *checksum = 0;
+    }
     size_t total_read = 0;
     size_t bytes_read;
-    int last_percent = -1;
+    int last_decile = 0;
     
     printf("Copying");
     fflush(stdout);
@@ -110,17 +210,13 @@ int copy_file(const char *source_path, const char *dest_path) {
             goto cleanup;
         }
         
+        if (checksum != NULL) {
+            *checksum = crc32c_update(*checksum, buffer, bytes_read);
+        }
         total_read += bytes_read;
         
         /* Show progress */
-        if (file_size > 0) {
-            int percent = (int)((total_read * 100) / file_size);
-            if (percent != last_percent && percent % 10 == 0) {
-                printf(".");
-                fflush(stdout);
-                last_percent = percent;
-            }
-        }
+        show_progress(total_read, file_size, &last_decile);
     }
     
     printf(" Done!\n");
@@ -149,11 +245,705 @@ cleanup:
 }
 
 /**
- * Verify that two files are identical
+ * Copy file with progress reporting
+ * Returns: 0 on success, -1 on error
+ */
+int copy_file(const char *source_path, const char *dest_path) {
+    return copy_file_checked(source_path, dest_path, NULL);
+}
+
+#ifdef HAVE_POSIX_IO
+/**
+ * True when errno means "this method is not available here" rather than
+ * a real I/O failure (old kernel, cross-filesystem, special file, ...)
+ */
+static bool is_unsupported_errno(int err) {
+    return err == ENOSYS || err == EXDEV || err == EINVAL ||
+           err == EOPNOTSUPP || err == ENOTSUP;
+}
+
+/**
+ * Write the whole buffer, retrying on short writes and EINTR
+ */
+static bool write_all(int fd, const unsigned char *data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+/**
+ * Move up to 'length' bytes using one kernel-side method.
+ * Both descriptors advance their own file offsets, so methods can be
+ * switched mid-copy without losing track of the position.
+ * Returns: bytes copied, 0 at EOF, -1 on error (errno is set)
+ */
+static ssize_t kernel_copy_step(CopyMethod method, int in_fd, int out_fd,
+                                const unsigned char *map, size_t offset,
+                                size_t length) {
+    switch (method) {
+#ifdef __linux__
+        case COPY_METHOD_COPY_FILE_RANGE:
+            return copy_file_range(in_fd, NULL, out_fd, NULL, length, 0);
+        case COPY_METHOD_SENDFILE:
+            return sendfile(out_fd, in_fd, NULL, length);
+#endif
+        case COPY_METHOD_MMAP:
+            if (!write_all(out_fd, map + offset, length)) {
+                return -1;
+            }
+            return (ssize_t)length;
+        default:
+            errno = ENOSYS;
+            return -1;
+    }
+}
+
+/**
+ * Copy file without a userspace bounce buffer.
+ * Tries copy_file_range -> sendfile -> mmap+write (or only 'method' if
+ * one is forced) and finally falls back to the stdio copy_file().
+ * Progress reporting and the 0/-1 return contract match copy_file().
+ *
+ * If 'checksum' is not NULL, the CRC32C of the source is computed during
+ * the copy. copy_file_range and sendfile never show the bytes to
+ * userspace, so AUTO then starts at mmap+write (hashed straight from the
+ * mapping), and a forced in-kernel method falls back to stdio.
+ */
+int copy_file_kernel(const char *source_path, const char *dest_path, CopyMethod method,
+                     uint32_t *checksum) {
+    TRACE_SCOPE("copy_file_kernel");
+    int in_fd = -1;
+    int out_fd = -1;
+    unsigned char *map = NULL;
+    size_t map_length = 0;
+    int result = -1;
+    
+    if (checksum != NULL) {
+        *checksum = 0;
+        if (method == COPY_METHOD_COPY_FILE_RANGE || method == COPY_METHOD_SENDFILE) {
+            printf("%s cannot be hashed inline, using stdio\n", copy_method_name(method));
+            method = COPY_METHOD_STDIO;
+        }
+    }
+    if (method == COPY_METHOD_STDIO) {
+        return copy_file_checked(source_path, dest_path, checksum);
+    }
+    
+    in_fd = open(source_path, O_RDONLY);
+    if (in_fd < 0) {
+        perror("Error opening source file");
+        return -1;
+    }
+    
+    struct stat st;
+    if (fstat(in_fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        /* Pipes and devices have no size - let stdio handle them */
+        close(in_fd);
+        return copy_file_checked(source_path, dest_path, checksum);
+    }
+    
+    long file_size = (long)st.st_size;
+    printf("Source file size: %ld bytes\n", file_size);
+    
+    out_fd = open(dest_path, O_WRONLY | O_CREAT | O_TRUNC, st.st_mode & 0777);
+    if (out_fd < 0) {
+        perror("Error opening destination file");
+        goto cleanup;
+    }
+    
+    /* AUTO walks the list; a forced method has no fallback except stdio */
+    CopyMethod current = method;
+    if (method == COPY_METHOD_AUTO) {
+        current = checksum != NULL ? COPY_METHOD_MMAP : COPY_METHOD_COPY_FILE_RANGE;
+    }
+    size_t total_copied = 0;
+    size_t remaining = (size_t)st.st_size;
+    int last_decile = 0;
+    
+    printf("Copying via %s", copy_method_name(current));
+    fflush(stdout);
+    
+    while (remaining > 0) {
+        size_t chunk = remaining < KERNEL_CHUNK_SIZE ? remaining : KERNEL_CHUNK_SIZE;
+        ssize_t copied;
+        
+        if (current == COPY_METHOD_MMAP && map == NULL) {
+            /* Map lazily: only reached when both syscalls were rejected */
+            void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, in_fd, 0);
+            if (p != MAP_FAILED) {
+                map = (unsigned char*)p;
+                map_length = (size_t)st.st_size;
+                madvise(map, map_length, MADV_SEQUENTIAL);
+            }
+        }
+        
+        if (current == COPY_METHOD_MMAP && map == NULL) {
+            copied = -1;
+            errno = ENOTSUP;
+        } else {
+            copied = kernel_copy_step(current, in_fd, out_fd, map, total_copied, chunk);
+        }
+        
+        if (copied < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (!is_unsupported_errno(errno)) {
+                perror("\nError: Copy failed");
+                goto cleanup;
+            }
+            if (method != COPY_METHOD_AUTO || current == COPY_METHOD_MMAP) {
+                /* Out of kernel-side options: rewind and do it in userspace */
+                printf(" unsupported, falling back to stdio\n");
+                close(out_fd);
+                out_fd = -1;
+                close(in_fd);
+                in_fd = -1;
+                result = copy_file_checked(source_path, dest_path, checksum);
+                goto cleanup;
+            }
+            current = (CopyMethod)(current + 1);
+            printf(" -> %s", copy_method_name(current));
+            fflush(stdout);
+            continue;
+        }
+        
+        if (copied == 0) {
+            /* Source shrank while copying: the destination is incomplete */
+            fprintf(stderr, "\nError: Source shrank while copying (%zu of %ld bytes copied)\n",
+                    total_copied, file_size);
+            goto cleanup;
+        }
+        
+        if (checksum != NULL) {
+            /* Only mmap+write gets here: hash the bytes just written */
+            *checksum = crc32c_update(*checksum, map + total_copied, (size_t)copied);
+        }
+        total_copied += (size_t)copied;
+        remaining -= (size_t)copied;
+        show_progress(total_copied, file_size, &last_decile);
+    }
+    
+    printf(" Done!\n");
+    printf("Successfully copied %zu bytes\n", total_copied);
+    result = 0;
+    
+cleanup:
+    if (map != NULL) {
+        munmap(map, map_length);
+    }
+    if (out_fd >= 0 && close(out_fd) != 0 && result == 0) {
+        /* NFS and friends report deferred write errors on close() */
+        perror("Error closing destination file");
+        result = -1;
+    }
+    if (in_fd >= 0) {
+        close(in_fd);
+    }
+    
+    return result;
+}
+#else
+/**
+ * No POSIX descriptors on this platform: the stdio loop is the only path
+ */
+int copy_file_kernel(const char *source_path, const char *dest_path, CopyMethod method,
+                     uint32_t *checksum) {
+    (void)method;
+    return copy_file_checked(source_path, dest_path, checksum);
+}
+#endif
+
+/**
+ * Options for the pipelined copy engine
+ */
+typedef struct {
+    int jobs;          /* Reader threads issuing pread() in parallel */
+    int queue_depth;   /* Ring slots = blocks in flight between readers and writer */
+    bool use_uring;    /* Single-threaded io_uring backend instead of threads */
+} PipelineOptions;
+
+#ifdef HAVE_POSIX_IO
+/**
+ * One aligned buffer of the ring.
+ * Block b always lives in slot b % depth, so the writer can drain
+ * blocks in file order while readers complete them out of order.
+ */
+typedef struct {
+    unsigned char *data;
+    size_t length;
+    long ready_block;   /* Block index currently held, -1 = empty */
+} RingSlot;
+
+/**
+ * State shared by the reader threads and the writer (calling) thread
+ */
+typedef struct {
+    RingSlot *slots;
+    size_t depth;
+    size_t file_size;
+    long total_blocks;
+    long next_block;      /* Next block a reader will claim */
+    long blocks_written;  /* Blocks drained by the writer */
+    bool failed;
+    int in_fd;
+    pthread_mutex_t lock;
+    pthread_cond_t slot_free;
+    pthread_cond_t slot_ready;
+} CopyRing;
+
+/**
+ * Reader thread: claim the next block, pread() it into its slot, publish.
+ * A block may only be claimed once the writer has drained the block that
+ * used the same slot one lap earlier.
+ */
+static void* pipeline_reader(void *arg) {
+    CopyRing *ring = (CopyRing*)arg;
+    
+    pthread_mutex_lock(&ring->lock);
+    for (;;) {
+        while (!ring->failed && ring->next_block < ring->total_blocks &&
+               ring->next_block >= ring->blocks_written + (long)ring->depth) {
+            pthread_cond_wait(&ring->slot_free, &ring->lock);
+        }
+        if (ring->failed || ring->next_block >= ring->total_blocks) {
+            break;
+        }
+        
+        long block = ring->next_block++;
+        pthread_mutex_unlock(&ring->lock);
+        
+        RingSlot *slot = &ring->slots[(size_t)block % ring->depth];
+        off_t offset = (off_t)block * PIPELINE_BLOCK_SIZE;
+        size_t wanted = ring->file_size - (size_t)offset;
+        if (wanted > PIPELINE_BLOCK_SIZE) {
+            wanted = PIPELINE_BLOCK_SIZE;
+        }
+        
+        /* Explicit pair: the scope ends before the lock, not at loop end */
+        TRACE_BEGIN(read_scope, "pipeline read block");
+        size_t got = 0;
+        bool ok = true;
+        while (got < wanted) {
+            ssize_t n = pread(ring->in_fd, slot->data + got, wanted - got, offset + (off_t)got);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                /* Error, or the source shrank under us */
+                ok = false;
+                break;
+            }
+            got += (size_t)n;
+        }
+        TRACE_END(read_scope);
+        
+        pthread_mutex_lock(&ring->lock);
+        if (!ok) {
+            ring->failed = true;
+        } else {
+            slot->length = got;
+            slot->ready_block = block;
+        }
+        pthread_cond_broadcast(&ring->slot_ready);
+    }
+    /* Wake everyone so a failure or the end of file is noticed */
+    pthread_cond_broadcast(&ring->slot_ready);
+    pthread_cond_broadcast(&ring->slot_free);
+    pthread_mutex_unlock(&ring->lock);
+    
+    return NULL;
+}
+
+/**
+ * Threaded pipeline: 'jobs' readers fill the ring, this thread writes
+ * (and hashes into 'checksum' if not NULL: blocks arrive in file order).
+ * Returns: bytes written, or -1 on error
+ */
+static long long pipeline_copy_threads(int in_fd, int out_fd, size_t file_size,
+                                       const PipelineOptions *opts, uint32_t *checksum) {
+    CopyRing ring;
+    pthread_t readers[PIPELINE_MAX_JOBS];
+    int started = 0;
+    long long total_written = -1;
+    int last_decile = 0;
+    
+    memset(&ring, 0, sizeof(ring));
+    ring.depth = (size_t)opts->queue_depth;
+    ring.file_size = file_size;
+    ring.total_blocks = (long)((file_size + PIPELINE_BLOCK_SIZE - 1) / PIPELINE_BLOCK_SIZE);
+    ring.in_fd = in_fd;
+    
+    ring.slots = (RingSlot*)calloc(ring.depth, sizeof(RingSlot));
+    if (ring.slots == NULL) {
+        fprintf(stderr, "Error: Failed to allocate ring\n");
+        return -1;
+    }
+    for (size_t i = 0; i < ring.depth; i++) {
+        void *p = NULL;
+        if (posix_memalign(&p, PIPELINE_ALIGNMENT, PIPELINE_BLOCK_SIZE) != 0) {
+            fprintf(stderr, "Error: Failed to allocate ring buffer\n");
+            goto cleanup_slots;
+        }
+        ring.slots[i].data = (unsigned char*)p;
+        ring.slots[i].ready_block = -1;
+    }
+    
+    pthread_mutex_init(&ring.lock, NULL);
+    pthread_cond_init(&ring.slot_free, NULL);
+    pthread_cond_init(&ring.slot_ready, NULL);
+    
+    for (started = 0; started < opts->jobs; started++) {
+        if (pthread_create(&readers[started], NULL, pipeline_reader, &ring) != 0) {
+            fprintf(stderr, "Error: Failed to start reader thread\n");
+            pthread_mutex_lock(&ring.lock);
+            ring.failed = true;
+            pthread_cond_broadcast(&ring.slot_free);
+            pthread_mutex_unlock(&ring.lock);
+            break;
+        }
+    }
+    
+    /* Writer: drain blocks strictly in file order */
+    long long written = 0;
+    for (long block = 0; block < ring.total_blocks; block++) {
+        RingSlot *slot = &ring.slots[(size_t)block % ring.depth];
+        
+        pthread_mutex_lock(&ring.lock);
+        while (!ring.failed && slot->ready_block != block) {
+            pthread_cond_wait(&ring.slot_ready, &ring.lock);
+        }
+        bool failed = ring.failed;
+        pthread_mutex_unlock(&ring.lock);
+        
+        if (failed) {
+            fprintf(stderr, "\nError: Read failed\n");
+            break;
+        }
+        
+        /* Slot is ours until blocks_written moves past it - write unlocked */
+        if (!write_all(out_fd, slot->data, slot->length)) {
+            perror("\nError: Write failed");
+            pthread_mutex_lock(&ring.lock);
+            ring.failed = true;
+            pthread_cond_broadcast(&ring.slot_free);
+            pthread_mutex_unlock(&ring.lock);
+            break;
+        }
+        if (checksum != NULL) {
+            *checksum = crc32c_update(*checksum, slot->data, slot->length);
+        }
+        written += (long long)slot->length;
+        
+        pthread_mutex_lock(&ring.lock);
+        slot->ready_block = -1;
+        ring.blocks_written++;
+        pthread_cond_broadcast(&ring.slot_free);
+        pthread_mutex_unlock(&ring.lock);
+        
+        show_progress((size_t)written, (long)file_size, &last_decile);
+    }
+    
+    for (int i = 0; i < started; i++) {
+        pthread_join(readers[i], NULL);
+    }
+    if (!ring.failed) {
+        total_written = written;
+    }
+    
+    pthread_cond_destroy(&ring.slot_ready);
+    pthread_cond_destroy(&ring.slot_free);
+    pthread_mutex_destroy(&ring.lock);
+    
+cleanup_slots:
+    for (size_t i = 0; i < ring.depth; i++) {
+        free(ring.slots[i].data);
+    }
+    free(ring.slots);
+    
+    return total_written;
+}
+
+#ifdef HAVE_LIBURING
+/**
+ * io_uring slot: each buffer alternates read -> write -> read ...
+ */
+typedef struct {
+    unsigned char *data;
+    off_t offset;     /* File offset of this block (same for src and dst) */
+    size_t length;    /* Block length */
+    size_t done;      /* Bytes finished in the current phase */
+    bool writing;
+    bool written;     /* Written, waiting for earlier blocks to be hashed */
+} UringSlot;
+
+static void uring_queue(struct io_uring *ring, UringSlot *slots, size_t index,
+                        int in_fd, int out_fd) {
+    struct io_uring_sqe *sqe = io_uring_get_sqe(ring);  /* SQ >= depth, never NULL */
+    UringSlot *slot = &slots[index];
+    
+    if (slot->writing) {
+        io_uring_prep_write(sqe, out_fd, slot->data + slot->done,
+                            (unsigned)(slot->length - slot->done),
+                            (__u64)(slot->offset + (off_t)slot->done));
+    } else {
+        io_uring_prep_read(sqe, in_fd, slot->data + slot->done,
+                           (unsigned)(slot->length - slot->done),
+                           (__u64)(slot->offset + (off_t)slot->done));
+    }
+    io_uring_sqe_set_data(sqe, (void*)(uintptr_t)index);
+}
+
+/**
+ * Give a free slot the next block to read
+ * Returns: false when the whole file has been handed out
+ */
+static bool uring_next_block(UringSlot *slot, size_t *next_offset, size_t file_size) {
+    if (*next_offset >= file_size) {
+        return false;
+    }
+    slot->writing = false;
+    slot->done = 0;
+    slot->offset = (off_t)*next_offset;
+    slot->length = file_size - *next_offset < PIPELINE_BLOCK_SIZE ?
+                   file_size - *next_offset : PIPELINE_BLOCK_SIZE;
+    *next_offset += slot->length;
+    return true;
+}
+
+/**
+ * io_uring pipeline: keeps up to queue_depth reads and writes in flight
+ * from a single thread, with no per-block syscalls.
+ * With a 'checksum', a written block is hashed (and its slot reused) only
+ * once every earlier block has been: completions arrive in any order,
+ * CRC32C must see the file in order.
+ * Returns: bytes written, -1 on error, -2 if io_uring is unavailable
+ */
+static long long pipeline_copy_uring(int in_fd, int out_fd, size_t file_size,
+                                     const PipelineOptions *opts, uint32_t *checksum) {
+    struct io_uring ring;
+    size_t depth = (size_t)opts->queue_depth;
+    long long written = 0;
+    long long result = -1;
+    int last_decile = 0;
+    
+    if (io_uring_queue_init((unsigned)depth, &ring, 0) < 0) {
+        return -2;
+    }
+    
+    UringSlot *slots = (UringSlot*)calloc(depth, sizeof(UringSlot));
+    if (slots == NULL) {
+        io_uring_queue_exit(&ring);
+        return -1;
+    }
+    
+    size_t next_offset = 0;
+    size_t inflight = 0;
+    for (size_t i = 0; i < depth; i++) {
+        void *p = NULL;
+        if (posix_memalign(&p, PIPELINE_ALIGNMENT, PIPELINE_BLOCK_SIZE) != 0) {
+            goto cleanup;
+        }
+        slots[i].data = (unsigned char*)p;
+    }
+    
+    /* Prime the queue with one read per slot */
+    size_t hashed = 0;
+    for (size_t i = 0; i < depth && uring_next_block(&slots[i], &next_offset, file_size); i++) {
+        uring_queue(&ring, slots, i, in_fd, out_fd);
+        inflight++;
+    }
+    io_uring_submit(&ring);
+    
+    while (inflight > 0) {
+        struct io_uring_cqe *cqe;
+        if (io_uring_wait_cqe(&ring, &cqe) < 0) {
+            goto cleanup;
+        }
+        size_t index = (size_t)(uintptr_t)io_uring_cqe_get_data(cqe);
+        int res = cqe->res;
+        io_uring_cqe_seen(&ring, cqe);
+        inflight--;
+        
+        UringSlot *slot = &slots[index];
+        if (res == -EINTR || res == -EAGAIN) {
+            res = 0;   /* Resubmit the same range */
+        } else if (res < 0 || (res == 0 && !slot->writing)) {
+            fprintf(stderr, "\nError: %s failed: %s\n",
+                    slot->writing ? "Write" : "Read", strerror(res < 0 ? -res : EIO));
+            /* Drain what is still in flight before tearing down buffers */
+            while (inflight > 0 && io_uring_wait_cqe(&ring, &cqe) == 0) {
+                io_uring_cqe_seen(&ring, cqe);
+                inflight--;
+            }
+            goto cleanup;
+        }
+        
+        slot->done += (size_t)res;
+        if (slot->done < slot->length || !slot->writing) {
+            if (slot->done == slot->length) {
+                slot->done = 0;
+                slot->writing = true;   /* Read complete: write it out */
+            }
+            /* Short transfers queue the remainder */
+            uring_queue(&ring, slots, index, in_fd, out_fd);
+            inflight++;
+            io_uring_submit(&ring);
+            continue;
+        }
+        
+        written += (long long)slot->length;
+        show_progress((size_t)written, (long)file_size, &last_decile);
+        slot->written = true;
+        
+        /* Reuse written slots: right away, or in file order when hashing */
+        for (;;) {
+            size_t next = index;
+            if (checksum != NULL) {
+                for (next = 0; next < depth; next++) {
+                    if (slots[next].written && (size_t)slots[next].offset == hashed) {
+                        break;
+                    }
+                }
+                if (next == depth) {
+                    break;      /* An earlier block is still in flight */
+                }
+                *checksum = crc32c_update(*checksum, slots[next].data, slots[next].length);
+                hashed += slots[next].length;
+            }
+            slots[next].written = false;
+            if (uring_next_block(&slots[next], &next_offset, file_size)) {
+                uring_queue(&ring, slots, next, in_fd, out_fd);
+                inflight++;
+            }
+            if (checksum == NULL) {
+                break;
+            }
+        }
+        io_uring_submit(&ring);
+    }
+    
+    result = written;
+    
+cleanup:
+    for (size_t i = 0; i < depth; i++) {
+        free(slots[i].data);
+    }
+    free(slots);
+    io_uring_queue_exit(&ring);
+    
+    return result;
+}
+#endif /* HAVE_LIBURING */
+
+/**
+ * Pipelined copy: readers and writer overlap instead of taking turns.
+ * Uses io_uring when requested and compiled in, otherwise reader threads.
+ * If 'checksum' is not NULL, each block's CRC32C is added as it is written.
+ * Returns: 0 on success, -1 on error (same contract as copy_file())
+ */
+int copy_file_pipelined(const char *source_path, const char *dest_path,
+                        const PipelineOptions *opts, uint32_t *checksum) {
+    TRACE_SCOPE("copy_file_pipelined");
+    PipelineOptions o = *opts;
+    int result = -1;
+    
+    /* Clamp to sane limits */
+    if (o.jobs < 1) o.jobs = 1;
+    if (o.jobs > PIPELINE_MAX_JOBS) o.jobs = PIPELINE_MAX_JOBS;
+    if (o.queue_depth < 2) o.queue_depth = 2;
+    if (o.queue_depth > PIPELINE_MAX_DEPTH) o.queue_depth = PIPELINE_MAX_DEPTH;
+    if (checksum != NULL) *checksum = 0;
+    
+    int in_fd = open(source_path, O_RDONLY);
+    if (in_fd < 0) {
+        perror("Error opening source file");
+        return -1;
+    }
+    
+    struct stat st;
+    if (fstat(in_fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(in_fd);
+        return copy_file_checked(source_path, dest_path, checksum);
+    }
+    printf("Source file size: %lld bytes\n", (long long)st.st_size);
+    
+    int out_fd = open(dest_path, O_WRONLY | O_CREAT | O_TRUNC, st.st_mode & 0777);
+    if (out_fd < 0) {
+        perror("Error opening destination file");
+        close(in_fd);
+        return -1;
+    }
+    
+#ifdef __linux__
+    posix_fadvise(in_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    
+    long long copied = -2;
+#ifdef HAVE_LIBURING
+    if (o.use_uring) {
+        printf("Copying via io_uring (queue depth %d)", o.queue_depth);
+        fflush(stdout);
+        copied = pipeline_copy_uring(in_fd, out_fd, (size_t)st.st_size, &o, checksum);
+        if (copied == -2) {
+            printf(" unavailable, using threads\n");
+        }
+    }
+#else
+    if (o.use_uring) {
+        printf("io_uring support not compiled in, using threads\n");
+    }
+#endif
+    if (copied == -2) {
+        printf("Copying via %d reader thread(s), %d buffers", o.jobs, o.queue_depth);
+        fflush(stdout);
+        copied = pipeline_copy_threads(in_fd, out_fd, (size_t)st.st_size, &o, checksum);
+    }
+    
+    if (copied >= 0) {
+        printf(" Done!\n");
+        printf("Successfully copied %lld bytes\n", copied);
+        result = 0;
+    }
+    
+    if (close(out_fd) != 0 && result == 0) {
+        perror("Error closing destination file");
+        result = -1;
+    }
+    close(in_fd);
+    
+    return result;
+}
+#else
+/**
+ * No threads / descriptors on this platform: serial stdio copy
+ */
+int copy_file_pipelined(const char *source_path, const char *dest_path,
+                        const PipelineOptions *opts, uint32_t *checksum) {
+    (void)opts;
+    return copy_file_checked(source_path, dest_path, checksum);
+}
+#endif
+
+/**
+ * Verify that two files are identical.
+ * Compares 1MB blocks with memcmp (vectorized by libc) and only scans
+ * byte-wise inside the first block that differs.
  */
 bool verify_copy(const char *file1_path, const char *file2_path) {
     FILE *file1 = fopen(file1_path, "rb");
     FILE *file2 = fopen(file2_path, "rb");
+    unsigned char *block1 = NULL;
+    unsigned char *block2 = NULL;
     bool identical = true;
     
     if (file1 == NULL || file2 == NULL) {
@@ -173,31 +963,87 @@ bool verify_copy(const char *file1_path, const char *file2_path) {
         goto cleanup;
     }
     
-    /* Compare contents byte by byte */
-    int ch1, ch2;
+    block1 = (unsigned char*)malloc(VERIFY_BLOCK_SIZE);
+    block2 = (unsigned char*)malloc(VERIFY_BLOCK_SIZE);
+    if (block1 == NULL || block2 == NULL) {
+        fprintf(stderr, "Error: Failed to allocate verification buffers\n");
+        identical = false;
+        goto cleanup;
+    }
+    
+    /* Compare contents block by block */
     size_t position = 0;
+    size_t n1;
     
-    while ((ch1 = fgetc(file1)) != EOF) {
-        ch2 = fgetc(file2);
+    while ((n1 = fread(block1, 1, VERIFY_BLOCK_SIZE, file1)) > 0) {
+        size_t n2 = fread(block2, 1, n1, file2);
         
-        if (ch1 != ch2) {
-            printf("Verification failed: Difference at byte %zu\n", position);
+        if (n2 != n1 || memcmp(block1, block2, n1) != 0) {
+            size_t i = 0;
+            while (i < n2 && block1[i] == block2[i]) {
+                i++;
+            }
+            printf("Verification failed: Difference at byte %zu\n", position + i);
             identical = false;
             goto cleanup;
         }
         
-        position++;
+        position += n1;
     }
     
     printf("Verification successful: Files are identical\n");
     
 cleanup:
+    free(block1);
+    free(block2);
     fclose(file1);
     fclose(file2);
     
     return identical;
 }
 
+/**
+ * Verify a copy against the CRC32C computed during the copy.
+ * Reads only the destination, once.
+ */
+bool verify_copy_checksum(const char *dest_path, uint32_t expected) {
+    FILE *file = fopen(dest_path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for verification\n");
+        return false;
+    }
+    
+    unsigned char *block = (unsigned char*)malloc(VERIFY_BLOCK_SIZE);
+    if (block == NULL) {
+        fprintf(stderr, "Error: Failed to allocate verification buffer\n");
+        fclose(file);
+        return false;
+    }
+    
+    uint32_t crc = 0;
+    size_t n;
+    while ((n = fread(block, 1, VERIFY_BLOCK_SIZE, file)) > 0) {
+        crc = crc32c_update(crc, block, n);
+    }
+    bool read_error = ferror(file) != 0;
+    
+    free(block);
+    fclose(file);
+    
+    if (read_error) {
+        fprintf(stderr, "Error: Read failed during verification\n");
+        return false;
+    }
+    if (crc != expected) {
+        printf("Verification failed: CRC32C 0x%08X, expected 0x%08X\n",
+               (unsigned)crc, (unsigned)expected);
+        return false;
+    }
+    
+    printf("Verification successful: CRC32C 0x%08X matches\n", (unsigned)crc);
+    return true;
+}
+
 /**
  * Create a test file
  */
@@ -238,20 +1084,67 @@ int main(int argc, char *argv[]) {
     printf("╚════════════════════════════════════════════════════════════╝\n\n");
     
     /* Handle command-line arguments */
-    if (argc == 3) {
+    PipelineOptions pipeline = { 1, PIPELINE_DEFAULT_DEPTH, false };
+    bool use_pipeline = false;
+    VerifyMode verify = VERIFY_FULL;
+    const char *paths[2] = { NULL, NULL };
+    int path_count = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            pipeline.jobs = atoi(argv[++i]);
+            use_pipeline = true;
+        } else if (strcmp(argv[i], "--queue-depth") == 0 && i + 1 < argc) {
+            pipeline.queue_depth = atoi(argv[++i]);
+            use_pipeline = true;
+        } else if (strcmp(argv[i], "--uring") == 0) {
+            pipeline.use_uring = true;
+            use_pipeline = true;
+        } else if (strcmp(argv[i], "--verify=checksum") == 0) {
+            verify = VERIFY_CHECKSUM;
+        } else if (strcmp(argv[i], "--verify=full") == 0) {
+            verify = VERIFY_FULL;
+        } else if (strcmp(argv[i], "--verify=none") == 0) {
+            verify = VERIFY_NONE;
+        } else if (path_count < 2) {
+            paths[path_count++] = argv[i];
+        } else {
+            path_count = 3;   /* Too many arguments: show usage */
+        }
+    }
+
+    /* CRC tables and CPU probe: once, before any copy or worker thread */
+    crc32_init();
+
+    if (path_count == 2) {
         /* Copy user-specified files */
-        const char *source = argv[1];
-        const char *dest = argv[2];
+        const char *source = paths[0];
+        const char *dest = paths[1];
         
         printf("Copying '%s' to '%s'\n", source, dest);
         
-        if (copy_file(source, dest) == 0) {
+        /* Checksum mode hashes inside whichever engine does the copy */
+        int status;
+        uint32_t checksum = 0;
+        uint32_t *hash = verify == VERIFY_CHECKSUM ? &checksum : NULL;
+        if (use_pipeline) {
+            status = copy_file_pipelined(source, dest, &pipeline, hash);
+        } else {
+            status = copy_file_kernel(source, dest, COPY_METHOD_AUTO, hash);
+        }
+        
+        if (status == 0 && verify != VERIFY_NONE) {
             printf("\nVerifying copy...\n");
-            verify_copy(source, dest);
+            if (verify == VERIFY_CHECKSUM) {
+                verify_copy_checksum(dest, checksum);
+            } else {
+                verify_copy(source, dest);
+            }
         }
     } else {
         /* Demo mode: create test file and copy it */
-        printf("Usage: %s <source> <destination>\n\n", argv[0]);
+        printf("Usage: %s [--jobs N] [--queue-depth N] [--uring]\n"
+               "       [--verify=full|checksum|none] <source> <destination>\n\n", argv[0]);
         printf("Running demo mode...\n\n");
         
         const char *test_file = "test_source.txt";
@@ -262,12 +1155,38 @@ int main(int argc, char *argv[]) {
         
         printf("\n");
         
-        /* Copy file */
+        /* Copy file with the portable stdio loop */
         if (copy_file(test_file, copy_file_path) == 0) {
             printf("\nVerifying copy...\n");
             verify_copy(test_file, copy_file_path);
         }
         
+        /* Hash inline during the copy, then read only the destination */
+        uint32_t checksum = 0;
+        printf("\n[stdio + inline CRC32C]\n");
+        if (copy_file_checked(test_file, copy_file_path, &checksum) == 0) {
+            verify_copy_checksum(copy_file_path, checksum);
+        }
+        
+        /* Copy again with each kernel-side method */
+        for (CopyMethod m = COPY_METHOD_COPY_FILE_RANGE; m <= COPY_METHOD_MMAP; m++) {
+            printf("\n[%s]\n", copy_method_name(m));
+            if (copy_file_kernel(test_file, copy_file_path, m, NULL) == 0) {
+                verify_copy(test_file, copy_file_path);
+            }
+        }
+        
+        /* And with the pipelined engine */
+        PipelineOptions demo_pipeline = { 2, 4, false };
+        printf("\n[pipelined]\n");
+        if (copy_file_pipelined(test_file, copy_file_path, &demo_pipeline, NULL) == 0) {
+            verify_copy(test_file, copy_file_path);
+        }
+        printf("\n[pipelined + inline CRC32C]\n");
+        if (copy_file_pipelined(test_file, copy_file_path, &demo_pipeline, &checksum) == 0) {
+            verify_copy_checksum(copy_file_path, checksum);
+        }
+        
         /* Clean up */
         printf("\nCleaning up test files...\n");
         remove(test_file);
@@ -280,7 +1199,10 @@ int main(int argc, char *argv[]) {
     printf("║ - Buffer size: 8KB (good for most files)                  ║\n");
     printf("║ - Larger buffers: fewer syscalls, more memory             ║\n");
     printf("║ - Binary mode: prevents line ending conversion            ║\n");
+    printf("║ - copy_file_range/sendfile: zero userspace copies         ║\n");
+    printf("║ - --jobs/--queue-depth: overlap reads with writes         ║\n");
     printf("║ - Always verify critical copies                           ║\n");
+    printf("║ - --verify=checksum: CRC32C inline, no second source read ║\n");
     printf("╚════════════════════════════════════════════════════════════╝\n");
     
     return 0;
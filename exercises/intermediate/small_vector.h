@@ -0,0 +1,179 @@
+/**
+ * small_vector.h
+ *
+ * Generic, type-parameterized dynamic array with small-buffer optimization.
+ *
+ * DEFINE_SMALL_VECTOR(Name, T, N) generates a vector type 'Name' holding
+ * elements of type T, plus Name_init/Name_push/... functions. The first N
+ * elements live inside the struct itself, so a vector that never grows
+ * past N never calls malloc().
+ *
+ * Usage:
+ *   DEFINE_SMALL_VECTOR(IntVec, int, 16)
+ *
+ *   IntVec v;
+ *   IntVec_init(&v);
+ *   IntVec_push(&v, 42);           // No malloc until the 17th element
+ *   int *first = IntVec_at(&v, 0);
+ *   IntVec_free(&v);
+ *
+ * Element ownership:
+ * - Elements are relocated bitwise (memcpy) when storage grows. That is
+ *   C's "move": the old bytes are abandoned, never destroyed, so types
+ *   that own heap memory (char*, nested arrays, ...) are safe to store.
+ * - Elements are never duplicated. Name_emplace() returns an
+ *   uninitialized slot to construct in place, avoiding a temporary.
+ * - Name_free_with(v, dtor) calls dtor on each element before freeing.
+ * - Types holding pointers into themselves cannot be relocated bitwise
+ *   and must not be stored by value.
+ * - C++ code should use SmallVector<T, N> from small_vector.hpp instead:
+ *   same inline layout, but growth runs each element's move constructor.
+ *
+ * The vector itself points into its own inline buffer, so never copy a
+ * vector struct with '='. Use Name_move(dst, src) instead: dst must be
+ * initialized, and whatever it held is freed first (as '=' would drop it).
+ *
+ * Memory Implications:
+ * - sizeof(Name) grows by N * sizeof(T): keep N small (8-32)
+ * - Inline storage lives wherever the vector lives (stack, struct, ...)
+ * - Spilling to the heap copies the N inline elements once
+ */
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#define DEFINE_SMALL_VECTOR(Name, T, InlineCapacity)                            \
+                                                                                \
+typedef struct {                                                                \
+    T *data;           /* inline_storage or a heap block */                     \
+    size_t size;                                                                \
+    size_t capacity;                                                            \
+    T inline_storage[InlineCapacity];                                           \
+} Name;                                                                         \
+                                                                                \
+static inline void Name##_init(Name *v) {                                       \
+    v->data = v->inline_storage;                                                \
+    v->size = 0;                                                                \
+    v->capacity = (InlineCapacity);                                             \
+}                                                                               \
+                                                                                \
+static inline bool Name##_is_inline(const Name *v) {                            \
+    return v->data == v->inline_storage;                                        \
+}                                                                               \
+                                                                                \
+/* Grow to at least 'capacity' elements; relocates (moves) elements */         \
+static inline bool Name##_reserve(Name *v, size_t capacity) {                   \
+    if (capacity <= v->capacity) {                                              \
+        return true;                                                            \
+    }                                                                           \
+    size_t new_capacity = v->capacity * 2;                                      \
+    if (new_capacity < capacity) {                                              \
+        new_capacity = capacity;                                                \
+    }                                                                           \
+    T *new_data;                                                                \
+    if (Name##_is_inline(v)) {                                                  \
+        /* First spill: copy the inline elements out once */                    \
+        new_data = (T*)malloc(new_capacity * sizeof(T));                        \
+        if (new_data == NULL) {                                                 \
+            return false;                                                       \
+        }                                                                       \
+        memcpy(new_data, v->inline_storage, v->size * sizeof(T));               \
+    } else {                                                                    \
+        new_data = (T*)realloc(v->data, new_capacity * sizeof(T));              \
+        if (new_data == NULL) {                                                 \
+            return false;                                                       \
+        }                                                                       \
+    }                                                                           \
+    v->data = new_data;                                                         \
+    v->capacity = new_capacity;                                                 \
+    return true;                                                                \
+}                                                                               \
+                                                                                \
+/* Append an uninitialized slot and return it (NULL on failure) */             \
+static inline T* Name##_emplace(Name *v) {                                      \
+    if (v->size == v->capacity && !Name##_reserve(v, v->size + 1)) {            \
+        return NULL;                                                            \
+    }                                                                           \
+    return &v->data[v->size++];                                                 \
+}                                                                               \
+                                                                                \
+static inline bool Name##_push(Name *v, T value) {                              \
+    T *slot = Name##_emplace(v);                                                \
+    if (slot == NULL) {                                                         \
+        return false;                                                           \
+    }                                                                           \
+    *slot = value;                                                              \
+    return true;                                                                \
+}                                                                               \
+                                                                                \
+static inline bool Name##_push_many(Name *v, const T *values, size_t count) {  \
+    if (count == 0) {                                                           \
+        return true;                                                            \
+    }                                                                           \
+    if (!Name##_reserve(v, v->size + count)) {                                  \
+        return false;                                                           \
+    }                                                                           \
+    memcpy(v->data + v->size, values, count * sizeof(T));                       \
+    v->size += count;                                                           \
+    return true;                                                                \
+}                                                                               \
+                                                                                \
+/* Pointer to element i, or NULL when out of range */                          \
+static inline T* Name##_at(Name *v, size_t i) {                                 \
+    return i < v->size ? &v->data[i] : NULL;                                    \
+}                                                                               \
+                                                                                \
+/* Move the last element out into *out (ownership passes to caller) */         \
+static inline bool Name##_pop(Name *v, T *out) {                                \
+    if (v->size == 0) {                                                         \
+        return false;                                                           \
+    }                                                                           \
+    v->size--;                                                                  \
+    if (out != NULL) {                                                          \
+        memcpy(out, &v->data[v->size], sizeof(T));                              \
+    }                                                                           \
+    return true;                                                                \
+}                                                                               \
+                                                                                \
+static inline void Name##_clear(Name *v) {                                      \
+    v->size = 0;                                                                \
+}                                                                               \
+                                                                                \
+static inline void Name##_free(Name *v) {                                       \
+    if (!Name##_is_inline(v)) {                                                 \
+        free(v->data);                                                          \
+    }                                                                           \
+    Name##_init(v);                                                             \
+}                                                                               \
+                                                                                \
+/* Replace dst with src's contents, freeing what dst held (dst must be          \
+   initialized): steals the heap block, or copies the inline part */            \
+static inline void Name##_move(Name *dst, Name *src) {                          \
+    if (dst == src) {                                                           \
+        return;                                                                 \
+    }                                                                           \
+    Name##_free(dst);                                                           \
+    if (Name##_is_inline(src)) {                                                \
+        memcpy(dst->inline_storage, src->inline_storage, src->size * sizeof(T));\
+        dst->size = src->size;                                                  \
+    } else {                                                                    \
+        dst->data = src->data;                                                  \
+        dst->size = src->size;                                                  \
+        dst->capacity = src->capacity;                                          \
+    }                                                                           \
+    Name##_init(src);                                                           \
+}                                                                               \
+                                                                                \
+/* Destroy each element with 'dtor', then release storage */                   \
+static inline void Name##_free_with(Name *v, void (*dtor)(T *element)) {        \
+    for (size_t i = 0; i < v->size; i++) {                                      \
+        dtor(&v->data[i]);                                                      \
+    }                                                                           \
+    Name##_free(v);                                                             \
+}
+
+#endif /* SMALL_VECTOR_H */
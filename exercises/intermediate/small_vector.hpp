@@ -0,0 +1,232 @@
+/**
+ * small_vector.hpp
+ *
+ * The C++17 counterpart of small_vector.h: SmallVector<T, N> keeps its
+ * first N elements inside the object, so a vector that never grows past
+ * N never calls operator new.
+ *
+ * Usage:
+ *   SmallVector<std::string, 8> names;
+ *   names.push_back("alice");          // Constructed in the inline buffer
+ *   names.emplace_back(3, 'x');        // In place, no temporary
+ *   for (const std::string &name : names) { ... }
+ *
+ * Element ownership (where the macro version can only memcpy):
+ * - Trivially copyable T is relocated with one memcpy, like the C version
+ * - Any other T is moved element by element (std::move_if_noexcept), then
+ *   the moved-from originals are destroyed. std::string, std::vector,
+ *   std::unique_ptr, ... are therefore never deep-copied on growth, and
+ *   types that point into themselves are safe too.
+ * - Destructors run on clear(), pop_back() and destruction
+ *
+ * Unlike the C struct, a SmallVector may be copied and moved with '=':
+ * moving a heap-backed vector steals its block, moving an inline one
+ * moves the elements (the inline buffer cannot be stolen).
+ *
+ * Memory Implications:
+ * - sizeof(SmallVector<T, N>) grows by N * sizeof(T): keep N small (8-32)
+ * - Spilling to the heap relocates the N inline elements once
+ * - Out of memory throws std::bad_alloc (operator new)
+ */
+
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T, std::size_t InlineCapacity>
+class SmallVector {
+    static_assert(InlineCapacity > 0, "use std::vector for no inline storage");
+
+public:
+    SmallVector() noexcept = default;
+
+    // Delegating to the default constructor: if an element constructor
+    // throws, ~SmallVector() still runs and releases what was built
+    SmallVector(std::initializer_list<T> values) : SmallVector() {
+        reserve(values.size());
+        for (const T &value : values) {
+            unchecked_emplace_back(value);
+        }
+    }
+
+    SmallVector(const SmallVector &other) : SmallVector() {
+        reserve(other.size_);
+        for (const T &value : other) {
+            unchecked_emplace_back(value);
+        }
+    }
+
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        take(std::move(other));
+    }
+
+    SmallVector& operator=(const SmallVector &other) {
+        if (this != &other) {
+            SmallVector copy(other);
+            clear();
+            release_heap();
+            take(std::move(copy));
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            release_heap();
+            take(std::move(other));
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        release_heap();
+    }
+
+    // ========================================
+    // ACCESS
+    // ========================================
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    T& operator[](std::size_t index) noexcept { return data_[index]; }
+    const T& operator[](std::size_t index) const noexcept { return data_[index]; }
+    T& back() noexcept { return data_[size_ - 1]; }
+
+    T* begin() noexcept { return data_; }
+    T* end() noexcept { return data_ + size_; }
+    const T* begin() const noexcept { return data_; }
+    const T* end() const noexcept { return data_ + size_; }
+
+    // ========================================
+    // MODIFIERS
+    // ========================================
+
+    /**
+     * Grow to at least 'capacity' elements; relocates (moves) elements
+     */
+    void reserve(std::size_t capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        std::size_t new_capacity = capacity_ * 2 > capacity ? capacity_ * 2 : capacity;
+        T *new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T),
+                                                     std::align_val_t(alignof(T))));
+        try {
+            relocate(data_, size_, new_data);
+        } catch (...) {
+            ::operator delete(new_data, std::align_val_t(alignof(T)));
+            throw;                              // Elements left where they were
+        }
+        release_heap();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    /**
+     * Construct a new last element in place from 'args'
+     * Time Complexity: O(1) amortized
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            // 'args' may refer to an element: build it before relocating
+            T value(std::forward<Args>(args)...);
+            reserve(size_ + 1);
+            return unchecked_emplace_back(std::move(value));
+        }
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        data_[--size_].~T();
+    }
+
+    void clear() noexcept {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+private:
+    /**
+     * Move 'count' elements from 'from' into raw storage at 'to' and end
+     * the lifetime of the originals. memcpy when T allows it.
+     */
+    static void relocate(T *from, std::size_t count, T *to) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+            }
+        } else {
+            // A throwing move falls back to copying, so on an exception
+            // the originals are untouched and only the new ones are undone
+            std::size_t built = 0;
+            try {
+                for (; built < count; built++) {
+                    ::new (static_cast<void*>(to + built)) T(std::move_if_noexcept(from[built]));
+                }
+            } catch (...) {
+                std::destroy(to, to + built);
+                throw;
+            }
+            std::destroy(from, from + count);
+        }
+    }
+
+    template <typename... Args>
+    T& unchecked_emplace_back(Args&&... args) {
+        T *slot = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        size_++;
+        return *slot;
+    }
+
+    /**
+     * Adopt other's elements; this vector must be empty and inline
+     */
+    void take(SmallVector &&other) {
+        if (other.is_inline()) {
+            relocate(other.data_, other.size_, data_);
+        } else {
+            data_ = other.data_;                // Steal the heap block
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.capacity_ = InlineCapacity;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    void release_heap() noexcept {
+        if (!is_inline()) {
+            ::operator delete(data_, std::align_val_t(alignof(T)));
+            data_ = inline_data();
+            capacity_ = InlineCapacity;
+        }
+    }
+
+    T* inline_data() noexcept { return reinterpret_cast<T*>(inline_storage_); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_storage_); }
+
+    T *data_ = inline_data();
+    std::size_t size_ = 0;
+    std::size_t capacity_ = InlineCapacity;
+    alignas(T) unsigned char inline_storage_[InlineCapacity * sizeof(T)];
+};
+
+#endif /* SMALL_VECTOR_HPP */
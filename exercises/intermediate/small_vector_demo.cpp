@@ -0,0 +1,105 @@
+/**
+ * small_vector_demo.cpp - SmallVector<T, N> (C++17)
+ *
+ * Demonstrates (small_vector.hpp):
+ * - Small vectors that never touch the heap
+ * - Growth that MOVES non-trivial elements instead of copying them
+ * - Moving a whole vector: heap block stolen, inline elements moved
+ *
+ * The C macro version (small_vector.h, used in ex01_dynamic_array.c) can
+ * only relocate bytes; with a template the element's own move
+ * constructor runs, so std::string and friends need no special casing.
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "small_vector.hpp"
+
+/**
+ * Element that counts its copies and moves
+ */
+struct Tracked {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    std::string name;
+
+    explicit Tracked(std::string n) : name(std::move(n)) {}
+    Tracked(const Tracked &other) : name(other.name) { copies++; }
+    Tracked(Tracked &&other) noexcept : name(std::move(other.name)) { moves++; }
+    Tracked& operator=(const Tracked&) = delete;
+    Tracked& operator=(Tracked&&) = delete;
+
+    static void reset() { copies = moves = 0; }
+};
+
+void demonstrate_inline_storage(void) {
+    printf("========================================\n");
+    printf("1. INLINE STORAGE\n");
+    printf("========================================\n\n");
+
+    SmallVector<int, 16> values;
+    for (int i = 0; i < 16; i++) {
+        values.push_back(i * i);
+    }
+    printf("  16 ints:   inline=%s, capacity %zu, sizeof %zu bytes\n",
+           values.is_inline() ? "yes" : "no", values.capacity(), sizeof(values));
+    values.push_back(256);
+    printf("  17th int:  inline=%s, capacity %zu (one spill, memcpy relocation)\n\n",
+           values.is_inline() ? "yes" : "no", values.capacity());
+}
+
+void demonstrate_move_on_growth(void) {
+    printf("========================================\n");
+    printf("2. GROWTH MOVES NON-TRIVIAL ELEMENTS\n");
+    printf("========================================\n\n");
+
+    Tracked::reset();
+    SmallVector<Tracked, 4> names;
+    for (int i = 0; i < 20; i++) {
+        names.emplace_back("request-" + std::to_string(i));   // Built in place
+    }
+    printf("  20 emplace_back into N=4: %d copies, %d moves (all from growth)\n",
+           Tracked::copies, Tracked::moves);
+    printf("  names[19] = %s, capacity %zu\n\n", names[19].name.c_str(), names.capacity());
+}
+
+void demonstrate_vector_move(void) {
+    printf("========================================\n");
+    printf("3. MOVING A WHOLE VECTOR\n");
+    printf("========================================\n\n");
+
+    SmallVector<Tracked, 4> big;
+    for (int i = 0; i < 8; i++) {
+        big.emplace_back("big-" + std::to_string(i));
+    }
+    Tracked::reset();
+    SmallVector<Tracked, 4> stolen(std::move(big));
+    printf("  Heap-backed (8 of 4):  %d element moves, source size now %zu\n",
+           Tracked::moves, big.size());
+
+    SmallVector<Tracked, 4> small;
+    small.emplace_back("only");
+    Tracked::reset();
+    SmallVector<Tracked, 4> moved(std::move(small));
+    printf("  Inline (1 of 4):       %d element move,  '%s' still inline=%s\n\n",
+           Tracked::moves, moved[0].name.c_str(), moved.is_inline() ? "yes" : "no");
+}
+
+int main() {
+    printf("\n");
+    printf("╔════════════════════════════════════════╗\n");
+    printf("║   SMALL VECTOR (C++17 TEMPLATE)        ║\n");
+    printf("╚════════════════════════════════════════╝\n\n");
+
+    demonstrate_inline_storage();
+    demonstrate_move_on_growth();
+    demonstrate_vector_move();
+
+    printf("Key Takeaways:\n");
+    printf("  - Up to N elements live in the object: no operator new at all\n");
+    printf("  - Growth relocates with memcpy for trivial types, move ctors otherwise\n");
+    printf("  - Copies happen only when you copy the vector itself\n");
+    return 0;
+}
@@ -10,6 +10,7 @@
  */
 
 #include <stdio.h>
+#include "output_writer.h"
 
 // Function prototypes
 void print_array(int arr[], int size);
@@ -186,10 +187,11 @@ int main(void) {
 // Function definitions
 
 void print_array(int arr[], int size) {
-    for (int i = 0; i < size; i++) {
-        printf("%d ", arr[i]);
-    }
-    printf("\n");
+    // Buffered writer (output_writer.h): one write instead of a printf per element
+    OutputWriter *out = output_stdout();
+    write_int_array(out, arr, size > 0 ? (size_t)size : 0, " ");
+    output_write_str(out, size > 0 ? " \n" : "\n");
+    output_writer_flush(out);
 }
 
 int sum_array(int arr[], int size) {
@@ -11,6 +11,7 @@
  */
 
 #include <stdio.h>
+#include "output_writer.h"
 
 // Function prototypes (declarations)
 void greet(void);
@@ -176,7 +177,11 @@ int fibonacci(int n) {
 
 // Function that accepts an array
 void print_array(int arr[], int size) {
-    for (int i = 0; i < size; i++) {
-        printf("%d ", arr[i]);
+    // Buffered writer (output_writer.h): one write instead of a printf per element
+    OutputWriter *out = output_stdout();
+    write_int_array(out, arr, size > 0 ? (size_t)size : 0, " ");
+    if (size > 0) {
+        output_write_char(out, ' ');
     }
+    output_writer_flush(out);
 }
@@ -6,10 +6,15 @@
  * - String input/output
  * - String library functions
  * - String manipulation
+ * - Character-class statistics in one vectorized pass
+ *   (count_classes() from fundamentals/intermediate/char_classes.c)
  */
 
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include "char_classes.h"
 
 int main(void) {
     printf("=== Strings in C ===\n\n");
@@ -134,5 +139,24 @@ int main(void) {
     printf("  Formatted: %s\n", buffer);
     printf("\n");
     
+    // PART 11: Character classes
+    printf("11. CHARACTER CLASSES\n");
+    char paragraph[] = "C was created in 1972 at Bell Labs.\n\tIt is still everywhere!";
+    CharClassTable classes;
+    char_class_table_init(&classes);
+    int letters = char_class_add_ctype(&classes, isalpha);
+    int upper = char_class_add_ctype(&classes, isupper);
+    int digits = char_class_add_ctype(&classes, isdigit);
+    int spaces = char_class_add_ctype(&classes, isspace);
+    
+    // One pass over the bytes instead of one loop (and strlen check) per class
+    uint64_t counts[CHAR_CLASS_MAX];
+    size_t length = strlen(paragraph);
+    count_classes(paragraph, length, &classes, counts);
+    printf("  %zu bytes: %llu letters (%llu uppercase), %llu digits, %llu whitespace\n",
+           length, (unsigned long long)counts[letters], (unsigned long long)counts[upper],
+           (unsigned long long)counts[digits], (unsigned long long)counts[spaces]);
+    printf("\n");
+    
     return 0;
 }
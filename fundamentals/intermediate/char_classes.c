@@ -0,0 +1,424 @@
+/**
+ * char_classes.c - Vectorized Character-Class Counting
+ *
+ * See char_classes.h for the nibble-lookup scheme. The scalar path defines
+ * the result (byte_classes[] is the whole truth); the SIMD paths only run
+ * when the rectangle tables describe the classes exactly.
+ */
+
+#include "char_classes.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_PTHREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define NIBBLE_RECTANGLES 8             // Bits in one lookup-table entry
+#define COUNTER_FLUSH 255               // Vectors before byte counters overflow
+#define HISTOGRAM_MIN 1024              // Shorter inputs: classify byte by byte
+
+// ========================================
+// TABLE CONSTRUCTION
+// ========================================
+
+void char_class_table_init(CharClassTable *table) {
+    memset(table, 0, sizeof(*table));
+}
+
+/**
+ * Add one class from a 256-entry membership set. Rows of the 16 x 16 byte
+ * grid with the same set of low nibbles share one rectangle bit.
+ */
+static int add_member_set(CharClassTable *table, const bool member[256]) {
+    if (table->class_count >= CHAR_CLASS_MAX) {
+        return -1;
+    }
+    int index = table->class_count++;
+    uint8_t class_bit = (uint8_t)(1u << index);
+
+    uint16_t columns[16] = {0};
+    for (int byte = 0; byte < 256; byte++) {
+        if (member[byte]) {
+            table->byte_classes[byte] |= class_bit;
+            columns[byte >> 4] |= (uint16_t)(1u << (byte & 0x0F));
+        }
+    }
+
+    bool assigned[16] = {false};
+    for (int row = 0; row < 16; row++) {
+        if (columns[row] == 0 || assigned[row]) {
+            continue;
+        }
+        int rectangle = table->rectangles++;
+        if (rectangle >= NIBBLE_RECTANGLES) {
+            continue;                   // Out of bits: table stays scalar-only
+        }
+        uint8_t bit = (uint8_t)(1u << rectangle);
+        for (int other = row; other < 16; other++) {
+            if (columns[other] == columns[row]) {
+                table->hi_nibble[other] |= bit;
+                assigned[other] = true;
+            }
+        }
+        for (int col = 0; col < 16; col++) {
+            if (columns[row] & (1u << col)) {
+                table->lo_nibble[col] |= bit;
+            }
+        }
+        table->class_bits[index] |= bit;
+    }
+    return index;
+}
+
+int char_class_add(CharClassTable *table, const char *members) {
+    bool member[256] = {false};
+    for (const unsigned char *p = (const unsigned char*)members; *p != '\0'; p++) {
+        member[*p] = true;
+    }
+    return add_member_set(table, member);
+}
+
+int char_class_add_ctype(CharClassTable *table, int (*is_member)(int)) {
+    bool member[256];
+    for (int byte = 0; byte < 256; byte++) {
+        member[byte] = is_member(byte) != 0;
+    }
+    return add_member_set(table, member);
+}
+
+// ========================================
+// SCALAR
+// ========================================
+
+/**
+ * Short inputs: look up each byte and add its class bits
+ */
+static void count_classes_bytes(const uint8_t *p, size_t len, const CharClassTable *table,
+                                uint64_t *counts) {
+    for (size_t i = 0; i < len; i++) {
+        uint8_t classes = table->byte_classes[p[i]];
+        for (int c = 0; c < table->class_count; c++) {
+            counts[c] += (classes >> c) & 1u;
+        }
+    }
+}
+
+/**
+ * Long inputs: byte histogram first (4 interleaved tables so repeated
+ * bytes do not serialize on one counter), classes summed at the end
+ */
+static void count_classes_histogram(const uint8_t *p, size_t len, const CharClassTable *table,
+                                    uint64_t *counts) {
+    uint64_t histogram[4][256];
+    memset(histogram, 0, sizeof(histogram));
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        histogram[0][p[i]]++;
+        histogram[1][p[i + 1]]++;
+        histogram[2][p[i + 2]]++;
+        histogram[3][p[i + 3]]++;
+    }
+    for (; i < len; i++) {
+        histogram[0][p[i]]++;
+    }
+
+    for (int byte = 0; byte < 256; byte++) {
+        uint64_t seen = histogram[0][byte] + histogram[1][byte] + histogram[2][byte] + histogram[3][byte];
+        uint8_t classes = table->byte_classes[byte];
+        for (int c = 0; c < table->class_count; c++) {
+            if (classes & (1u << c)) {
+                counts[c] += seen;
+            }
+        }
+    }
+}
+
+static void count_classes_scalar(const uint8_t *p, size_t len, const CharClassTable *table,
+                                 uint64_t *counts) {
+    if (len >= HISTOGRAM_MIN) {
+        count_classes_histogram(p, len, table, counts);
+    } else {
+        count_classes_bytes(p, len, table, counts);
+    }
+}
+
+// ========================================
+// SIMD
+// ========================================
+
+#ifdef HAVE_X86_SIMD
+static bool cpu_has_avx2(void) {
+    static int has_avx2 = -1;
+    if (has_avx2 < 0) {
+        has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return has_avx2 != 0;
+}
+
+static bool cpu_has_ssse3(void) {
+    static int has_ssse3 = -1;
+    if (has_ssse3 < 0) {
+        has_ssse3 = __builtin_cpu_supports("ssse3") ? 1 : 0;
+    }
+    return has_ssse3 != 0;
+}
+
+/**
+ * AVX2: 32 bytes per step. Per class, a byte counter per lane counts the
+ * bytes OUTSIDE the class (cmpeq gives -1, subtracting adds 1); psadbw
+ * widens them every COUNTER_FLUSH vectors.
+ * Returns: bytes consumed (a multiple of 32)
+ */
+__attribute__((target("avx2")))
+static size_t count_classes_avx2(const uint8_t *p, size_t len, const CharClassTable *table,
+                                 uint64_t *counts) {
+    const __m256i lo_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)table->lo_nibble));
+    const __m256i hi_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)table->hi_nibble));
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+    const int classes = table->class_count;
+    __m256i bits[CHAR_CLASS_MAX];
+    for (int c = 0; c < classes; c++) {
+        bits[c] = _mm256_set1_epi8((char)table->class_bits[c]);
+    }
+
+    size_t vectors = len / 32;
+    for (size_t done = 0; done < vectors; ) {
+        size_t batch = vectors - done < COUNTER_FLUSH ? vectors - done : COUNTER_FLUSH;
+        __m256i outside[CHAR_CLASS_MAX];
+        for (int c = 0; c < classes; c++) {
+            outside[c] = zero;
+        }
+        for (size_t v = done; v < done + batch; v++) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(p + v * 32));
+            __m256i lo = _mm256_and_si256(x, low_mask);
+            __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask);
+            __m256i found = _mm256_and_si256(_mm256_shuffle_epi8(lo_table, lo),
+                                             _mm256_shuffle_epi8(hi_table, hi));
+            for (int c = 0; c < classes; c++) {
+                __m256i miss = _mm256_cmpeq_epi8(_mm256_and_si256(found, bits[c]), zero);
+                outside[c] = _mm256_sub_epi8(outside[c], miss);
+            }
+        }
+        for (int c = 0; c < classes; c++) {
+            __m256i sums = _mm256_sad_epu8(outside[c], zero);
+            uint64_t miss = (uint64_t)_mm256_extract_epi64(sums, 0) + (uint64_t)_mm256_extract_epi64(sums, 1) +
+                            (uint64_t)_mm256_extract_epi64(sums, 2) + (uint64_t)_mm256_extract_epi64(sums, 3);
+            counts[c] += batch * 32 - miss;
+        }
+        done += batch;
+    }
+    return vectors * 32;
+}
+
+/**
+ * SSSE3: the same kernel, 16 bytes per step
+ */
+__attribute__((target("ssse3")))
+static size_t count_classes_ssse3(const uint8_t *p, size_t len, const CharClassTable *table,
+                                  uint64_t *counts) {
+    const __m128i lo_table = _mm_loadu_si128((const __m128i*)table->lo_nibble);
+    const __m128i hi_table = _mm_loadu_si128((const __m128i*)table->hi_nibble);
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+    const int classes = table->class_count;
+    __m128i bits[CHAR_CLASS_MAX];
+    for (int c = 0; c < classes; c++) {
+        bits[c] = _mm_set1_epi8((char)table->class_bits[c]);
+    }
+
+    size_t vectors = len / 16;
+    for (size_t done = 0; done < vectors; ) {
+        size_t batch = vectors - done < COUNTER_FLUSH ? vectors - done : COUNTER_FLUSH;
+        __m128i outside[CHAR_CLASS_MAX];
+        for (int c = 0; c < classes; c++) {
+            outside[c] = zero;
+        }
+        for (size_t v = done; v < done + batch; v++) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(p + v * 16));
+            __m128i lo = _mm_and_si128(x, low_mask);
+            __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), low_mask);
+            __m128i found = _mm_and_si128(_mm_shuffle_epi8(lo_table, lo),
+                                          _mm_shuffle_epi8(hi_table, hi));
+            for (int c = 0; c < classes; c++) {
+                __m128i miss = _mm_cmpeq_epi8(_mm_and_si128(found, bits[c]), zero);
+                outside[c] = _mm_sub_epi8(outside[c], miss);
+            }
+        }
+        for (int c = 0; c < classes; c++) {
+            __m128i sums = _mm_sad_epu8(outside[c], zero);
+            uint64_t miss = (uint64_t)_mm_cvtsi128_si64(sums) +
+                            (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums));
+            counts[c] += batch * 16 - miss;
+        }
+        done += batch;
+    }
+    return vectors * 16;
+}
+#endif
+
+#ifdef HAVE_NEON
+/**
+ * NEON: vqtbl1q_u8 is the 16-entry lookup; vtstq_u8 sets a lane to -1
+ * when the byte is IN the class, so the counters count members directly
+ */
+static size_t count_classes_neon(const uint8_t *p, size_t len, const CharClassTable *table,
+                                 uint64_t *counts) {
+    const uint8x16_t lo_table = vld1q_u8(table->lo_nibble);
+    const uint8x16_t hi_table = vld1q_u8(table->hi_nibble);
+    const uint8x16_t low_mask = vdupq_n_u8(0x0F);
+    const int classes = table->class_count;
+    uint8x16_t bits[CHAR_CLASS_MAX];
+    for (int c = 0; c < classes; c++) {
+        bits[c] = vdupq_n_u8(table->class_bits[c]);
+    }
+
+    size_t vectors = len / 16;
+    for (size_t done = 0; done < vectors; ) {
+        size_t batch = vectors - done < COUNTER_FLUSH ? vectors - done : COUNTER_FLUSH;
+        uint8x16_t inside[CHAR_CLASS_MAX];
+        for (int c = 0; c < classes; c++) {
+            inside[c] = vdupq_n_u8(0);
+        }
+        for (size_t v = done; v < done + batch; v++) {
+            uint8x16_t x = vld1q_u8(p + v * 16);
+            uint8x16_t found = vandq_u8(vqtbl1q_u8(lo_table, vandq_u8(x, low_mask)),
+                                        vqtbl1q_u8(hi_table, vshrq_n_u8(x, 4)));
+            for (int c = 0; c < classes; c++) {
+                inside[c] = vsubq_u8(inside[c], vtstq_u8(found, bits[c]));
+            }
+        }
+        for (int c = 0; c < classes; c++) {
+            counts[c] += vaddlvq_u8(inside[c]);
+        }
+        done += batch;
+    }
+    return vectors * 16;
+}
+#endif
+
+/**
+ * Single-threaded counting
+ * Time Complexity: O(len), 16-32 bytes per step
+ * Space Complexity: O(1)
+ */
+void count_classes(const void *buf, size_t len, const CharClassTable *table, uint64_t *counts) {
+    const uint8_t *p = buf;
+    for (int c = 0; c < table->class_count; c++) {
+        counts[c] = 0;
+    }
+    if (table->class_count == 0) {
+        return;
+    }
+
+    size_t done = 0;
+    if (table->rectangles <= NIBBLE_RECTANGLES) {
+#if defined(HAVE_X86_SIMD)
+        if (cpu_has_avx2()) {
+            done = count_classes_avx2(p, len, table, counts);
+        } else if (cpu_has_ssse3()) {
+            done = count_classes_ssse3(p, len, table, counts);
+        }
+#elif defined(HAVE_NEON)
+        done = count_classes_neon(p, len, table, counts);
+#endif
+    }
+    count_classes_scalar(p + done, len - done, table, counts);
+}
+
+// ========================================
+// PARALLEL VARIANT
+// ========================================
+
+#ifdef HAVE_PTHREADS
+typedef struct {
+    const uint8_t *buf;
+    size_t begin;
+    size_t end;
+    const CharClassTable *table;
+    uint64_t counts[CHAR_CLASS_MAX];
+} CountTask;
+
+static int resolve_threads(int threads, size_t len) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > CHAR_CLASS_MAX_THREADS) {
+        threads = CHAR_CLASS_MAX_THREADS;
+    }
+    // Keep each thread's share at least a quarter of the cutoff
+    size_t max_useful = len / (CHAR_CLASS_PARALLEL_CUTOFF / 4);
+    if (max_useful < 1) {
+        max_useful = 1;
+    }
+    if ((size_t)threads > max_useful) {
+        threads = (int)max_useful;
+    }
+    return threads;
+}
+
+static void *count_worker(void *arg) {
+    CountTask *task = (CountTask*)arg;
+    count_classes(task->buf + task->begin, task->end - task->begin, task->table, task->counts);
+    return NULL;
+}
+#endif
+
+/**
+ * Parallel counting: each thread counts a contiguous slice, the caller
+ * runs the first slice and adds up the per-slice counts
+ */
+void count_classes_parallel(const void *buf, size_t len, const CharClassTable *table,
+                            uint64_t *counts, int threads) {
+#ifdef HAVE_PTHREADS
+    if (len >= CHAR_CLASS_PARALLEL_CUTOFF) {
+        threads = resolve_threads(threads, len);
+        if (threads > 1) {
+            CountTask tasks[CHAR_CLASS_MAX_THREADS];
+            for (int t = 0; t < threads; t++) {
+                tasks[t].buf = buf;
+                tasks[t].begin = len * (size_t)t / (size_t)threads;
+                tasks[t].end = len * (size_t)(t + 1) / (size_t)threads;
+                tasks[t].table = table;
+            }
+
+            pthread_t handles[CHAR_CLASS_MAX_THREADS];
+            bool started[CHAR_CLASS_MAX_THREADS] = {false};
+            for (int t = 1; t < threads; t++) {
+                started[t] = pthread_create(&handles[t], NULL, count_worker, &tasks[t]) == 0;
+            }
+            count_worker(&tasks[0]);
+            for (int t = 1; t < threads; t++) {
+                if (started[t]) {
+                    pthread_join(handles[t], NULL);
+                } else {
+                    count_worker(&tasks[t]);    // Could not start: run here
+                }
+            }
+
+            for (int c = 0; c < table->class_count; c++) {
+                counts[c] = 0;
+                for (int t = 0; t < threads; t++) {
+                    counts[c] += tasks[t].counts[c];
+                }
+            }
+            return;
+        }
+    }
+#else
+    (void)threads;
+#endif
+    count_classes(buf, len, table, counts);
+}
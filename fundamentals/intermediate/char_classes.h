@@ -0,0 +1,86 @@
+/**
+ * char_classes.h - Vectorized Character-Class Counting
+ *
+ * count_vowels_consonants() in ex08_vowel_counter.c makes three calls per
+ * character (isalpha, tolower, is_vowel) and tests for '\0' every step.
+ * count_classes() instead counts up to CHAR_CLASS_MAX classes of bytes in
+ * one length-bounded pass, 16 or 32 bytes per step.
+ *
+ * How a byte is classified without branches (nibble lookup):
+ *   bits = lo_nibble[b & 0x0F] & hi_nibble[b >> 4]
+ * Both tables have 16 entries, so one pshufb (x86) / tbl (ARM) looks up
+ * a whole vector of bytes at once. Each table bit stands for a rectangle
+ * "rows (high nibbles) x columns (low nibbles)" of the 16 x 16 byte
+ * grid; a class is the union of its rectangles:
+ *
+ *   'a'-'z' = 0x61-0x7A  ->  row 6 x cols 1-F  +  row 7 x cols 0-A
+ *
+ * char_class_add*() works out the rectangles; a table needing more than
+ * 8 of them in total still works, through the scalar 256-entry path.
+ *
+ * CPU Overhead (per 32 bytes, AVX2):
+ * - 2 shuffles + 4 ALU ops to classify, 3 ops per class to count
+ * - Byte-wide counters, widened every 255 vectors (no per-byte branches)
+ * - ~1 cycle per byte scalar vs ~0.1 cycle per byte vectorized for 2 classes
+ *
+ * SIMD paths (picked at runtime):
+ * - x86-64:  AVX2 when the CPU has it, SSSE3 otherwise, else scalar
+ * - AArch64: NEON (vqtbl1q_u8)
+ */
+
+#ifndef CHAR_CLASSES_H
+#define CHAR_CLASSES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CHAR_CLASS_MAX 8
+#define CHAR_CLASS_PARALLEL_CUTOFF (1u << 20)  // Below 1MB one thread is faster
+#define CHAR_CLASS_MAX_THREADS 64
+
+typedef struct {
+    uint8_t byte_classes[256];          // Bit c set: byte is in class c (scalar path)
+    uint8_t lo_nibble[16];              // Rectangle bits by low nibble
+    uint8_t hi_nibble[16];              // Rectangle bits by high nibble
+    uint8_t class_bits[CHAR_CLASS_MAX]; // Rectangle bits making up class c
+    int class_count;
+    int rectangles;                     // Rectangle bits used (vectorizable while <= 8)
+} CharClassTable;
+
+/**
+ * Empty table (no classes)
+ */
+void char_class_table_init(CharClassTable *table);
+
+/**
+ * Add a class containing exactly the bytes of 'members' (NUL-terminated).
+ * Classes may overlap.
+ * Returns: the class index, or -1 if CHAR_CLASS_MAX classes exist
+ */
+int char_class_add(CharClassTable *table, const char *members);
+
+/**
+ * Add a class of every byte 0-255 for which is_member(byte) != 0,
+ * e.g. char_class_add_ctype(&table, isdigit) (C locale)
+ * Returns: the class index, or -1 if CHAR_CLASS_MAX classes exist
+ */
+int char_class_add_ctype(CharClassTable *table, int (*is_member)(int));
+
+/**
+ * counts[c] = number of bytes of buf[0, len) in class c
+ * (for c < table->class_count; other entries untouched)
+ *
+ * Time Complexity: O(len * classes / 32)
+ */
+void count_classes(const void *buf, size_t len, const CharClassTable *table, uint64_t *counts);
+
+/**
+ * Same result, split across threads. threads <= 0 uses every online CPU.
+ * Falls back to count_classes() below CHAR_CLASS_PARALLEL_CUTOFF bytes
+ * or when threads are unavailable.
+ */
+void count_classes_parallel(const void *buf, size_t len, const CharClassTable *table,
+                            uint64_t *counts, int threads);
+
+#endif // CHAR_CLASSES_H
@@ -0,0 +1,115 @@
+/**
+ * constexpr_tables.cpp - Compile-Time Lookup Tables (C++17)
+ *
+ * Demonstrates:
+ * - Building lookup tables with constexpr functions (math_tables.hpp)
+ * - static_assert on computed values: wrong math fails the BUILD
+ * - Sizing a table from std::numeric_limits (every value that fits)
+ * - Calling the C implementation in math_utils.c from C++ (extern "C")
+ *
+ * The C tables in math_tables.inc are checked against the constexpr
+ * tables simply by including math_tables.hpp here.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+
+#include "math_tables.hpp"
+
+extern "C" {
+#include "math_utils.h"
+}
+
+// Everything below is evaluated by the compiler: no run-time cost
+static_assert(math_tables::factorial_table<int>()[12] == 479001600);
+static_assert(math_tables::fibonacci_table<int>()[46] == 1836311903);
+static_assert(!math_tables::factorial_checked<int>(13).has_value());
+static_assert(math_tables::is_prime_below(65521) && !math_tables::is_prime_below(65535));
+
+/**
+ * Table sizes follow the value type automatically
+ */
+void demonstrate_table_sizes(void) {
+    printf("========================================\n");
+    printf("1. TABLE SIZES FROM numeric_limits\n");
+    printf("========================================\n\n");
+
+    printf("  Type       factorials  fibonacci numbers\n");
+    printf("  int16_t    %10zu  %17zu\n",
+           math_tables::factorial_count<std::int16_t>(), math_tables::fibonacci_count<std::int16_t>());
+    printf("  int        %10zu  %17zu\n",
+           math_tables::factorial_count<int>(), math_tables::fibonacci_count<int>());
+    printf("  uint64_t   %10zu  %17zu\n\n",
+           math_tables::factorial_count<std::uint64_t>(), math_tables::fibonacci_count<std::uint64_t>());
+}
+
+/**
+ * Checked lookups: overflow is a value (std::nullopt), not garbage
+ */
+void demonstrate_checked_lookups(void) {
+    printf("========================================\n");
+    printf("2. CHECKED LOOKUPS\n");
+    printf("========================================\n\n");
+
+    int tests[] = {12, 13, 20, 21};
+    for (int n : tests) {
+        auto as_int = math_tables::factorial_checked<int>(n);
+        auto as_u64 = math_tables::factorial_checked<std::uint64_t>(n);
+        printf("  %2d!  int: %-12s  uint64_t: ", n, as_int ? std::to_string(*as_int).c_str() : "overflow");
+        if (as_u64) {
+            printf("%" PRIu64 "\n", *as_u64);
+        } else {
+            printf("overflow\n");
+        }
+    }
+
+    printf("\n  F(93) = %" PRIu64 " (largest in uint64_t)\n",
+           *math_tables::fibonacci_checked<std::uint64_t>(93));
+    printf("  F(94) -> %s\n\n",
+           math_tables::fibonacci_checked<std::uint64_t>(94) ? "fits" : "overflow");
+}
+
+/**
+ * The C library and the constexpr tables agree
+ */
+void demonstrate_c_interop(void) {
+    printf("========================================\n");
+    printf("3. SAME ANSWERS FROM C (math_utils.c)\n");
+    printf("========================================\n\n");
+
+    bool agree = true;
+    for (int n = 0; n <= FIBONACCI_MAX_U64; n++) {
+        std::uint64_t value = 0;
+        agree = agree && fibonacci_checked(n, &value) &&
+                value == math_tables::fibonacci_values<std::uint64_t>[static_cast<std::size_t>(n)];
+        agree = agree && fibonacci_fast_doubling(static_cast<std::uint64_t>(n)) == value;
+    }
+    for (int n = 0; n < MATH_PRIME_TABLE_LIMIT; n++) {
+        agree = agree && is_prime(n) == math_tables::is_prime_below(static_cast<std::size_t>(n));
+    }
+    printf("  fibonacci_checked / fast doubling / is_prime vs constexpr: %s\n",
+           agree ? "identical ✓" : "MISMATCH ✗");
+    printf("  next_prime(65521) = %d (first prime past the table)\n\n", next_prime(65521));
+}
+
+int main() {
+    printf("\n");
+    printf("╔════════════════════════════════════════╗\n");
+    printf("║   CONSTEXPR LOOKUP TABLES (C++17)      ║\n");
+    printf("╚════════════════════════════════════════╝\n\n");
+
+    demonstrate_table_sizes();
+    demonstrate_checked_lookups();
+    demonstrate_c_interop();
+
+    printf("========================================\n");
+    printf("KEY TAKEAWAYS\n");
+    printf("========================================\n\n");
+    printf("1. constexpr moves table construction into the compiler\n");
+    printf("2. static_assert turns a wrong table entry into a build error\n");
+    printf("3. numeric_limits sizes each table to exactly what fits\n");
+    printf("4. std::optional makes overflow explicit instead of wrapping\n\n");
+
+    return 0;
+}
@@ -27,6 +27,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include "matrix.h"
 
 /* Windows UTF-8 console setup */
 #ifdef _WIN32
@@ -187,50 +189,116 @@ void example_dynamic_string(void) {
 void example_2d_array(void) {
     printf("\n=== Example 5: 2D Array Allocation ===\n");
     
-    int rows = 3;
-    int cols = 4;
-    
-    /* Method 1: Allocate array of pointers (non-contiguous) */
-    int **matrix = (int**)malloc(rows * sizeof(int*));
-    if (matrix == NULL) {
+    size_t rows = 3;
+    size_t cols = 4;
+    
+    /*
+     * int **matrix with one malloc per row would cost rows + 1 allocations
+     * scattered over the heap, and every matrix[i][j] loads a row pointer
+     * first. Matrix uses ONE aligned block: element (i, j) lives at
+     * data[i * stride + j].
+     */
+    Matrix matrix;
+    if (!matrix_create(&matrix, rows, cols)) {
         fprintf(stderr, "Error: Matrix allocation failed\n");
         return;
     }
     
-    /* Allocate each row */
-    for (int i = 0; i < rows; i++) {
-        matrix[i] = (int*)malloc(cols * sizeof(int));
-        if (matrix[i] == NULL) {
-            fprintf(stderr, "Error: Row %d allocation failed\n", i);
-            /* Cleanup already allocated rows */
-            for (int j = 0; j < i; j++) {
-                free(matrix[j]);
-            }
-            free(matrix);
-            return;
-        }
-    }
-    
     /* Initialize matrix */
-    printf("Allocated %dx%d matrix:\n", rows, cols);
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            matrix[i][j] = i * cols + j;
-            printf("%3d ", matrix[i][j]);
+    printf("Allocated %zux%zu matrix (1 allocation, stride %zu):\n", rows, cols, matrix.stride);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            *matrix_at(&matrix, i, j) = (double)(i * cols + j);
+            printf("%3.0f ", *matrix_at(&matrix, i, j));
         }
         printf("\n");
     }
     
-    /* Free all allocated memory (reverse order) */
-    for (int i = 0; i < rows; i++) {
-        free(matrix[i]);
+    /* A view shares the parent's memory: no allocation, no copy */
+    Matrix corner;
+    matrix_view(&matrix, 1, 1, 2, 3, &corner);
+    printf("View of rows 1-2, cols 1-3: ");
+    for (size_t i = 0; i < corner.rows; i++) {
+        for (size_t j = 0; j < corner.cols; j++) {
+            printf("%.0f ", *matrix_at(&corner, i, j));
+        }
     }
-    free(matrix);
-    matrix = NULL;
+    printf("\n");
+    
+    /* One free for the whole matrix (views need none) */
+    matrix_free(&matrix);
     
     printf("Matrix memory freed.\n");
 }
 
+static double wall_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Example 5b: Large matrices - tiled transpose and blocked multiply
+ * (timings are only meaningful with -O2: at -O0 nothing is vectorized)
+ */
+void example_matrix_multiply(void) {
+    printf("\n=== Example 5b: Cache-Blocked Matrix Multiply ===\n");
+    
+    size_t n = 512;
+    Matrix a, b, c_naive, c_blocked, t;
+    bool ok = matrix_create(&a, n, n);
+    ok = matrix_create(&b, n, n) && ok;
+    ok = matrix_create(&c_naive, n, n) && ok;
+    ok = matrix_create(&c_blocked, n, n) && ok;
+    ok = matrix_create(&t, n, n) && ok;
+    if (!ok) {
+        fprintf(stderr, "Error: Matrix allocation failed\n");
+        goto cleanup;
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            *matrix_at(&a, i, j) = (double)((i * 7 + j * 3) % 17) - 8.0;
+            *matrix_at(&b, i, j) = (double)((i * 5 + j * 11) % 13) - 6.0;
+        }
+    }
+    
+    double start = wall_seconds();
+    matrix_multiply_naive(&a, &b, &c_naive);
+    double naive_s = wall_seconds() - start;
+    
+    start = wall_seconds();
+    matrix_multiply(&a, &b, &c_blocked, 1);
+    double blocked_s = wall_seconds() - start;
+    bool same = true;
+    for (size_t i = 0; i < n && same; i++) {
+        same = memcmp(matrix_row(&c_naive, i), matrix_row(&c_blocked, i), n * sizeof(double)) == 0;
+    }
+    
+    start = wall_seconds();
+    matrix_multiply(&a, &b, &c_blocked, 0);
+    double threaded_s = wall_seconds() - start;
+    
+    double gflop = 2.0 * n * n * n / 1e9;
+    printf("%zux%zu multiply (%.2f GFLOP):\n", n, n, gflop);
+    printf("  Naive i-j-k:          %7.1f ms\n", naive_s * 1000);
+    printf("  Blocked, 1 thread:    %7.1f ms (%.2f GFLOP/s) %s\n", blocked_s * 1000,
+           blocked_s > 0 ? gflop / blocked_s : 0.0, same ? "✓ same result" : "(rounding differs: FMA)");
+    printf("  Blocked, all threads: %7.1f ms\n", threaded_s * 1000);
+    
+    start = wall_seconds();
+    matrix_transpose(&a, &t);
+    printf("  Tiled transpose:      %7.1f ms, a[3][5] = %.0f, t[5][3] = %.0f\n",
+           (wall_seconds() - start) * 1000, *matrix_at(&a, 3, 5), *matrix_at(&t, 5, 3));
+    
+cleanup:
+    matrix_free(&a);
+    matrix_free(&b);
+    matrix_free(&c_naive);
+    matrix_free(&c_blocked);
+    matrix_free(&t);
+}
+
 /**
  * Example 6: Memory leak demonstration (what NOT to do)
  * Educational example showing common mistakes
@@ -364,6 +432,7 @@ int main(void) {
     example_realloc();
     example_dynamic_string();
     example_2d_array();
+    example_matrix_multiply();
     example_memory_leak_warning();
     example_proper_cleanup();
     
@@ -375,6 +444,7 @@ int main(void) {
     printf("║ 4. Never free the same memory twice                       ║\n");
     printf("║ 5. Set pointers to NULL after freeing                     ║\n");
     printf("║ 6. Use valgrind to detect memory errors                   ║\n");
+    printf("║ 7. Matrices: one contiguous block, not int** rows         ║\n");
     printf("╚════════════════════════════════════════════════════════════╝\n");
     
     return 0;
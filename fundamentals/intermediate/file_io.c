@@ -5,6 +5,8 @@
  * Topics covered:
  * - Opening and closing files (fopen, fclose)
  * - Text file I/O (fprintf, fscanf, fgets, fputs)
+ * - Fast line reading (line_reader.h: read(2) + memchr, zero-copy views)
+ * - Memory-mapped record files (record_store.h: O(1) random access)
  * - Binary file I/O (fread, fwrite)
  * - File positioning (fseek, ftell, rewind)
  * - Error handling (ferror, feof, perror)
@@ -21,6 +23,8 @@
  * - System calls (underlying write/read): ~100-1000 CPU cycles
  * - Disk I/O: 1-10ms latency (millions of CPU cycles)
  * - Binary I/O faster than formatted text I/O
+ * - fgetc: one locked libc call per byte; line_reader: one read() per
+ *   256KB and memchr for newlines (see Example 10 for MB/s)
  * 
  * RAII Pattern in C:
  * - Always pair fopen() with fclose()
@@ -31,6 +35,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <stdint.h>
+#include "line_reader.h"
+#include "record_store.h"
 
 /* Windows UTF-8 console setup */
 #ifdef _WIN32
@@ -46,6 +55,15 @@ void setup_utf8_console(void) {}
 #define TEXT_FILE "example_text.txt"
 #define BINARY_FILE "example_binary.dat"
 #define DATA_FILE "student_data.txt"
+#define LOG_FILE "example_log.txt"
+#define RECORD_FILE "student_records.dat"
+
+/* Fixed-size record used by the binary examples (4 and 11) */
+struct Student {
+    int id;
+    char name[50];
+    float gpa;
+};
 
 /**
  * Example 1: Basic text file writing
@@ -79,15 +97,18 @@ void example_write_text_file(void) {
 
 /**
  * Example 2: Reading text file
- * Demonstrates fopen, fgets, and fclose
+ * Demonstrates line-by-line reading with a LineReader
+ * 
+ * Unlike fgets, there is no fixed line buffer to overflow or split long
+ * lines, and no per-line copy: each line is a view into the reader's
+ * buffer, valid until the next line_reader_next() call.
  */
 void example_read_text_file(void) {
     printf("\n=== Example 2: Reading Text File ===\n");
     
     /* Open file for reading */
-    FILE *file = fopen(TEXT_FILE, "r");
-    
-    if (file == NULL) {
+    LineReader reader;
+    if (!line_reader_open(&reader, TEXT_FILE)) {
         perror("Error opening file for reading");
         return;
     }
@@ -95,20 +116,20 @@ void example_read_text_file(void) {
     printf("Reading from '%s':\n", TEXT_FILE);
     printf("-----------------------------------\n");
     
-    /* Read file line by line */
-    char buffer[256];
-    while (fgets(buffer, sizeof(buffer), file) != NULL) {
-        printf("%s", buffer); /* fgets includes newline */
+    /* Read file line by line (newline stripped, NUL-terminated) */
+    StringView line;
+    while (line_reader_next(&reader, &line)) {
+        printf("%.*s\n", (int)line.length, line.data);
     }
     
     printf("-----------------------------------\n");
     
     /* Check if we stopped due to error or EOF */
-    if (ferror(file)) {
-        perror("Error reading file");
+    if (reader.error != 0) {
+        fprintf(stderr, "Error reading file: %s\n", strerror(reader.error));
     }
     
-    fclose(file);
+    line_reader_close(&reader);
     printf("File read successfully.\n");
 }
 
@@ -144,13 +165,7 @@ void example_append_to_file(void) {
 void example_binary_file(void) {
     printf("\n=== Example 4: Binary File I/O ===\n");
     
-    /* Data structure to save */
-    struct Student {
-        int id;
-        char name[50];
-        float gpa;
-    };
-    
+    /* Data structure to save (struct Student, defined at the top) */
     struct Student students[3] = {
         {101, "Alice Johnson", 3.8f},
         {102, "Bob Smith", 3.6f},
@@ -262,8 +277,41 @@ void example_file_positioning(void) {
 }
 
 /**
- * Example 6: Formatted input with fscanf
+ * Parse "name age score" from one line (the fscanf "%49s %d %f" format)
+ * 
+ * The view is NUL-terminated, so strtol/strtof can run on it directly;
+ * no per-field library call scans the stream byte by byte.
+ * Returns: 1 if all three fields were present, 0 otherwise
+ */
+int parse_student_line(StringView line, char *name, size_t name_size, int *age, float *score) {
+    const char *p = line.data;
+    const char *end = line.data + line.length;
+    
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    const char *name_start = p;
+    while (p < end && *p != ' ' && *p != '\t') p++;
+    size_t name_length = (size_t)(p - name_start);
+    if (name_length == 0 || name_length >= name_size) {
+        return 0;
+    }
+    memcpy(name, name_start, name_length);
+    name[name_length] = '\0';
+    
+    char *next;
+    long value = strtol(p, &next, 10);
+    if (next == p) {
+        return 0;
+    }
+    *age = (int)value;
+    p = next;
+    *score = strtof(p, &next);
+    return next != p;
+}
+
+/**
+ * Example 6: Formatted input
  * Demonstrates reading structured data from text file
+ * (fprintf to write, LineReader + parse_student_line to read back)
  */
 void example_formatted_input(void) {
     printf("\n=== Example 6: Formatted Input ===\n");
@@ -283,9 +331,9 @@ void example_formatted_input(void) {
     
     printf("Created data file '%s'\n\n", DATA_FILE);
     
-    /* Read structured data */
-    file = fopen(DATA_FILE, "r");
-    if (file == NULL) {
+    /* Read structured data: one line at a time, fields parsed in place */
+    LineReader reader;
+    if (!line_reader_open(&reader, DATA_FILE)) {
         perror("Error opening data file");
         return;
     }
@@ -299,11 +347,14 @@ void example_formatted_input(void) {
     float score;
     
     /* Read until EOF or error */
-    while (fscanf(file, "%49s %d %f", name, &age, &score) == 3) {
-        printf("%-10s %-5d %-7.1f\n", name, age, score);
+    StringView line;
+    while (line_reader_next(&reader, &line)) {
+        if (parse_student_line(line, name, sizeof(name), &age, &score)) {
+            printf("%-10s %-5d %-7.1f\n", name, age, score);
+        }
     }
     
-    fclose(file);
+    line_reader_close(&reader);
 }
 
 /**
@@ -429,6 +480,176 @@ cleanup:
     return result;
 }
 
+/**
+ * Example 10: Line reading throughput
+ * Same log file counted three ways: fgetc per byte, fgets per line,
+ * and LineReader views (one read() per 256KB, memchr for '\n')
+ */
+#define LOG_LINES 400000
+
+void example_line_reading_speed(void) {
+    printf("\n=== Example 10: Line Reading Throughput ===\n");
+    
+    FILE *file = fopen(LOG_FILE, "w");
+    if (file == NULL) {
+        perror("Error creating log file");
+        return;
+    }
+    for (int i = 0; i < LOG_LINES; i++) {
+        fprintf(file, "2026-01-%02d 12:%02d:%02d INFO request %d served in %d us\n",
+                1 + i % 28, i % 60, (i / 60) % 60, i, (i * 37) % 5000);
+    }
+    long file_size = ftell(file);
+    fclose(file);
+    double megabytes = (double)file_size / (1024.0 * 1024.0);
+    printf("Log file: %d lines, %.1f MB\n", LOG_LINES, megabytes);
+    
+    /* fgetc: one call per byte */
+    clock_t start = clock();
+    long lines = 0;
+    file = fopen(LOG_FILE, "r");
+    if (file != NULL) {
+        int c;
+        while ((c = fgetc(file)) != EOF) {
+            if (c == '\n') lines++;
+        }
+        fclose(file);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("  fgetc:       %ld lines, %8.1f MB/s\n", lines, seconds > 0 ? megabytes / seconds : 0.0);
+    
+    /* fgets: one call and one copy per line */
+    start = clock();
+    lines = 0;
+    file = fopen(LOG_FILE, "r");
+    if (file != NULL) {
+        char buffer[256];
+        while (fgets(buffer, sizeof(buffer), file) != NULL) {
+            lines++;
+        }
+        fclose(file);
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("  fgets:       %ld lines, %8.1f MB/s\n", lines, seconds > 0 ? megabytes / seconds : 0.0);
+    
+    /* LineReader: views into a 256KB buffer */
+    start = clock();
+    lines = 0;
+    LineReader reader;
+    if (line_reader_open(&reader, LOG_FILE)) {
+        StringView line;
+        while (line_reader_next(&reader, &line)) {
+            lines++;
+        }
+        seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("  line_reader: %ld lines, %8.1f MB/s (%zu reads, %zu bytes copied across refills)\n",
+               lines, seconds > 0 ? megabytes / seconds : 0.0, reader.refills, reader.bytes_copied);
+        line_reader_close(&reader);
+    }
+}
+
+/**
+ * Example 11: Memory-mapped record store
+ * Random access by index into a file of struct Student records
+ * 
+ * fseek/fread (Example 5 positioning) costs calls, a syscall and a copy
+ * per record; the record store maps the file once and record i is
+ * just map + header + i * sizeof(struct Student).
+ */
+#define STORE_RECORDS 200000
+#define STORE_LOOKUPS 200000
+
+void example_record_store(void) {
+    printf("\n=== Example 11: Memory-Mapped Record Store ===\n");
+    
+    RecordStore store;
+    if (!record_store_create(&store, RECORD_FILE, sizeof(struct Student))) {
+        perror("Error creating record store");
+        return;
+    }
+    
+    /* Append grows the file in 64MB extents, not per record */
+    for (int i = 0; i < STORE_RECORDS; i++) {
+        struct Student s = {0};
+        s.id = 100000 + i;
+        snprintf(s.name, sizeof(s.name), "Student %d", i);
+        s.gpa = 2.0f + (float)(i % 200) / 100.0f;
+        if (record_store_append(&store, &s) == NULL) {
+            perror("Error appending record");
+            break;
+        }
+    }
+    printf("Appended %llu records of %zu bytes (header v%u, %u-byte header)\n",
+           (unsigned long long)record_store_count(&store), sizeof(struct Student),
+           (unsigned)store.header->version, (unsigned)store.header->header_size);
+    record_store_close(&store);     /* Trims the unused extent tail */
+    
+    /* Reopen read-only: header is validated against sizeof(struct Student) */
+    if (!record_store_open(&store, RECORD_FILE, sizeof(struct Student), false)) {
+        perror("Error opening record store");
+        remove(RECORD_FILE);
+        return;
+    }
+    record_store_advise(&store, RECORD_ACCESS_RANDOM);
+    uint64_t count = record_store_count(&store);
+    if (count == 0) {
+        /* Every append failed: nothing to index (and count - 1 would wrap) */
+        printf("Record store is empty, skipping lookups\n");
+        record_store_close(&store);
+        remove(RECORD_FILE);
+        return;
+    }
+    
+    /* Random lookups via the mapping */
+    uint32_t seed = 2026;
+    double gpa_sum = 0.0;
+    clock_t start = clock();
+    for (int i = 0; i < STORE_LOOKUPS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        const struct Student *s = record_store_get(&store, (seed >> 8) % count);
+        gpa_sum += s->gpa;
+    }
+    double mmap_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    const struct Student *last = record_store_get(&store, count - 1);
+    printf("Record %llu: ID %d, %s, GPA %.2f\n", (unsigned long long)(count - 1),
+           last->id, last->name, last->gpa);
+    record_store_close(&store);
+    
+    /* Same lookups with fseek + fread on the same file */
+    FILE *file = fopen(RECORD_FILE, "rb");
+    double fseek_sum = 0.0;
+    double fseek_seconds = 0.0;
+    if (file != NULL) {
+        seed = 2026;
+        start = clock();
+        for (int i = 0; i < STORE_LOOKUPS; i++) {
+            seed = seed * 1103515245u + 12345u;
+            long offset = (long)(RECORD_STORE_HEADER_SIZE +
+                                 ((seed >> 8) % count) * sizeof(struct Student));
+            struct Student s;
+            if (fseek(file, offset, SEEK_SET) == 0 && fread(&s, sizeof(s), 1, file) == 1) {
+                fseek_sum += s.gpa;
+            }
+        }
+        fseek_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        fclose(file);
+    }
+    
+    printf("%d random lookups:\n", STORE_LOOKUPS);
+    printf("  fseek + fread:      %.4f s (GPA sum %.1f)\n", fseek_seconds, fseek_sum);
+    printf("  record_store_get:   %.4f s (GPA sum %.1f)\n", mmap_seconds, gpa_sum);
+    
+    /* A store written with a different record layout is rejected */
+    if (!record_store_open(&store, RECORD_FILE, sizeof(struct Student) + 4, false)) {
+        printf("Opening with the wrong record size: rejected (%s)\n", strerror(errno));
+    } else {
+        record_store_close(&store);
+    }
+    
+    remove(RECORD_FILE);
+}
+
 /**
  * Cleanup function to remove example files
  */
@@ -436,6 +657,8 @@ void cleanup_example_files(void) {
     remove(TEXT_FILE);
     remove(BINARY_FILE);
     remove(DATA_FILE);
+    remove(LOG_FILE);
+    remove(RECORD_FILE);
 }
 
 /**
@@ -458,11 +681,13 @@ int main(void) {
     printf("  fprintf/fscanf    - Formatted text I/O\n");
     printf("  fgets/fputs       - Line-based I/O\n");
     printf("  fgetc/fputc       - Character I/O\n");
+    printf("  line_reader_next  - Zero-copy lines (read + memchr)\n");
     printf("\n");
     
     printf("Binary I/O:\n");
     printf("  fread(ptr, size, count, file)  - Read binary data\n");
     printf("  fwrite(ptr, size, count, file) - Write binary data\n");
+    printf("  record_store_get(store, i)     - Mapped record, O(1)\n");
     printf("\n");
     
     printf("Positioning:\n");
@@ -488,6 +713,8 @@ int main(void) {
     example_error_handling();
     example_file_modes();
     example_multiple_files();
+    example_line_reading_speed();
+    example_record_store();
     
     /* Clean up all example files */
     cleanup_example_files();
@@ -501,6 +728,7 @@ int main(void) {
     printf("║ 4. Check ferror() and feof() after reads                  ║\n");
     printf("║ 5. Buffered I/O is faster than unbuffered                 ║\n");
     printf("║ 6. Binary I/O is faster than text I/O                     ║\n");
+    printf("║ 7. Big text files: read() large blocks, memchr for lines  ║\n");
     printf("╚════════════════════════════════════════════════════════════╝\n");
     
     return 0;
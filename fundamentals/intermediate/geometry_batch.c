@@ -0,0 +1,523 @@
+/**
+ * geometry_batch.c - Implementation of the Batched Geometry Kernels
+ *
+ * Each kernel has a scalar loop that defines the result; the SIMD
+ * versions compute exactly the same expression per lane
+ * (sub, mul, mul, add, then sqrt) so the outputs are bit-identical.
+ * Ties in nearest_point() always go to the lowest index.
+ */
+
+#include "geometry_batch.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define HAVE_NEON 1             // float64x2 needs AArch64, not 32-bit NEON
+#include <arm_neon.h>
+#endif
+
+#define GRID_MAX_CELLS_PER_POINT 2
+
+#ifdef HAVE_X86_SIMD
+static bool cpu_has_avx2(void) {
+    static int has_avx2 = -1;
+    if (has_avx2 < 0) {
+        has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return has_avx2 != 0;
+}
+#endif
+
+// ========================================
+// POINT ARRAYS
+// ========================================
+
+bool point_array_from_points(PointArray *array, const Point *points, size_t count) {
+    array->x = malloc((count > 0 ? count : 1) * sizeof(double));
+    array->y = malloc((count > 0 ? count : 1) * sizeof(double));
+    array->count = 0;
+    if (array->x == NULL || array->y == NULL) {
+        point_array_free(array);
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        array->x[i] = points[i].x;
+        array->y[i] = points[i].y;
+    }
+    array->count = count;
+    return true;
+}
+
+void point_array_free(PointArray *array) {
+    free(array->x);
+    free(array->y);
+    array->x = NULL;
+    array->y = NULL;
+    array->count = 0;
+}
+
+// ========================================
+// DISTANCES TO ONE POINT
+// ========================================
+
+static void to_point_scalar(const double *x, const double *y, size_t n,
+                            double qx, double qy, double *out, bool squared) {
+    for (size_t i = 0; i < n; i++) {
+        double dx = x[i] - qx;
+        double dy = y[i] - qy;
+        double d2 = dx * dx + dy * dy;
+        out[i] = squared ? d2 : sqrt(d2);
+    }
+}
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+static size_t to_point_avx2(const double *x, const double *y, size_t n,
+                            double qx, double qy, double *out, bool squared) {
+    const __m256d vqx = _mm256_set1_pd(qx);
+    const __m256d vqy = _mm256_set1_pd(qy);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vqx);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vqy);
+        __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        _mm256_storeu_pd(out + i, squared ? d2 : _mm256_sqrt_pd(d2));
+    }
+    return i;
+}
+
+static size_t to_point_sse2(const double *x, const double *y, size_t n,
+                            double qx, double qy, double *out, bool squared) {
+    const __m128d vqx = _mm_set1_pd(qx);
+    const __m128d vqy = _mm_set1_pd(qy);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), vqx);
+        __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), vqy);
+        __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        _mm_storeu_pd(out + i, squared ? d2 : _mm_sqrt_pd(d2));
+    }
+    return i;
+}
+#endif
+
+#ifdef HAVE_NEON
+static size_t to_point_neon(const double *x, const double *y, size_t n,
+                            double qx, double qy, double *out, bool squared) {
+    const float64x2_t vqx = vdupq_n_f64(qx);
+    const float64x2_t vqy = vdupq_n_f64(qy);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t dx = vsubq_f64(vld1q_f64(x + i), vqx);
+        float64x2_t dy = vsubq_f64(vld1q_f64(y + i), vqy);
+        float64x2_t d2 = vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy));
+        vst1q_f64(out + i, squared ? d2 : vsqrtq_f64(d2));
+    }
+    return i;
+}
+#endif
+
+/**
+ * SIMD body, scalar tail
+ */
+static void to_point(const double *x, const double *y, size_t n,
+                     double qx, double qy, double *out, bool squared) {
+    size_t done = 0;
+#if defined(HAVE_X86_SIMD)
+    done = cpu_has_avx2() ? to_point_avx2(x, y, n, qx, qy, out, squared)
+                          : to_point_sse2(x, y, n, qx, qy, out, squared);
+#elif defined(HAVE_NEON)
+    done = to_point_neon(x, y, n, qx, qy, out, squared);
+#endif
+    to_point_scalar(x + done, y + done, n - done, qx, qy, out + done, squared);
+}
+
+void distances_to_point(const PointArray *points, Point query, double *out) {
+    to_point(points->x, points->y, points->count, query.x, query.y, out, false);
+}
+
+void squared_distances_to_point(const PointArray *points, Point query, double *out) {
+    to_point(points->x, points->y, points->count, query.x, query.y, out, true);
+}
+
+void distance_matrix(const PointArray *a, const PointArray *b, double *out, bool squared) {
+    // One row per point of a: a streaming pass over b, which stays in cache
+    for (size_t i = 0; i < a->count; i++) {
+        to_point(b->x, b->y, b->count, a->x[i], a->y[i], out + i * b->count, squared);
+    }
+}
+
+// ========================================
+// PAIRWISE DISTANCES
+// ========================================
+
+static void pairwise_scalar(const double *ax, const double *ay, const double *bx, const double *by,
+                            size_t n, double *out) {
+    for (size_t i = 0; i < n; i++) {
+        double dx = bx[i] - ax[i];
+        double dy = by[i] - ay[i];
+        out[i] = sqrt(dx * dx + dy * dy);
+    }
+}
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+static size_t pairwise_avx2(const double *ax, const double *ay, const double *bx, const double *by,
+                            size_t n, double *out) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(bx + i), _mm256_loadu_pd(ax + i));
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(by + i), _mm256_loadu_pd(ay + i));
+        __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        _mm256_storeu_pd(out + i, _mm256_sqrt_pd(d2));
+    }
+    return i;
+}
+
+static size_t pairwise_sse2(const double *ax, const double *ay, const double *bx, const double *by,
+                            size_t n, double *out) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d dx = _mm_sub_pd(_mm_loadu_pd(bx + i), _mm_loadu_pd(ax + i));
+        __m128d dy = _mm_sub_pd(_mm_loadu_pd(by + i), _mm_loadu_pd(ay + i));
+        __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        _mm_storeu_pd(out + i, _mm_sqrt_pd(d2));
+    }
+    return i;
+}
+#endif
+
+#ifdef HAVE_NEON
+static size_t pairwise_neon(const double *ax, const double *ay, const double *bx, const double *by,
+                            size_t n, double *out) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t dx = vsubq_f64(vld1q_f64(bx + i), vld1q_f64(ax + i));
+        float64x2_t dy = vsubq_f64(vld1q_f64(by + i), vld1q_f64(ay + i));
+        float64x2_t d2 = vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy));
+        vst1q_f64(out + i, vsqrtq_f64(d2));
+    }
+    return i;
+}
+#endif
+
+void pairwise_distances(const PointArray *a, const PointArray *b, double *out) {
+    size_t n = a->count;
+    size_t done = 0;
+#if defined(HAVE_X86_SIMD)
+    done = cpu_has_avx2() ? pairwise_avx2(a->x, a->y, b->x, b->y, n, out)
+                          : pairwise_sse2(a->x, a->y, b->x, b->y, n, out);
+#elif defined(HAVE_NEON)
+    done = pairwise_neon(a->x, a->y, b->x, b->y, n, out);
+#endif
+    pairwise_scalar(a->x + done, a->y + done, b->x + done, b->y + done, n - done, out + done);
+}
+
+// ========================================
+// NEAREST POINT
+// ========================================
+
+/**
+ * Lane-wise running minimum: every lane keeps its best squared distance
+ * and (as a double, exact below 2^53) the index where it was seen.
+ * Strict compares keep the earliest index within a lane; the lanes are
+ * then merged with the lower index winning ties.
+ */
+static void merge_lanes(const double *best, const double *best_index, int lanes,
+                        double *d2, size_t *index) {
+    for (int lane = 0; lane < lanes; lane++) {
+        size_t lane_index = (size_t)best_index[lane];
+        if (best[lane] < *d2 || (best[lane] == *d2 && lane_index < *index)) {
+            *d2 = best[lane];
+            *index = lane_index;
+        }
+    }
+}
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+static size_t nearest_avx2(const double *x, const double *y, size_t n, double qx, double qy,
+                           double *d2, size_t *index) {
+    const __m256d vqx = _mm256_set1_pd(qx);
+    const __m256d vqy = _mm256_set1_pd(qy);
+    const __m256d step = _mm256_set1_pd(4.0);
+    __m256d idx = _mm256_setr_pd(0.0, 1.0, 2.0, 3.0);
+    __m256d best = _mm256_set1_pd(INFINITY);
+    __m256d best_idx = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vqx);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vqy);
+        __m256d dist = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        __m256d lt = _mm256_cmp_pd(dist, best, _CMP_LT_OQ);
+        best = _mm256_blendv_pd(best, dist, lt);
+        best_idx = _mm256_blendv_pd(best_idx, idx, lt);
+        idx = _mm256_add_pd(idx, step);
+    }
+    double lanes[4], lane_idx[4];
+    _mm256_storeu_pd(lanes, best);
+    _mm256_storeu_pd(lane_idx, best_idx);
+    merge_lanes(lanes, lane_idx, 4, d2, index);
+    return i;
+}
+
+static size_t nearest_sse2(const double *x, const double *y, size_t n, double qx, double qy,
+                           double *d2, size_t *index) {
+    const __m128d vqx = _mm_set1_pd(qx);
+    const __m128d vqy = _mm_set1_pd(qy);
+    const __m128d step = _mm_set1_pd(2.0);
+    __m128d idx = _mm_setr_pd(0.0, 1.0);
+    __m128d best = _mm_set1_pd(INFINITY);
+    __m128d best_idx = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), vqx);
+        __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), vqy);
+        __m128d dist = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        __m128d lt = _mm_cmplt_pd(dist, best);
+        best = _mm_or_pd(_mm_and_pd(lt, dist), _mm_andnot_pd(lt, best));
+        best_idx = _mm_or_pd(_mm_and_pd(lt, idx), _mm_andnot_pd(lt, best_idx));
+        idx = _mm_add_pd(idx, step);
+    }
+    double lanes[2], lane_idx[2];
+    _mm_storeu_pd(lanes, best);
+    _mm_storeu_pd(lane_idx, best_idx);
+    merge_lanes(lanes, lane_idx, 2, d2, index);
+    return i;
+}
+#endif
+
+#ifdef HAVE_NEON
+static size_t nearest_neon(const double *x, const double *y, size_t n, double qx, double qy,
+                           double *d2, size_t *index) {
+    const float64x2_t vqx = vdupq_n_f64(qx);
+    const float64x2_t vqy = vdupq_n_f64(qy);
+    const float64x2_t step = vdupq_n_f64(2.0);
+    static const double first_index[2] = {0.0, 1.0};
+    float64x2_t idx = vld1q_f64(first_index);
+    float64x2_t best = vdupq_n_f64(INFINITY);
+    float64x2_t best_idx = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t dx = vsubq_f64(vld1q_f64(x + i), vqx);
+        float64x2_t dy = vsubq_f64(vld1q_f64(y + i), vqy);
+        float64x2_t dist = vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy));
+        uint64x2_t lt = vcltq_f64(dist, best);
+        best = vbslq_f64(lt, dist, best);
+        best_idx = vbslq_f64(lt, idx, best_idx);
+        idx = vaddq_f64(idx, step);
+    }
+    double lanes[2], lane_idx[2];
+    vst1q_f64(lanes, best);
+    vst1q_f64(lane_idx, best_idx);
+    merge_lanes(lanes, lane_idx, 2, d2, index);
+    return i;
+}
+#endif
+
+size_t nearest_point(const PointArray *points, Point query, double *distance) {
+    size_t n = points->count;
+    if (n == 0) {
+        return (size_t)-1;
+    }
+    const double *x = points->x;
+    const double *y = points->y;
+    double best = INFINITY;
+    size_t best_index = 0;
+    size_t done = 0;
+
+    // Lane indices are doubles: stay below 2^53 (always true in practice)
+    if ((uint64_t)n < (UINT64_C(1) << 53)) {
+#if defined(HAVE_X86_SIMD)
+        done = cpu_has_avx2() ? nearest_avx2(x, y, n, query.x, query.y, &best, &best_index)
+                              : nearest_sse2(x, y, n, query.x, query.y, &best, &best_index);
+#elif defined(HAVE_NEON)
+        done = nearest_neon(x, y, n, query.x, query.y, &best, &best_index);
+#endif
+    }
+    for (size_t i = done; i < n; i++) {
+        double dx = x[i] - query.x;
+        double dy = y[i] - query.y;
+        double d2 = dx * dx + dy * dy;
+        if (d2 < best) {                    // Tail indices are all larger
+            best = d2;
+            best_index = i;
+        }
+    }
+    if (distance != NULL) {
+        *distance = sqrt(best);
+    }
+    return best_index;
+}
+
+// ========================================
+// CIRCLES
+// ========================================
+
+// Plain loops: no dependency between iterations, so -O3 vectorizes them
+void circle_areas(const double *radii, size_t count, double *out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = PI * radii[i] * radii[i];
+    }
+}
+
+void circle_circumferences(const double *radii, size_t count, double *out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = 2 * PI * radii[i];
+    }
+}
+
+// ========================================
+// UNIFORM GRID
+// ========================================
+
+static size_t grid_cell_coord(double value, double min, double inv_cell_size, size_t cells) {
+    double cell = (value - min) * inv_cell_size;
+    if (cell <= 0.0) {
+        return 0;
+    }
+    return cell >= (double)cells ? cells - 1 : (size_t)cell;
+}
+
+bool point_grid_build(PointGrid *grid, const Point *points, size_t count, double cell_size) {
+    grid->cell_start = NULL;
+    grid->x = NULL;
+    grid->y = NULL;
+    grid->index = NULL;
+    grid->count = 0;
+
+    double min_x = 0.0, min_y = 0.0, max_x = 0.0, max_y = 0.0;
+    if (count > 0) {
+        min_x = max_x = points[0].x;
+        min_y = max_y = points[0].y;
+    }
+    for (size_t i = 1; i < count; i++) {
+        min_x = points[i].x < min_x ? points[i].x : min_x;
+        max_x = points[i].x > max_x ? points[i].x : max_x;
+        min_y = points[i].y < min_y ? points[i].y : min_y;
+        max_y = points[i].y > max_y ? points[i].y : max_y;
+    }
+    double width = max_x - min_x;
+    double height = max_y - min_y;
+
+    if (!(cell_size > 0.0)) {
+        // About one point per cell
+        double area = width * height;
+        cell_size = area > 0.0 ? sqrt(area / (double)(count > 0 ? count : 1))
+                               : (width > height ? width : height) / (double)(count > 0 ? count : 1);
+        if (!(cell_size > 0.0)) {
+            cell_size = 1.0;                // All points identical (or none)
+        }
+    }
+
+    // Enlarge cells until the table has at most ~2 cells per point
+    double max_cells = (double)(count > 0 ? count : 1) * GRID_MAX_CELLS_PER_POINT + 16.0;
+    double cols = floor(width / cell_size) + 1.0;
+    double rows = floor(height / cell_size) + 1.0;
+    while (cols * rows > max_cells) {
+        cell_size *= 2.0;
+        cols = floor(width / cell_size) + 1.0;
+        rows = floor(height / cell_size) + 1.0;
+    }
+
+    grid->min_x = min_x;
+    grid->min_y = min_y;
+    grid->cell_size = cell_size;
+    grid->inv_cell_size = 1.0 / cell_size;
+    grid->cols = (size_t)cols;
+    grid->rows = (size_t)rows;
+    size_t cells = grid->cols * grid->rows;
+
+    grid->cell_start = calloc(cells + 1, sizeof(size_t));
+    grid->x = malloc((count > 0 ? count : 1) * sizeof(double));
+    grid->y = malloc((count > 0 ? count : 1) * sizeof(double));
+    grid->index = malloc((count > 0 ? count : 1) * sizeof(size_t));
+    size_t *cell_of = malloc((count > 0 ? count : 1) * sizeof(size_t));
+    if (grid->cell_start == NULL || grid->x == NULL || grid->y == NULL ||
+        grid->index == NULL || cell_of == NULL) {
+        free(cell_of);
+        point_grid_free(grid);
+        return false;
+    }
+
+    // Counting sort by cell: count, prefix sum, scatter
+    for (size_t i = 0; i < count; i++) {
+        size_t cx = grid_cell_coord(points[i].x, min_x, grid->inv_cell_size, grid->cols);
+        size_t cy = grid_cell_coord(points[i].y, min_y, grid->inv_cell_size, grid->rows);
+        cell_of[i] = cy * grid->cols + cx;
+        grid->cell_start[cell_of[i] + 1]++;
+    }
+    for (size_t c = 0; c < cells; c++) {
+        grid->cell_start[c + 1] += grid->cell_start[c];
+    }
+    for (size_t i = 0; i < count; i++) {
+        size_t slot = grid->cell_start[cell_of[i]]++;
+        grid->x[slot] = points[i].x;
+        grid->y[slot] = points[i].y;
+        grid->index[slot] = i;
+    }
+    // The scatter advanced every start to the next cell's start: shift back
+    for (size_t c = cells; c > 0; c--) {
+        grid->cell_start[c] = grid->cell_start[c - 1];
+    }
+    grid->cell_start[0] = 0;
+
+    free(cell_of);
+    grid->count = count;
+    return true;
+}
+
+size_t point_grid_query_radius(const PointGrid *grid, Point center, double radius,
+                               size_t *results, size_t max_results) {
+    if (grid->count == 0 || !(radius >= 0.0)) {
+        return 0;
+    }
+    // Circle's bounding box entirely outside the grid: nothing to scan
+    double max_x = grid->min_x + (double)grid->cols * grid->cell_size;
+    double max_y = grid->min_y + (double)grid->rows * grid->cell_size;
+    if (center.x + radius < grid->min_x || center.x - radius > max_x ||
+        center.y + radius < grid->min_y || center.y - radius > max_y) {
+        return 0;
+    }
+
+    size_t cx0 = grid_cell_coord(center.x - radius, grid->min_x, grid->inv_cell_size, grid->cols);
+    size_t cx1 = grid_cell_coord(center.x + radius, grid->min_x, grid->inv_cell_size, grid->cols);
+    size_t cy0 = grid_cell_coord(center.y - radius, grid->min_y, grid->inv_cell_size, grid->rows);
+    size_t cy1 = grid_cell_coord(center.y + radius, grid->min_y, grid->inv_cell_size, grid->rows);
+    double r2 = radius * radius;
+    size_t found = 0;
+
+    for (size_t cy = cy0; cy <= cy1; cy++) {
+        // Cells cx0..cx1 of one row are one contiguous run of entries
+        size_t begin = grid->cell_start[cy * grid->cols + cx0];
+        size_t end = grid->cell_start[cy * grid->cols + cx1 + 1];
+        for (size_t k = begin; k < end; k++) {
+            double dx = grid->x[k] - center.x;
+            double dy = grid->y[k] - center.y;
+            if (dx * dx + dy * dy <= r2) {
+                if (found < max_results) {
+                    results[found] = grid->index[k];
+                }
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+void point_grid_free(PointGrid *grid) {
+    free(grid->cell_start);
+    free(grid->x);
+    free(grid->y);
+    free(grid->index);
+    grid->cell_start = NULL;
+    grid->x = NULL;
+    grid->y = NULL;
+    grid->index = NULL;
+    grid->count = 0;
+}
@@ -9,7 +9,10 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
 #include "math_utils.h"  // Include our custom header
+#include "geometry_batch.h"  // Batched versions of the geometry functions
 
 #ifdef _WIN32
 #include <windows.h>
@@ -21,6 +24,7 @@ void demonstrate_prime_numbers(void);
 void demonstrate_sequences(void);
 void demonstrate_geometry(void);
 void demonstrate_utilities(void);
+void demonstrate_batch_geometry(void);
 
 int main(void) {
 #ifdef _WIN32
@@ -40,6 +44,7 @@ int main(void) {
     demonstrate_sequences();
     demonstrate_geometry();
     demonstrate_utilities();
+    demonstrate_batch_geometry();
 
     printf("========================================\n");
     printf("     ALL DEMONSTRATIONS COMPLETED      \n");
@@ -119,7 +124,24 @@ void demonstrate_sequences(void) {
     for (int i = 0; i <= 15; i++) {
         printf("  fib(%2d) = %d\n", i, fibonacci(i));
     }
-    printf("\n");
+
+    // int results stop at 12! and F(46); the checked variants report overflow
+    printf("\nOverflow-Checked (uint64_t):\n");
+    int checked[] = {FACTORIAL_MAX_INT + 1, FACTORIAL_MAX_U64, FACTORIAL_MAX_U64 + 1};
+    for (int i = 0; i < 3; i++) {
+        uint64_t value;
+        if (factorial_checked(checked[i], &value)) {
+            printf("  %2d! = %llu\n", checked[i], (unsigned long long)value);
+        } else {
+            printf("  %2d! = overflow (factorial() returns %d)\n", checked[i], factorial(checked[i]));
+        }
+    }
+    uint64_t fib93;
+    if (fibonacci_checked(FIBONACCI_MAX_U64, &fib93)) {
+        printf("  fib(93) = %llu (largest that fits)\n", (unsigned long long)fib93);
+    }
+    printf("  fib(100) mod 2^64 = %llu (fast doubling)\n\n",
+           (unsigned long long)fibonacci_fast_doubling(100));
 }
 
 /**
@@ -163,7 +185,16 @@ void demonstrate_utilities(void) {
     int a = 48, b = 18;
     printf("Numbers: a = %d, b = %d\n", a, b);
     printf("  GCD(a, b) = %d\n", gcd(a, b));
-    printf("  LCM(a, b) = %d\n\n", lcm(a, b));
+    printf("  LCM(a, b) = %d\n", lcm(a, b));
+    // a * b would overflow int here; lcm() divides first and reports 0
+    printf("  LCM(100000, 70001) = %d (does not fit in int)\n", lcm(100000, 70001));
+    uint64_t big_lcm;
+    if (lcm64_checked(100000, 70001, &big_lcm)) {
+        printf("  lcm64_checked(100000, 70001) = %llu\n", (unsigned long long)big_lcm);
+    }
+    int denominators[] = {360, 840, 1260, 35, 9999};
+    printf("  gcd_many({360, 840, 1260, 35, ...}) = %d (exits as soon as it reaches 1)\n\n",
+           gcd_many(denominators, 5));
 
     int x = 100, y = 200;
     printf("Swap Function:\n");
@@ -175,3 +206,90 @@ void demonstrate_utilities(void) {
     printf("  PI = %.10f\n", PI);
     printf("  E = %.10f\n\n", E);
 }
+
+#define BATCH_POINTS 1000000
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Demonstrate the batched geometry kernels (geometry_batch.h)
+ */
+void demonstrate_batch_geometry(void) {
+    printf("========================================\n");
+    printf("6. BATCH GEOMETRY (SoA + SIMD)\n");
+    printf("========================================\n\n");
+
+    Point *points = malloc(BATCH_POINTS * sizeof(Point));
+    double *distances = malloc(BATCH_POINTS * sizeof(double));
+    size_t *matches = malloc(BATCH_POINTS * sizeof(size_t));
+    PointArray array;
+    if (points == NULL || distances == NULL || matches == NULL) {
+        printf("  Allocation failed\n\n");
+        free(points);
+        free(distances);
+        free(matches);
+        return;
+    }
+    srand(42);
+    for (int i = 0; i < BATCH_POINTS; i++) {
+        points[i].x = (double)rand() / RAND_MAX * 1000.0;
+        points[i].y = (double)rand() / RAND_MAX * 1000.0;
+    }
+    if (!point_array_from_points(&array, points, BATCH_POINTS)) {
+        printf("  Allocation failed\n\n");
+        free(points);
+        free(distances);
+        free(matches);
+        return;
+    }
+    Point query = {500.0, 500.0};
+
+    printf("Distances from (%.0f, %.0f) to %d points:\n", query.x, query.y, BATCH_POINTS);
+    clock_t start = clock();
+    for (int i = 0; i < BATCH_POINTS; i++) {
+        distances[i] = distance_between_points(points[i], query);
+    }
+    printf("  distance_between_points() loop: %.2f ms\n", seconds_since(start) * 1000.0);
+
+    start = clock();
+    distances_to_point(&array, query, distances);
+    printf("  distances_to_point() batch:     %.2f ms\n", seconds_since(start) * 1000.0);
+
+    start = clock();
+    squared_distances_to_point(&array, query, distances);
+    printf("  squared (no sqrt):              %.2f ms\n\n", seconds_since(start) * 1000.0);
+
+    double nearest_distance;
+    size_t nearest = nearest_point(&array, query, &nearest_distance);
+    printf("Nearest point: #%zu (%.3f, %.3f), distance %.4f\n\n",
+           nearest, points[nearest].x, points[nearest].y, nearest_distance);
+
+    // Radius query: brute force touches every point, the grid a few cells
+    double radius = 10.0;
+    size_t brute = 0;
+    start = clock();
+    squared_distances_to_point(&array, query, distances);
+    for (int i = 0; i < BATCH_POINTS; i++) {
+        brute += distances[i] <= radius * radius;
+    }
+    double brute_ms = seconds_since(start) * 1000.0;
+
+    PointGrid grid;
+    if (point_grid_build(&grid, points, BATCH_POINTS, 0.0)) {
+        start = clock();
+        size_t found = point_grid_query_radius(&grid, query, radius, matches, BATCH_POINTS);
+        double grid_ms = seconds_since(start) * 1000.0;
+        printf("Points within %.0f of the query:\n", radius);
+        printf("  Brute force: %zu points, %.3f ms\n", brute, brute_ms);
+        printf("  PointGrid:   %zu points, %.3f ms (%zux%zu cells of %.2f)\n\n",
+               found, grid_ms, grid.cols, grid.rows, grid.cell_size);
+        point_grid_free(&grid);
+    }
+
+    point_array_free(&array);
+    free(points);
+    free(distances);
+    free(matches);
+}
@@ -0,0 +1,200 @@
+/**
+ * line_reader.c - Implementation of the Buffered Line Reader
+ *
+ * Buffer states (pos <= scan <= end <= capacity):
+ *
+ *   buffer: [ consumed | current partial line | free space ]
+ *           0         pos                    end        capacity
+ *
+ * line_reader_next() searches [scan, end) for '\n'. If there is none,
+ * the partial line is moved to the front (the only copy, and only for
+ * a line crossing a refill boundary), the buffer grows if the line
+ * already fills it, and one read() appends more data.
+ */
+
+#include "line_reader.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_POSIX_IO 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static bool reader_init(LineReader *reader, size_t capacity) {
+    reader->buffer = malloc(capacity + 1);
+    if (reader->buffer == NULL) {
+        return false;
+    }
+    reader->capacity = capacity;
+    reader->pos = 0;
+    reader->end = 0;
+    reader->scan = 0;
+    reader->eof = false;
+    reader->error = 0;
+    reader->refills = 0;
+    reader->bytes_copied = 0;
+    reader->lines = 0;
+    return true;
+}
+
+bool line_reader_open(LineReader *reader, const char *path) {
+    reader->buffer = NULL;
+    reader->owns_source = true;
+    reader->file = NULL;
+    reader->fd = -1;
+#ifdef HAVE_POSIX_IO
+    reader->fd = open(path, O_RDONLY);
+    if (reader->fd < 0) {
+        return false;
+    }
+#else
+    reader->file = fopen(path, "rb");
+    if (reader->file == NULL) {
+        return false;
+    }
+#endif
+    if (!reader_init(reader, LINE_READER_DEFAULT_CAPACITY)) {
+        line_reader_close(reader);
+        errno = ENOMEM;
+        return false;
+    }
+    return true;
+}
+
+bool line_reader_attach(LineReader *reader, FILE *file) {
+    reader->owns_source = false;
+    reader->file = file;
+#ifdef HAVE_POSIX_IO
+    reader->fd = fileno(file);
+#else
+    reader->fd = -1;
+#endif
+    if (!reader_init(reader, LINE_READER_DEFAULT_CAPACITY)) {
+        errno = ENOMEM;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Append up to the free space from the source
+ * Returns: bytes read, 0 at end of file, -1 on error
+ */
+static long read_source(LineReader *reader) {
+    char *dest = reader->buffer + reader->end;
+    size_t space = reader->capacity - reader->end;
+#ifdef HAVE_POSIX_IO
+    for (;;) {
+        ssize_t got = read(reader->fd, dest, space);
+        if (got >= 0) {
+            return (long)got;
+        }
+        if (errno != EINTR) {
+            reader->error = errno;
+            return -1;
+        }
+    }
+#else
+    size_t got = fread(dest, 1, space, reader->file);
+    if (got == 0 && ferror(reader->file)) {
+        reader->error = errno != 0 ? errno : EIO;
+        return -1;
+    }
+    return (long)got;
+#endif
+}
+
+/**
+ * Make room after a partial line: slide it to the front, or grow
+ */
+static bool make_room(LineReader *reader) {
+    size_t partial = reader->end - reader->pos;
+    if (reader->pos > 0) {
+        if (partial > 0) {
+            memmove(reader->buffer, reader->buffer + reader->pos, partial);
+            reader->bytes_copied += partial;
+        }
+        reader->scan -= reader->pos;
+        reader->end = partial;
+        reader->pos = 0;
+    }
+    if (reader->end == reader->capacity) {
+        // One line fills the whole buffer: double it
+        if (reader->capacity > (SIZE_MAX - 1) / 2) {
+            reader->error = ENOMEM;
+            return false;
+        }
+        char *grown = realloc(reader->buffer, reader->capacity * 2 + 1);
+        if (grown == NULL) {
+            reader->error = ENOMEM;
+            return false;
+        }
+        reader->buffer = grown;
+        reader->capacity *= 2;
+    }
+    return true;
+}
+
+bool line_reader_next(LineReader *reader, StringView *line) {
+    if (reader->buffer == NULL) {
+        return false;
+    }
+    for (;;) {
+        char *start = reader->buffer + reader->pos;
+        char *newline = memchr(reader->buffer + reader->scan, '\n', reader->end - reader->scan);
+
+        if (newline != NULL || (reader->eof && reader->end > reader->pos)) {
+            size_t length = newline != NULL ? (size_t)(newline - start) : reader->end - reader->pos;
+            reader->pos = newline != NULL ? reader->pos + length + 1 : reader->end;
+            reader->scan = reader->pos;
+            if (length > 0 && start[length - 1] == '\r') {
+                length--;                   // Windows line ending
+            }
+            start[length] = '\0';           // Newline, '\r' or the spare byte
+            line->data = start;
+            line->length = length;
+            reader->lines++;
+            return true;
+        }
+        if (reader->eof || reader->error != 0) {
+            return false;
+        }
+
+        // No newline in the buffered data: everything up to end is scanned
+        reader->scan = reader->end;
+        if (!make_room(reader)) {
+            return false;
+        }
+        long got = read_source(reader);
+        if (got < 0) {
+            return false;
+        }
+        if (got == 0) {
+            reader->eof = true;
+        } else {
+            reader->end += (size_t)got;
+            reader->refills++;
+        }
+    }
+}
+
+void line_reader_close(LineReader *reader) {
+    if (reader->owns_source) {
+#ifdef HAVE_POSIX_IO
+        if (reader->fd >= 0) {
+            close(reader->fd);
+        }
+#else
+        if (reader->file != NULL) {
+            fclose(reader->file);
+        }
+#endif
+    }
+    reader->fd = -1;
+    reader->file = NULL;
+    free(reader->buffer);
+    reader->buffer = NULL;
+}
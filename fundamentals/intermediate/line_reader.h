@@ -0,0 +1,98 @@
+/**
+ * line_reader.h - Buffered Zero-Copy Line Reader
+ *
+ * Replaces per-character fgetc()/fscanf() loops for large text files:
+ * - Refills a large buffer (256KB) with one read(2) call
+ * - Finds newlines with memchr() (SIMD in every mainstream libc)
+ * - Returns each line as a StringView pointing INTO the buffer
+ *
+ * Memory Implications:
+ * - No allocation per line; one buffer per reader
+ * - A line is only copied (moved to the buffer start) when it spans two
+ *   refills; lines longer than the buffer grow it by doubling
+ * - The '\n' is overwritten with '\0', so view.data is also a valid
+ *   C string (usable with strtol/strtod/sscanf directly)
+ *
+ * CPU Overhead:
+ * - fgetc:       one locked libc call per byte (~10-50 MB/s)
+ * - fgets:       one call per line, copies every byte (~0.5-1 GB/s)
+ * - line_reader: one syscall per 256KB, memchr scans 16-32 bytes/cycle
+ *                (several GB/s from the page cache)
+ *
+ * Lifetime rule: a StringView is valid only until the next
+ * line_reader_next() or line_reader_close() call. Copy what you keep.
+ *
+ * Usage:
+ *   LineReader reader;
+ *   StringView line;
+ *   if (line_reader_open(&reader, "big.log")) {
+ *       while (line_reader_next(&reader, &line)) {
+ *           process(line.data, line.length);
+ *       }
+ *       line_reader_close(&reader);
+ *   }
+ */
+
+#ifndef LINE_READER_H
+#define LINE_READER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LINE_READER_DEFAULT_CAPACITY (256 * 1024)
+
+/**
+ * Non-owning slice of text (not necessarily part of a larger C string)
+ */
+typedef struct {
+    const char *data;
+    size_t length;
+} StringView;
+
+typedef struct {
+    int fd;                 // Source on POSIX (read(2))
+    FILE *file;             // Source elsewhere (fread)
+    bool owns_source;       // Opened by line_reader_open()
+    char *buffer;           // capacity + 1 bytes (room for a final '\0')
+    size_t capacity;
+    size_t pos;             // Start of unread data
+    size_t end;             // End of valid data
+    size_t scan;            // Resume memchr here (bytes before it have no '\n')
+    bool eof;
+    int error;              // errno of a failed read, 0 if none
+    // Statistics
+    size_t refills;         // read() calls that returned data
+    size_t bytes_copied;    // Bytes moved because a line spanned a refill
+    size_t lines;
+} LineReader;
+
+/**
+ * Open a file for line reading
+ * Returns: false (with errno set) if the file cannot be opened
+ */
+bool line_reader_open(LineReader *reader, const char *path);
+
+/**
+ * Read lines from an already open stream (not closed by the reader).
+ * Reading starts at the stream's file offset, bypassing its FILE buffer:
+ * attach right after fopen() or rewind(), before any stdio reads.
+ */
+bool line_reader_attach(LineReader *reader, FILE *file);
+
+/**
+ * Next line without its '\n' (or "\r\n"), NUL-terminated in place.
+ * A final line without a newline is still returned.
+ * Returns: false at end of file or on a read error (see reader->error)
+ *
+ * Time Complexity: O(line length) amortized, no allocation
+ */
+bool line_reader_next(LineReader *reader, StringView *line);
+
+/**
+ * Release the buffer (and close the file if line_reader_open() opened it)
+ */
+void line_reader_close(LineReader *reader);
+
+#endif /* LINE_READER_H */
@@ -0,0 +1,220 @@
+/**
+ * math_tables.hpp - Compile-Time Lookup Tables (C++17 constexpr)
+ *
+ * The C++ counterpart of the tables in math_utils.c:
+ * - factorial_table<T>() / fibonacci_table<T>() build a std::array holding
+ *   EVERY value that fits in T, sized automatically from
+ *   std::numeric_limits<T> (13 entries for int, 21 for uint64_t, ...)
+ * - prime_bitmap<Limit>() runs a sieve of Eratosthenes inside the compiler
+ * - Lookups are plain array indexing: O(1), no loop at run time
+ *
+ * The same header verifies math_tables.inc: the static_asserts at the
+ * bottom compare the generated C tables entry by entry against the
+ * constexpr versions, so C and C++ callers can never disagree.
+ *
+ * Memory Implications:
+ * - Tables live in read-only data (.rodata); nothing is built at start-up
+ * - Each table is instantiated once per type that is actually used
+ *
+ * Usage:
+ *   constexpr auto fact = math_tables::factorial_table<std::uint64_t>();
+ *   static_assert(fact[20] == 2432902008176640000ULL);
+ */
+
+#ifndef MATH_TABLES_HPP
+#define MATH_TABLES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include "math_tables.inc"
+
+namespace math_tables {
+
+// ========================================
+// TABLE SIZES
+// ========================================
+
+/**
+ * Number of factorials 0!, 1!, ... that fit in T
+ */
+template <typename T>
+constexpr std::size_t factorial_count() {
+    T value = 1;                            // 0!
+    std::size_t n = 1;
+    while (value <= std::numeric_limits<T>::max() / static_cast<T>(n)) {
+        value *= static_cast<T>(n);         // n!
+        n++;
+    }
+    return n;
+}
+
+/**
+ * Number of Fibonacci numbers F(0), F(1), ... that fit in T
+ */
+template <typename T>
+constexpr std::size_t fibonacci_count() {
+    T prev = 0, curr = 1;
+    std::size_t count = 2;
+    while (prev <= std::numeric_limits<T>::max() - curr) {
+        T next = prev + curr;
+        prev = curr;
+        curr = next;
+        count++;
+    }
+    return count;
+}
+
+// ========================================
+// TABLE GENERATORS
+// ========================================
+
+template <typename T>
+constexpr std::array<T, factorial_count<T>()> factorial_table() {
+    std::array<T, factorial_count<T>()> table{};
+    table[0] = 1;
+    for (std::size_t n = 1; n < table.size(); n++) {
+        table[n] = table[n - 1] * static_cast<T>(n);
+    }
+    return table;
+}
+
+template <typename T>
+constexpr std::array<T, fibonacci_count<T>()> fibonacci_table() {
+    std::array<T, fibonacci_count<T>()> table{};
+    table[0] = 0;
+    table[1] = 1;
+    for (std::size_t n = 2; n < table.size(); n++) {
+        table[n] = table[n - 1] + table[n - 2];
+    }
+    return table;
+}
+
+/**
+ * Odd-only sieve: bit (i % 64) of word (i / 64) is set when 2*i + 1 is prime
+ */
+template <std::size_t Limit>
+constexpr std::array<std::uint64_t, Limit / 128> prime_bitmap() {
+    static_assert(Limit % 128 == 0, "limit must be a multiple of 128");
+    std::array<std::uint64_t, Limit / 128> bits{};
+    for (auto &word : bits) {
+        word = ~std::uint64_t{0};
+    }
+    bits[0] &= ~std::uint64_t{1};           // 1 is not prime
+    for (std::size_t p = 3; p * p < Limit; p += 2) {
+        if ((bits[p / 128] >> (p / 2 % 64)) & 1u) {
+            for (std::size_t m = p * p; m < Limit; m += 2 * p) {
+                bits[m / 128] &= ~(std::uint64_t{1} << (m / 2 % 64));
+            }
+        }
+    }
+    return bits;
+}
+
+/**
+ * One instance of each table per program (C++17 inline variables), so
+ * run-time lookups index .rodata instead of rebuilding an array
+ */
+template <typename T>
+inline constexpr auto factorial_values = factorial_table<T>();
+
+template <typename T>
+inline constexpr auto fibonacci_values = fibonacci_table<T>();
+
+template <std::size_t Limit>
+inline constexpr auto prime_bits = prime_bitmap<Limit>();
+
+// ========================================
+// LOOKUPS
+// ========================================
+
+/**
+ * n! if it fits in T, std::nullopt otherwise (negative n or overflow)
+ */
+template <typename T>
+constexpr std::optional<T> factorial_checked(int n) {
+    const auto &table = factorial_values<T>;
+    if (n < 0 || static_cast<std::size_t>(n) >= table.size()) {
+        return std::nullopt;
+    }
+    return table[static_cast<std::size_t>(n)];
+}
+
+template <typename T>
+constexpr std::optional<T> fibonacci_checked(int n) {
+    const auto &table = fibonacci_values<T>;
+    if (n < 0 || static_cast<std::size_t>(n) >= table.size()) {
+        return std::nullopt;
+    }
+    return table[static_cast<std::size_t>(n)];
+}
+
+/**
+ * F(n) modulo 2^64 in O(log n) (same algorithm as math_utils.c)
+ */
+constexpr std::uint64_t fibonacci_fast_doubling(std::uint64_t n) {
+    std::uint64_t a = 0, b = 1;
+    for (int bit = 63; bit >= 0; bit--) {
+        std::uint64_t c = a * (2 * b - a);
+        std::uint64_t d = a * a + b * b;
+        if ((n >> bit) & 1u) {
+            a = d;
+            b = c + d;
+        } else {
+            a = c;
+            b = d;
+        }
+    }
+    return a;
+}
+
+template <std::size_t Limit = MATH_PRIME_TABLE_LIMIT>
+constexpr bool is_prime_below(std::size_t n) {
+    const auto &bits = prime_bits<Limit>;
+    if (n < 3 || n % 2 == 0) {
+        return n == 2;
+    }
+    return (bits[n / 128] >> (n / 2 % 64)) & 1u;
+}
+
+// ========================================
+// GENERATED C TABLES == CONSTEXPR TABLES
+// ========================================
+
+namespace detail {
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool same_entries(const std::array<T, N> &expected, const T (&actual)[M]) {
+    if (N != M) {
+        return false;
+    }
+    for (std::size_t i = 0; i < N; i++) {
+        if (expected[i] != actual[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr std::uint64_t c_factorial_u64[] = { MATH_FACTORIAL_U64_TABLE };
+constexpr std::uint64_t c_fibonacci_u64[] = { MATH_FIBONACCI_U64_TABLE };
+constexpr std::uint64_t c_prime_bitmap[] = { MATH_PRIME_BITMAP_TABLE };
+
+}  // namespace detail
+
+static_assert(factorial_count<int>() == 13 && factorial_count<std::uint64_t>() == 21);
+static_assert(fibonacci_count<int>() == 47 && fibonacci_count<std::uint64_t>() == 94);
+static_assert(detail::same_entries(factorial_table<std::uint64_t>(), detail::c_factorial_u64),
+              "math_tables.inc: factorial table is wrong");
+static_assert(detail::same_entries(fibonacci_table<std::uint64_t>(), detail::c_fibonacci_u64),
+              "math_tables.inc: fibonacci table is wrong");
+static_assert(detail::same_entries(prime_bitmap<MATH_PRIME_TABLE_LIMIT>(), detail::c_prime_bitmap),
+              "math_tables.inc: prime bitmap is wrong");
+static_assert(fibonacci_fast_doubling(93) == fibonacci_table<std::uint64_t>()[93]);
+
+}  // namespace math_tables
+
+#endif  // MATH_TABLES_HPP
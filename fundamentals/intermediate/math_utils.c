@@ -9,7 +9,10 @@
  */
 
 #include "math_utils.h"
+#include "math_tables.inc"
 #include <math.h>
+#include <limits.h>
+#include <stddef.h>
 
 // ========================================
 // BASIC ARITHMETIC
@@ -57,18 +60,70 @@ double cube(double x) {
     return x * x * x;
 }
 
+// ========================================
+// LOOKUP TABLES
+// ========================================
+
+/*
+ * Generated tables (math_tables.inc), checked against constexpr
+ * recomputation in math_tables.hpp. The asserts below catch a table
+ * that was regenerated with the wrong length or a corrupted boundary.
+ */
+static const uint64_t factorial_table[] = { MATH_FACTORIAL_U64_TABLE };
+static const uint64_t fibonacci_table[] = { MATH_FIBONACCI_U64_TABLE };
+static const uint64_t prime_bitmap[] = { MATH_PRIME_BITMAP_TABLE };
+
+#define TABLE_LENGTH(table) (sizeof(table) / sizeof((table)[0]))
+
+_Static_assert(TABLE_LENGTH(factorial_table) == FACTORIAL_MAX_U64 + 1,
+               "factorial table must cover every n! that fits in uint64_t");
+_Static_assert(TABLE_LENGTH(fibonacci_table) == FIBONACCI_MAX_U64 + 1,
+               "fibonacci table must cover every F(n) that fits in uint64_t");
+_Static_assert(TABLE_LENGTH(prime_bitmap) * 128 == MATH_PRIME_TABLE_LIMIT,
+               "prime bitmap holds one bit per odd number below the limit");
+_Static_assert(FACTORIAL_MAX_INT <= FACTORIAL_MAX_U64 &&
+               FIBONACCI_MAX_INT <= FIBONACCI_MAX_U64,
+               "int results are served from the 64-bit tables");
+_Static_assert((uint64_t)MATH_PRIME_TABLE_LIMIT * MATH_PRIME_TABLE_LIMIT > (uint64_t)INT_MAX,
+               "tabulated primes must reach sqrt(INT_MAX) for trial division");
+
+/**
+ * Index of the lowest set bit (word != 0)
+ */
+static inline int lowest_bit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while ((word & 1u) == 0) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
 // ========================================
 // PRIME NUMBER OPERATIONS
 // ========================================
 
 bool is_prime(int n) {
-    if (n <= 1) return false;
-    if (n <= 3) return true;
-    if (n % 2 == 0 || n % 3 == 0) return false;
-    
-    for (int i = 5; i * i <= n; i += 6) {
-        if (n % i == 0 || n % (i + 2) == 0) {
-            return false;
+    if (n < 3) return n == 2;
+    if (n % 2 == 0) return false;
+
+    if (n < MATH_PRIME_TABLE_LIMIT) {
+        int i = n / 2;                      // Bit i represents 2*i + 1
+        return (prime_bitmap[i / 64] >> (i % 64)) & 1u;
+    }
+
+    // Trial division by odd primes only, walking the set bits of the table
+    for (size_t w = 0; w < TABLE_LENGTH(prime_bitmap); w++) {
+        uint64_t bits = prime_bitmap[w];
+        while (bits != 0) {
+            int p = (int)(w * 128) + 2 * lowest_bit(bits) + 1;
+            if (p > n / p) return true;     // p*p > n without overflow
+            if (n % p == 0) return false;
+            bits &= bits - 1;               // Clear lowest set bit
         }
     }
     return true;
@@ -76,12 +131,31 @@ bool is_prime(int n) {
 
 int next_prime(int n) {
     if (n < 2) return 2;
-    
-    int candidate = n + 1;
-    while (!is_prime(candidate)) {
-        candidate++;
+
+    long long candidate = (long long)n + 1;
+    candidate |= 1;                         // 2 is the only even prime
+
+    if (candidate < MATH_PRIME_TABLE_LIMIT) {
+        // Mask off the bits below the candidate, then scan whole words
+        size_t i = (size_t)candidate / 2;
+        size_t w = i / 64;
+        uint64_t bits = prime_bitmap[w] & (~UINT64_C(0) << (i % 64));
+        for (;;) {
+            if (bits != 0) {
+                return (int)(w * 128) + 2 * lowest_bit(bits) + 1;
+            }
+            if (++w == TABLE_LENGTH(prime_bitmap)) break;
+            bits = prime_bitmap[w];
+        }
+        candidate = MATH_PRIME_TABLE_LIMIT + 1;
     }
-    return candidate;
+
+    for (; candidate <= INT_MAX; candidate += 2) {
+        if (is_prime((int)candidate)) {
+            return (int)candidate;
+        }
+    }
+    return 0;                               // No larger prime fits in int
 }
 
 // ========================================
@@ -89,27 +163,43 @@ int next_prime(int n) {
 // ========================================
 
 int factorial(int n) {
-    if (n < 0) return 0;  // Undefined for negative
-    if (n == 0 || n == 1) return 1;
-    
-    int result = 1;
-    for (int i = 2; i <= n; i++) {
-        result *= i;
-    }
-    return result;
+    if (n < 0 || n > FACTORIAL_MAX_INT) return 0;  // Undefined / overflow
+    return (int)factorial_table[n];
 }
 
 int fibonacci(int n) {
-    if (n <= 0) return 0;
-    if (n == 1) return 1;
-    
-    int prev = 0, curr = 1;
-    for (int i = 2; i <= n; i++) {
-        int next = prev + curr;
-        prev = curr;
-        curr = next;
+    if (n < 0 || n > FIBONACCI_MAX_INT) return 0;
+    return (int)fibonacci_table[n];
+}
+
+bool factorial_checked(int n, uint64_t *out) {
+    if (n < 0 || n > FACTORIAL_MAX_U64) return false;
+    *out = factorial_table[n];
+    return true;
+}
+
+bool fibonacci_checked(int n, uint64_t *out) {
+    if (n < 0 || n > FIBONACCI_MAX_U64) return false;
+    *out = fibonacci_table[n];
+    return true;
+}
+
+uint64_t fibonacci_fast_doubling(uint64_t n) {
+    uint64_t a = 0, b = 1;                  // F(k), F(k+1) with k = 0
+
+    // Walk the bits of n from the top: k -> 2k, then 2k+1 if the bit is set
+    for (int bit = 63; bit >= 0; bit--) {
+        uint64_t c = a * (2 * b - a);       // F(2k)   (mod 2^64)
+        uint64_t d = a * a + b * b;         // F(2k+1)
+        if ((n >> bit) & 1u) {
+            a = d;
+            b = c + d;
+        } else {
+            a = c;
+            b = d;
+        }
     }
-    return curr;
+    return a;
 }
 
 // ========================================
@@ -134,22 +224,84 @@ double distance_between_points(Point p1, Point p2) {
 // UTILITY FUNCTIONS
 // ========================================
 
+/**
+ * |n| as unsigned: defined even for INT_MIN (where -n overflows)
+ */
+static inline uint64_t magnitude(int n) {
+    return n < 0 ? (uint64_t)0 - (uint64_t)n : (uint64_t)n;
+}
+
+uint64_t gcd64(uint64_t a, uint64_t b) {
+    // Binary GCD: gcd(2^k * a', 2^k * b') = 2^k * gcd(a', b'), and for
+    // odd a, b: gcd(a, b) = gcd(a, b - a). No division anywhere.
+    if (a == 0) return b;
+    if (b == 0) return a;
+
+    int shift = lowest_bit(a | b);          // Common factors of 2
+    a >>= lowest_bit(a);
+    do {
+        b >>= lowest_bit(b);                // b odd
+        if (a > b) {
+            uint64_t temp = a;              // Compiles to cmov, not a branch
+            a = b;
+            b = temp;
+        }
+        b -= a;                             // Even (odd - odd)
+    } while (b != 0);
+    return a << shift;
+}
+
 int gcd(int a, int b) {
-    // Euclidean algorithm
-    a = ABS(a);
-    b = ABS(b);
-    
-    while (b != 0) {
-        int temp = b;
-        b = a % b;
-        a = temp;
-    }
-    return a;
+    uint64_t g = gcd64(magnitude(a), magnitude(b));
+    return g <= INT_MAX ? (int)g : 0;       // Only 2^31 does not fit
 }
 
 int lcm(int a, int b) {
     if (a == 0 || b == 0) return 0;
-    return ABS(a * b) / gcd(a, b);
+    uint64_t ua = magnitude(a);
+    uint64_t ub = magnitude(b);
+    uint64_t l = ua / gcd64(ua, ub) * ub;   // < 2^62: cannot overflow
+    return l <= INT_MAX ? (int)l : 0;
+}
+
+bool lcm64_checked(uint64_t a, uint64_t b, uint64_t *out) {
+    if (a == 0 || b == 0) {
+        *out = 0;
+        return true;
+    }
+    uint64_t reduced = a / gcd64(a, b);
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;    // GCC/Clang extension
+    uint128 l = (uint128)reduced * b;
+    if (l > UINT64_MAX) return false;
+    *out = (uint64_t)l;
+#else
+    if (reduced > UINT64_MAX / b) return false;
+    *out = reduced * b;
+#endif
+    return true;
+}
+
+uint64_t lcm64(uint64_t a, uint64_t b) {
+    uint64_t l;
+    return lcm64_checked(a, b, &l) ? l : 0;
+}
+
+int gcd_many(const int* values, size_t count) {
+    uint64_t g = 0;                         // gcd(0, x) = x
+    for (size_t i = 0; i < count; i++) {
+        g = gcd64(g, magnitude(values[i]));
+        if (g == 1) {
+            break;                          // Nothing can lower it further
+        }
+    }
+    return g <= INT_MAX ? (int)g : 0;
+}
+
+void gcd_pairs(const int* a, const int* b, int* out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = gcd(a[i], b[i]);
+    }
 }
 
 void swap_int(int* a, int* b) {
@@ -17,6 +17,8 @@
 
 // Standard library includes
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 // ========================================
 // CONSTANTS
@@ -25,6 +27,12 @@
 #define PI 3.14159265359
 #define E 2.71828182846
 
+// Largest n whose result fits the return type (see math_tables.inc)
+#define FACTORIAL_MAX_INT 12        // 13! > INT_MAX
+#define FACTORIAL_MAX_U64 20        // 21! > UINT64_MAX
+#define FIBONACCI_MAX_INT 46        // F(47) > INT_MAX
+#define FIBONACCI_MAX_U64 93        // F(94) > UINT64_MAX
+
 // ========================================
 // MACROS
 // ========================================
@@ -70,16 +78,40 @@ double cube(double x);
 
 /**
  * Prime number operations
+ * Below 65536: one bit test in a precomputed 4KB bitmap.
+ * Above: trial division by the tabulated primes only (not every 6k±1).
+ * next_prime() returns 0 when no larger prime fits in int.
  */
 bool is_prime(int n);
 int next_prime(int n);
 
 /**
- * Factorial and Fibonacci
+ * Factorial and Fibonacci (table lookup, O(1))
+ * Return 0 for negative n and when the result does not fit in int
+ * (n > FACTORIAL_MAX_INT / FIBONACCI_MAX_INT); use the checked
+ * variants below to tell overflow apart from a real result.
  */
 int factorial(int n);
 int fibonacci(int n);
 
+/**
+ * Overflow-checked 64-bit variants
+ * Returns: false (and leaves *out untouched) if n < 0 or the result
+ * does not fit in uint64_t
+ */
+bool factorial_checked(int n, uint64_t *out);
+bool fibonacci_checked(int n, uint64_t *out);
+
+/**
+ * F(n) modulo 2^64 by fast doubling:
+ *   F(2k)   = F(k) * (2*F(k+1) - F(k))
+ *   F(2k+1) = F(k)^2 + F(k+1)^2
+ * Exact for n <= FIBONACCI_MAX_U64, wraps (well defined) above that.
+ *
+ * Time Complexity: O(log n), no table
+ */
+uint64_t fibonacci_fast_doubling(uint64_t n);
+
 /**
  * Geometric calculations
  */
@@ -94,6 +126,36 @@ int gcd(int a, int b);  // Greatest common divisor
 int lcm(int a, int b);  // Least common multiple
 void swap_int(int* a, int* b);
 
+/**
+ * GCD / LCM details
+ * - gcd() uses binary (Stein's) GCD: shifts and subtractions driven by
+ *   count-trailing-zeros, no division. Results are always >= 0;
+ *   gcd(INT_MIN, 0) and gcd(INT_MIN, INT_MIN) (= 2^31) return 0.
+ * - lcm() divides BEFORE multiplying, in 64 bits: returns 0 when the
+ *   result does not fit in int (instead of overflowing)
+ */
+uint64_t gcd64(uint64_t a, uint64_t b);
+
+/**
+ * 64-bit lcm: a / gcd(a, b) * b with a 128-bit intermediate
+ * Returns: false (and leaves *out untouched) if the lcm exceeds 2^64 - 1
+ */
+bool lcm64_checked(uint64_t a, uint64_t b, uint64_t *out);
+uint64_t lcm64(uint64_t a, uint64_t b);  // 0 on overflow
+
+/**
+ * gcd of a whole array; stops as soon as the running gcd reaches 1
+ * Returns: 0 for an empty (or all-zero) array
+ *
+ * Time Complexity: O(n log max) worst case, often far less (early exit)
+ */
+int gcd_many(const int* values, size_t count);
+
+/**
+ * Element-wise: out[i] = gcd(a[i], b[i]) (e.g. to reduce fractions)
+ */
+void gcd_pairs(const int* a, const int* b, int* out, size_t count);
+
 // ========================================
 // INLINE FUNCTIONS (C99+)
 // ========================================
@@ -0,0 +1,282 @@
+/**
+ * matrix.c - Contiguous Matrix Implementation
+ */
+
+#include "matrix.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_PTHREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define STRIDE_MULTIPLE (MATRIX_ALIGNMENT / sizeof(double))    // 8 doubles
+#define TRANSPOSE_TILE 32               // 32 x 32 doubles = 8KB per side
+#define BLOCK_K 128                     // Rows of b per block
+#define BLOCK_J 256                     // Columns of b / c per block (b block: 256KB)
+#define ROWS_PER_PASS 4                 // Rows of c updated together (register blocking)
+#define PARALLEL_MIN_FLOPS (1u << 22)   // Below this, threads cost more than they save
+
+/* ============================================================================
+ * Allocation and views
+ * ============================================================================
+ */
+
+static void* aligned_block(size_t bytes) {
+#ifdef _WIN32
+    return _aligned_malloc(bytes, MATRIX_ALIGNMENT);
+#else
+    return aligned_alloc(MATRIX_ALIGNMENT, bytes);      // bytes is a multiple of 64
+#endif
+}
+
+static void aligned_block_free(void *block) {
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+
+bool matrix_create(Matrix *m, size_t rows, size_t cols) {
+    memset(m, 0, sizeof(*m));
+    size_t stride = (cols + STRIDE_MULTIPLE - 1) / STRIDE_MULTIPLE * STRIDE_MULTIPLE;
+    if (stride < cols || (stride != 0 && rows > SIZE_MAX / sizeof(double) / stride)) {
+        return false;
+    }
+    size_t bytes = rows * stride * sizeof(double);
+    if (bytes == 0) bytes = MATRIX_ALIGNMENT;           // Keep data non-NULL for empty shapes
+
+    void *block = aligned_block(bytes);
+    if (block == NULL) return false;
+    memset(block, 0, bytes);
+
+    m->data = block;
+    m->rows = rows;
+    m->cols = cols;
+    m->stride = stride;
+    m->allocation = block;
+    return true;
+}
+
+void matrix_free(Matrix *m) {
+    if (m->allocation != NULL) {
+        aligned_block_free(m->allocation);
+    }
+    memset(m, 0, sizeof(*m));
+}
+
+bool matrix_view(const Matrix *m, size_t row, size_t col, size_t rows, size_t cols, Matrix *view) {
+    if (row > m->rows || rows > m->rows - row || col > m->cols || cols > m->cols - col) {
+        return false;
+    }
+    view->data = matrix_at(m, row, col);
+    view->rows = rows;
+    view->cols = cols;
+    view->stride = m->stride;
+    view->allocation = NULL;
+    return true;
+}
+
+void matrix_copy(const Matrix *src, const Matrix *dst) {
+    for (size_t i = 0; i < src->rows; i++) {
+        memcpy(matrix_row(dst, i), matrix_row(src, i), src->cols * sizeof(double));
+    }
+}
+
+void matrix_fill(const Matrix *m, double value) {
+    for (size_t i = 0; i < m->rows; i++) {
+        double *row = matrix_row(m, i);
+        for (size_t j = 0; j < m->cols; j++) {
+            row[j] = value;
+        }
+    }
+}
+
+/* ============================================================================
+ * Transpose
+ * ============================================================================
+ */
+
+/**
+ * A plain dst[j][i] = src[i][j] loop writes one element per row of dst:
+ * for wide matrices each write touches a new cache line (and page). In
+ * 32 x 32 tiles both the source rows and the destination rows of one
+ * tile fit in L1 at the same time.
+ */
+bool matrix_transpose(const Matrix *src, const Matrix *dst) {
+    if (dst->rows != src->cols || dst->cols != src->rows) return false;
+
+    for (size_t ib = 0; ib < src->rows; ib += TRANSPOSE_TILE) {
+        size_t i_end = ib + TRANSPOSE_TILE < src->rows ? ib + TRANSPOSE_TILE : src->rows;
+        for (size_t jb = 0; jb < src->cols; jb += TRANSPOSE_TILE) {
+            size_t j_end = jb + TRANSPOSE_TILE < src->cols ? jb + TRANSPOSE_TILE : src->cols;
+            for (size_t i = ib; i < i_end; i++) {
+                const double *in = matrix_row(src, i);
+                for (size_t j = jb; j < j_end; j++) {
+                    *matrix_at(dst, j, i) = in[j];
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* ============================================================================
+ * Multiply
+ * ============================================================================
+ */
+
+/**
+ * c[i][j0..j1) += a[i][k0..k1) * b[k0..k1)[j0..j1) for ROWS_PER_PASS rows
+ * at once: each b row loaded from cache feeds four rows of c.
+ * 'restrict' promises the rows do not overlap so the j loop vectorizes.
+ */
+static void multiply_4_rows(double *restrict c0, double *restrict c1,
+                            double *restrict c2, double *restrict c3,
+                            const double *a0, const double *a1,
+                            const double *a2, const double *a3,
+                            const Matrix *b, size_t k0, size_t k1, size_t j0, size_t j1) {
+    for (size_t k = k0; k < k1; k++) {
+        const double *restrict b_row = matrix_row(b, k);
+        double x0 = a0[k], x1 = a1[k], x2 = a2[k], x3 = a3[k];
+        for (size_t j = j0; j < j1; j++) {
+            double bj = b_row[j];
+            c0[j] += x0 * bj;
+            c1[j] += x1 * bj;
+            c2[j] += x2 * bj;
+            c3[j] += x3 * bj;
+        }
+    }
+}
+
+static void multiply_1_row(double *restrict c0, const double *a0,
+                           const Matrix *b, size_t k0, size_t k1, size_t j0, size_t j1) {
+    for (size_t k = k0; k < k1; k++) {
+        const double *restrict b_row = matrix_row(b, k);
+        double x0 = a0[k];
+        for (size_t j = j0; j < j1; j++) {
+            c0[j] += x0 * b_row[j];
+        }
+    }
+}
+
+/**
+ * Rows [row_begin, row_end) of c = a * b, blocked so one BLOCK_K x BLOCK_J
+ * block of b stays in L2 while every row of c in the range uses it
+ */
+static void multiply_rows(const Matrix *a, const Matrix *b, const Matrix *c,
+                          size_t row_begin, size_t row_end) {
+    for (size_t i = row_begin; i < row_end; i++) {
+        memset(matrix_row(c, i), 0, c->cols * sizeof(double));
+    }
+
+    for (size_t k0 = 0; k0 < a->cols; k0 += BLOCK_K) {
+        size_t k1 = k0 + BLOCK_K < a->cols ? k0 + BLOCK_K : a->cols;
+        for (size_t j0 = 0; j0 < b->cols; j0 += BLOCK_J) {
+            size_t j1 = j0 + BLOCK_J < b->cols ? j0 + BLOCK_J : b->cols;
+            size_t i = row_begin;
+            for (; i + ROWS_PER_PASS <= row_end; i += ROWS_PER_PASS) {
+                multiply_4_rows(matrix_row(c, i), matrix_row(c, i + 1),
+                                matrix_row(c, i + 2), matrix_row(c, i + 3),
+                                matrix_row(a, i), matrix_row(a, i + 1),
+                                matrix_row(a, i + 2), matrix_row(a, i + 3),
+                                b, k0, k1, j0, j1);
+            }
+            for (; i < row_end; i++) {
+                multiply_1_row(matrix_row(c, i), matrix_row(a, i), b, k0, k1, j0, j1);
+            }
+        }
+    }
+}
+
+typedef struct {
+    const Matrix *a, *b, *c;
+    size_t row_begin, row_end;
+} MultiplyTask;
+
+#ifdef HAVE_PTHREADS
+static void* multiply_worker(void *arg) {
+    MultiplyTask *task = arg;
+    multiply_rows(task->a, task->b, task->c, task->row_begin, task->row_end);
+    return NULL;
+}
+#endif
+
+static int resolve_threads(int threads, const Matrix *a, const Matrix *b) {
+#ifdef HAVE_PTHREADS
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > MATRIX_MAX_THREADS) {
+        threads = MATRIX_MAX_THREADS;
+    }
+    // At least one ROWS_PER_PASS group per thread, and enough work overall
+    size_t max_useful = a->rows / ROWS_PER_PASS;
+    double flops = (double)a->rows * (double)a->cols * (double)b->cols;
+    if (flops < PARALLEL_MIN_FLOPS || max_useful < 1) {
+        max_useful = 1;
+    }
+    if ((size_t)threads > max_useful) {
+        threads = (int)max_useful;
+    }
+    return threads;
+#else
+    (void)threads;
+    (void)a;
+    (void)b;
+    return 1;
+#endif
+}
+
+bool matrix_multiply(const Matrix *a, const Matrix *b, const Matrix *c, int threads) {
+    if (a->cols != b->rows || c->rows != a->rows || c->cols != b->cols) return false;
+
+    threads = resolve_threads(threads, a, b);
+    MultiplyTask tasks[MATRIX_MAX_THREADS];
+    size_t groups = (a->rows + ROWS_PER_PASS - 1) / ROWS_PER_PASS;
+    for (int t = 0; t < threads; t++) {
+        // Split on ROWS_PER_PASS boundaries so every thread gets full groups
+        size_t begin = groups * (size_t)t / (size_t)threads * ROWS_PER_PASS;
+        size_t end = groups * (size_t)(t + 1) / (size_t)threads * ROWS_PER_PASS;
+        tasks[t] = (MultiplyTask){ a, b, c, begin, end < a->rows ? end : a->rows };
+    }
+
+#ifdef HAVE_PTHREADS
+    pthread_t handles[MATRIX_MAX_THREADS];
+    bool started[MATRIX_MAX_THREADS] = { false };
+    for (int t = 1; t < threads; t++) {
+        started[t] = pthread_create(&handles[t], NULL, multiply_worker, &tasks[t]) == 0;
+    }
+    multiply_rows(a, b, c, tasks[0].row_begin, tasks[0].row_end);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(handles[t], NULL);
+        } else {
+            multiply_rows(a, b, c, tasks[t].row_begin, tasks[t].row_end);   // Could not start: run here
+        }
+    }
+#else
+    multiply_rows(a, b, c, tasks[0].row_begin, tasks[0].row_end);
+#endif
+    return true;
+}
+
+bool matrix_multiply_naive(const Matrix *a, const Matrix *b, const Matrix *c) {
+    if (a->cols != b->rows || c->rows != a->rows || c->cols != b->cols) return false;
+
+    for (size_t i = 0; i < a->rows; i++) {
+        for (size_t j = 0; j < b->cols; j++) {
+            double sum = 0.0;
+            for (size_t k = 0; k < a->cols; k++) {
+                sum += *matrix_at(a, i, k) * *matrix_at(b, k, j);   // Column walk on b
+            }
+            *matrix_at(c, i, j) = sum;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,344 @@
+/**
+ * output_writer.c - Implementation of the Buffered Output Writer
+ *
+ * Buffer states (length <= capacity):
+ *
+ *   buffer: [ formatted, not yet written | free space ]
+ *           0                           length      capacity
+ *
+ * Every output_write_*() call makes sure the value fits in the free space
+ * (flushing first if not) and formats in place, so nothing is formatted
+ * twice or into a temporary. A flush is one write(2) of [0, length), or
+ * one fwrite() into the stream's own buffer when it is short.
+ */
+
+#include "output_writer.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_POSIX_IO 1
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+/**
+ * "00" "01" ... "99": two digits per table lookup halves the divisions
+ */
+static const char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static void writer_init(OutputWriter *out, FILE *file, char *buffer, size_t capacity) {
+    out->file = file;
+#ifdef HAVE_POSIX_IO
+    out->fd = fileno(file);
+#else
+    out->fd = -1;
+#endif
+    out->buffer = buffer;
+    out->capacity = capacity;
+    out->length = 0;
+    out->error = 0;
+    out->flushes = 0;
+    out->bytes_written = 0;
+}
+
+bool output_writer_attach(OutputWriter *out, FILE *file, size_t capacity) {
+    if (capacity == 0) {
+        capacity = OUTPUT_WRITER_DEFAULT_CAPACITY;
+    }
+    if (capacity <= OUTPUT_INT_MAX_CHARS) {
+        capacity = OUTPUT_INT_MAX_CHARS + 1;
+    }
+    char *buffer = malloc(capacity);
+    if (buffer == NULL) {
+        errno = ENOMEM;
+        return false;
+    }
+    writer_init(out, file, buffer, capacity);
+    out->owns_buffer = true;
+    return true;
+}
+
+void output_writer_attach_buffer(OutputWriter *out, FILE *file, char *buffer, size_t capacity) {
+    writer_init(out, file, buffer, capacity);
+    out->owns_buffer = false;
+}
+
+OutputWriter* output_stdout(void) {
+    static char stdout_buffer[OUTPUT_WRITER_DEFAULT_CAPACITY];
+    static OutputWriter writer;
+    static bool attached = false;
+    if (!attached) {
+        output_writer_attach_buffer(&writer, stdout, stdout_buffer, sizeof(stdout_buffer));
+        attached = true;
+    }
+    return &writer;
+}
+
+#ifdef HAVE_POSIX_IO
+/**
+ * writev() until every byte of both blocks is out (write(2) may stop
+ * early on pipes, terminals and signals)
+ */
+static bool write_fully(OutputWriter *out, const char *first, size_t first_length,
+                        const char *second, size_t second_length) {
+    struct iovec parts[2] = {
+        { (void*)first, first_length },
+        { (void*)second, second_length },
+    };
+    struct iovec *part = parts;
+    int count = second_length > 0 ? 2 : 1;
+    while (count > 0) {
+        ssize_t n = writev(out->fd, part, count);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            out->error = errno;
+            return false;
+        }
+        out->flushes++;
+        out->bytes_written += (size_t)n;
+        size_t done = (size_t)n;
+        while (count > 0 && done >= part->iov_len) {
+            done -= part->iov_len;
+            part++;
+            count--;
+        }
+        if (count > 0) {
+            part->iov_base = (char*)part->iov_base + done;
+            part->iov_len -= done;
+        }
+    }
+    return true;
+}
+#endif
+
+/**
+ * Send the buffer followed by an optional uncopied block
+ */
+static bool writer_send(OutputWriter *out, const char *extra, size_t extra_length) {
+    if (out->error != 0) {
+        return false;
+    }
+    if (out->length == 0 && extra_length == 0) {
+        return true;
+    }
+#ifdef HAVE_POSIX_IO
+    if (extra_length == 0 && out->length <= OUTPUT_WRITER_STDIO_LIMIT) {
+        bool ok = fwrite(out->buffer, 1, out->length, out->file) == out->length;
+        if (!ok) {
+            out->error = errno != 0 ? errno : EIO;
+        } else {
+            out->flushes++;
+            out->bytes_written += out->length;
+        }
+        out->length = 0;
+        return ok;
+    }
+    if (fflush(out->file) != 0) {
+        out->error = errno != 0 ? errno : EIO;
+        return false;
+    }
+    bool ok = write_fully(out, out->buffer, out->length, extra, extra_length);
+#else
+    bool ok = fwrite(out->buffer, 1, out->length, out->file) == out->length
+           && (extra_length == 0 || fwrite(extra, 1, extra_length, out->file) == extra_length);
+    if (!ok) {
+        out->error = errno != 0 ? errno : EIO;
+    } else {
+        out->flushes++;
+        out->bytes_written += out->length + extra_length;
+    }
+#endif
+    out->length = 0;
+    return ok;
+}
+
+bool output_writer_flush(OutputWriter *out) {
+    return writer_send(out, NULL, 0);
+}
+
+bool output_writer_close(OutputWriter *out) {
+    bool ok = output_writer_flush(out);
+    if (out->owns_buffer) {
+        free(out->buffer);
+    }
+    out->buffer = NULL;
+    out->capacity = 0;
+    return ok;
+}
+
+bool output_write(OutputWriter *out, const void *data, size_t length) {
+    if (length <= out->capacity - out->length) {
+        memcpy(out->buffer + out->length, data, length);
+        out->length += length;
+        return true;
+    }
+    if (length >= out->capacity / 2) {
+        return writer_send(out, (const char*)data, length);
+    }
+    if (!output_writer_flush(out)) {
+        return false;
+    }
+    memcpy(out->buffer, data, length);
+    out->length = length;
+    return true;
+}
+
+// ========================================
+// INTEGER FORMATTING
+// ========================================
+
+static inline void write_pair(char *dst, uint32_t value) {
+    memcpy(dst, &digit_pairs[value * 2], 2);
+}
+
+/**
+ * Exactly 4 / 8 digits with leading zeros. The two halves of an 8-digit
+ * block are split off first, so their divisions run in parallel instead
+ * of as one long dependent chain.
+ */
+static inline void write_fixed4(char *dst, uint32_t value) {
+    write_pair(dst, value / 100);
+    write_pair(dst + 2, value % 100);
+}
+
+static inline void write_fixed8(char *dst, uint32_t value) {
+    write_fixed4(dst, value / 10000);
+    write_fixed4(dst + 4, value % 10000);
+}
+
+/**
+ * 0 <= value < 10000, no leading zeros
+ */
+static inline size_t write_small(char *dst, uint32_t value) {
+    if (value < 10) {
+        dst[0] = (char)('0' + value);
+        return 1;
+    }
+    if (value < 100) {
+        write_pair(dst, value);
+        return 2;
+    }
+    if (value < 1000) {
+        dst[0] = (char)('0' + value / 100);
+        write_pair(dst + 1, value % 100);
+        return 3;
+    }
+    write_fixed4(dst, value);
+    return 4;
+}
+
+static inline size_t format_u32(char *dst, uint32_t value) {
+    if (value < 10000) {
+        return write_small(dst, value);
+    }
+    if (value < 100000000) {
+        size_t length = write_small(dst, value / 10000);
+        write_fixed4(dst + length, value % 10000);
+        return length + 4;
+    }
+    size_t length = write_small(dst, value / 100000000);     // 1..42
+    write_fixed8(dst + length, value % 100000000);
+    return length + 8;
+}
+
+size_t format_uint(char *dst, unsigned long long value) {
+    if (value <= UINT32_MAX) {
+        return format_u32(dst, (uint32_t)value);
+    }
+    // Low 8 digits as a block, the rest (at most 12 digits) recursively
+    size_t length = format_uint(dst, value / 100000000);
+    write_fixed8(dst + length, (uint32_t)(value % 100000000));
+    return length + 8;
+}
+
+size_t format_int(char *dst, long long value) {
+    if (value < 0) {
+        *dst = '-';
+        // Negate in unsigned arithmetic: -LLONG_MIN overflows long long
+        return 1 + format_uint(dst + 1, 0ull - (unsigned long long)value);
+    }
+    return format_uint(dst, (unsigned long long)value);
+}
+
+/**
+ * int fast path: the '-' is always stored and only counted when needed,
+ * so random signs cost no mispredicted branch
+ */
+static inline size_t format_i32(char *dst, int value) {
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    size_t sign = value < 0;
+    dst[0] = '-';
+    return sign + format_u32(dst + sign, magnitude);
+}
+
+/**
+ * Make room for 'length' more bytes in the buffer
+ */
+static inline bool reserve(OutputWriter *out, size_t length) {
+    return out->capacity - out->length >= length || output_writer_flush(out);
+}
+
+bool output_write_int(OutputWriter *out, long long value) {
+    if (!reserve(out, OUTPUT_INT_MAX_CHARS)) {
+        return false;
+    }
+    out->length += format_int(out->buffer + out->length, value);
+    return true;
+}
+
+bool output_write_uint(OutputWriter *out, unsigned long long value) {
+    if (!reserve(out, OUTPUT_INT_MAX_CHARS)) {
+        return false;
+    }
+    out->length += format_uint(out->buffer + out->length, value);
+    return true;
+}
+
+bool output_write_int_padded(OutputWriter *out, long long value, int width) {
+    char digits[OUTPUT_INT_MAX_CHARS];
+    size_t length = format_int(digits, value);
+    for (size_t pad = length; width > 0 && pad < (size_t)width; pad++) {
+        if (!output_write_char(out, ' ')) {
+            return false;
+        }
+    }
+    return output_write(out, digits, length);
+}
+
+bool write_int_array(OutputWriter *out, const int *values, size_t count, const char *separator) {
+    size_t separator_length = strlen(separator);
+    size_t per_value = OUTPUT_INT_MAX_CHARS + separator_length;
+    if (per_value > out->capacity) {
+        // Separator too long to format in place: take the general path
+        for (size_t i = 0; i < count; i++) {
+            if ((i > 0 && !output_write(out, separator, separator_length))
+                || !output_write_int(out, values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!reserve(out, per_value)) {
+            return false;
+        }
+        char *p = out->buffer + out->length;
+        if (i > 0) {
+            memcpy(p, separator, separator_length);
+            p += separator_length;
+        }
+        p += format_i32(p, values[i]);
+        out->length = (size_t)(p - out->buffer);
+    }
+    return true;
+}
@@ -8,6 +8,7 @@
  * - Macro functions
  * - Predefined macros
  * - Stringification and token pasting
+ * - Feature flags in practice: TRACE_SCOPE tracing macros (trace.h)
  * - Common pitfalls and best practices
  * 
  * The preprocessor runs BEFORE compilation, performing text substitution
@@ -16,6 +17,8 @@
 
 #include <stdio.h>
 
+#include "trace.h"    // benchmarks/trace.h: TRACE_* macros, ENABLE_TRACING
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -219,6 +222,26 @@ void demonstrate_conditional_compilation(void) {
 #endif
     printf("\n");
 
+    // The same switch applied to instrumentation: trace.h's macros expand
+    // to ((void)0) unless the build defines ENABLE_TRACING=1, so traced
+    // hot paths cost nothing in a normal build
+    printf("Tracing (cmake -DENABLE_TRACING=ON):\n");
+#if ENABLE_TRACING
+    printf("  ✓ Tracing: ENABLED (events written to trace.json at exit)\n");
+#else
+    printf("  ✗ Tracing: DISABLED\n");
+#endif
+    printf("  TRACE_SCOPE(\"demo\") expands to:\n    %s\n", TOSTRING(TRACE_SCOPE("demo")));
+    {
+        TRACE_SCOPE("preprocessor demo");   // Ends at the closing brace
+        long sum = 0;
+        for (int i = 1; i <= 1000; i++) {
+            sum += i;
+        }
+        TRACE_COUNTER("preprocessor demo sum", sum);
+        printf("  Traced block: sum(1..1000) = %ld\n\n", sum);
+    }
+
     // Conditional code compilation
 #ifdef DEBUG_MODE
     int debug_counter = 0;
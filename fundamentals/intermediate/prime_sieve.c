@@ -0,0 +1,537 @@
+/**
+ * prime_sieve.c - Implementation of the Segmented Prime Sieve
+ *
+ * Bit layout: global bit b stands for the odd number 2*b + 1, so
+ * word w of the (virtual) whole-range bitmap covers [128*w, 128*w + 128).
+ * A query [lo, hi) is the bit range [lo/2, hi/2); the prime 2 is added
+ * separately.
+ *
+ * Each segment is sieved in three steps:
+ * 1. Copy the 3*5*7*11*13 wheel pattern (15015 words, repeating)
+ * 2. Cross off odd multiples of every base prime 17 <= p <= sqrt(hi),
+ *    resuming from where the previous segment stopped (no division)
+ * 3. Count or collect the surviving bits
+ */
+
+#include "prime_sieve.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_PTHREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define SEGMENT_WORDS (PRIME_SIEVE_SEGMENT_BYTES / 8)
+#define SEGMENT_BITS ((uint64_t)SEGMENT_WORDS * 64)
+#define WHEEL_PRODUCT 15015u                // 3 * 5 * 7 * 11 * 13
+#define WHEEL_WORDS WHEEL_PRODUCT           // 15015 words = 64 whole pattern periods
+#define FIRST_SIEVING_PRIME 17u
+#define PARALLEL_MIN_SEGMENTS 16            // Fewer segments than this: one thread
+
+static const uint32_t wheel_primes[] = {3, 5, 7, 11, 13};
+
+// ========================================
+// BIT HELPERS
+// ========================================
+
+static inline int popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    while (word != 0) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+static inline int lowest_bit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while ((word & 1u) == 0) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * floor(sqrt(x)) without floating point (digit-by-digit method)
+ */
+static uint64_t isqrt64(uint64_t x) {
+    uint64_t root = 0;
+    uint64_t bit = UINT64_C(1) << 62;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// ========================================
+// MILLER-RABIN
+// ========================================
+
+static inline uint64_t mul_mod(uint64_t a, uint64_t b, uint64_t m) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;    // GCC/Clang extension
+    return (uint64_t)((uint128)a * b % m);
+#else
+    // Double-and-add: no 128-bit type, never overflows
+    uint64_t result = 0;
+    a %= m;
+    while (b != 0) {
+        if (b & 1u) {
+            result = result >= m - a ? result - (m - a) : result + a;
+        }
+        a = a >= m - a ? a - (m - a) : a + a;
+        b >>= 1;
+    }
+    return result;
+#endif
+}
+
+static uint64_t pow_mod(uint64_t base, uint64_t exponent, uint64_t m) {
+    uint64_t result = 1;
+    base %= m;
+    while (exponent != 0) {
+        if (exponent & 1u) {
+            result = mul_mod(result, base, m);
+        }
+        base = mul_mod(base, base, m);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+bool is_prime64(uint64_t n) {
+    static const uint32_t small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61};
+    // These 7 bases have no strong pseudoprime below 2^64 (Jim Sinclair)
+    static const uint64_t bases[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+
+    if (n < 2) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(small_primes) / sizeof(small_primes[0]); i++) {
+        if (n % small_primes[i] == 0) {
+            return n == small_primes[i];
+        }
+    }
+    if (n < 67 * 67) {
+        return true;                        // No factor below 67
+    }
+
+    // n - 1 = d * 2^s with d odd
+    uint64_t d = n - 1;
+    int s = 0;
+    while ((d & 1u) == 0) {
+        d >>= 1;
+        s++;
+    }
+
+    for (size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); i++) {
+        uint64_t a = bases[i] % n;
+        if (a == 0) {
+            continue;
+        }
+        uint64_t x = pow_mod(a, d, n);
+        if (x == 1 || x == n - 1) {
+            continue;
+        }
+        bool witness = true;
+        for (int r = 1; r < s; r++) {
+            x = mul_mod(x, x, n);
+            if (x == n - 1) {
+                witness = false;
+                break;
+            }
+        }
+        if (witness) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ========================================
+// SIEVE SETUP (shared, read-only)
+// ========================================
+
+typedef struct {
+    uint64_t *wheel;            // WHEEL_WORDS, multiples of 3..13 cleared
+    uint32_t *primes;           // Base primes 17 <= p <= sqrt(hi - 1)
+    size_t prime_count;
+} SieveShared;
+
+/**
+ * Wheel pattern: bit b is clear when 2*b + 1 is divisible by 3, 5, 7, 11
+ * or 13. The period is 15015 bits, so 15015 words repeat exactly.
+ */
+static bool build_wheel(SieveShared *shared) {
+    shared->wheel = malloc(WHEEL_WORDS * sizeof(uint64_t));
+    if (shared->wheel == NULL) {
+        return false;
+    }
+    memset(shared->wheel, 0xFF, WHEEL_WORDS * sizeof(uint64_t));
+    for (size_t i = 0; i < sizeof(wheel_primes) / sizeof(wheel_primes[0]); i++) {
+        uint64_t q = wheel_primes[i];
+        for (uint64_t b = (q - 1) / 2; b < (uint64_t)WHEEL_WORDS * 64; b += q) {
+            shared->wheel[b / 64] &= ~(UINT64_C(1) << (b % 64));
+        }
+    }
+    return true;
+}
+
+/**
+ * Plain odd-only sieve up to 'limit' (<= 2^25) for the base primes
+ */
+static bool build_base_primes(SieveShared *shared, uint64_t limit) {
+    shared->primes = NULL;
+    shared->prime_count = 0;
+    if (limit < FIRST_SIEVING_PRIME) {
+        return true;
+    }
+    size_t bits = (size_t)(limit / 2 + 1);  // Odd numbers 1..limit
+    unsigned char *composite = calloc(bits, 1);
+    // pi(x) < 1.26 x / ln(x); x / 4 is a safe bound for x >= 17
+    shared->primes = malloc((size_t)(limit / 4 + 8) * sizeof(uint32_t));
+    if (composite == NULL || shared->primes == NULL) {
+        free(composite);
+        free(shared->primes);
+        shared->primes = NULL;
+        return false;
+    }
+    for (size_t i = 1; i < bits; i++) {
+        if (composite[i]) {
+            continue;
+        }
+        uint64_t p = 2 * i + 1;
+        if (p >= FIRST_SIEVING_PRIME) {
+            shared->primes[shared->prime_count++] = (uint32_t)p;
+        }
+        for (uint64_t m = p * p / 2; m < bits; m += p) {
+            composite[m] = 1;
+        }
+    }
+    free(composite);
+    return true;
+}
+
+static void shared_free(SieveShared *shared) {
+    free(shared->wheel);
+    free(shared->primes);
+}
+
+// ========================================
+// SEGMENT WORKER
+// ========================================
+
+typedef struct {
+    const SieveShared *shared;
+    uint64_t bit_begin;         // Global bit range handled by this task
+    uint64_t bit_end;
+    bool collect;               // Store primes (else only count)
+    // Results
+    uint64_t count;
+    uint64_t *primes;
+    size_t primes_capacity;
+    bool failed;
+} SieveTask;
+
+static bool push_prime(SieveTask *task, uint64_t prime) {
+    if (task->count == task->primes_capacity) {
+        size_t capacity = task->primes_capacity ? task->primes_capacity * 2 : 1024;
+        uint64_t *grown = realloc(task->primes, capacity * sizeof(uint64_t));
+        if (grown == NULL) {
+            return false;
+        }
+        task->primes = grown;
+        task->primes_capacity = capacity;
+    }
+    task->primes[task->count++] = prime;
+    return true;
+}
+
+/**
+ * Fill a segment starting at global word 'word' from the wheel pattern
+ */
+static void copy_wheel(const uint64_t *wheel, uint64_t *segment, uint64_t word, size_t words) {
+    size_t offset = (size_t)(word % WHEEL_WORDS);
+    while (words > 0) {
+        size_t chunk = WHEEL_WORDS - offset;
+        if (chunk > words) {
+            chunk = words;
+        }
+        memcpy(segment, wheel + offset, chunk * sizeof(uint64_t));
+        segment += chunk;
+        words -= chunk;
+        offset = 0;
+    }
+}
+
+static void *sieve_worker(void *arg) {
+    SieveTask *task = (SieveTask*)arg;
+    const SieveShared *shared = task->shared;
+    uint64_t first_word = task->bit_begin / 64;
+    uint64_t end_word = (task->bit_end + 63) / 64;
+
+    uint64_t *segment = malloc(SEGMENT_WORDS * sizeof(uint64_t));
+    uint64_t *next = malloc((shared->prime_count + 1) * sizeof(uint64_t));
+    if (segment == NULL || next == NULL) {
+        free(segment);
+        free(next);
+        task->failed = true;
+        return NULL;
+    }
+
+    // Next odd multiple of p (as a global bit) at or after this task's start
+    uint64_t start_number = first_word * 128;
+    for (size_t k = 0; k < shared->prime_count; k++) {
+        uint64_t p = shared->primes[k];
+        uint64_t m = p * p;
+        if (m < start_number) {
+            m = (start_number + p - 1) / p * p;
+            if ((m & 1u) == 0) {
+                m += p;
+            }
+        }
+        next[k] = m / 2;
+    }
+
+    for (uint64_t word = first_word; word < end_word; word += SEGMENT_WORDS) {
+        size_t words = end_word - word < SEGMENT_WORDS ? (size_t)(end_word - word) : SEGMENT_WORDS;
+        uint64_t seg_bit = word * 64;
+        uint64_t seg_bits = (uint64_t)words * 64;
+
+        copy_wheel(shared->wheel, segment, word, words);
+        if (word == 0) {
+            // The pattern also removed the wheel primes themselves; 1 is not prime
+            segment[0] &= ~UINT64_C(1);
+            for (size_t i = 0; i < sizeof(wheel_primes) / sizeof(wheel_primes[0]); i++) {
+                segment[0] |= UINT64_C(1) << (wheel_primes[i] / 2);
+            }
+        }
+
+        // Cross off: stepping one bit = stepping 2p in numbers (odd multiples)
+        for (size_t k = 0; k < shared->prime_count; k++) {
+            uint64_t p = shared->primes[k];
+            uint64_t bit = next[k] - seg_bit;     // next[] never falls behind seg_bit
+            for (; bit < seg_bits; bit += p) {
+                segment[bit / 64] &= ~(UINT64_C(1) << (bit % 64));
+            }
+            next[k] = seg_bit + bit;
+        }
+
+        // Keep only bits inside [bit_begin, bit_end)
+        if (seg_bit < task->bit_begin) {
+            segment[0] &= ~UINT64_C(0) << (task->bit_begin - seg_bit);
+        }
+        if (seg_bit + seg_bits > task->bit_end) {
+            uint64_t keep = task->bit_end - (seg_bit + seg_bits - 64);
+            if (keep < 64) {
+                segment[words - 1] &= (UINT64_C(1) << keep) - 1;
+            }
+        }
+
+        if (!task->collect) {
+            for (size_t w = 0; w < words; w++) {
+                task->count += (uint64_t)popcount64(segment[w]);
+            }
+            continue;
+        }
+        for (size_t w = 0; w < words; w++) {
+            uint64_t bits = segment[w];
+            while (bits != 0) {
+                uint64_t b = seg_bit + w * 64 + (uint64_t)lowest_bit(bits);
+                if (!push_prime(task, 2 * b + 1)) {
+                    task->failed = true;
+                    free(segment);
+                    free(next);
+                    return NULL;
+                }
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    free(segment);
+    free(next);
+    return NULL;
+}
+
+// ========================================
+// DRIVER
+// ========================================
+
+static int resolve_threads(int threads, uint64_t bits) {
+#ifdef HAVE_PTHREADS
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > PRIME_SIEVE_MAX_THREADS) {
+        threads = PRIME_SIEVE_MAX_THREADS;
+    }
+    uint64_t max_useful = bits / (SEGMENT_BITS * PARALLEL_MIN_SEGMENTS);
+    if (max_useful < 1) {
+        max_useful = 1;
+    }
+    if ((uint64_t)threads > max_useful) {
+        threads = (int)max_useful;
+    }
+    return threads;
+#else
+    (void)threads;
+    (void)bits;
+    return 1;
+#endif
+}
+
+/**
+ * Run worker(task[t]) for t in [0, threads): the caller runs task 0.
+ * A task whose thread cannot be created runs on the caller instead.
+ */
+static void run_sieve_tasks(SieveTask *tasks, int threads) {
+#ifdef HAVE_PTHREADS
+    pthread_t handles[PRIME_SIEVE_MAX_THREADS];
+    bool started[PRIME_SIEVE_MAX_THREADS] = {false};
+
+    for (int t = 1; t < threads; t++) {
+        started[t] = pthread_create(&handles[t], NULL, sieve_worker, &tasks[t]) == 0;
+    }
+    sieve_worker(&tasks[0]);
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(handles[t], NULL);
+        } else {
+            sieve_worker(&tasks[t]);
+        }
+    }
+#else
+    for (int t = 0; t < threads; t++) {
+        sieve_worker(&tasks[t]);
+    }
+#endif
+}
+
+/**
+ * Sieve [lo, hi) with the odd primes; tasks[] hold the per-thread results
+ * Returns: number of tasks used, 0 on failure
+ */
+static int sieve_range(uint64_t lo, uint64_t hi, int threads, bool collect,
+                       SieveShared *shared, SieveTask *tasks) {
+    uint64_t bit_begin = lo / 2;
+    uint64_t bit_end = hi / 2;
+
+    if (!build_wheel(shared)) {
+        return 0;
+    }
+    if (!build_base_primes(shared, isqrt64(hi - 1))) {
+        free(shared->wheel);
+        return 0;
+    }
+
+    threads = resolve_threads(threads, bit_end - bit_begin);
+    // Split on segment boundaries so no two threads share a word
+    uint64_t first_segment = bit_begin / SEGMENT_BITS;
+    uint64_t segments = (bit_end + SEGMENT_BITS - 1) / SEGMENT_BITS - first_segment;
+    for (int t = 0; t < threads; t++) {
+        uint64_t begin = (first_segment + segments * (uint64_t)t / (uint64_t)threads) * SEGMENT_BITS;
+        uint64_t end = (first_segment + segments * (uint64_t)(t + 1) / (uint64_t)threads) * SEGMENT_BITS;
+        tasks[t].shared = shared;
+        tasks[t].bit_begin = begin > bit_begin ? begin : bit_begin;
+        tasks[t].bit_end = end < bit_end ? end : bit_end;
+        tasks[t].collect = collect;
+        tasks[t].count = 0;
+        tasks[t].primes = NULL;
+        tasks[t].primes_capacity = 0;
+        tasks[t].failed = false;
+    }
+    run_sieve_tasks(tasks, threads);
+    return threads;
+}
+
+uint64_t prime_count_parallel(uint64_t n, int threads) {
+    if (n < 2 || n > PRIME_SIEVE_MAX) {
+        return 0;
+    }
+    SieveShared shared;
+    SieveTask tasks[PRIME_SIEVE_MAX_THREADS];
+    int used = sieve_range(0, n + 1, threads, false, &shared, tasks);
+    if (used == 0) {
+        return 0;
+    }
+
+    uint64_t total = 1;                     // The prime 2
+    bool failed = false;
+    for (int t = 0; t < used; t++) {
+        total += tasks[t].count;
+        failed = failed || tasks[t].failed;
+    }
+    shared_free(&shared);
+    return failed ? 0 : total;
+}
+
+uint64_t prime_count(uint64_t n) {
+    return prime_count_parallel(n, 1);
+}
+
+uint64_t* primes_in_range_parallel(uint64_t lo, uint64_t hi, int threads, size_t *count) {
+    *count = 0;
+    if (hi > PRIME_SIEVE_MAX || lo >= hi || hi <= 2) {
+        return NULL;
+    }
+    SieveShared shared;
+    SieveTask tasks[PRIME_SIEVE_MAX_THREADS];
+    int used = sieve_range(lo, hi, threads, true, &shared, tasks);
+    if (used == 0) {
+        return NULL;
+    }
+
+    // Concatenate the per-thread lists in range order
+    bool has_two = lo <= 2;
+    size_t total = has_two ? 1 : 0;
+    bool failed = false;
+    for (int t = 0; t < used; t++) {
+        total += (size_t)tasks[t].count;
+        failed = failed || tasks[t].failed;
+    }
+    uint64_t *primes = failed || total == 0 ? NULL : malloc(total * sizeof(uint64_t));
+    if (primes != NULL) {
+        size_t filled = 0;
+        if (has_two) {
+            primes[filled++] = 2;
+        }
+        for (int t = 0; t < used; t++) {
+            if (tasks[t].count > 0) {
+                memcpy(primes + filled, tasks[t].primes, (size_t)tasks[t].count * sizeof(uint64_t));
+                filled += (size_t)tasks[t].count;
+            }
+        }
+        *count = total;
+    }
+    for (int t = 0; t < used; t++) {
+        free(tasks[t].primes);
+    }
+    shared_free(&shared);
+    return primes;
+}
+
+uint64_t* primes_in_range(uint64_t lo, uint64_t hi, size_t *count) {
+    return primes_in_range_parallel(lo, hi, 1, count);
+}
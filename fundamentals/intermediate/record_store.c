@@ -0,0 +1,240 @@
+/**
+ * record_store.c - Implementation of the Memory-Mapped Record Store
+ *
+ * The whole file is mapped MAP_SHARED, so writes through record pointers
+ * (and header updates) go straight to the page cache; msync() or close
+ * makes them durable. Growing the file is ftruncate() + remap.
+ */
+
+#define _DEFAULT_SOURCE     /* madvise, MADV_* */
+#include "record_store.h"
+#include <string.h>
+#include <errno.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef HAVE_MMAP
+
+static void store_reset(RecordStore *store) {
+    store->fd = -1;
+    store->map = NULL;
+    store->map_size = 0;
+    store->header = NULL;
+    store->record_size = 0;
+    store->writable = false;
+}
+
+static bool map_file(RecordStore *store, size_t size) {
+    int prot = PROT_READ | (store->writable ? PROT_WRITE : 0);
+    void *map = mmap(NULL, size, prot, MAP_SHARED, store->fd, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    store->map = map;
+    store->map_size = size;
+    store->header = (RecordStoreHeader*)map;
+    return true;
+}
+
+static size_t file_size_for(const RecordStore *store, uint64_t capacity) {
+    return RECORD_STORE_HEADER_SIZE + (size_t)capacity * store->record_size;
+}
+
+bool record_store_create(RecordStore *store, const char *path, size_t record_size) {
+    store_reset(store);
+    if (record_size == 0 || record_size > UINT32_MAX) {
+        errno = EINVAL;
+        return false;
+    }
+    store->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (store->fd < 0) {
+        return false;
+    }
+    store->record_size = record_size;
+    store->writable = true;
+
+    // Start with just the header page; the first append adds an extent
+    if (ftruncate(store->fd, RECORD_STORE_HEADER_SIZE) != 0 ||
+        !map_file(store, RECORD_STORE_HEADER_SIZE)) {
+        int saved = errno;
+        close(store->fd);
+        store_reset(store);
+        errno = saved;
+        return false;
+    }
+    store->header->magic = RECORD_STORE_MAGIC;
+    store->header->version = RECORD_STORE_VERSION;
+    store->header->header_size = RECORD_STORE_HEADER_SIZE;
+    store->header->record_size = (uint32_t)record_size;
+    store->header->count = 0;
+    store->header->capacity = 0;
+    return true;
+}
+
+bool record_store_open(RecordStore *store, const char *path, size_t record_size, bool writable) {
+    store_reset(store);
+    if (record_size == 0) {
+        errno = EINVAL;
+        return false;
+    }
+    store->fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if (store->fd < 0) {
+        return false;
+    }
+    store->record_size = record_size;
+    store->writable = writable;
+
+    // Validate the header with pread before trusting it to size the mapping
+    RecordStoreHeader header;
+    struct stat info;
+    bool valid = pread(store->fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+                 fstat(store->fd, &info) == 0 &&
+                 header.magic == RECORD_STORE_MAGIC &&
+                 header.version == RECORD_STORE_VERSION &&
+                 header.header_size == RECORD_STORE_HEADER_SIZE &&
+                 header.record_size == record_size &&
+                 header.count <= header.capacity &&
+                 header.capacity <= (SIZE_MAX - RECORD_STORE_HEADER_SIZE) / record_size &&
+                 (uint64_t)info.st_size >= file_size_for(store, header.capacity);
+    if (!valid || !map_file(store, file_size_for(store, header.capacity))) {
+        int saved = valid ? errno : EINVAL;
+        close(store->fd);
+        store_reset(store);
+        errno = saved;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Extend the file by one extent and remap it
+ * (record pointers from before the call are invalidated on success only)
+ */
+static bool grow(RecordStore *store) {
+    size_t current = store->map_size;
+    size_t extent = current / 8 > RECORD_STORE_EXTENT_BYTES ? current / 8 : RECORD_STORE_EXTENT_BYTES;
+    uint64_t capacity = store->header->capacity + (extent + store->record_size - 1) / store->record_size;
+    size_t new_size = file_size_for(store, capacity);
+
+    // ftruncate makes a sparse file: disk blocks are allocated on write
+    if (ftruncate(store->fd, (off_t)new_size) != 0) {
+        return false;
+    }
+    // Map the new size before dropping the old mapping: on failure the
+    // store keeps working at its old capacity (a file longer than the
+    // header's capacity is still valid for record_store_open)
+    unsigned char *old_map = store->map;
+    size_t old_size = store->map_size;
+    if (!map_file(store, new_size)) {
+        return false;
+    }
+    munmap(old_map, old_size);
+    store->header->capacity = capacity;
+    return true;
+}
+
+void* record_store_append(RecordStore *store, const void *record) {
+    if (!store->writable || store->header == NULL) {
+        errno = EBADF;
+        return NULL;
+    }
+    if (store->header->count == store->header->capacity && !grow(store)) {
+        return NULL;
+    }
+    uint64_t index = store->header->count;
+    unsigned char *slot = store->map + RECORD_STORE_HEADER_SIZE + (size_t)index * store->record_size;
+    memcpy(slot, record, store->record_size);
+    store->header->count = index + 1;      // Publish after the data is written
+    return slot;
+}
+
+bool record_store_advise(RecordStore *store, RecordAccess access) {
+    int advice = MADV_NORMAL;
+    switch (access) {
+        case RECORD_ACCESS_SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+        case RECORD_ACCESS_RANDOM:     advice = MADV_RANDOM;     break;
+        case RECORD_ACCESS_WILLNEED:   advice = MADV_WILLNEED;   break;
+        case RECORD_ACCESS_NORMAL:     advice = MADV_NORMAL;     break;
+    }
+    if (store->map_size <= RECORD_STORE_HEADER_SIZE) {
+        return true;                        // No records mapped yet
+    }
+    // Header page excluded: it is always hot
+    return madvise(store->map + RECORD_STORE_HEADER_SIZE,
+                   store->map_size - RECORD_STORE_HEADER_SIZE, advice) == 0;
+}
+
+bool record_store_sync(RecordStore *store) {
+    if (store->map == NULL) {
+        return false;
+    }
+    return msync(store->map, store->map_size, MS_SYNC) == 0;
+}
+
+void record_store_close(RecordStore *store) {
+    if (store->map != NULL) {
+        uint64_t count = store->header->count;
+        if (store->writable) {
+            store->header->capacity = count;    // Tail extent is trimmed below
+        }
+        munmap(store->map, store->map_size);
+        if (store->writable) {
+            // On failure the file keeps its extent tail: still valid, just larger
+            int trimmed = ftruncate(store->fd, (off_t)file_size_for(store, count));
+            (void)trimmed;
+        }
+    }
+    if (store->fd >= 0) {
+        close(store->fd);
+    }
+    store_reset(store);
+}
+
+#else /* !HAVE_MMAP */
+
+bool record_store_create(RecordStore *store, const char *path, size_t record_size) {
+    (void)path;
+    (void)record_size;
+    memset(store, 0, sizeof(*store));
+    errno = ENOSYS;
+    return false;
+}
+
+bool record_store_open(RecordStore *store, const char *path, size_t record_size, bool writable) {
+    (void)path;
+    (void)record_size;
+    (void)writable;
+    memset(store, 0, sizeof(*store));
+    errno = ENOSYS;
+    return false;
+}
+
+void* record_store_append(RecordStore *store, const void *record) {
+    (void)store;
+    (void)record;
+    errno = ENOSYS;
+    return NULL;
+}
+
+bool record_store_advise(RecordStore *store, RecordAccess access) {
+    (void)store;
+    (void)access;
+    return false;
+}
+
+bool record_store_sync(RecordStore *store) {
+    (void)store;
+    return false;
+}
+
+void record_store_close(RecordStore *store) {
+    memset(store, 0, sizeof(*store));
+}
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * record_store.h - Memory-Mapped Fixed-Record Store
+ *
+ * A file of equally sized records (e.g. struct Student) that is mapped
+ * into memory instead of read with fread():
+ * - Record i lives at  header_size + i * record_size  (the same offset
+ *   arithmetic as fseek(file, offset, SEEK_SET) in file_io.c Example 5)
+ * - record_store_get() is pointer arithmetic: O(1), no syscall, no copy
+ * - Only the pages actually touched are read from disk, so a random
+ *   lookup in a 50GB file costs one page fault, not a 50GB load
+ *
+ * File layout:
+ *   [ RecordStoreHeader, padded to 4KB | record 0 | record 1 | ... ]
+ * The header carries a magic number, a format version and the record
+ * size, so a file written with a different struct layout is rejected.
+ * Records are stored in native byte order and struct layout.
+ *
+ * Growth: record_store_append() extends the file in large extents
+ * (RECORD_STORE_EXTENT_BYTES, or 1/8 of the file if larger) with
+ * ftruncate() and remaps, so appends do not remap on every call.
+ * The unused tail of the last extent is trimmed by record_store_close().
+ *
+ * Memory Implications:
+ * - The mapping is virtual address space; RSS grows only with pages
+ *   touched and the kernel may drop clean pages under memory pressure
+ * - Pointers from get/append are invalidated by an append that grows
+ *   the file (the mapping moves) and by close
+ *
+ * CPU Overhead:
+ * - fseek + fread per record: 2 libc calls + 1 syscall + 1 copy
+ * - record_store_get:         1 multiply-add (+ page fault on first touch)
+ *
+ * Platform: POSIX mmap. Elsewhere open/create fail with ENOSYS; use the
+ * fseek/fread path shown in file_io.c.
+ */
+
+#ifndef RECORD_STORE_H
+#define RECORD_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RECORD_STORE_MAGIC 0x31535452u          /* "RTS1" little-endian */
+#define RECORD_STORE_VERSION 1u
+#define RECORD_STORE_HEADER_SIZE 4096u          /* Records start page-aligned */
+#define RECORD_STORE_EXTENT_BYTES (64u * 1024u * 1024u)
+
+/**
+ * On-disk header (first bytes of the file)
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t record_size;
+    uint64_t count;             // Records in use
+    uint64_t capacity;          // Records the file currently has room for
+} RecordStoreHeader;
+
+typedef struct {
+    int fd;
+    unsigned char *map;         // Whole file: header + records
+    size_t map_size;
+    RecordStoreHeader *header;  // Points into map
+    size_t record_size;
+    bool writable;
+} RecordStore;
+
+/**
+ * Access pattern hints (madvise) for the record area
+ */
+typedef enum {
+    RECORD_ACCESS_NORMAL,
+    RECORD_ACCESS_SEQUENTIAL,   // Aggressive read-ahead, drop pages behind
+    RECORD_ACCESS_RANDOM,       // No read-ahead: each lookup reads one page
+    RECORD_ACCESS_WILLNEED      // Start reading everything in now
+} RecordAccess;
+
+/**
+ * Create (or truncate) a store for records of 'record_size' bytes
+ * Returns: false with errno set on failure
+ */
+bool record_store_create(RecordStore *store, const char *path, size_t record_size);
+
+/**
+ * Open an existing store. Fails with EINVAL if the magic, version or
+ * record size do not match, or the file is shorter than its header says.
+ */
+bool record_store_open(RecordStore *store, const char *path, size_t record_size, bool writable);
+
+/**
+ * Pointer to record 'index', or NULL if index >= count
+ *
+ * Time Complexity: O(1)
+ */
+static inline void* record_store_get(const RecordStore *store, uint64_t index) {
+    if (index >= store->header->count) {
+        return NULL;
+    }
+    return store->map + store->header->header_size + (size_t)index * store->record_size;
+}
+
+static inline uint64_t record_store_count(const RecordStore *store) {
+    return store->header->count;
+}
+
+/**
+ * Copy one record to the end, growing the file by an extent if needed
+ * Returns: pointer to the stored record, NULL on failure
+ *
+ * Time Complexity: O(1) amortized
+ */
+void* record_store_append(RecordStore *store, const void *record);
+
+/**
+ * Tell the kernel how the records will be read
+ */
+bool record_store_advise(RecordStore *store, RecordAccess access);
+
+/**
+ * Flush dirty pages and the header to disk (msync)
+ */
+bool record_store_sync(RecordStore *store);
+
+/**
+ * Unmap, trim the unused extent tail (if writable) and close
+ */
+void record_store_close(RecordStore *store);
+
+#endif /* RECORD_STORE_H */
@@ -9,13 +9,16 @@
  * - Structures and functions
  * - typedef for cleaner syntax
  * - Struct alignment and padding
+ * - Struct-of-arrays (columnar) layout and packed serialization
  * 
  * Structures group related data under a single name,
  * forming the foundation of object-oriented concepts in C.
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -66,15 +69,61 @@ typedef struct Node {
     struct Node* next;  // Self-referential structure
 } Node;
 
+// Struct-of-arrays (columnar) containers
+//
+// An array of struct Student stores whole records side by side, so a scan
+// of one field (e.g. average GPA) drags every other field and all the
+// padding through the cache: 64 bytes loaded per 4-byte gpa. A table
+// stores each field in its own array; a scan streams only its column,
+// and contiguous same-type data lets the compiler use SIMD.
+typedef struct {
+    int* ids;
+    float* gpas;
+    uint8_t* enrolled;      // 0/1: one byte, no bool padding
+    char (*names)[50];      // Cold column: only touched when printing
+    size_t count;
+    size_t capacity;
+} StudentTable;
+
+typedef struct {
+    int* employee_ids;
+    float* salaries;
+    int* zip_codes;
+    char (*names)[50];
+    Address* addresses;     // Street/city/state rarely scanned: kept together
+    size_t count;
+    size_t capacity;
+} EmployeeTable;
+
+// Packed on-disk encoding: fixed little-endian fields, length-prefixed
+// strings, no padding (independent of compiler and architecture)
+#define STUDENT_PACKED_MAX (4 + 1 + 49 + 4 + 1)
+#define EMPLOYEE_PACKED_MAX (4 + 1 + 49 + 4 + 1 + 99 + 1 + 49 + 1 + 19 + 4)
+
 // Function declarations
 void demonstrate_basics(void);
 void demonstrate_initialization(void);
 void demonstrate_nested(void);
 void demonstrate_functions(void);
 void demonstrate_memory_layout(void);
+void demonstrate_struct_of_arrays(void);
 void print_student(struct Student s);
 void update_salary(Employee* emp, float new_salary);
 int calculate_area(Rect rect);
+bool student_table_init(StudentTable* table, size_t capacity);
+bool student_table_push(StudentTable* table, const struct Student* s);
+struct Student student_table_get(const StudentTable* table, size_t index);
+void student_table_free(StudentTable* table);
+float student_table_average_gpa(const StudentTable* table);
+size_t student_table_filter_ids(const StudentTable* table, int min_id, int max_id, size_t* out);
+bool employee_table_init(EmployeeTable* table, size_t capacity);
+bool employee_table_push(EmployeeTable* table, const Employee* e);
+void employee_table_free(EmployeeTable* table);
+double employee_table_total_salary(const EmployeeTable* table);
+size_t student_pack(const struct Student* s, uint8_t* out);
+size_t student_unpack(const uint8_t* in, size_t available, struct Student* s);
+size_t employee_pack(const Employee* e, uint8_t* out);
+size_t employee_unpack(const uint8_t* in, size_t available, Employee* e);
 
 int main(void) {
 #ifdef _WIN32
@@ -92,6 +141,7 @@ int main(void) {
     demonstrate_nested();
     demonstrate_functions();
     demonstrate_memory_layout();
+    demonstrate_struct_of_arrays();
 
     printf("========================================\n");
     printf("     ALL DEMONSTRATIONS COMPLETED      \n");
@@ -312,7 +362,131 @@ void demonstrate_memory_layout(void) {
     printf("  • Order members by size (largest first) for efficiency\n");
     printf("  • Use pointers for large structures in functions\n");
     printf("  • Consider cache line alignment for performance\n");
-    printf("  • Use designated initializers for clarity\n\n");
+    printf("  • Use designated initializers for clarity\n");
+    printf("  • Scan-heavy data: store fields as columns (section 6)\n\n");
+}
+
+/**
+ * Struct-of-Arrays and Packed Encoding
+ * Column scans over a table vs. the same scans over an array of structs
+ */
+#define SOA_RECORDS 1000000
+
+// Array-of-structs reference scans
+static float aos_average_gpa(const struct Student* students, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += students[i].gpa;
+    }
+    return count > 0 ? (float)(sum / (double)count) : 0.0f;
+}
+
+static size_t aos_filter_ids(const struct Student* students, size_t count,
+                             int min_id, int max_id, size_t* out) {
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (students[i].id >= min_id && students[i].id <= max_id) {
+            out[found++] = i;
+        }
+    }
+    return found;
+}
+
+void demonstrate_struct_of_arrays(void) {
+    printf("========================================\n");
+    printf("6. STRUCT-OF-ARRAYS & PACKED ENCODING\n");
+    printf("========================================\n\n");
+
+    struct Student* aos = malloc(SOA_RECORDS * sizeof(struct Student));
+    size_t* matches = malloc(SOA_RECORDS * sizeof(size_t));
+    StudentTable table;
+    if (aos == NULL || matches == NULL || !student_table_init(&table, SOA_RECORDS)) {
+        printf("Allocation failed\n\n");
+        free(aos);
+        free(matches);
+        return;
+    }
+
+    for (size_t i = 0; i < SOA_RECORDS; i++) {
+        struct Student s = {
+            .id = (int)(100000 + (i * 7919) % SOA_RECORDS),
+            .gpa = 2.0f + (float)(i % 201) / 100.0f,
+            .is_enrolled = (i % 3) != 0
+        };
+        snprintf(s.name, sizeof(s.name), "Student %zu", i);
+        aos[i] = s;
+        student_table_push(&table, &s);
+    }
+
+    printf("%d students:\n", SOA_RECORDS);
+    printf("  AoS: %zu bytes/record -> %zu MB total\n",
+           sizeof(struct Student), SOA_RECORDS * sizeof(struct Student) >> 20);
+    printf("  SoA: gpa column %zu MB, id column %zu MB\n\n",
+           SOA_RECORDS * sizeof(float) >> 20, SOA_RECORDS * sizeof(int) >> 20);
+
+    // Average GPA: AoS reads every byte of every record, SoA one column
+    clock_t start = clock();
+    float aos_avg = aos_average_gpa(aos, SOA_RECORDS);
+    double aos_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    float soa_avg = student_table_average_gpa(&table);
+    double soa_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Average GPA scan:\n");
+    printf("  AoS: %.4f in %.4f s (%zu MB touched)\n",
+           aos_avg, aos_time, SOA_RECORDS * sizeof(struct Student) >> 20);
+    printf("  SoA: %.4f in %.4f s (%zu MB touched, %zux less traffic)\n\n",
+           soa_avg, soa_time, SOA_RECORDS * sizeof(float) >> 20,
+           sizeof(struct Student) / sizeof(float));
+
+    // Filter by id range: branch-free compaction over the id column
+    int min_id = 200000, max_id = 300000;
+    start = clock();
+    size_t aos_found = aos_filter_ids(aos, SOA_RECORDS, min_id, max_id, matches);
+    aos_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    size_t soa_found = student_table_filter_ids(&table, min_id, max_id, matches);
+    soa_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Filter %d <= id <= %d:\n", min_id, max_id);
+    printf("  AoS: %zu matches in %.4f s\n", aos_found, aos_time);
+    printf("  SoA: %zu matches in %.4f s (first: %s)\n\n", soa_found, soa_time,
+           soa_found > 0 ? table.names[matches[0]] : "-");
+
+    // Employee table: payroll touches only the salary column
+    EmployeeTable staff;
+    if (employee_table_init(&staff, 2)) {
+        Employee a = {12345, "Frank Wilson", 75000.0f, {"123 Main St", "Springfield", "IL", 62701}};
+        Employee b = {67890, "Grace Taylor", 72000.0f, {"456 Oak Ave", "Chicago", "IL", 60601}};
+        employee_table_push(&staff, &a);
+        employee_table_push(&staff, &b);
+        printf("EmployeeTable: %zu employees, payroll $%.2f\n",
+               staff.count, employee_table_total_salary(&staff));
+
+        // Packed encoding round trip
+        uint8_t buffer[EMPLOYEE_PACKED_MAX];
+        size_t packed = employee_pack(&a, buffer);
+        Employee decoded;
+        size_t used = employee_unpack(buffer, packed, &decoded);
+        printf("  Packed Employee: %zu bytes (sizeof(Employee) = %zu), decoded %s: %s, %s %d\n",
+               packed, sizeof(Employee), used == packed ? "OK" : "FAILED",
+               decoded.name, decoded.address.city, decoded.address.zip_code);
+        employee_table_free(&staff);
+    }
+
+    struct Student sample = student_table_get(&table, 0);
+    uint8_t record[STUDENT_PACKED_MAX];
+    size_t packed = student_pack(&sample, record);
+    struct Student back;
+    size_t used = student_unpack(record, packed, &back);
+    printf("  Packed Student:  %zu bytes (sizeof(struct Student) = %zu), decoded %s: ",
+           packed, sizeof(struct Student), used == packed ? "OK" : "FAILED");
+    print_student(back);
+    printf("\n");
+
+    student_table_free(&table);
+    free(aos);
+    free(matches);
 }
 
 /**
@@ -333,3 +507,332 @@ int calculate_area(Rect rect) {
     int height = rect.top_left.y - rect.bottom_right.y;
     return width * height;
 }
+
+/**
+ * StudentTable: one array per field, grown together
+ */
+bool student_table_init(StudentTable* table, size_t capacity) {
+    table->count = 0;
+    table->capacity = capacity > 0 ? capacity : 16;
+    table->ids = malloc(table->capacity * sizeof(int));
+    table->gpas = malloc(table->capacity * sizeof(float));
+    table->enrolled = malloc(table->capacity * sizeof(uint8_t));
+    table->names = malloc(table->capacity * sizeof(*table->names));
+    if (!table->ids || !table->gpas || !table->enrolled || !table->names) {
+        student_table_free(table);
+        return false;
+    }
+    return true;
+}
+
+static bool grow_column(void** column, size_t new_capacity, size_t element_size) {
+    void* grown = realloc(*column, new_capacity * element_size);
+    if (grown == NULL) {
+        return false;
+    }
+    *column = grown;
+    return true;
+}
+
+bool student_table_push(StudentTable* table, const struct Student* s) {
+    if (table->count == table->capacity) {
+        size_t new_capacity = table->capacity * 2;
+        void* ids = table->ids;
+        void* gpas = table->gpas;
+        void* enrolled = table->enrolled;
+        void* names = table->names;
+        bool ok = grow_column(&ids, new_capacity, sizeof(int)) &&
+                  grow_column(&gpas, new_capacity, sizeof(float)) &&
+                  grow_column(&enrolled, new_capacity, sizeof(uint8_t)) &&
+                  grow_column(&names, new_capacity, sizeof(*table->names));
+        // Columns that did grow stay valid (just larger) if a later one failed
+        table->ids = ids;
+        table->gpas = gpas;
+        table->enrolled = enrolled;
+        table->names = names;
+        if (!ok) {
+            return false;
+        }
+        table->capacity = new_capacity;
+    }
+    size_t i = table->count++;
+    table->ids[i] = s->id;
+    table->gpas[i] = s->gpa;
+    table->enrolled[i] = s->is_enrolled ? 1 : 0;
+    memcpy(table->names[i], s->name, sizeof(table->names[i]));
+    return true;
+}
+
+struct Student student_table_get(const StudentTable* table, size_t index) {
+    struct Student s;
+    s.id = table->ids[index];
+    memcpy(s.name, table->names[index], sizeof(s.name));
+    s.gpa = table->gpas[index];
+    s.is_enrolled = table->enrolled[index] != 0;
+    return s;
+}
+
+void student_table_free(StudentTable* table) {
+    free(table->ids);
+    free(table->gpas);
+    free(table->enrolled);
+    free(table->names);
+    table->ids = NULL;
+    table->gpas = NULL;
+    table->enrolled = NULL;
+    table->names = NULL;
+    table->count = 0;
+    table->capacity = 0;
+}
+
+/**
+ * Average of the gpa column
+ * 
+ * Eight independent partial sums: no loop-carried dependency on a single
+ * accumulator, so the adds pipeline and map onto 4/8-wide SIMD lanes
+ * (a single float accumulator cannot be vectorized without -ffast-math).
+ */
+float student_table_average_gpa(const StudentTable* table) {
+    const float* gpa = table->gpas;
+    size_t n = table->count;
+    float partial[8] = {0};
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (int lane = 0; lane < 8; lane++) {
+            partial[lane] += gpa[i + lane];
+        }
+    }
+    double sum = 0.0;
+    for (int lane = 0; lane < 8; lane++) {
+        sum += partial[lane];
+    }
+    for (; i < n; i++) {
+        sum += gpa[i];
+    }
+    return n > 0 ? (float)(sum / (double)n) : 0.0f;
+}
+
+/**
+ * Indices of rows with min_id <= id <= max_id, in order
+ * 
+ * Branch-free: the index is always stored and the cursor advances by the
+ * comparison result, so random matches cost no mispredictions.
+ * The range test is one unsigned compare: (id - min) <= (max - min).
+ */
+size_t student_table_filter_ids(const StudentTable* table, int min_id, int max_id, size_t* out) {
+    if (max_id < min_id) {
+        return 0;
+    }
+    const int* ids = table->ids;
+    uint32_t span = (uint32_t)max_id - (uint32_t)min_id;
+    size_t found = 0;
+    for (size_t i = 0; i < table->count; i++) {
+        out[found] = i;
+        found += ((uint32_t)ids[i] - (uint32_t)min_id) <= span;
+    }
+    return found;
+}
+
+/**
+ * EmployeeTable: hot numeric columns apart from the bulky Address
+ */
+bool employee_table_init(EmployeeTable* table, size_t capacity) {
+    table->count = 0;
+    table->capacity = capacity > 0 ? capacity : 16;
+    table->employee_ids = malloc(table->capacity * sizeof(int));
+    table->salaries = malloc(table->capacity * sizeof(float));
+    table->zip_codes = malloc(table->capacity * sizeof(int));
+    table->names = malloc(table->capacity * sizeof(*table->names));
+    table->addresses = malloc(table->capacity * sizeof(Address));
+    if (!table->employee_ids || !table->salaries || !table->zip_codes ||
+        !table->names || !table->addresses) {
+        employee_table_free(table);
+        return false;
+    }
+    return true;
+}
+
+bool employee_table_push(EmployeeTable* table, const Employee* e) {
+    if (table->count == table->capacity) {
+        size_t new_capacity = table->capacity * 2;
+        void* ids = table->employee_ids;
+        void* salaries = table->salaries;
+        void* zips = table->zip_codes;
+        void* names = table->names;
+        void* addresses = table->addresses;
+        bool ok = grow_column(&ids, new_capacity, sizeof(int)) &&
+                  grow_column(&salaries, new_capacity, sizeof(float)) &&
+                  grow_column(&zips, new_capacity, sizeof(int)) &&
+                  grow_column(&names, new_capacity, sizeof(*table->names)) &&
+                  grow_column(&addresses, new_capacity, sizeof(Address));
+        table->employee_ids = ids;
+        table->salaries = salaries;
+        table->zip_codes = zips;
+        table->names = names;
+        table->addresses = addresses;
+        if (!ok) {
+            return false;
+        }
+        table->capacity = new_capacity;
+    }
+    size_t i = table->count++;
+    table->employee_ids[i] = e->employee_id;
+    table->salaries[i] = e->salary;
+    table->zip_codes[i] = e->address.zip_code;
+    memcpy(table->names[i], e->name, sizeof(table->names[i]));
+    table->addresses[i] = e->address;
+    return true;
+}
+
+void employee_table_free(EmployeeTable* table) {
+    free(table->employee_ids);
+    free(table->salaries);
+    free(table->zip_codes);
+    free(table->names);
+    free(table->addresses);
+    table->employee_ids = NULL;
+    table->salaries = NULL;
+    table->zip_codes = NULL;
+    table->names = NULL;
+    table->addresses = NULL;
+    table->count = 0;
+    table->capacity = 0;
+}
+
+double employee_table_total_salary(const EmployeeTable* table) {
+    double total = 0.0;
+    for (size_t i = 0; i < table->count; i++) {
+        total += table->salaries[i];
+    }
+    return total;
+}
+
+/**
+ * Packed encoding helpers: explicit little-endian byte order
+ */
+static uint8_t* put_u32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+    return out + 4;
+}
+
+static uint32_t get_u32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) |
+           ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static uint8_t* put_float(uint8_t* out, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return put_u32(out, bits);
+}
+
+static float get_float(const uint8_t* in) {
+    uint32_t bits = get_u32(in);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// String: 1 length byte + bytes (no terminator, no unused tail)
+static uint8_t* put_string(uint8_t* out, const char* text, size_t field_size) {
+    const char* nul = memchr(text, '\0', field_size - 1);
+    size_t length = nul != NULL ? (size_t)(nul - text) : field_size - 1;
+    *out++ = (uint8_t)length;
+    memcpy(out, text, length);
+    return out + length;
+}
+
+// Returns: bytes consumed, 0 if truncated or too long for the field
+static size_t get_string(const uint8_t* in, size_t available, char* text, size_t field_size) {
+    if (available < 1 || in[0] >= field_size || (size_t)in[0] + 1 > available) {
+        return 0;
+    }
+    memcpy(text, in + 1, in[0]);
+    memset(text + in[0], 0, field_size - in[0]);
+    return (size_t)in[0] + 1;
+}
+
+/**
+ * Student: id(4) name(1+len) gpa(4) enrolled(1)
+ * Returns: bytes written (at most STUDENT_PACKED_MAX)
+ */
+size_t student_pack(const struct Student* s, uint8_t* out) {
+    uint8_t* p = out;
+    p = put_u32(p, (uint32_t)s->id);
+    p = put_string(p, s->name, sizeof(s->name));
+    p = put_float(p, s->gpa);
+    *p++ = s->is_enrolled ? 1 : 0;
+    return (size_t)(p - out);
+}
+
+/**
+ * Returns: bytes consumed, 0 if the input is truncated or malformed
+ */
+size_t student_unpack(const uint8_t* in, size_t available, struct Student* s) {
+    if (available < 4) {
+        return 0;
+    }
+    s->id = (int)get_u32(in);
+    size_t used = 4;
+    size_t n = get_string(in + used, available - used, s->name, sizeof(s->name));
+    if (n == 0 || available - used - n < 5) {
+        return 0;
+    }
+    used += n;
+    s->gpa = get_float(in + used);
+    s->is_enrolled = in[used + 4] != 0;
+    return used + 5;
+}
+
+/**
+ * Employee: id(4) name salary(4) street city state zip(4)
+ */
+size_t employee_pack(const Employee* e, uint8_t* out) {
+    uint8_t* p = out;
+    p = put_u32(p, (uint32_t)e->employee_id);
+    p = put_string(p, e->name, sizeof(e->name));
+    p = put_float(p, e->salary);
+    p = put_string(p, e->address.street, sizeof(e->address.street));
+    p = put_string(p, e->address.city, sizeof(e->address.city));
+    p = put_string(p, e->address.state, sizeof(e->address.state));
+    p = put_u32(p, (uint32_t)e->address.zip_code);
+    return (size_t)(p - out);
+}
+
+size_t employee_unpack(const uint8_t* in, size_t available, Employee* e) {
+    size_t used = 0, n;
+    if (available < 4) {
+        return 0;
+    }
+    e->employee_id = (int)get_u32(in);
+    used += 4;
+    if ((n = get_string(in + used, available - used, e->name, sizeof(e->name))) == 0) {
+        return 0;
+    }
+    used += n;
+    if (available - used < 4) {
+        return 0;
+    }
+    e->salary = get_float(in + used);
+    used += 4;
+    if ((n = get_string(in + used, available - used, e->address.street, sizeof(e->address.street))) == 0) {
+        return 0;
+    }
+    used += n;
+    if ((n = get_string(in + used, available - used, e->address.city, sizeof(e->address.city))) == 0) {
+        return 0;
+    }
+    used += n;
+    if ((n = get_string(in + used, available - used, e->address.state, sizeof(e->address.state))) == 0) {
+        return 0;
+    }
+    used += n;
+    if (available - used < 4) {
+        return 0;
+    }
+    e->address.zip_code = (int)get_u32(in + used);
+    return used + 4;
+}
@@ -0,0 +1,156 @@
+/**
+ * ============================================================================
+ * arena.c - Arena Allocator Chunk Management
+ * ============================================================================
+ *
+ * See arena.h for the cost model. Only the slow path lives here: the bump
+ * itself is inline in the header so the parse loop never makes a call.
+ *
+ * CHUNK REUSE:
+ * Chunks after 'current' are empty but retained. Reset points 'current'
+ * back at the first chunk; the slow path walks forward into retained
+ * chunks (zeroing their bump offset) before it asks malloc for more.
+ * That is what makes reset and rewind O(1) regardless of chunk count.
+ *
+ * ============================================================================
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+void arena_init(Arena *arena, size_t chunk_size) {
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->chunk_size = chunk_size != 0 ? chunk_size : ARENA_DEFAULT_CHUNK_SIZE;
+    arena->last = NULL;
+    arena->reserved = 0;
+}
+
+void arena_free(Arena *arena) {
+    ArenaChunk *chunk = arena->first;
+    while (chunk != NULL) {
+        ArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    arena_init(arena, arena->chunk_size);
+}
+
+/**
+ * Bump inside one chunk; NULL if it does not fit
+ */
+static void* chunk_bump(ArenaChunk *chunk, size_t size, size_t align) {
+    uintptr_t base = (uintptr_t)chunk->data;
+    uintptr_t top = (base + chunk->used + (align - 1)) & ~(uintptr_t)(align - 1);
+    if (top - base > chunk->capacity || size > chunk->capacity - (top - base)) {
+        return NULL;
+    }
+    chunk->used = (top - base) + size;
+    return (void*)top;
+}
+
+void* arena_alloc_slow(Arena *arena, size_t size, size_t align) {
+    // Worst-case padding is align - 1
+    if (size > SIZE_MAX - sizeof(ArenaChunk) - align) {
+        return NULL;
+    }
+    size_t needed = size + align - 1;
+
+    // Reuse the next retained chunk if it is large enough
+    ArenaChunk *next = arena->current != NULL ? arena->current->next : arena->first;
+    if (next == NULL || next->capacity < needed) {
+        size_t capacity = needed > arena->chunk_size ? needed : arena->chunk_size;
+        ArenaChunk *chunk = malloc(sizeof(ArenaChunk) + capacity);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->capacity = capacity;
+        chunk->next = next;             // Insert before the too-small chunk
+        if (arena->current != NULL) {
+            arena->current->next = chunk;
+        } else {
+            arena->first = chunk;
+        }
+        arena->reserved += sizeof(ArenaChunk) + capacity;
+        next = chunk;
+    }
+
+    next->used = 0;
+    arena->current = next;
+    arena->last = chunk_bump(next, size, align);
+    return arena->last;
+}
+
+void* arena_realloc(Arena *arena, void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) {
+        return arena_alloc(arena, new_size);
+    }
+
+    // Most recent allocation: move the bump pointer instead of copying
+    ArenaChunk *chunk = arena->current;
+    if (ptr == arena->last && chunk != NULL) {
+        size_t offset = (size_t)((unsigned char*)ptr - chunk->data);
+        if (new_size <= chunk->capacity - offset) {
+            chunk->used = offset + new_size;
+            return ptr;
+        }
+    } else if (new_size <= old_size) {
+        return ptr;                     // Shrinking elsewhere: keep the block
+    }
+
+    void *block = arena_alloc(arena, new_size);
+    if (block != NULL) {
+        memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return block;
+}
+
+char* arena_strndup(Arena *arena, const char *text, size_t length) {
+    char *copy = arena_alloc_aligned(arena, length + 1, 1);
+    if (copy != NULL) {
+        memcpy(copy, text, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+void arena_reset(Arena *arena) {
+    arena->current = arena->first;
+    if (arena->current != NULL) {
+        arena->current->used = 0;
+    }
+    arena->last = NULL;
+}
+
+ArenaMarker arena_mark(const Arena *arena) {
+    ArenaMarker marker;
+    marker.chunk = arena->current;
+    marker.used = arena->current != NULL ? arena->current->used : 0;
+    return marker;
+}
+
+void arena_rewind(Arena *arena, ArenaMarker marker) {
+    if (marker.chunk == NULL) {
+        arena_reset(arena);             // Marked before the first allocation
+        return;
+    }
+    arena->current = marker.chunk;
+    arena->current->used = marker.used;
+    arena->last = NULL;
+}
+
+size_t arena_bytes_used(const Arena *arena) {
+    size_t used = 0;
+    for (ArenaChunk *chunk = arena->first; chunk != NULL; chunk = chunk->next) {
+        used += chunk->used;
+        if (chunk == arena->current) {
+            break;
+        }
+    }
+    return arena->current != NULL ? used : 0;
+}
+
+size_t arena_bytes_reserved(const Arena *arena) {
+    return arena->reserved;
+}
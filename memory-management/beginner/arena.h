@@ -0,0 +1,154 @@
+/**
+ * ============================================================================
+ * arena.h - Arena (Bump Pointer) Allocator
+ * ============================================================================
+ *
+ * PURPOSE:
+ * Replaces "malloc per object, free per object" with "bump a pointer per
+ * object, free everything at once". Built for parse loops such as
+ * read_line_arena() in stack_vs_heap.c: every line of a batch comes from
+ * the arena, and one arena_reset() releases the whole batch.
+ *
+ * COST MODEL:
+ * Operation       | malloc/free          | Arena
+ * ----------------|----------------------|------------------------------
+ * Allocate        | 50-300 cycles        | ~3 instructions (inline bump)
+ * Free one object | 50-150 cycles        | Not supported (no-op)
+ * Free everything | N x free()           | O(1) arena_reset()
+ * Per-object hdr  | 8-16 bytes           | 0 bytes (alignment padding only)
+ * Fragmentation   | Can be severe        | None (objects packed in order)
+ *
+ * LAYOUT:
+ * Memory comes from a linked list of chunks (ARENA_DEFAULT_CHUNK_SIZE
+ * each, or larger for oversized requests). Chunks are never returned to
+ * malloc before arena_free(): reset and rewind only move the bump
+ * pointer back, so a steady-state parse loop performs zero malloc calls.
+ *
+ * USAGE:
+ *   Arena arena;
+ *   arena_init(&arena, 0);                      // 0 = default chunk size
+ *   while (batch) {
+ *       char *line = read_line_arena(&reader, &arena);   // LineReader
+ *       ...
+ *       arena_reset(&arena);                    // Free the whole batch
+ *   }
+ *   arena_free(&arena);
+ *
+ * Scoped temporaries:
+ *   ArenaMarker mark = arena_mark(&arena);
+ *   scratch = arena_alloc(&arena, n);
+ *   arena_rewind(&arena, mark);                 // Frees only 'scratch'
+ *
+ * NOT THREAD-SAFE: use one arena per thread.
+ * ============================================================================
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#define ARENA_DEFAULT_ALIGN _Alignof(max_align_t)
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;        // Retained after reset for reuse
+    size_t capacity;                // Bytes in data[]
+    size_t used;                    // Bump offset into data[]
+    unsigned char data[];
+} ArenaChunk;
+
+typedef struct {
+    ArenaChunk *first;              // Oldest chunk (reset target)
+    ArenaChunk *current;            // Chunk being bumped
+    size_t chunk_size;              // Minimum size of a new chunk
+    void *last;                     // Most recent allocation (for arena_realloc)
+    size_t reserved;                // Bytes obtained from malloc
+} Arena;
+
+/**
+ * Saved arena position for arena_rewind()
+ */
+typedef struct {
+    ArenaChunk *chunk;
+    size_t used;
+} ArenaMarker;
+
+/**
+ * Initialize an empty arena (no memory is reserved until first use).
+ * chunk_size = 0 selects ARENA_DEFAULT_CHUNK_SIZE.
+ */
+void arena_init(Arena *arena, size_t chunk_size);
+
+/**
+ * Release every chunk back to malloc
+ */
+void arena_free(Arena *arena);
+
+/**
+ * Slow path: move to (or allocate) a chunk with room for size + align
+ */
+void* arena_alloc_slow(Arena *arena, size_t size, size_t align);
+
+/**
+ * Allocate 'size' bytes aligned to 'align' (a power of two).
+ * Returns: pointer valid until the next reset/rewind past it, NULL on OOM
+ *
+ * Time Complexity: O(1) - inline bump on the fast path
+ */
+static inline void* arena_alloc_aligned(Arena *arena, size_t size, size_t align) {
+    ArenaChunk *chunk = arena->current;
+    if (chunk != NULL) {
+        uintptr_t base = (uintptr_t)chunk->data;
+        uintptr_t top = (base + chunk->used + (align - 1)) & ~(uintptr_t)(align - 1);
+        if (top - base <= chunk->capacity && size <= chunk->capacity - (top - base)) {
+            chunk->used = (top - base) + size;
+            arena->last = (void*)top;
+            return (void*)top;
+        }
+    }
+    return arena_alloc_slow(arena, size, align);
+}
+
+/**
+ * Allocate with malloc-compatible alignment
+ */
+static inline void* arena_alloc(Arena *arena, size_t size) {
+    return arena_alloc_aligned(arena, size, ARENA_DEFAULT_ALIGN);
+}
+
+/**
+ * Grow or shrink an allocation. The most recent allocation is resized in
+ * place when its chunk has room; otherwise the data is copied to a new
+ * block (the old block is reclaimed at the next reset).
+ * Returns: new pointer, NULL on OOM (old block stays valid)
+ */
+void* arena_realloc(Arena *arena, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * Copy 'length' bytes of a string into the arena and NUL-terminate it
+ */
+char* arena_strndup(Arena *arena, const char *text, size_t length);
+
+/**
+ * Free everything allocated so far; chunks are kept for reuse.
+ *
+ * Time Complexity: O(1)
+ */
+void arena_reset(Arena *arena);
+
+/**
+ * Save / restore the current position: arena_rewind() frees everything
+ * allocated after arena_mark(), in O(1)
+ */
+ArenaMarker arena_mark(const Arena *arena);
+void arena_rewind(Arena *arena, ArenaMarker marker);
+
+/**
+ * Introspection helpers
+ */
+size_t arena_bytes_used(const Arena *arena);       // Live bytes incl. padding
+size_t arena_bytes_reserved(const Arena *arena);   // Bytes obtained from malloc
+
+#endif /* ARENA_H */
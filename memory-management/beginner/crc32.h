@@ -0,0 +1,88 @@
+/**
+ * ============================================================================
+ * crc32.h - Table-Driven and Hardware-Accelerated CRC32 / CRC32C
+ * ============================================================================
+ *
+ * PURPOSE:
+ * Production CRC engine behind the crc32_byte() lookup-table example in
+ * stack_vs_heap.c. Two polynomials are provided:
+ * - CRC32  (IEEE 802.3, 0xEDB88320 reflected): zip, PNG, Ethernet
+ * - CRC32C (Castagnoli, 0x82F63B78 reflected): iSCSI, ext4, SSE4.2 crc32
+ *
+ * IMPLEMENTATIONS (fastest available picked at runtime):
+ * Impl        | Bytes/step | Approx. throughput (x86-64, 3 GHz)
+ * ------------|------------|------------------------------------
+ * Bytewise    | 1          | ~0.4 GB/s  (1 lookup per byte)
+ * Slicing-8   | 8          | ~2-3 GB/s  (8 independent lookups)
+ * Slicing-16  | 16         | ~3-4 GB/s  (16 lookups, 16KB of tables)
+ * Hardware    | 16-64      | ~8-30 GB/s (PCLMUL folding / crc32 insn)
+ *
+ * Hardware paths:
+ * - CRC32 on x86:   PCLMULQDQ carry-less multiply folding (4x128-bit lanes)
+ * - CRC32C on x86:  SSE4.2 crc32 instruction (8 bytes per instruction)
+ * - ARMv8:          __crc32d / __crc32cd when built with +crc
+ *
+ * USAGE:
+ *   uint32_t crc = 0;
+ *   crc = crc32_update(crc, chunk1, len1);   // Chunking does not matter
+ *   crc = crc32_update(crc, chunk2, len2);
+ *
+ * ============================================================================
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Available implementations (for benchmarking / forcing a path)
+ */
+typedef enum {
+    CRC32_IMPL_BYTEWISE,
+    CRC32_IMPL_SLICE8,
+    CRC32_IMPL_SLICE16,
+    CRC32_IMPL_HARDWARE,
+    CRC32_IMPL_COUNT
+} Crc32Impl;
+
+/**
+ * Full 256-entry byte tables, emitted as constants at compile time
+ */
+extern const uint32_t crc32_table[256];
+extern const uint32_t crc32c_table[256];
+
+/**
+ * Build the slicing tables and probe CPU features.
+ * Called automatically on first use and safe to race: one thread builds,
+ * the others wait for it. Call it up front to keep the one-time cost
+ * (~16K table entries) out of a timed region.
+ */
+void crc32_init(void);
+
+/**
+ * Extend a running checksum; start with crc = 0.
+ * Dispatches to the fastest implementation on this CPU.
+ */
+uint32_t crc32_update(uint32_t crc, const void *data, size_t length);
+uint32_t crc32c_update(uint32_t crc, const void *data, size_t length);
+
+/**
+ * Same as above, but with an explicit implementation.
+ * Falls back to slicing-16 if 'impl' is not available.
+ */
+uint32_t crc32_update_impl(Crc32Impl impl, uint32_t crc, const void *data, size_t length);
+uint32_t crc32c_update_impl(Crc32Impl impl, uint32_t crc, const void *data, size_t length);
+
+/**
+ * Introspection helpers
+ */
+const char* crc32_impl_name(Crc32Impl impl);
+bool crc32_has_hardware(void);
+bool crc32c_has_hardware(void);
+const char* crc32_hardware_name(void);   /* e.g. "PCLMULQDQ", "none" */
+const char* crc32c_hardware_name(void);  /* e.g. "SSE4.2 crc32", "none" */
+
+#endif /* CRC32_H */
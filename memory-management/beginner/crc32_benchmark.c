@@ -0,0 +1,155 @@
+/**
+ * ============================================================================
+ * crc32_benchmark.c - CRC32 / CRC32C Throughput in GB/s
+ * ============================================================================
+ *
+ * PURPOSE:
+ * Checks every CRC implementation in crc32.c against known test vectors,
+ * then measures throughput for buffer sizes from L1-resident (4KB) to
+ * DRAM-resident (64MB).
+ *
+ * WHAT TO EXPECT:
+ * - Bytewise is latency-bound: one dependent table lookup per byte
+ * - Slicing-8/16 overlap independent lookups: ~5-10x faster
+ * - Hardware paths are limited by load bandwidth on large buffers
+ *
+ * COMPILATION:
+ * gcc -O2 crc32_benchmark.c crc32.c -o crc32_benchmark
+ *
+ * ============================================================================
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "crc32.h"
+
+#define MIN_RUN_SECONDS 0.2
+
+/**
+ * Monotonic wall clock in seconds (clock() would measure CPU time only)
+ */
+static double now_seconds(void) {
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * Verify all implementations against the standard "123456789" check values
+ * and against each other on an odd-length, misaligned buffer
+ */
+static int self_test(const unsigned char *buffer, size_t length) {
+    const char *check = "123456789";
+    int failures = 0;
+    
+    uint32_t ref32 = crc32_update_impl(CRC32_IMPL_BYTEWISE, 0, buffer + 1, length - 1);
+    uint32_t ref32c = crc32c_update_impl(CRC32_IMPL_BYTEWISE, 0, buffer + 1, length - 1);
+    
+    for (int impl = 0; impl < CRC32_IMPL_COUNT; impl++) {
+        uint32_t a = crc32_update_impl((Crc32Impl)impl, 0, check, 9);
+        uint32_t b = crc32c_update_impl((Crc32Impl)impl, 0, check, 9);
+        uint32_t c = crc32_update_impl((Crc32Impl)impl, 0, buffer + 1, length - 1);
+        uint32_t d = crc32c_update_impl((Crc32Impl)impl, 0, buffer + 1, length - 1);
+        bool ok = a == 0xCBF43926u && b == 0xE3069283u && c == ref32 && d == ref32c;
+        
+        printf("  %-10s CRC32=0x%08X CRC32C=0x%08X  %s\n",
+               crc32_impl_name((Crc32Impl)impl), (unsigned)a, (unsigned)b,
+               ok ? "OK" : "MISMATCH");
+        if (!ok) {
+            failures++;
+        }
+    }
+    
+    /* Chunked updates must equal one-shot */
+    uint32_t chunked = crc32_update(crc32_update(0, buffer, 1000), buffer + 1000, length - 1000);
+    if (chunked != crc32_update(0, buffer, length)) {
+        printf("  chunked update MISMATCH\n");
+        failures++;
+    }
+    
+    return failures;
+}
+
+/**
+ * Time one implementation on 'length' bytes; repeats until the run is
+ * long enough to be measurable, returns GB/s
+ */
+static double measure(Crc32Impl impl, bool castagnoli, const unsigned char *buffer,
+                      size_t length, volatile uint32_t *sink) {
+    size_t reps = 1;
+    for (;;) {
+        uint32_t crc = 0;
+        double start = now_seconds();
+        for (size_t r = 0; r < reps; r++) {
+            crc = castagnoli ? crc32c_update_impl(impl, crc, buffer, length)
+                             : crc32_update_impl(impl, crc, buffer, length);
+        }
+        double elapsed = now_seconds() - start;
+        *sink = crc;   /* Keeps the compiler from discarding the loop */
+        
+        if (elapsed >= MIN_RUN_SECONDS) {
+            return ((double)length * (double)reps) / elapsed / 1e9;
+        }
+        reps *= 2;
+    }
+}
+
+int main(void) {
+    const size_t sizes[] = { 4 * 1024, 256 * 1024, 64 * 1024 * 1024 };
+    const size_t max_size = sizes[2];
+    volatile uint32_t sink = 0;
+    
+    printf("=================================================\n");
+    printf("  CRC32 / CRC32C Throughput\n");
+    printf("=================================================\n\n");
+    
+    crc32_init();
+    printf("CRC32  hardware: %s\n", crc32_hardware_name());
+    printf("CRC32C hardware: %s\n\n", crc32c_hardware_name());
+    
+    unsigned char *buffer = malloc(max_size);
+    if (buffer == NULL) {
+        fprintf(stderr, "Allocation failed!\n");
+        return 1;
+    }
+    srand(12345);
+    for (size_t i = 0; i < max_size; i++) {
+        buffer[i] = (unsigned char)rand();
+    }
+    
+    printf("--- Self Test ---\n");
+    int failures = self_test(buffer, 100003);
+    
+    for (int poly = 0; poly < 2; poly++) {
+        printf("\n--- %s throughput (GB/s) ---\n", poly ? "CRC32C" : "CRC32");
+        printf("  %-10s %10s %10s %10s\n", "impl", "4KB", "256KB", "64MB");
+        for (int impl = 0; impl < CRC32_IMPL_COUNT; impl++) {
+            bool hw = poly ? crc32c_has_hardware() : crc32_has_hardware();
+            if (impl == CRC32_IMPL_HARDWARE && !hw) {
+                printf("  %-10s %10s\n", crc32_impl_name((Crc32Impl)impl), "n/a");
+                continue;
+            }
+            printf("  %-10s", crc32_impl_name((Crc32Impl)impl));
+            for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+                printf(" %10.2f", measure((Crc32Impl)impl, poly != 0, buffer, sizes[s], &sink));
+            }
+            printf("\n");
+        }
+    }
+    
+    free(buffer);
+    
+    printf("\n=================================================\n");
+    printf("%s\n", failures == 0 ? "All implementations agree" : "SELF TEST FAILED");
+    printf("=================================================\n");
+    
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+/**
+ * ============================================================================
+ * packet_pool.c - Packet Buffer Pool and Scatter-Gather Descriptors
+ * ============================================================================
+ *
+ * See packet_pool.h for the layout and cost model. Buffer alloc / free
+ * are inline in the header; this file holds the operations that walk a
+ * packet's segment list.
+ *
+ * ============================================================================
+ */
+
+#include "packet_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void* aligned_block(size_t bytes) {
+#ifdef _WIN32
+    return _aligned_malloc(bytes, PACKET_BUFFER_ALIGN);
+#else
+    return aligned_alloc(PACKET_BUFFER_ALIGN, bytes);   // bytes is a multiple of 2048
+#endif
+}
+
+static void aligned_block_free(void *block) {
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+
+static inline void prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+bool packet_pool_init(PacketPool *pool, size_t buffer_count) {
+    memset(pool, 0, sizeof(*pool));
+    if (buffer_count == 0 || buffer_count > UINT32_MAX ||
+        buffer_count > SIZE_MAX / PACKET_BUFFER_SIZE) {
+        return false;
+    }
+
+    pool->memory = aligned_block(buffer_count * PACKET_BUFFER_SIZE);
+    pool->buffers = malloc(buffer_count * sizeof(PacketBuffer));
+    pool->free_stack = malloc(buffer_count * sizeof(uint32_t));
+    if (pool->memory == NULL || pool->buffers == NULL || pool->free_stack == NULL) {
+        packet_pool_destroy(pool);
+        return false;
+    }
+
+    for (size_t i = 0; i < buffer_count; i++) {
+        pool->buffers[i].data = pool->memory + i * PACKET_BUFFER_SIZE;
+        pool->buffers[i].refcount = 0;
+        pool->buffers[i].index = (uint32_t)i;
+        // Buffer 0 on top of the stack: the first packets fill memory in order
+        pool->free_stack[i] = (uint32_t)(buffer_count - 1 - i);
+    }
+    pool->buffer_count = buffer_count;
+    pool->free_count = buffer_count;
+    return true;
+}
+
+void packet_pool_destroy(PacketPool *pool) {
+    if (pool->memory != NULL) {
+        aligned_block_free(pool->memory);
+    }
+    free(pool->buffers);
+    free(pool->free_stack);
+    memset(pool, 0, sizeof(*pool));
+}
+
+bool packet_receive(PacketPool *pool, Packet *packet, const uint8_t *data, size_t length) {
+    packet->segment_count = 0;
+    packet->length = 0;
+    size_t needed = (length + PACKET_BUFFER_SIZE - 1) / PACKET_BUFFER_SIZE;
+    if (needed > PACKET_MAX_SEGMENTS || needed > pool->free_count) {
+        return false;
+    }
+
+    while (packet->length < length) {
+        size_t chunk = length - packet->length;
+        if (chunk > PACKET_BUFFER_SIZE) chunk = PACKET_BUFFER_SIZE;
+
+        PacketBuffer *buffer = packet_buffer_alloc(pool);    // Cannot fail: checked above
+        memcpy(buffer->data, data + packet->length, chunk);
+        packet->segments[packet->segment_count++] = (PacketSegment){ buffer->data, chunk, buffer };
+        packet->length += chunk;
+    }
+    return true;
+}
+
+bool packet_slice(const Packet *packet, size_t offset, size_t length, Packet *view) {
+    view->segment_count = 0;
+    view->length = 0;
+    if (offset > packet->length || length > packet->length - offset) {
+        return false;
+    }
+
+    for (size_t i = 0; i < packet->segment_count && view->length < length; i++) {
+        const PacketSegment *segment = &packet->segments[i];
+        if (offset >= segment->length) {
+            offset -= segment->length;              // Range starts in a later segment
+            continue;
+        }
+        size_t chunk = segment->length - offset;
+        if (chunk > length - view->length) chunk = length - view->length;
+
+        packet_buffer_ref(segment->buffer);
+        view->segments[view->segment_count++] =
+            (PacketSegment){ segment->base + offset, chunk, segment->buffer };
+        view->length += chunk;
+        offset = 0;
+    }
+    return true;
+}
+
+void packet_release(PacketPool *pool, Packet *packet) {
+    for (size_t i = 0; i < packet->segment_count; i++) {
+        packet_buffer_unref(pool, packet->segments[i].buffer);
+    }
+    packet->segment_count = 0;
+    packet->length = 0;
+}
+
+size_t packet_read(const Packet *packet, size_t offset, void *out, size_t length) {
+    uint8_t *dst = out;
+    size_t copied = 0;
+    for (size_t i = 0; i < packet->segment_count && copied < length; i++) {
+        const PacketSegment *segment = &packet->segments[i];
+        if (offset >= segment->length) {
+            offset -= segment->length;
+            continue;
+        }
+        size_t chunk = segment->length - offset;
+        if (chunk > length - copied) chunk = length - copied;
+        memcpy(dst + copied, segment->base + offset, chunk);
+        copied += chunk;
+        offset = 0;
+    }
+    return copied;
+}
+
+const uint8_t* packet_header(const Packet *packet, size_t length, void *scratch) {
+    if (length > packet->length) return NULL;
+    if (packet->segment_count > 0 && packet->segments[0].length >= length) {
+        return packet->segments[0].base;
+    }
+    packet_read(packet, 0, scratch, length);
+    return scratch;
+}
+
+size_t packet_process_burst(PacketPool *pool, Packet *packets, size_t count,
+                            PacketHandler handler, void *context) {
+    if (count > 0 && packets[0].segment_count > 0) {
+        prefetch(packets[0].segments[0].base);
+    }
+    for (size_t i = 0; i < count; i++) {
+        // Start loading the next packet's header while this one is handled
+        if (i + 1 < count && packets[i + 1].segment_count > 0) {
+            prefetch(packets[i + 1].segments[0].base);
+        }
+        handler(&packets[i], context);
+    }
+    // Release after the whole burst: the free stack is touched in one pass
+    for (size_t i = 0; i < count; i++) {
+        packet_release(pool, &packets[i]);
+    }
+    return count;
+}
+
+#ifdef PACKET_HAVE_IOVEC
+size_t packet_to_iovec(const Packet *packet, struct iovec *iov, size_t max) {
+    size_t n = packet->segment_count < max ? packet->segment_count : max;
+    for (size_t i = 0; i < n; i++) {
+        iov[i].iov_base = packet->segments[i].base;
+        iov[i].iov_len = packet->segments[i].length;
+    }
+    return n;
+}
+#endif
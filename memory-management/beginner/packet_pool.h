@@ -0,0 +1,207 @@
+/**
+ * ============================================================================
+ * packet_pool.h - Zero-Copy Packet Pipeline (Buffer Pool + Scatter-Gather)
+ * ============================================================================
+ *
+ * PURPOSE:
+ * process_packet() in stack_vs_heap.c copies every packet into a 256-byte
+ * stack buffer and rejects anything larger. Here packets are received
+ * ONCE into buffers from a fixed pool, and every later stage works on
+ * descriptors that point into those buffers:
+ * - No per-packet malloc: buffers come from a preallocated pool
+ * - No per-stage memcpy: handlers get views (pointer + length), and a
+ *   sub-range of a packet (e.g. the payload after a header) is a new
+ *   descriptor sharing the same buffers
+ * - No size limit from a stack array: a packet larger than one buffer
+ *   spans several (up to PACKET_MAX_SEGMENTS), iovec style
+ *
+ * LAYOUT:
+ *   PacketPool.memory   [buf 0: 2KB][buf 1: 2KB][buf 2: 2KB] ...  (64B aligned)
+ *   PacketPool.buffers  {data, refcount} per buffer (kept apart from the data
+ *                       so refcount updates never dirty packet cache lines)
+ *
+ *   Packet              segments[]: {base, length, buffer}
+ *                                     |
+ *   3000-byte packet:   [buf 7: 2048 bytes] -> [buf 2: 952 bytes]
+ *
+ * Every segment holds one reference on its buffer. A buffer goes back to
+ * the pool when its last reference is released, so a view can outlive the
+ * packet it was sliced from.
+ *
+ * COST MODEL:
+ * Operation            | Copy per stage            | Pool + views
+ * ---------------------|---------------------------|----------------------
+ * Get a buffer         | stack / malloc per packet | LIFO pop (cache-warm)
+ * Hand to a handler    | memcpy(len)               | pass a descriptor
+ * Take a sub-range     | memcpy(sub-len)           | O(segments) + refcount
+ * Packets > 1 buffer   | rejected or realloc'd     | chained segments
+ *
+ * BURSTS:
+ * packet_process_burst() runs a handler over up to PACKET_BURST_MAX
+ * packets in one call, prefetching the next packet's first line while the
+ * current one is handled, then returns all their buffers to the pool.
+ *
+ * USAGE:
+ *   PacketPool pool;
+ *   packet_pool_init(&pool, 1024);
+ *   Packet burst[PACKET_BURST_MAX];
+ *   size_t n = 0;
+ *   while (n < PACKET_BURST_MAX && frame_ready())
+ *       packet_receive(&pool, &burst[n++], frame, frame_length);
+ *   packet_process_burst(&pool, burst, n, handler, context);
+ *   packet_pool_destroy(&pool);
+ *
+ * NOT THREAD-SAFE: one pool per thread (run-to-completion packet loop).
+ * ============================================================================
+ */
+
+#ifndef PACKET_POOL_H
+#define PACKET_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PACKET_HAVE_IOVEC 1
+#include <sys/uio.h>
+#endif
+
+#define PACKET_BUFFER_SIZE 2048     // Data bytes per buffer (one Ethernet frame)
+#define PACKET_BUFFER_ALIGN 64      // Each buffer starts on a cache line
+#define PACKET_MAX_SEGMENTS 8       // Largest packet: 8 x 2KB = 16KB
+#define PACKET_BURST_MAX 32
+
+typedef struct {
+    uint8_t *data;                  // PACKET_BUFFER_SIZE bytes in pool memory
+    uint32_t refcount;              // 0 = on the free list
+    uint32_t index;                 // Position in PacketPool.buffers
+} PacketBuffer;
+
+typedef struct {
+    uint8_t *memory;                // buffer_count * PACKET_BUFFER_SIZE, aligned
+    PacketBuffer *buffers;
+    uint32_t *free_stack;           // Indices of free buffers (LIFO)
+    size_t free_count;
+    size_t buffer_count;
+} PacketPool;
+
+/**
+ * One contiguous piece of a packet. base/length mirror struct iovec.
+ */
+typedef struct {
+    uint8_t *base;
+    size_t length;
+    PacketBuffer *buffer;           // Owns one reference
+} PacketSegment;
+
+/**
+ * Scatter-gather packet descriptor (or a view into another packet)
+ */
+typedef struct {
+    PacketSegment segments[PACKET_MAX_SEGMENTS];
+    size_t segment_count;
+    size_t length;                  // Sum of segment lengths
+} Packet;
+
+/**
+ * Handler for packet_process_burst(). The packet (and its buffers) is
+ * valid for the duration of the call; use packet_slice() to keep a view.
+ */
+typedef void (*PacketHandler)(const Packet *packet, void *context);
+
+/**
+ * Allocate 'buffer_count' buffers in one aligned block
+ * Returns: false on allocation failure (pool left empty)
+ */
+bool packet_pool_init(PacketPool *pool, size_t buffer_count);
+
+/**
+ * Free the pool. Outstanding packets and views become invalid.
+ */
+void packet_pool_destroy(PacketPool *pool);
+
+static inline size_t packet_pool_available(const PacketPool *pool) {
+    return pool->free_count;
+}
+
+/**
+ * Take a buffer with refcount 1
+ * Returns: NULL when the pool is exhausted
+ *
+ * Time Complexity: O(1)
+ */
+static inline PacketBuffer* packet_buffer_alloc(PacketPool *pool) {
+    if (pool->free_count == 0) return NULL;
+    PacketBuffer *buffer = &pool->buffers[pool->free_stack[--pool->free_count]];
+    buffer->refcount = 1;
+    return buffer;
+}
+
+static inline void packet_buffer_ref(PacketBuffer *buffer) {
+    buffer->refcount++;
+}
+
+/**
+ * Drop one reference; the last one returns the buffer to the pool.
+ * LIFO: the next alloc gets the buffer that was just touched (still in cache).
+ */
+static inline void packet_buffer_unref(PacketPool *pool, PacketBuffer *buffer) {
+    if (--buffer->refcount == 0) {
+        pool->free_stack[pool->free_count++] = buffer->index;
+    }
+}
+
+/**
+ * Copy 'length' bytes (a received frame) into pool buffers, chaining as
+ * many as needed. This is the one copy in the pipeline; on hardware the
+ * NIC / DMA writes straight into pool buffers instead.
+ * Returns: false if the frame needs more than PACKET_MAX_SEGMENTS buffers
+ *          or the pool runs dry (nothing is kept in that case)
+ */
+bool packet_receive(PacketPool *pool, Packet *packet, const uint8_t *data, size_t length);
+
+/**
+ * View of bytes [offset, offset + length) of 'packet' without copying:
+ * the view's segments point into the same buffers and take a reference
+ * on each. Release it with packet_release() like any packet.
+ * Returns: false if the range is outside the packet
+ */
+bool packet_slice(const Packet *packet, size_t offset, size_t length, Packet *view);
+
+/**
+ * Drop the packet's references (buffers no longer referenced return to
+ * the pool) and leave it empty
+ */
+void packet_release(PacketPool *pool, Packet *packet);
+
+/**
+ * Gather-copy bytes [offset, offset + length) into 'out'
+ * Returns: bytes copied (less than length at the end of the packet)
+ */
+size_t packet_read(const Packet *packet, size_t offset, void *out, size_t length);
+
+/**
+ * Pointer to the first 'length' bytes (e.g. a header) as one contiguous
+ * block: straight into the first segment when it is long enough (the
+ * common case, no copy), otherwise gathered into 'scratch'.
+ * Returns: NULL if the packet is shorter than 'length'
+ */
+const uint8_t* packet_header(const Packet *packet, size_t length, void *scratch);
+
+/**
+ * Run 'handler' on each of 'count' packets, then release all of them.
+ * Returns: packets handled
+ */
+size_t packet_process_burst(PacketPool *pool, Packet *packets, size_t count,
+                            PacketHandler handler, void *context);
+
+#ifdef PACKET_HAVE_IOVEC
+/**
+ * Fill 'iov' with the packet's segments for writev()/sendmsg()
+ * Returns: entries written (at most 'max')
+ */
+size_t packet_to_iovec(const Packet *packet, struct iovec *iov, size_t max);
+#endif
+
+#endif // PACKET_POOL_H
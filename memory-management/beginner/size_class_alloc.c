@@ -0,0 +1,545 @@
+/**
+ * ============================================================================
+ * size_class_alloc.c - Spans, Central Depot and Thread Caches
+ * ============================================================================
+ *
+ * See size_class_alloc.h for the overview.
+ *
+ * SPAN LAYOUT (SC_SPAN_SIZE bytes, SC_SPAN_SIZE-aligned):
+ *   [ScSpan header | obj 0 | obj 1 | ... | obj n-1 | tail slack]
+ * Objects are handed out by bumping 'bump' until the span is carved,
+ * then from the span's own free list. 'in_use' counts objects outside
+ * the span (in thread caches or held by the application); when it drops
+ * to zero the span is unmapped, unless it is the last one of its class.
+ *
+ * LOCKING:
+ * Thread caches are _Thread_local and never locked. Each class has its
+ * own depot mutex, so threads using different sizes never contend.
+ * Global counters are relaxed atomics: they are statistics, not
+ * synchronization.
+ *
+ * ============================================================================
+ */
+
+#define _DEFAULT_SOURCE     /* MAP_ANONYMOUS */
+#include "size_class_alloc.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_PTHREADS 1
+#define HAVE_MMAP 1
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#else
+#include <stdlib.h>
+#endif
+
+#if defined(__linux__)
+#include <stdio.h>
+#endif
+
+#define SC_LARGE_CLASS UINT32_MAX
+#define SC_SPAN_HEADER 128      // sizeof(ScSpan) rounded up, keeps objects 16-aligned
+#define SC_BATCH_BYTES (16 * 1024)
+#define SC_MAX_BATCH 32
+
+typedef struct ScSpan {
+    struct ScSpan *prev;        // Depot partial list (spans with free objects)
+    struct ScSpan *next;
+    void *free_list;            // Returned objects
+    unsigned char *bump;        // Next never-used object
+    unsigned char *end;         // End of the last whole object
+    size_t mapped;              // Bytes of this mapping
+    uint32_t size_class;        // SC_LARGE_CLASS for a single large object
+    uint32_t in_use;            // Objects outside the span
+    bool in_partial;
+} ScSpan;
+
+_Static_assert(sizeof(ScSpan) <= SC_SPAN_HEADER, "span header too large");
+
+typedef struct {
+    void *head;                 // Objects linked through their first word
+    uint32_t count;
+} ScFreeList;
+
+typedef struct ScThreadCache {
+    ScFreeList lists[SC_NUM_CLASSES];
+    atomic_size_t cached_bytes; // Written by the owner only, read by stats
+    struct ScThreadCache *next; // Registry of live caches
+    bool registered;
+} ScThreadCache;
+
+typedef struct {
+#ifdef HAVE_PTHREADS
+    pthread_mutex_t lock;
+#endif
+    ScSpan *partial;
+    size_t partial_count;
+} ScDepot;
+
+static ScDepot depots[SC_NUM_CLASSES];
+static _Thread_local ScThreadCache thread_cache;
+
+static atomic_size_t mapped_bytes;
+static atomic_size_t in_use_bytes;      // Outside spans, including thread caches
+static atomic_size_t span_count;
+static atomic_size_t large_count;
+
+#ifdef HAVE_PTHREADS
+static pthread_once_t init_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cache_key;
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+#define SC_LOCK(m) pthread_mutex_lock(m)
+#define SC_UNLOCK(m) pthread_mutex_unlock(m)
+#else
+#define SC_LOCK(m) ((void)0)
+#define SC_UNLOCK(m) ((void)0)
+#endif
+static ScThreadCache *registry;
+
+/* ============================================================================
+ * Size classes
+ * ============================================================================
+ */
+
+static size_t class_size(uint32_t c) {
+    if (c < 8) {
+        return 16u * (c + 1);
+    }
+    uint32_t k = c - 8;
+    uint32_t lg = 7 + k / 4;
+    return ((size_t)1 << lg) + (size_t)(k % 4 + 1) * ((size_t)1 << (lg - 2));
+}
+
+static int floor_log2(size_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll((unsigned long long)value);
+#else
+    int lg = 0;
+    while (value >>= 1) {
+        lg++;
+    }
+    return lg;
+#endif
+}
+
+/**
+ * Round a small request (1..SC_MAX_SMALL_SIZE) to its class index
+ */
+static uint32_t size_to_class(size_t size) {
+    if (size <= 128) {
+        return size == 0 ? 0 : (uint32_t)((size + 15) / 16 - 1);
+    }
+    int lg = floor_log2(size - 1);              // size in (2^lg, 2^(lg+1)]
+    uint32_t quarter = (uint32_t)((size - 1) >> (lg - 2)) & 3;
+    return 8 + (uint32_t)(lg - 7) * 4 + quarter;
+}
+
+static uint32_t batch_count(uint32_t c) {
+    size_t n = SC_BATCH_BYTES / class_size(c);
+    return n < 2 ? 2 : (n > SC_MAX_BATCH ? SC_MAX_BATCH : (uint32_t)n);
+}
+
+static ScSpan* span_of(const void *ptr) {
+    return (ScSpan*)((uintptr_t)ptr & ~(uintptr_t)(SC_SPAN_SIZE - 1));
+}
+
+/* ============================================================================
+ * OS memory (SC_SPAN_SIZE-aligned mappings)
+ * ============================================================================
+ */
+
+static void* map_aligned(size_t bytes) {
+#ifdef HAVE_MMAP
+    // Over-map by one span, then trim to an aligned window
+    size_t padded = bytes + SC_SPAN_SIZE;
+    unsigned char *raw = mmap(NULL, padded, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return NULL;
+    }
+    uintptr_t start = ((uintptr_t)raw + SC_SPAN_SIZE - 1) & ~(uintptr_t)(SC_SPAN_SIZE - 1);
+    size_t head = (size_t)(start - (uintptr_t)raw);
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    if (padded - head > bytes) {
+        munmap((unsigned char*)start + bytes, padded - head - bytes);
+    }
+    return (void*)start;
+#else
+    return aligned_alloc(SC_SPAN_SIZE, bytes);
+#endif
+}
+
+static void unmap_aligned(void *ptr, size_t bytes) {
+#ifdef HAVE_MMAP
+    munmap(ptr, bytes);
+#else
+    (void)bytes;
+    free(ptr);
+#endif
+}
+
+/* ============================================================================
+ * Initialization and thread-cache registry
+ * ============================================================================
+ */
+
+#ifdef HAVE_PTHREADS
+static void thread_exit_flush(void *cache) {
+    (void)cache;
+    sc_thread_flush();
+    pthread_mutex_lock(&registry_lock);
+    for (ScThreadCache **link = &registry; *link != NULL; link = &(*link)->next) {
+        if (*link == &thread_cache) {
+            *link = thread_cache.next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&registry_lock);
+    thread_cache.registered = false;
+}
+
+static void init_once_routine(void) {
+    for (int c = 0; c < SC_NUM_CLASSES; c++) {
+        pthread_mutex_init(&depots[c].lock, NULL);
+    }
+    pthread_key_create(&cache_key, thread_exit_flush);
+}
+#endif
+
+static void register_thread_cache(void) {
+#ifdef HAVE_PTHREADS
+    pthread_once(&init_once, init_once_routine);
+    pthread_mutex_lock(&registry_lock);
+    thread_cache.next = registry;
+    registry = &thread_cache;
+    pthread_mutex_unlock(&registry_lock);
+    // Non-NULL value so the destructor runs at thread exit
+    pthread_setspecific(cache_key, &thread_cache);
+#else
+    thread_cache.next = registry;
+    registry = &thread_cache;
+#endif
+    thread_cache.registered = true;
+}
+
+/**
+ * Owner-only update: a relaxed load + store (plain moves), not a locked add
+ */
+static inline void cached_add(size_t bytes) {
+    size_t value = atomic_load_explicit(&thread_cache.cached_bytes, memory_order_relaxed);
+    atomic_store_explicit(&thread_cache.cached_bytes, value + bytes, memory_order_relaxed);
+}
+
+static inline void cached_sub(size_t bytes) {
+    size_t value = atomic_load_explicit(&thread_cache.cached_bytes, memory_order_relaxed);
+    atomic_store_explicit(&thread_cache.cached_bytes, value - bytes, memory_order_relaxed);
+}
+
+/* ============================================================================
+ * Central depot
+ * ============================================================================
+ */
+
+static void partial_push(ScDepot *depot, ScSpan *span) {
+    span->prev = NULL;
+    span->next = depot->partial;
+    if (depot->partial != NULL) {
+        depot->partial->prev = span;
+    }
+    depot->partial = span;
+    span->in_partial = true;
+    depot->partial_count++;
+}
+
+static void partial_remove(ScDepot *depot, ScSpan *span) {
+    if (span->prev != NULL) {
+        span->prev->next = span->next;
+    } else {
+        depot->partial = span->next;
+    }
+    if (span->next != NULL) {
+        span->next->prev = span->prev;
+    }
+    span->in_partial = false;
+    depot->partial_count--;
+}
+
+static ScSpan* new_span(uint32_t size_class) {
+    ScSpan *span = map_aligned(SC_SPAN_SIZE);
+    if (span == NULL) {
+        return NULL;
+    }
+    size_t object = class_size(size_class);
+    size_t objects = (SC_SPAN_SIZE - SC_SPAN_HEADER) / object;
+    span->free_list = NULL;
+    span->bump = (unsigned char*)span + SC_SPAN_HEADER;
+    span->end = span->bump + objects * object;
+    span->mapped = SC_SPAN_SIZE;
+    span->size_class = size_class;
+    span->in_use = 0;
+    span->in_partial = false;
+    atomic_fetch_add_explicit(&mapped_bytes, SC_SPAN_SIZE, memory_order_relaxed);
+    atomic_fetch_add_explicit(&span_count, 1, memory_order_relaxed);
+    return span;
+}
+
+/**
+ * Move up to 'want' objects of one class from the depot to 'list'
+ * Returns: number of objects moved (0 only on out of memory)
+ */
+static uint32_t refill_from_depot(uint32_t size_class, ScFreeList *list, uint32_t want) {
+    ScDepot *depot = &depots[size_class];
+    size_t object = class_size(size_class);
+    uint32_t moved = 0;
+
+    SC_LOCK(&depot->lock);
+    while (moved < want) {
+        ScSpan *span = depot->partial;
+        if (span == NULL) {
+            span = new_span(size_class);
+            if (span == NULL) {
+                break;
+            }
+            partial_push(depot, span);
+        }
+        void *obj;
+        if (span->free_list != NULL) {
+            obj = span->free_list;
+            span->free_list = *(void**)obj;
+        } else {
+            obj = span->bump;
+            span->bump += object;
+        }
+        span->in_use++;
+        if (span->free_list == NULL && span->bump == span->end) {
+            partial_remove(depot, span);        // Full: nothing left to hand out
+        }
+        *(void**)obj = list->head;
+        list->head = obj;
+        list->count++;
+        moved++;
+    }
+    SC_UNLOCK(&depot->lock);
+
+    atomic_fetch_add_explicit(&in_use_bytes, moved * object, memory_order_relaxed);
+    return moved;
+}
+
+/**
+ * Move 'count' objects from the front of 'list' back to their spans
+ */
+static void release_to_depot(uint32_t size_class, ScFreeList *list, uint32_t count) {
+    ScDepot *depot = &depots[size_class];
+    size_t object = class_size(size_class);
+    uint32_t released = 0;
+
+    SC_LOCK(&depot->lock);
+    while (released < count && list->head != NULL) {
+        void *obj = list->head;
+        list->head = *(void**)obj;
+        list->count--;
+        released++;
+
+        ScSpan *span = span_of(obj);
+        *(void**)obj = span->free_list;
+        span->free_list = obj;
+        span->in_use--;
+        if (!span->in_partial) {
+            partial_push(depot, span);
+        }
+        // Empty span: give it back to the OS, but keep one per class warm
+        // so a class that oscillates around zero does not map/unmap
+        if (span->in_use == 0 && depot->partial_count > 1) {
+            partial_remove(depot, span);
+            unmap_aligned(span, span->mapped);
+            atomic_fetch_sub_explicit(&mapped_bytes, SC_SPAN_SIZE, memory_order_relaxed);
+            atomic_fetch_sub_explicit(&span_count, 1, memory_order_relaxed);
+        }
+    }
+    SC_UNLOCK(&depot->lock);
+
+    atomic_fetch_sub_explicit(&in_use_bytes, released * object, memory_order_relaxed);
+}
+
+/* ============================================================================
+ * Large objects
+ * ============================================================================
+ */
+
+static void* large_alloc(size_t size) {
+    if (size > SIZE_MAX - SC_SPAN_HEADER - SC_SPAN_SIZE) {
+        return NULL;
+    }
+    size_t bytes = (size + SC_SPAN_HEADER + 4095) & ~(size_t)4095;
+    ScSpan *span = map_aligned(bytes);
+    if (span == NULL) {
+        return NULL;
+    }
+    span->mapped = bytes;
+    span->size_class = SC_LARGE_CLASS;
+    span->in_use = 1;
+    atomic_fetch_add_explicit(&mapped_bytes, bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&in_use_bytes, bytes - SC_SPAN_HEADER, memory_order_relaxed);
+    atomic_fetch_add_explicit(&large_count, 1, memory_order_relaxed);
+    return (unsigned char*)span + SC_SPAN_HEADER;
+}
+
+static void large_free(ScSpan *span) {
+    atomic_fetch_sub_explicit(&mapped_bytes, span->mapped, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&in_use_bytes, span->mapped - SC_SPAN_HEADER, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&large_count, 1, memory_order_relaxed);
+    unmap_aligned(span, span->mapped);
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================
+ */
+
+void* sc_malloc(size_t size) {
+    if (size > SC_MAX_SMALL_SIZE) {
+        return large_alloc(size);
+    }
+    uint32_t c = size_to_class(size);
+    ScFreeList *list = &thread_cache.lists[c];
+
+    if (list->head == NULL) {
+        if (!thread_cache.registered) {
+            register_thread_cache();
+        }
+        uint32_t got = refill_from_depot(c, list, batch_count(c));
+        if (got == 0) {
+            return NULL;
+        }
+        cached_add(got * class_size(c));
+    }
+
+    // Fast path: pop from this thread's list
+    void *obj = list->head;
+    list->head = *(void**)obj;
+    list->count--;
+    cached_sub(class_size(c));
+    return obj;
+}
+
+void sc_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    ScSpan *span = span_of(ptr);
+    uint32_t c = span->size_class;
+    if (c == SC_LARGE_CLASS) {
+        large_free(span);
+        return;
+    }
+
+    // Registered even if this thread never allocates, so its cache is
+    // counted in stats and flushed at thread exit
+    if (!thread_cache.registered) {
+        register_thread_cache();
+    }
+
+    // Fast path: push onto this thread's list
+    ScFreeList *list = &thread_cache.lists[c];
+    *(void**)ptr = list->head;
+    list->head = ptr;
+    list->count++;
+    cached_add(class_size(c));
+
+    // Too many cached: hand one batch back so other threads can reuse it
+    uint32_t batch = batch_count(c);
+    if (list->count > 2 * batch) {
+        release_to_depot(c, list, batch);
+        cached_sub(batch * class_size(c));
+    }
+}
+
+size_t sc_usable_size(const void *ptr) {
+    if (ptr == NULL) {
+        return 0;
+    }
+    const ScSpan *span = span_of(ptr);
+    if (span->size_class == SC_LARGE_CLASS) {
+        return span->mapped - SC_SPAN_HEADER;
+    }
+    return class_size(span->size_class);
+}
+
+void* sc_realloc(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return sc_malloc(size);
+    }
+    size_t usable = sc_usable_size(ptr);
+    // Same class (or shrinking by less than half): keep the block
+    if (size <= usable && size > usable / 2) {
+        return ptr;
+    }
+    void *block = sc_malloc(size);
+    if (block != NULL) {
+        memcpy(block, ptr, size < usable ? size : usable);
+        sc_free(ptr);
+    }
+    return block;
+}
+
+void sc_thread_flush(void) {
+    for (uint32_t c = 0; c < SC_NUM_CLASSES; c++) {
+        ScFreeList *list = &thread_cache.lists[c];
+        if (list->count > 0) {
+            size_t bytes = list->count * class_size(c);
+            release_to_depot(c, list, list->count);
+            cached_sub(bytes);
+        }
+    }
+}
+
+void sc_get_stats(ScStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->mapped_bytes = atomic_load_explicit(&mapped_bytes, memory_order_relaxed);
+    size_t out = atomic_load_explicit(&in_use_bytes, memory_order_relaxed);
+    stats->spans = atomic_load_explicit(&span_count, memory_order_relaxed);
+    stats->large_objects = atomic_load_explicit(&large_count, memory_order_relaxed);
+
+#ifdef HAVE_PTHREADS
+    pthread_mutex_lock(&registry_lock);
+#endif
+    for (ScThreadCache *cache = registry; cache != NULL; cache = cache->next) {
+        stats->cached_bytes += atomic_load_explicit(&cache->cached_bytes, memory_order_relaxed);
+    }
+#ifdef HAVE_PTHREADS
+    pthread_mutex_unlock(&registry_lock);
+#endif
+
+    // Counters are read one by one while other threads run:
+    // clamp so a racing snapshot stays consistent
+    if (stats->cached_bytes > out) {
+        stats->cached_bytes = out;
+    }
+    stats->in_use_bytes = out - stats->cached_bytes;
+    stats->free_bytes = stats->mapped_bytes > out ? stats->mapped_bytes - out : 0;
+    stats->fragmentation = stats->mapped_bytes > 0
+        ? (double)(stats->mapped_bytes - stats->in_use_bytes) / (double)stats->mapped_bytes
+        : 0.0;
+}
+
+size_t sc_process_rss(void) {
+#if defined(__linux__)
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm == NULL) {
+        return 0;
+    }
+    unsigned long total = 0, resident = 0;
+    int fields = fscanf(statm, "%lu %lu", &total, &resident);
+    fclose(statm);
+    return fields == 2 ? (size_t)resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,110 @@
+/**
+ * ============================================================================
+ * size_class_alloc.h - Segregated Size-Class Allocator with Thread Caches
+ * ============================================================================
+ *
+ * PURPOSE:
+ * The fix for the fragmentation shown by heap_fragmentation_demo() in
+ * stack_vs_heap.c. Instead of one free list where blocks of every size
+ * are split and coalesced, each request is rounded up to one of 36 size
+ * classes and served from spans that hold only that class:
+ * - A freed slot is always reusable by the next request of its class,
+ *   so free memory can never be "too fragmented to use"
+ * - A span whose objects are all back in the depot is returned to the
+ *   OS (one empty span per class is kept warm), so once thread caches
+ *   are flushed RSS follows the live set instead of the historical peak
+ * - Waste is bounded: at most 25% rounding inside an object
+ *
+ * SIZE CLASSES:
+ * Range          | Step      | Classes
+ * ---------------|-----------|------------------------------------
+ * 1 - 128        | 16 bytes  | 16, 32, 48, ... 128          (8)
+ * 129 - 16384    | 1/4 power | 160, 192, 224, 256, 320, ... (28)
+ * > 16384        | -         | Dedicated mapping per object
+ *
+ * STRUCTURE:
+ *   thread cache (no lock) --batch--> central depot (lock per class)
+ *                                         |
+ *                                  64KB spans (mmap, aligned)
+ *
+ * - sc_malloc/sc_free touch only the calling thread's cache: a list pop
+ *   or push, no atomics, no locks
+ * - Caches refill / drain in batches, so the per-class lock is taken
+ *   once per ~32 small operations
+ * - Spans are SC_SPAN_SIZE-aligned: sc_free finds an object's span (and
+ *   size class) by masking the pointer, with no per-object header
+ *
+ * Memory freed on a different thread goes to that thread's cache and is
+ * reused there. A thread's cache is returned to the depot when it exits.
+ * Until then it keeps up to two batches per class, and each cached
+ * object pins its span: after freeing a large working set, a long-lived
+ * thread calls sc_thread_flush() to give the spans back.
+ *
+ * USAGE:
+ *   char *p = sc_malloc(100);       // 112-byte class
+ *   sc_free(p);
+ *   ScStats stats;
+ *   sc_get_stats(&stats);           // mapped / in use / fragmentation
+ *
+ * ============================================================================
+ */
+
+#ifndef SIZE_CLASS_ALLOC_H
+#define SIZE_CLASS_ALLOC_H
+
+#include <stddef.h>
+
+#define SC_SPAN_SIZE (64 * 1024)
+#define SC_NUM_CLASSES 36
+#define SC_MAX_SMALL_SIZE 16384
+
+typedef struct {
+    size_t mapped_bytes;        // Obtained from the OS (spans + large objects)
+    size_t in_use_bytes;        // Held by the application (class-rounded)
+    size_t cached_bytes;        // Parked in thread caches
+    size_t free_bytes;          // Mapped but neither in use nor cached
+    size_t spans;               // Small-object spans currently mapped
+    size_t large_objects;       // Objects > SC_MAX_SMALL_SIZE
+    double fragmentation;       // (mapped - in_use) / mapped
+} ScStats;
+
+/**
+ * Allocate at least 'size' bytes, 16-byte aligned.
+ * Returns: NULL on out of memory
+ *
+ * Time Complexity: O(1) - O(batch) when the thread cache refills
+ */
+void* sc_malloc(size_t size);
+
+/**
+ * Release memory from sc_malloc/sc_realloc (NULL is ignored)
+ */
+void sc_free(void *ptr);
+
+/**
+ * realloc() semantics; stays in place if the size class does not change
+ */
+void* sc_realloc(void *ptr, size_t size);
+
+/**
+ * Bytes actually usable at ptr (the size class)
+ */
+size_t sc_usable_size(const void *ptr);
+
+/**
+ * Return the calling thread's cached objects to the depot, unmapping
+ * spans that become empty (done automatically at thread exit)
+ */
+void sc_thread_flush(void);
+
+/**
+ * Allocator-wide statistics (approximate while other threads run)
+ */
+void sc_get_stats(ScStats *stats);
+
+/**
+ * Resident set size of the whole process in bytes (0 if unknown)
+ */
+size_t sc_process_rss(void);
+
+#endif /* SIZE_CLASS_ALLOC_H */
@@ -32,11 +32,22 @@
  * Access          | 1-3 cycles  | 1-10 cycles
  * Fragmentation   | None        | Can be severe
  * 
+ * Arena (arena.h): heap memory with stack-like cost - bump a pointer to
+ * allocate, reset once to free a whole batch (see Parts 3 and 8)
+ * Size classes (size_class_alloc.h): heap without external fragmentation -
+ * Part 5 runs the same churn against glibc malloc and sc_malloc
+ * Packet pool (packet_pool.h): fixed, refcounted buffers and scatter-gather
+ * views - Part 9 handles packets of any size without copying them
+ * 
  * COMPILATION:
- * gcc -O2 -g stack_vs_heap.c -o stack_heap_demo
+ * gcc -O2 -g -pthread -I../../benchmarks stack_vs_heap.c crc32.c arena.c \
+ *     size_class_alloc.c packet_pool.c ../../fundamentals/intermediate/line_reader.c \
+ *     -I../../fundamentals/intermediate ../../benchmarks/perf_counters.c -o stack_heap_demo
  * 
  * PROFILING:
  * time ./stack_heap_demo
+ * (performance_comparison() also reads the CPU's hardware counters on
+ *  Linux: IPC and cache/branch/TLB misses per iteration)
  * valgrind --tool=massif ./stack_heap_demo  # Heap profiling
  * 
  * AUTHOR: C/C++ Learning Repository
@@ -50,6 +61,18 @@
 #include <stdint.h>
 #include <time.h>
 #include <stdbool.h>
+#include "crc32.h"
+#include "arena.h"
+#include "size_class_alloc.h"
+#include "line_reader.h"
+#include "perf_counters.h"
+#include "packet_pool.h"
+
+// glibc heap statistics for the fragmentation comparison (glibc 2.33+)
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#define HAVE_MALLINFO2 1
+#include <malloc.h>
+#endif
 
 /* ============================================================================
  * PART 1: Stack Allocation Basics
@@ -176,6 +199,7 @@ int* heap_lifetime_correct(void) {
  */
 
 #define ITERATIONS 1000000
+#define ARENA_BATCH 1024        // Allocations freed per arena_reset()
 
 /**
  * Measure stack allocation performance
@@ -224,6 +248,38 @@ double benchmark_heap(void) {
     return (double)(end - start) / CLOCKS_PER_SEC;
 }
 
+/**
+ * Measure arena allocation performance: same allocations as
+ * benchmark_heap(), freed with one arena_reset() per ARENA_BATCH
+ * 
+ * Expected: Close to stack (inline pointer bump, no per-object free)
+ */
+double benchmark_arena(void) {
+    Arena arena;
+    arena_init(&arena, 0);
+    clock_t start = clock();
+    
+    for (int i = 0; i < ITERATIONS; i++) {
+        // Allocate from arena
+        char* buffer = arena_alloc(&arena, 256);
+        
+        if (buffer) {
+            // Use buffer
+            buffer[0] = (char)i;
+            buffer[255] = (char)i;
+        }
+        
+        // Free the whole batch at once (chunks are reused, no free())
+        if ((i + 1) % ARENA_BATCH == 0) {
+            arena_reset(&arena);
+        }
+    }
+    
+    clock_t end = clock();
+    arena_free(&arena);
+    return (double)(end - start) / CLOCKS_PER_SEC;
+}
+
 /**
  * Compare allocation strategies
  */
@@ -231,12 +287,43 @@ void performance_comparison(void) {
     printf("\n--- Performance Comparison ---\n");
     printf("Running %d iterations...\n", ITERATIONS);
     
+    // Hardware counters show WHY: instructions, cycles and misses per
+    // allocation, instead of trusting the "100x" folklore below
+    PerfCounters counters;
+    bool have_counters = perf_counters_open(&counters);
+    PerfSample stack_sample, heap_sample, arena_sample;
+    
+    perf_counters_start(&counters);
     double stack_time = benchmark_stack();
+    perf_counters_stop(&counters, &stack_sample);
+    
+    perf_counters_start(&counters);
     double heap_time = benchmark_heap();
+    perf_counters_stop(&counters, &heap_sample);
+    
+    perf_counters_start(&counters);
+    double arena_time = benchmark_arena();
+    perf_counters_stop(&counters, &arena_sample);
     
     printf("Stack allocation: %.6f seconds\n", stack_time);
     printf("Heap allocation:  %.6f seconds\n", heap_time);
+    printf("Arena allocation: %.6f seconds (reset every %d)\n", arena_time, ARENA_BATCH);
     printf("Heap is %.2fx slower than stack\n", heap_time / stack_time);
+    printf("Heap is %.2fx slower than arena\n", heap_time / arena_time);
+    
+    if (have_counters) {
+        perf_sample_print(&stack_sample, ITERATIONS, "stack");
+        perf_sample_print(&heap_sample, ITERATIONS, "heap");
+        perf_sample_print(&arena_sample, ITERATIONS, "arena");
+        if (stack_sample.valid[PERF_INSTRUCTIONS] && heap_sample.valid[PERF_INSTRUCTIONS] &&
+            stack_sample.value[PERF_INSTRUCTIONS] > 0) {
+            printf("    [perf] heap executes %.1fx the instructions of stack\n",
+                   heap_sample.value[PERF_INSTRUCTIONS] / stack_sample.value[PERF_INSTRUCTIONS]);
+        }
+    } else {
+        perf_counters_print_unavailable(&counters);
+    }
+    perf_counters_close(&counters);
     
     // Typical results:
     // Stack: 0.001 seconds
@@ -306,43 +393,166 @@ void heap_size_limits(void) {
  * ============================================================================
  */
 
+/**
+ * Allocator under test: heap_fragmentation_demo() runs the same
+ * workload against glibc malloc and the size-class allocator
+ */
+typedef struct {
+    const char* name;
+    void* (*alloc)(size_t size);
+    void (*release)(void* ptr);
+    size_t (*footprint)(size_t* in_use);    // Bytes held from the OS (0 = unknown)
+    void (*trim)(void);                     // Give cached memory back (NULL = none)
+} DemoAllocator;
+
+static size_t glibc_footprint(size_t* in_use) {
+#ifdef HAVE_MALLINFO2
+    struct mallinfo2 info = mallinfo2();
+    *in_use = info.uordblks + info.hblkhd;  // Live small blocks + mmapped blocks
+    return info.arena + info.hblkhd;        // sbrk heap + mmapped blocks
+#else
+    *in_use = 0;
+    return 0;
+#endif
+}
+
+static size_t size_class_footprint(size_t* in_use) {
+    ScStats stats;
+    sc_get_stats(&stats);
+    *in_use = stats.in_use_bytes;
+    return stats.mapped_bytes;
+}
+
+static const DemoAllocator glibc_allocator = {
+    "glibc malloc", malloc, free, glibc_footprint, NULL
+};
+
+static const DemoAllocator size_class_allocator = {
+    "size-class (sc_malloc)", sc_malloc, sc_free, size_class_footprint, sc_thread_flush
+};
+
+#define CHURN_SLOTS 20000
+#define CHURN_ROUNDS 8
+#define CHURN_SURVIVOR_EVERY 64     // 1 in 64 blocks lives until the end
+
+static void print_footprint(const DemoAllocator* a, const char* label) {
+    size_t in_use = 0;
+    size_t held = a->footprint(&in_use);
+    if (held == 0) {
+        printf("  %-24s footprint unknown, process RSS %zu KB\n", label, sc_process_rss() / 1024);
+        return;
+    }
+    printf("  %-24s held %7zu KB, in use %7zu KB, fragmentation %5.1f%%, RSS %zu KB\n",
+           label, held / 1024, in_use / 1024,
+           held > in_use ? 100.0 * (double)(held - in_use) / (double)held : 0.0,
+           sc_process_rss() / 1024);
+}
+
 /**
  * Demonstrate heap fragmentation
  * 
  * Problem: Repeated alloc/free of varied sizes creates unusable gaps
+ * 
+ * Part A: the classic gap pattern (addresses show where blocks land)
+ * Part B: a long-running-service pattern - random-size churn whose size
+ *         mix drifts over time, with a few long-lived blocks pinning
+ *         memory. "held" is what the allocator keeps from the OS.
  */
-void heap_fragmentation_demo(void) {
-    printf("\n--- Heap Fragmentation ---\n");
+void heap_fragmentation_demo(const DemoAllocator* a) {
+    printf("\n--- Heap Fragmentation: %s ---\n", a->name);
     
     void* pointers[10];
     
     // Allocate 10 blocks of varying sizes
     for (int i = 0; i < 10; i++) {
         size_t size = (i + 1) * 100;
-        pointers[i] = malloc(size);
+        pointers[i] = a->alloc(size);
         printf("Allocated block %d: %zu bytes at %p\n", 
                i, size, pointers[i]);
     }
     
     // Free every other block (creates gaps)
     for (int i = 0; i < 10; i += 2) {
-        free(pointers[i]);
+        a->release(pointers[i]);
         printf("Freed block %d\n", i);
     }
     
     // Now try to allocate large contiguous block
-    void* large = malloc(3000);  // Needs contiguous space
+    void* large = a->alloc(3000);  // Needs contiguous space
     if (large) {
         printf("Large allocation (3000 bytes): SUCCESS at %p\n", large);
-        free(large);
+        a->release(large);
     } else {
         printf("Large allocation (3000 bytes): FAILED (fragmentation)\n");
     }
     
     // Free remaining blocks
     for (int i = 1; i < 10; i += 2) {
-        free(pointers[i]);
+        a->release(pointers[i]);
+    }
+    
+    // Part B: churn with a drifting size mix
+    void** slots = calloc(CHURN_SLOTS, sizeof(void*));
+    size_t survivors_per_round = (CHURN_SLOTS + CHURN_SURVIVOR_EVERY - 1) / CHURN_SURVIVOR_EVERY;
+    void** survivors = calloc(survivors_per_round * CHURN_ROUNDS, sizeof(void*));
+    if (!slots || !survivors) {
+        free(slots);
+        free(survivors);
+        return;
+    }
+    int num_survivors = 0;
+    uint32_t seed = 12345;
+    size_t peak_held = 0, peak_in_use = 0;
+    
+    for (int round = 0; round < CHURN_ROUNDS; round++) {
+        // Early rounds: small objects; later rounds: up to 4KB
+        size_t max_size = (size_t)64 << (round % 7);
+        for (int i = 0; i < CHURN_SLOTS; i++) {
+            seed = seed * 1103515245u + 12345u;
+            size_t size = 16 + (seed >> 8) % max_size;
+            if (slots[i] && (seed & 0x10000)) {
+                a->release(slots[i]);
+                slots[i] = NULL;
+            }
+            if (!slots[i]) {
+                slots[i] = a->alloc(size);
+                if (slots[i]) {
+                    memset(slots[i], 0xA5, size);
+                }
+            }
+            if (i % CHURN_SURVIVOR_EVERY == 0) {
+                survivors[num_survivors++] = a->alloc(16 + (seed >> 4) % 48);
+            }
+        }
+        size_t in_use = 0;
+        size_t held = a->footprint(&in_use);
+        if (held > peak_held) {
+            peak_held = held;
+            peak_in_use = in_use;
+        }
+    }
+    if (peak_held > 0) {
+        printf("  %-24s held %7zu KB, in use %7zu KB\n", "peak during churn",
+               peak_held / 1024, peak_in_use / 1024);
+    }
+    
+    // Load drops: only the long-lived blocks remain
+    for (int i = 0; i < CHURN_SLOTS; i++) {
+        a->release(slots[i]);
+    }
+    print_footprint(a, "after churn:");
+    
+    for (int i = 0; i < num_survivors; i++) {
+        a->release(survivors[i]);
+    }
+    print_footprint(a, "everything freed:");
+    if (a->trim != NULL) {
+        // Cached objects still pin their spans until the cache is flushed
+        a->trim();
+        print_footprint(a, "after sc_thread_flush():");
     }
+    free(slots);
+    free(survivors);
     
     // Stack has NO fragmentation (always contiguous)
 }
@@ -399,41 +609,290 @@ void process_packet(const uint8_t* data, size_t len) {
     // Process buffer...
 }
 
+// Example 1b: Packets of any size without copying (use a buffer pool)
+typedef struct {
+    uint32_t checksum;      // Running CRC32 over every byte handled
+    size_t bytes;
+    size_t packets;
+    size_t rejected;
+} PacketStats;
+
+void process_packet_view(const Packet* packet, void* context) {
+    // ✅ Pool buffers: the packet was received once and is read in place,
+    //    one crc32_update per segment - no size limit, no memcpy
+    PacketStats* stats = context;
+    for (size_t i = 0; i < packet->segment_count; i++) {
+        stats->checksum = crc32_update(stats->checksum, packet->segments[i].base,
+                                       packet->segments[i].length);
+    }
+    stats->bytes += packet->length;
+    stats->packets++;
+}
+
 // Example 2: User input (use heap)
-char* read_line(FILE* fp) {
+char* read_line(LineReader* reader) {
     // ✅ Heap: size unknown, lifetime extends beyond function
-    size_t capacity = 128;
-    char* line = malloc(capacity);
+    //    The line is found in the reader's buffer (one read() per 256KB,
+    //    memchr for '\n') and copied out once, so it outlives the next read
+    StringView view;
+    if (!line_reader_next(reader, &view)) {
+        return NULL;  // End of input or read error
+    }
     
+    char* line = malloc(view.length + 1);
     if (!line) return NULL;
     
-    size_t length = 0;
-    int c;
-    while ((c = fgetc(fp)) != EOF && c != '\n') {
-        if (length + 1 >= capacity) {
-            capacity *= 2;
-            char* new_line = realloc(line, capacity);
-            if (!new_line) {
-                free(line);
-                return NULL;
-            }
-            line = new_line;
-        }
-        line[length++] = (char)c;
-    }
-    
-    line[length] = '\0';
+    memcpy(line, view.data, view.length + 1);  // view.data is NUL-terminated
     return line;  // Caller must free!
 }
 
+// Example 2b: User input from an arena (no malloc, no free per line)
+char* read_line_arena(LineReader* reader, Arena* arena) {
+    // ✅ Arena: same single copy as read_line(), but the copy is a bump
+    //    of the arena pointer, and the caller frees a whole batch with
+    //    arena_reset()
+    StringView view;
+    if (!line_reader_next(reader, &view)) {
+        return NULL;  // End of input or read error
+    }
+    return arena_strndup(arena, view.data, view.length);
+}
+
 // Example 3: Lookup table (use static/const)
 uint32_t crc32_byte(uint8_t byte) {
-    // ✅ Static: computed once, persists, no allocation overhead
-    static const uint32_t crc_table[256] = {
-        0x00000000, 0x77073096, 0xEE0E612C, /* ... */
-    };
+    // ✅ Static const: emitted into .rodata at compile time, no allocation
+    //    overhead, shared by every caller (full table lives in crc32.c)
+    return crc32_table[byte];
+}
+
+// Example 4: Whole-buffer checksum built on the same table
+uint32_t checksum_buffer(const uint8_t* data, size_t len) {
+    // ✅ crc32_update() picks slicing-16 or PCLMUL/ARMv8 hardware at runtime
+    //    (see crc32_benchmark for GB/s per implementation)
+    return crc32_update(0, data, len);
+}
+
+/* ============================================================================
+ * PART 8: Arena Allocation for Parse Loops
+ * ============================================================================
+ */
+
+#define PARSE_LINES 200000
+
+/**
+ * Parse the same file with read_line() + free() and with
+ * read_line_arena() + one arena_reset() per batch of lines
+ */
+void arena_line_parsing_demo(void) {
+    printf("\n--- Part 8: Arena Allocation for Parse Loops ---\n");
     
-    return crc_table[byte];
+    FILE* fp = tmpfile();
+    if (!fp) {
+        perror("tmpfile");
+        return;
+    }
+    for (int i = 0; i < PARSE_LINES; i++) {
+        // Mostly short lines, every 100th one 300 bytes
+        int length = (i % 100 == 0) ? 300 : 20 + i % 60;
+        for (int j = 0; j < length; j++) {
+            fputc('a' + (i + j) % 26, fp);
+        }
+        fputc('\n', fp);
+    }
+    
+    // malloc/free per line
+    rewind(fp);
+    size_t heap_bytes = 0;
+    int heap_lines = 0;
+    double heap_time = 0.0;
+    LineReader reader;
+    char* line;
+    if (line_reader_attach(&reader, fp)) {
+        clock_t start = clock();
+        while ((line = read_line(&reader)) != NULL) {
+            heap_bytes += strlen(line);
+            heap_lines++;
+            free(line);
+        }
+        heap_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        line_reader_close(&reader);
+    }
+    
+    // Arena: lines live until the batch is done, then one reset
+    Arena arena;
+    arena_init(&arena, 0);
+    rewind(fp);
+    size_t arena_bytes = 0;
+    int arena_lines = 0;
+    double arena_time = 0.0;
+    if (line_reader_attach(&reader, fp)) {
+        clock_t start = clock();
+        while ((line = read_line_arena(&reader, &arena)) != NULL) {
+            arena_bytes += strlen(line);
+            if (++arena_lines % ARENA_BATCH == 0) {
+                arena_reset(&arena);
+            }
+        }
+        arena_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        line_reader_close(&reader);
+    }
+    
+    // Views alone: no allocation and no copy at all - lines point into
+    // the reader's 256KB buffer (copy to keep a line)
+    rewind(fp);
+    size_t view_bytes = 0;
+    int view_lines = 0;
+    double view_time = 0.0;
+    if (line_reader_attach(&reader, fp)) {
+        StringView view;
+        clock_t start = clock();
+        while (line_reader_next(&reader, &view)) {
+            view_bytes += view.length;
+            view_lines++;
+        }
+        view_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        line_reader_close(&reader);
+    }
+    
+    printf("read_line + free:        %d lines, %zu bytes, %.6f seconds\n",
+           heap_lines, heap_bytes, heap_time);
+    printf("read_line_arena + reset: %d lines, %zu bytes, %.6f seconds\n",
+           arena_lines, arena_bytes, arena_time);
+    printf("line_reader views:       %d lines, %zu bytes, %.6f seconds\n",
+           view_lines, view_bytes, view_time);
+    printf("Arena reserved %zu KB total for the whole file\n",
+           arena_bytes_reserved(&arena) / 1024);
+    
+    // Scoped temporaries: mark, allocate scratch, rewind
+    arena_reset(&arena);
+    char* keep = arena_strndup(&arena, "kept", 4);
+    ArenaMarker mark = arena_mark(&arena);
+    size_t before = arena_bytes_used(&arena);
+    void* scratch = arena_alloc(&arena, 4096);
+    size_t during = arena_bytes_used(&arena);
+    arena_rewind(&arena, mark);
+    printf("Marker: %zu bytes used -> %zu with scratch %s -> %zu after rewind (\"%s\" intact)\n",
+           before, during, scratch ? "allocated" : "failed", arena_bytes_used(&arena), keep);
+    
+    arena_free(&arena);
+    fclose(fp);
+}
+
+/* ============================================================================
+ * PART 9: Zero-Copy Packet Pipeline
+ * ============================================================================
+ */
+
+#define PIPELINE_PACKETS 200000
+#define PIPELINE_POOL_BUFFERS 1024
+#define JUMBO_FRAME 9000
+#define ETH_HEADER 14
+
+static size_t pipeline_frame_length(int i) {
+    // Mostly 64-1500 byte frames, every 16th a jumbo frame (spans 5 buffers)
+    return (i % 16 == 0) ? JUMBO_FRAME : 64 + (size_t)(i * 37) % 1437;
+}
+
+// process_packet() as a burst handler: gather into the stack, reject > 256
+static void copy_packet_handler(const Packet* packet, void* context) {
+    PacketStats* stats = context;
+    uint8_t buffer[256];
+    if (packet->length > sizeof(buffer)) {
+        stats->rejected++;
+        return;
+    }
+    packet_read(packet, 0, buffer, packet->length);
+    stats->checksum = crc32_update(stats->checksum, buffer, packet->length);
+    stats->bytes += packet->length;
+    stats->packets++;
+}
+
+typedef struct {
+    Packet queue[PACKET_BURST_MAX];     // Payload views waiting to be sent
+    size_t count;
+    uint32_t ethertypes;                // Sum of header fields (keeps the read live)
+} ForwardQueue;
+
+// Strip the Ethernet header and queue the payload as a view (no copy)
+static void forward_packet_handler(const Packet* packet, void* context) {
+    ForwardQueue* tx = context;
+    uint8_t scratch[ETH_HEADER];
+    const uint8_t* header = packet_header(packet, ETH_HEADER, scratch);
+    if (header == NULL) return;
+    tx->ethertypes += (uint32_t)((header[12] << 8) | header[13]);
+    packet_slice(packet, ETH_HEADER, packet->length - ETH_HEADER, &tx->queue[tx->count++]);
+}
+
+/**
+ * Feed the same frames through one handler in bursts of PACKET_BURST_MAX
+ * Returns: seconds spent
+ */
+static double run_pipeline(PacketPool* pool, const uint8_t* wire, PacketHandler handler,
+                           void* context, ForwardQueue* tx, size_t* peak_in_use) {
+    Packet burst[PACKET_BURST_MAX];
+    clock_t start = clock();
+    for (int i = 0; i < PIPELINE_PACKETS; ) {
+        size_t n = 0;
+        while (n < PACKET_BURST_MAX && i < PIPELINE_PACKETS) {
+            size_t length = pipeline_frame_length(i);
+            if (packet_receive(pool, &burst[n], wire + (size_t)(i % 64) * 64, length)) {
+                n++;
+            }
+            i++;
+        }
+        packet_process_burst(pool, burst, n, handler, context);
+        if (tx != NULL) {
+            // Views outlive the burst: their buffers are still referenced
+            size_t in_use = pool->buffer_count - packet_pool_available(pool);
+            if (in_use > *peak_in_use) *peak_in_use = in_use;
+            for (size_t q = 0; q < tx->count; q++) {
+                packet_release(pool, &tx->queue[q]);    // "Sent"
+            }
+            tx->count = 0;
+        }
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+void packet_pipeline_demo(void) {
+    printf("\n--- Part 9: Zero-Copy Packet Pipeline ---\n");
+    
+    PacketPool pool;
+    uint8_t* wire = malloc(64 * 64 + JUMBO_FRAME);
+    if (!wire || !packet_pool_init(&pool, PIPELINE_POOL_BUFFERS)) {
+        printf("Allocation failed\n");
+        free(wire);
+        return;
+    }
+    for (size_t i = 0; i < 64 * 64 + JUMBO_FRAME; i++) {
+        wire[i] = (uint8_t)(i * 131 + (i >> 7));
+    }
+    printf("%d packets, 1 in 16 jumbo (%d bytes), bursts of %d, pool of %d x %dB buffers\n",
+           PIPELINE_PACKETS, JUMBO_FRAME, PACKET_BURST_MAX, PIPELINE_POOL_BUFFERS,
+           PACKET_BUFFER_SIZE);
+    
+    PacketStats copied = { 0 };
+    double copy_time = run_pipeline(&pool, wire, copy_packet_handler, &copied, NULL, NULL);
+    
+    PacketStats viewed = { 0 };
+    double view_time = run_pipeline(&pool, wire, process_packet_view, &viewed, NULL, NULL);
+    
+    ForwardQueue tx = { .count = 0 };
+    size_t peak_in_use = 0;
+    double forward_time = run_pipeline(&pool, wire, forward_packet_handler, &tx, &tx, &peak_in_use);
+    
+    printf("copy into uint8_t[256]:  %zu handled, %zu rejected, %.1f MB, %.6f seconds\n",
+           copied.packets, copied.rejected, (double)copied.bytes / 1e6, copy_time);
+    printf("views into the pool:     %zu handled, %zu rejected, %.1f MB, %.6f seconds (CRC 0x%08X)\n",
+           viewed.packets, viewed.rejected, (double)viewed.bytes / 1e6, view_time,
+           (unsigned)viewed.checksum);
+    printf("payload views forwarded: %.6f seconds, up to %zu buffers held by queued views\n",
+           forward_time, peak_in_use);
+    printf("Buffers free after all runs: %zu of %zu\n",
+           packet_pool_available(&pool), pool.buffer_count);
+    
+    packet_pool_destroy(&pool);
+    free(wire);
 }
 
 /* ============================================================================
@@ -460,12 +919,26 @@ int main(void) {
     stack_size_limits();
     heap_size_limits();
     
-    // Part 5: Fragmentation
-    heap_fragmentation_demo();
+    // Part 5: Fragmentation (same workload, two allocators)
+    heap_fragmentation_demo(&glibc_allocator);
+    heap_fragmentation_demo(&size_class_allocator);
     
     // Part 6: Guidelines
     use_case_guidelines();
     
+    // Part 7: Static lookup table in action
+    const uint8_t sample[] = "123456789";
+    printf("\n--- Part 7: Static Lookup Table ---\n");
+    printf("crc32_byte(0x01) = 0x%08X\n", (unsigned)crc32_byte(0x01));
+    printf("CRC32(\"123456789\") = 0x%08X (expected 0xCBF43926)\n",
+           (unsigned)checksum_buffer(sample, sizeof(sample) - 1));
+    
+    // Part 8: Arena for parse loops
+    arena_line_parsing_demo();
+    
+    // Part 9: Pool buffers and views instead of per-packet copies
+    packet_pipeline_demo();
+    
     printf("\n=================================================\n");
     printf("Key Takeaways:\n");
     printf("1. Stack is 10-100x faster than heap\n");
@@ -474,6 +947,8 @@ int main(void) {
     printf("4. Heap allows flexible lifetime and size\n");
     printf("5. Heap can fragment with varied allocation sizes\n");
     printf("6. Embedded systems prefer stack over heap\n");
+    printf("7. Arenas give heap lifetime at near-stack cost\n");
+    printf("8. Buffer pools + views move packets without copying them\n");
     printf("=================================================\n");
     
     return 0;
@@ -520,7 +995,8 @@ int main(void) {
  * 3. Failure handling is complex (what if malloc returns NULL?)
  * 4. MISRA-C Rule 21.3: "malloc and free shall not be used"
  * 
- * Alternative: Memory pools with fixed-size blocks
+ * Alternative: Memory pools with fixed-size blocks, or an arena carved out
+ * of a static buffer and reset once per frame/message
  * 
  * ============================================================================
  */